@@ -0,0 +1,565 @@
+// Copyright (c) 2025 Intel Corporation
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+
+// Throughput of the VP9/AV1 header bit reader.
+// Synthetic streams of header-like syntax elements (mostly flags and short
+// fixed-width fields, some 16/32-bit fields, exp-Golomb, uvlc and LEB128
+// values) are written and then read back with VP9Bitstream/AV1Bitstream and
+// with a bit-at-a-time reference reader. Read values are compared between
+// the two. AV1 sequence header OBUs with random parameters are parsed with
+// ReadOBUInfo and ReadSequenceHeader, the same calls the decoder makes.
+//
+// Usage:
+//   av1_header_parse_bench [elements [iterations]]
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+#include "umc_av1_bitstream_utils.h"
+
+using UMC_AV1_DECODER::AV1Bitstream;
+
+enum ElementType
+{
+    ELEMENT_BITS,
+    ELEMENT_UE,
+    ELEMENT_SE,
+    ELEMENT_UVLC,
+    ELEMENT_LEB128,
+};
+
+struct Element
+{
+    ElementType type;
+    uint32_t    width;  // ELEMENT_BITS only
+    uint64_t    value;  // written value, reads are checked against it
+};
+
+class BitWriter
+{
+public:
+
+    void PutBits(uint64_t value, uint32_t nbits)
+    {
+        for (uint32_t i = nbits; i > 0; --i)
+            PutBit((uint32_t)(value >> (i - 1)) & 1);
+    }
+
+    void PutBit(uint32_t bit)
+    {
+        if (!(m_bits % 8))
+            m_data.push_back(0);
+        m_data.back() |= (uint8_t)(bit << (7 - m_bits % 8));
+        m_bits++;
+    }
+
+    // ue(v) of VP9/H.26x and uvlc() of AV1 have the same code
+    void PutUe(uint32_t value)
+    {
+        uint64_t code = (uint64_t)value + 1;
+        uint32_t len = 0;
+        while ((code >> len) > 1)
+            len++;
+
+        PutBits(0, len);
+        PutBits(code, len + 1);
+    }
+
+    void PutSe(int32_t value)
+    {
+        PutUe(value > 0 ? 2 * (uint32_t)value - 1 : 2 * (uint32_t)(-value));
+    }
+
+    void PutLeb128(uint64_t value)
+    {
+        do
+        {
+            uint32_t byte = value & 0x7f;
+            value >>= 7;
+            PutBits(value ? byte | 0x80 : byte, 8);
+        } while (value);
+    }
+
+    void ByteAlign()
+    {
+        while (m_bits % 8)
+            PutBit(0);
+    }
+
+    std::vector<uint8_t>& Data() { return m_data; }
+
+private:
+
+    std::vector<uint8_t> m_data;
+    size_t               m_bits = 0;
+};
+
+// Bit at a time reader, the algorithm VP9Bitstream used before it read through a 64-bit cache
+class ReferenceReader
+{
+public:
+
+    ReferenceReader(const uint8_t* data, size_t size)
+        : m_data(data)
+        , m_size(size)
+        , m_pos(0)
+    {}
+
+    uint32_t GetBit()
+    {
+        if (m_pos >= m_size * 8)
+            throw UMC_VP9_DECODER::vp9_exception(UMC::UMC_ERR_NOT_ENOUGH_DATA);
+
+        uint32_t bit = (m_data[m_pos / 8] >> (7 - m_pos % 8)) & 1;
+        m_pos++;
+        return bit;
+    }
+
+    uint32_t GetBits(uint32_t nbits)
+    {
+        uint32_t bits = 0;
+        for (; nbits > 0; --nbits)
+            bits = (bits << 1) | GetBit();
+        return bits;
+    }
+
+    uint32_t GetUe()
+    {
+        uint32_t zeroes = 0;
+        while (GetBit() == 0)
+            ++zeroes;
+
+        return zeroes == 0 ? 0 : ((1 << zeroes) | GetBits(zeroes)) - 1;
+    }
+
+    int32_t GetSe()
+    {
+        int32_t val = GetUe();
+        uint32_t sign = (val & 1);
+        val = (val + 1) >> 1;
+        return sign ? val : -int32_t(val);
+    }
+
+    uint32_t GetUvlc()
+    {
+        uint32_t leadingZeros = 0;
+        while (!GetBit())
+            ++leadingZeros;
+
+        if (leadingZeros >= 32)
+            return UINT32_MAX;
+        return (1u << leadingZeros) - 1 + GetBits(leadingZeros);
+    }
+
+    uint64_t GetLeb128()
+    {
+        uint64_t value = 0;
+        for (uint32_t i = 0; i < UMC_AV1_DECODER::MAX_LEB128_SIZE; ++i)
+        {
+            uint32_t byte = GetBits(8);
+            value |= (uint64_t)(byte & 0x7f) << (i * 7);
+            if (!(byte & 0x80))
+                return value;
+        }
+
+        throw UMC_VP9_DECODER::vp9_exception(UMC::UMC_ERR_INVALID_STREAM);
+    }
+
+private:
+
+    const uint8_t* m_data;
+    size_t         m_size;
+    size_t         m_pos;
+};
+
+static uint32_t Random(uint32_t& seed)
+{
+    seed = seed * 1103515245 + 12345;
+    return seed >> 8;
+}
+
+// Field widths and code types roughly follow VP9 uncompressed and AV1 frame headers:
+// half of the elements are flags, most of the rest are fields up to 8 bits wide
+static void MakeElements(std::vector<Element>& elements, size_t count, bool av1, uint32_t seed)
+{
+    elements.resize(count);
+
+    for (Element& e : elements)
+    {
+        uint32_t kind = Random(seed) % 100;
+        uint32_t value = Random(seed);
+
+        e.width = 0;
+
+        if (kind < 50)
+        {
+            e.type  = ELEMENT_BITS;
+            e.width = 1;
+        }
+        else if (kind < 75)
+        {
+            e.type  = ELEMENT_BITS;
+            e.width = 2 + Random(seed) % 7;
+        }
+        else if (kind < 83)
+        {
+            e.type  = ELEMENT_BITS;
+            e.width = 16;
+        }
+        else if (kind < 85)
+        {
+            e.type  = ELEMENT_BITS;
+            e.width = 32;
+            value   = (value << 8) ^ Random(seed);
+        }
+        else if (kind < 93)
+        {
+            // small codes are the common ones
+            e.type = av1 ? ELEMENT_UVLC : ((kind & 1) ? ELEMENT_UE : ELEMENT_SE);
+            value >>= 8 + Random(seed) % 16;
+        }
+        else
+        {
+            e.type = av1 ? ELEMENT_LEB128 : ELEMENT_UE;
+            value >>= Random(seed) % 24;
+        }
+
+        if (e.type == ELEMENT_BITS && e.width < 32)
+            value &= (1u << e.width) - 1;
+
+        if (e.type == ELEMENT_SE)
+            e.value = (uint64_t)(int64_t)((value & 1) ? -(int32_t)(value >> 1) : (int32_t)(value >> 1));
+        else
+            e.value = value;
+    }
+}
+
+static void WriteElements(const std::vector<Element>& elements, BitWriter& writer)
+{
+    for (const Element& e : elements)
+    {
+        switch (e.type)
+        {
+        case ELEMENT_BITS:   writer.PutBits(e.value, e.width);          break;
+        case ELEMENT_UE:     writer.PutUe((uint32_t)e.value);           break;
+        case ELEMENT_SE:     writer.PutSe((int32_t)(int64_t)e.value);   break;
+        case ELEMENT_UVLC:   writer.PutUe((uint32_t)e.value);           break;
+        case ELEMENT_LEB128: writer.PutLeb128(e.value);                 break;
+        }
+    }
+
+    writer.ByteAlign();
+}
+
+static uint64_t Read(ReferenceReader& reader, const Element& e)
+{
+    switch (e.type)
+    {
+    case ELEMENT_BITS:   return reader.GetBits(e.width);
+    case ELEMENT_UE:     return reader.GetUe();
+    case ELEMENT_SE:     return (uint64_t)(int64_t)reader.GetSe();
+    case ELEMENT_UVLC:   return reader.GetUvlc();
+    case ELEMENT_LEB128: return reader.GetLeb128();
+    }
+
+    return 0;
+}
+
+static uint64_t Read(AV1Bitstream& bs, const Element& e)
+{
+    switch (e.type)
+    {
+    case ELEMENT_BITS:   return e.width == 1 ? bs.GetBit() : bs.GetBits(e.width);
+    case ELEMENT_UE:     return bs.GetUe();
+    case ELEMENT_SE:     return (uint64_t)(int64_t)bs.GetSe();
+    case ELEMENT_UVLC:   return UMC_AV1_DECODER::read_uvlc(bs);
+    case ELEMENT_LEB128: return bs.GetLeb128();
+    }
+
+    return 0;
+}
+
+// Reads all elements, returns number of mismatches with the written values
+template <class Reader>
+static size_t ReadElements(Reader& reader, const std::vector<Element>& elements)
+{
+    size_t mismatches = 0;
+
+    for (const Element& e : elements)
+        mismatches += (Read(reader, e) != e.value);
+
+    return mismatches;
+}
+
+// Writes a temporal delimiter and sequence_header_obu() with random parameters,
+// returns the coded maximum frame size
+static void WriteSequenceHeaderObu(BitWriter& obu, uint32_t& seed, uint32_t& width, uint32_t& height)
+{
+    BitWriter payload;
+
+    width  = 16 + Random(seed) % 8177;
+    height = 16 + Random(seed) % 4305;
+
+    payload.PutBits(0, 3);                      // seq_profile
+    payload.PutBit(0);                          // still_picture
+    payload.PutBit(0);                          // reduced_still_picture_header
+    payload.PutBit(1);                          // timing_info_present_flag
+    payload.PutBits(1001, 32);                  // num_units_in_display_tick
+    payload.PutBits(60000, 32);                 // time_scale
+    payload.PutBit(1);                          // equal_picture_interval
+    payload.PutUe(Random(seed) % 4);            // num_ticks_per_picture_minus_1
+    payload.PutBit(1);                          // decoder_model_info_present_flag
+    payload.PutBits(23, 5);                     // buffer_delay_length_minus_1
+    payload.PutBits(1001, 32);                  // num_units_in_decoding_tick
+    payload.PutBits(31, 5);                     // buffer_removal_time_length_minus_1
+    payload.PutBits(31, 5);                     // frame_presentation_time_length_minus_1
+    payload.PutBit(1);                          // initial_display_delay_present_flag
+
+    uint32_t numOperatingPoints = 1 + Random(seed) % 8;
+    payload.PutBits(numOperatingPoints - 1, 5);
+    for (uint32_t i = 0; i < numOperatingPoints; i++)
+    {
+        payload.PutBits(Random(seed) & 0xfff, 12);  // operating_point_idc
+        uint32_t level = Random(seed) % 24;
+        payload.PutBits(level, 5);                  // seq_level_idx
+        if (level > 7)
+            payload.PutBit(Random(seed) & 1);       // seq_tier
+
+        uint32_t decoderModelPresent = Random(seed) & 1;
+        payload.PutBit(decoderModelPresent);
+        if (decoderModelPresent)
+        {
+            payload.PutBits(Random(seed), 24);      // decoder_buffer_delay
+            payload.PutBits(Random(seed), 24);      // encoder_buffer_delay
+            payload.PutBit(0);                      // low_delay_mode_flag
+        }
+
+        payload.PutBit(1);                          // initial_display_delay_present_for_this_op
+        payload.PutBits(Random(seed) % 10, 4);      // initial_display_delay_minus_1
+    }
+
+    payload.PutBits(12, 4);                     // frame_width_bits_minus_1
+    payload.PutBits(12, 4);                     // frame_height_bits_minus_1
+    payload.PutBits(width - 1, 13);
+    payload.PutBits(height - 1, 13);
+    payload.PutBit(0);                          // frame_id_numbers_present_flag
+    payload.PutBit(Random(seed) & 1);           // use_128x128_superblock
+    payload.PutBits(0x1ff, 9);                  // filter intra ... enable_ref_frame_mvs
+    payload.PutBit(1);                          // seq_choose_screen_content_tools
+    payload.PutBit(1);                          // seq_choose_integer_mv
+    payload.PutBits(6, 3);                      // order_hint_bits_minus_1
+    payload.PutBits(Random(seed) & 7, 3);       // superres, cdef, restoration
+    payload.PutBit(0);                          // high_bitdepth
+    payload.PutBit(0);                          // mono_chrome
+    payload.PutBit(1);                          // color_description_present_flag
+    payload.PutBits(1, 8);                      // color_primaries
+    payload.PutBits(1, 8);                      // transfer_characteristics
+    payload.PutBits(1, 8);                      // matrix_coefficients
+    payload.PutBit(0);                          // color_range
+    payload.PutBits(0, 2);                      // chroma_sample_position
+    payload.PutBit(0);                          // separate_uv_delta_q
+    payload.PutBit(0);                          // film_grain_params_present
+    payload.PutBit(1);                          // trailing_one_bit
+    payload.ByteAlign();
+
+    obu.PutBits(0x12, 8);                       // temporal delimiter, obu_has_size_field
+    obu.PutLeb128(0);
+    obu.PutBits(0x0a, 8);                       // sequence header, obu_has_size_field
+    obu.PutLeb128(payload.Data().size());
+    for (uint8_t byte : payload.Data())
+        obu.PutBits(byte, 8);
+}
+
+// Parses all OBUs of the buffer, returns number of sequence headers with wrong frame size
+static size_t ParseObus(std::vector<uint8_t>& data, const std::vector<uint32_t>& sizes, size_t& numObus)
+{
+    size_t mismatches = 0;
+    size_t numHeaders = 0;
+    size_t offset = 0;
+
+    numObus = 0;
+
+    while (offset < data.size())
+    {
+        AV1Bitstream bs(data.data() + offset, (uint32_t)(data.size() - offset));
+
+        UMC_AV1_DECODER::OBUInfo info;
+        bs.ReadOBUInfo(info);
+
+        if (info.header.obu_type == UMC_AV1_DECODER::OBU_SEQUENCE_HEADER)
+        {
+            UMC_AV1_DECODER::SequenceHeader sh = {};
+            bs.ReadSequenceHeader(sh);
+
+            mismatches += (sh.max_frame_width != sizes[2 * numHeaders] || sh.max_frame_height != sizes[2 * numHeaders + 1]);
+            numHeaders++;
+        }
+
+        offset += info.size;
+        numObus++;
+    }
+
+    return mismatches;
+}
+
+template <class Func>
+static double BestTime(int iterations, Func func)
+{
+    double best = 0;
+
+    for (int i = 0; i < iterations; i++)
+    {
+        auto start = std::chrono::steady_clock::now();
+        func();
+        double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+        if (!i || seconds < best)
+            best = seconds;
+    }
+
+    return best;
+}
+
+int main(int argc, char* argv[])
+{
+    size_t count = 1 << 20;
+    int iterations = 10;
+
+    if (argc == 2 || argc == 3)
+    {
+        count = (size_t)atol(argv[1]);
+        if (argc == 3)
+            iterations = atoi(argv[2]);
+    }
+    else if (argc != 1)
+    {
+        printf("usage: %s [elements [iterations]]\n", argv[0]);
+        return 1;
+    }
+
+    if (!count || iterations <= 0)
+    {
+        printf("usage: %s [elements [iterations]]\n", argv[0]);
+        return 1;
+    }
+
+    printf("%zu elements, %d iterations, best time of each run\n", count, iterations);
+    printf("%-8s %-10s %12s %12s %10s\n", "syntax", "reader", "Melements/s", "MB/s", "speedup");
+
+    int failures = 0;
+
+    for (bool av1 : { false, true })
+    {
+        const char* name = av1 ? "AV1" : "VP9";
+
+        std::vector<Element> elements;
+        MakeElements(elements, count, av1, av1 ? 2 : 1);
+
+        BitWriter writer;
+        WriteElements(elements, writer);
+        std::vector<uint8_t>& data = writer.Data();
+
+        size_t refMismatches = 0;
+        size_t mismatches = 0;
+
+        try
+        {
+            double refTime = BestTime(iterations, [&]()
+            {
+                ReferenceReader reader(data.data(), data.size());
+                refMismatches = ReadElements(reader, elements);
+            });
+
+            double time = BestTime(iterations, [&]()
+            {
+                AV1Bitstream bs(data.data(), (uint32_t)data.size());
+                mismatches = ReadElements(bs, elements);
+            });
+
+            printf("%-8s %-10s %12.1f %12.1f %10s\n", name, "reference", count / refTime * 1e-6, data.size() / refTime * 1e-6, "");
+            printf("%-8s %-10s %12.1f %12.1f %9.2fx\n", name, "cached", count / time * 1e-6, data.size() / time * 1e-6, refTime / time);
+        }
+        catch (UMC_VP9_DECODER::vp9_exception const& e)
+        {
+            printf("%-8s failed, error %d\n", name, (int)e.GetStatus());
+            failures++;
+            continue;
+        }
+
+        if (refMismatches || mismatches)
+        {
+            printf("%-8s MISMATCH: reference %zu, cached %zu\n", name, refMismatches, mismatches);
+            failures++;
+        }
+    }
+
+    // temporal delimiter and sequence header pairs, like the head of every AV1 random access point
+    {
+        size_t numHeaders = std::max<size_t>(count / 64, 1);
+        uint32_t seed = 3;
+
+        BitWriter writer;
+        std::vector<uint32_t> sizes;
+        for (size_t i = 0; i < numHeaders; i++)
+        {
+            uint32_t width = 0, height = 0;
+            WriteSequenceHeaderObu(writer, seed, width, height);
+            sizes.push_back(width);
+            sizes.push_back(height);
+        }
+
+        std::vector<uint8_t>& data = writer.Data();
+        size_t mismatches = 0;
+        size_t numObus = 0;
+
+        try
+        {
+            double time = BestTime(iterations, [&]()
+            {
+                mismatches = ParseObus(data, sizes, numObus);
+            });
+
+            printf("%-8s %-10s %12.1f %12.1f %10s (OBUs)\n", "AV1 SH", "cached", numObus / time * 1e-6, data.size() / time * 1e-6, "");
+        }
+        catch (UMC_AV1_DECODER::av1_exception const& e)
+        {
+            printf("%-8s failed, error %d\n", "AV1 SH", (int)e.GetStatus());
+            failures++;
+        }
+        catch (UMC_VP9_DECODER::vp9_exception const& e)
+        {
+            printf("%-8s failed, error %d\n", "AV1 SH", (int)e.GetStatus());
+            failures++;
+        }
+
+        if (mismatches)
+        {
+            printf("%-8s MISMATCH: %zu sequence headers\n", "AV1 SH", mismatches);
+            failures++;
+        }
+    }
+
+    return failures ? 1 : 0;
+}
@@ -43,6 +43,9 @@ using namespace UMC_HEVC_DECODER;
 
 #include "mfx_unified_h265d_logging.h"
 
+#include <cstdlib>
+#include <cstring>
+
 inline
 bool IsNeedToUseHWBuffering(eMFXHWType /*type*/)
 {
@@ -278,6 +281,15 @@ mfxStatus VideoDECODEH265::Init(mfxVideoParam *par)
     m_pH265VideoDecoder->SetFrameAllocator(m_surface_source.get());
     static_cast<VATaskSupplier*>(m_pH265VideoDecoder.get())->SetVideoHardwareAccelerator(m_va);
 
+    // finish frame submission on the scheduler thread while the next access unit is parsed
+    const char *pParseAhead = std::getenv("VPL_DECODE_PARSE_AHEAD");
+    bool parseAhead = pParseAhead && !strcmp(pParseAhead, "1");
+#if defined(MFX_ENABLE_PXP)
+    // protected session submits the bitstream set by the current call
+    parseAhead = parseAhead && !m_va->GetProtectedVA();
+#endif // MFX_ENABLE_PXP
+    static_cast<VATaskSupplier*>(m_pH265VideoDecoder.get())->SetParseAhead(parseAhead);
+
 
 #ifndef MFX_DEC_VIDEO_POSTPROCESS_DISABLE
     if (m_va->GetVideoProcessingVA())
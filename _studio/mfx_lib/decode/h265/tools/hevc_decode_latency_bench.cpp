@@ -0,0 +1,309 @@
+// Copyright (c) 2025 Intel Corporation
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+
+// Latency of DecodeFrameAsync calls of the HEVC decoder on a recorded stream.
+// The stream is decoded twice, with frame submission done by the calling thread
+// and with VPL_DECODE_PARSE_AHEAD=1, which leaves the execution of the packed
+// frame to the scheduler thread while the next access unit is parsed.
+// Checksums of NV12 and P010 output frames of both runs are compared, so the
+// option can be validated on hardware before it's turned on by default.
+//
+// Usage:
+//   hevc_decode_latency_bench input.265 [async_depth [render_node]]
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <deque>
+#include <thread>
+#include <vector>
+
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <va/va.h>
+#include <va/va_drm.h>
+
+#include "mfxvideo.h"
+
+struct LatencyStats
+{
+    std::vector<double>   calls;     // microseconds of the calls which consumed bitstream
+    std::vector<uint64_t> checksums; // per output frame, empty if the format isn't checked
+    int                   frames;
+    double                seconds;
+};
+
+static double Percentile(std::vector<double> values, double p)
+{
+    if (values.empty())
+        return 0;
+
+    std::sort(values.begin(), values.end());
+    size_t index = std::min(values.size() - 1, (size_t)(p * (values.size() - 1) + 0.5));
+
+    return values[index];
+}
+
+// FNV-1a over the visible rows of luma and interleaved chroma planes
+static mfxStatus Checksum(mfxFrameSurface1* surface, std::vector<uint64_t>& checksums)
+{
+    const mfxFrameInfo& info = surface->Info;
+    if (info.FourCC != MFX_FOURCC_NV12 && info.FourCC != MFX_FOURCC_P010)
+        return MFX_ERR_NONE;
+
+    mfxStatus sts = surface->FrameInterface->Map(surface, MFX_MAP_READ);
+    if (sts != MFX_ERR_NONE)
+        return sts;
+
+    const mfxFrameData& data = surface->Data;
+    size_t pitch          = ((size_t)data.PitchHigh << 16) + data.PitchLow;
+    size_t bytesPerSample = info.FourCC == MFX_FOURCC_P010 ? 2 : 1;
+
+    uint64_t hash = 14695981039346656037ull;
+    auto hashRows = [&](const mfxU8* plane, mfxU32 top, mfxU32 rows)
+    {
+        for (mfxU32 y = 0; y < rows; y++)
+        {
+            const mfxU8* row = plane + pitch * (top + y) + bytesPerSample * info.CropX;
+            for (size_t x = 0; x < bytesPerSample * info.CropW; x++)
+                hash = (hash ^ row[x]) * 1099511628211ull;
+        }
+    };
+
+    hashRows(data.Y, info.CropY, info.CropH);
+    hashRows(data.UV, info.CropY / 2, (info.CropH + 1) / 2);
+
+    checksums.push_back(hash);
+
+    return surface->FrameInterface->Unmap(surface);
+}
+
+static mfxStatus SyncAndRelease(mfxSession session, std::deque<std::pair<mfxSyncPoint, mfxFrameSurface1*>>& inFlight, LatencyStats& stats)
+{
+    mfxStatus sts = MFXVideoCORE_SyncOperation(session, inFlight.front().first, MFX_INFINITE);
+
+    mfxFrameSurface1* surface = inFlight.front().second;
+    if (sts == MFX_ERR_NONE && surface && surface->FrameInterface)
+        sts = Checksum(surface, stats.checksums);
+
+    if (surface && surface->FrameInterface)
+        surface->FrameInterface->Release(surface);
+
+    inFlight.pop_front();
+
+    return sts;
+}
+
+static mfxStatus Decode(
+    VADisplay                   display,
+    const std::vector<mfxU8>&   stream,
+    bool                        parseAhead,
+    mfxU16                      asyncDepth,
+    LatencyStats&               stats)
+{
+    // the decoder reads the option at initialization
+    setenv("VPL_DECODE_PARSE_AHEAD", parseAhead ? "1" : "0", 1);
+
+    mfxInitializationParam init = {};
+    init.AccelerationMode = MFX_ACCEL_MODE_VIA_VAAPI;
+
+    mfxSession session = nullptr;
+    mfxStatus sts = MFXInitialize(init, &session);
+    if (sts != MFX_ERR_NONE)
+        return sts;
+
+    sts = MFXVideoCORE_SetHandle(session, MFX_HANDLE_VA_DISPLAY, display);
+
+    mfxBitstream bs = {};
+    bs.Data       = const_cast<mfxU8*>(stream.data());
+    bs.DataLength = (mfxU32)stream.size();
+    bs.MaxLength  = (mfxU32)stream.size();
+
+    mfxVideoParam par = {};
+    par.mfx.CodecId = MFX_CODEC_HEVC;
+    par.IOPattern   = MFX_IOPATTERN_OUT_VIDEO_MEMORY;
+    par.AsyncDepth  = asyncDepth;
+
+    if (sts == MFX_ERR_NONE)
+        sts = MFXVideoDECODE_DecodeHeader(session, &bs, &par);
+
+    if (sts == MFX_ERR_NONE)
+        sts = MFXVideoDECODE_Init(session, &par);
+
+    std::deque<std::pair<mfxSyncPoint, mfxFrameSurface1*>> inFlight;
+    bool endOfStream = false;
+
+    stats = {};
+    auto start = std::chrono::steady_clock::now();
+
+    while (sts >= MFX_ERR_NONE)
+    {
+        mfxFrameSurface1* surfaceOut = nullptr;
+        mfxSyncPoint      syncp      = nullptr;
+
+        auto callStart = std::chrono::steady_clock::now();
+        sts = MFXVideoDECODE_DecodeFrameAsync(session, endOfStream ? nullptr : &bs, nullptr, &surfaceOut, &syncp);
+        auto callEnd = std::chrono::steady_clock::now();
+
+        if (!endOfStream)
+            stats.calls.push_back(std::chrono::duration<double, std::micro>(callEnd - callStart).count());
+
+        if (sts == MFX_ERR_MORE_DATA)
+        {
+            if (endOfStream)
+                break;
+
+            endOfStream = true;
+            sts = MFX_ERR_NONE;
+            continue;
+        }
+
+        if (sts == MFX_WRN_DEVICE_BUSY || sts == MFX_ERR_MORE_SURFACE)
+        {
+            if (!inFlight.empty())
+                sts = SyncAndRelease(session, inFlight, stats);
+            else
+                std::this_thread::sleep_for(std::chrono::milliseconds(1));
+
+            if (sts >= MFX_ERR_NONE)
+                sts = MFX_ERR_NONE;
+            continue;
+        }
+
+        if (sts > MFX_ERR_NONE)
+            sts = MFX_ERR_NONE;
+
+        if (sts == MFX_ERR_NONE && syncp)
+        {
+            inFlight.emplace_back(syncp, surfaceOut);
+            stats.frames++;
+
+            if (inFlight.size() >= std::max<mfxU16>(asyncDepth, 1))
+                sts = SyncAndRelease(session, inFlight, stats);
+        }
+    }
+
+    while (!inFlight.empty())
+    {
+        mfxStatus syncSts = SyncAndRelease(session, inFlight, stats);
+        if (sts >= MFX_ERR_NONE && syncSts < MFX_ERR_NONE)
+            sts = syncSts;
+    }
+
+    stats.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    MFXVideoDECODE_Close(session);
+    MFXClose(session);
+
+    return sts == MFX_ERR_MORE_DATA ? MFX_ERR_NONE : sts;
+}
+
+int main(int argc, char** argv)
+{
+    if (argc < 2)
+    {
+        printf("Usage: %s input.265 [async_depth [render_node]]\n", argv[0]);
+        return 1;
+    }
+
+    mfxU16      asyncDepth = (argc > 2) ? (mfxU16)atoi(argv[2]) : 4;
+    const char* node       = (argc > 3) ? argv[3] : "/dev/dri/renderD128";
+
+    FILE* file = fopen(argv[1], "rb");
+    if (!file)
+    {
+        printf("Can't open %s\n", argv[1]);
+        return 1;
+    }
+
+    std::vector<mfxU8> stream;
+    mfxU8 chunk[1 << 16];
+    for (size_t read; (read = fread(chunk, 1, sizeof(chunk), file)) > 0; )
+        stream.insert(stream.end(), chunk, chunk + read);
+    fclose(file);
+
+    int fd = open(node, O_RDWR);
+    if (fd < 0)
+    {
+        printf("Can't open %s\n", node);
+        return 1;
+    }
+
+    VADisplay display = vaGetDisplayDRM(fd);
+    int major = 0, minor = 0;
+    if (!display || vaInitialize(display, &major, &minor) != VA_STATUS_SUCCESS)
+    {
+        printf("Can't initialize VA display\n");
+        close(fd);
+        return 1;
+    }
+
+    printf("%-12s %8s %10s %10s %10s %10s %10s %8s\n", "submission", "frames", "fps", "mean,us", "p50,us", "p99,us", "max,us", "output");
+
+    int result = 0;
+    std::vector<uint64_t> reference;
+    for (bool parseAhead : { false, true })
+    {
+        LatencyStats stats;
+        mfxStatus sts = Decode(display, stream, parseAhead, asyncDepth, stats);
+        if (sts != MFX_ERR_NONE)
+        {
+            printf("%-12s failed with status %d\n", parseAhead ? "scheduler" : "caller", sts);
+            result = 1;
+            continue;
+        }
+
+        double mean = 0;
+        for (double call : stats.calls)
+            mean += call;
+        mean /= std::max<size_t>(stats.calls.size(), 1);
+
+        // submission by the calling thread gives the reference output
+        const char* output = "n/a";
+        if (!parseAhead)
+            reference = stats.checksums;
+        else if (!stats.checksums.empty())
+            output = stats.checksums == reference ? "same" : "differs";
+
+        if (!strcmp(output, "differs"))
+            result = 1;
+
+        printf("%-12s %8d %10.1f %10.1f %10.1f %10.1f %10.1f %8s\n",
+            parseAhead ? "scheduler" : "caller",
+            stats.frames,
+            stats.seconds > 0 ? stats.frames / stats.seconds : 0,
+            mean,
+            Percentile(stats.calls, 0.5),
+            Percentile(stats.calls, 0.99),
+            Percentile(stats.calls, 1.0),
+            output);
+    }
+
+    vaTerminate(display);
+    close(fd);
+
+    return result;
+}
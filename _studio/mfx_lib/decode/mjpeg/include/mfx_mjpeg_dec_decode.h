@@ -80,6 +80,44 @@ protected:
     mfxStatus GetVideoParam(mfxVideoParam *par, UMC::MJPEGVideoDecoderBaseMFX * mjpegDecoder);
 };
 
+class CJpegTask;
+
+class VideoDECODEMJPEGBase_SW : public VideoDECODEMJPEGBase
+{
+public:
+    VideoDECODEMJPEGBase_SW();
+
+    virtual mfxStatus Reset(mfxVideoParam *par);
+    virtual mfxStatus Close(void);
+
+    virtual mfxStatus Init(mfxVideoParam *decPar, mfxFrameAllocRequest *request, mfxFrameAllocResponse *response, mfxFrameAllocRequest *request_internal, bool isUseExternalFrames, VideoCORE *core);
+
+    virtual mfxStatus GetVideoParam(mfxVideoParam *par);
+    virtual mfxStatus RunThread(void *pParam, mfxU32 threadNumber, mfxU32 callNumber);
+    virtual mfxStatus CompleteTask(void *pParam, mfxStatus taskRes);
+    virtual mfxStatus CheckTaskAvailability(mfxU32 maxTaskNumber);
+    virtual mfxStatus ReserveUMCDecoder(UMC::MJPEGVideoDecoderBaseMFX* &pMJPEGVideoDecoder, mfxFrameSurface1 *surf);
+    virtual void ReleaseReservedTask();
+    virtual mfxStatus AddPicture(UMC::MediaDataEx *pSrcData, mfxU32 & numPic);
+    virtual mfxStatus AllocateFrameData(UMC::FrameData *&data);
+    virtual mfxStatus FillEntryPoint(MFX_ENTRY_POINT *pEntryPoint, mfxFrameSurface1 *surface_work, mfxFrameSurface1 *surface_out);
+
+protected:
+    // Return the task to the free tasks queue
+    void FreeTask(std::unique_ptr<CJpegTask> &pTask);
+
+    // Free tasks queue
+    std::vector<std::unique_ptr<CJpegTask>> m_freeTasks;
+    // Tasks being decoded
+    std::vector<std::unique_ptr<CJpegTask>> m_decodingTasks;
+    // Task collecting the pictures of the current frame
+    std::unique_ptr<CJpegTask> m_pReservedTask;
+    // Task decoded last, its decoder keeps the stream's tables
+    CJpegTask *m_pLastTask;
+    // Count of created tasks
+    mfxU32 m_tasksCount;
+};
+
 namespace UMC
 {
     class MJPEGVideoDecoderMFX_HW;
@@ -31,6 +31,8 @@
 
 #include "umc_jpeg_frame_constructor.h"
 #include "umc_mjpeg_mfx_decode_hw.h"
+#include "umc_mjpeg_mfx_decode.h"
+#include "mfx_mjpeg_task.h"
 
 
 
@@ -77,6 +79,7 @@ public:
     static eMFXPlatform GetPlatform(VideoCORE * core, mfxVideoParam * par);
     static mfxStatus Query(VideoCORE *core, mfxVideoParam *in, mfxVideoParam *out, eMFXHWType type);
     static bool CheckVideoParam(mfxVideoParam *in, eMFXHWType type);
+    static bool IsSoftwareDecodeSupported(mfxVideoParam * in);
 
 private:
 
@@ -135,6 +138,9 @@ mfxStatus VideoDECODEMJPEG::Init(mfxVideoParam *par)
     if (!MFX_JPEG_Utility::CheckVideoParam(par, type))
         MFX_RETURN(MFX_ERR_INVALID_VIDEO_PARAM);
 
+    if (MFX_PLATFORM_SOFTWARE == m_platform && !MFX_JPEG_Utility::IsSoftwareDecodeSupported(par))
+        MFX_RETURN(MFX_ERR_UNSUPPORTED);
+
     m_vFirstPar = *par;
     m_vFirstPar.mfx.NumThread = 0;
 
@@ -175,7 +181,7 @@ mfxStatus VideoDECODEMJPEG::Init(mfxVideoParam *par)
 
     if (MFX_PLATFORM_SOFTWARE == m_platform)
     {
-        MFX_RETURN(MFX_ERR_UNSUPPORTED);
+        decoder.reset(new VideoDECODEMJPEGBase_SW);
     }
     else
     {
@@ -470,6 +476,8 @@ mfxStatus VideoDECODEMJPEG::DecodeHeader(VideoCORE *core, mfxBitstream *bs, mfxV
 
     in.Save(bs);
 
+    // progressive and lossless frames are not decoded
+    MFX_CHECK(umcRes != UMC::UMC_ERR_NOT_IMPLEMENTED, MFX_ERR_UNSUPPORTED);
     MFX_CHECK_INIT(umcRes == UMC::UMC_OK);
 
     mfxVideoParam temp;
@@ -477,6 +485,12 @@ mfxStatus VideoDECODEMJPEG::DecodeHeader(VideoCORE *core, mfxBitstream *bs, mfxV
     umcRes = decoder.FillVideoParam(&temp, false);
     MFX_CHECK_INIT(umcRes == UMC::UMC_OK);
 
+    // the platform is chosen for the parsed stream parameters
+    mfxVideoParam parsed = *par;
+    parsed.mfx = temp.mfx;
+    MFX_CHECK(MFX_PLATFORM_SOFTWARE != MFX_JPEG_Utility::GetPlatform(core, &parsed) ||
+              MFX_JPEG_Utility::IsSoftwareDecodeSupported(&parsed), MFX_ERR_UNSUPPORTED);
+
     if(jpegQT)
     {
         umcRes = decoder.FillQuantTableExtBuf(jpegQT);
@@ -1041,6 +1055,13 @@ eMFXPlatform MFX_JPEG_Utility::GetPlatform(VideoCORE * core, mfxVideoParam * par
 {
     eMFXPlatform platform = core->GetPlatformType();
 
+    // force the software decoder
+    const char *pSWDecode = std::getenv("VPL_MJPEG_SW_DECODE");
+    if (pSWDecode && !strcmp(pSWDecode, "1"))
+    {
+        return MFX_PLATFORM_SOFTWARE;
+    }
+
     if (platform != MFX_PLATFORM_SOFTWARE)
     {
         if (MFX_ERR_NONE != core->IsGuidSupported(sDXVA2_Intel_IVB_ModeJPEG_VLD_NoFGT, par))
@@ -1291,6 +1312,11 @@ mfxStatus MFX_JPEG_Utility::Query(VideoCORE *core, mfxVideoParam *in, mfxVideoPa
             sts = MFX_ERR_UNSUPPORTED;
         }
 
+        if (GetPlatform(core, out) == MFX_PLATFORM_SOFTWARE && !IsSoftwareDecodeSupported(in))
+        {
+            sts = MFX_ERR_UNSUPPORTED;
+        }
+
         if (GetPlatform(core, out) != core->GetPlatformType() && sts == MFX_ERR_NONE)
         {
             assert(GetPlatform(core, out) == MFX_PLATFORM_SOFTWARE);
@@ -1425,6 +1451,19 @@ bool MFX_JPEG_Utility::CheckVideoParam(mfxVideoParam *in, eMFXHWType )
     return true;
 }
 
+// the software decoder handles baseline streams with one interleaved scan per frame,
+// sequential frames with the first scan covering all components have no other scans
+bool MFX_JPEG_Utility::IsSoftwareDecodeSupported(mfxVideoParam * in)
+{
+    if (in->mfx.CodecProfile && MFX_PROFILE_JPEG_BASELINE != in->mfx.CodecProfile)
+        return false;
+
+    if (MFX_SCANTYPE_NONINTERLEAVED == in->mfx.InterleavedDec)
+        return false;
+
+    return true;
+}
+
 mfxStatus VideoDECODEMJPEG::GetSurface(mfxFrameSurface1* & surface, mfxSurfaceHeader* import_surface)
 {
     MFX_CHECK(decoder && decoder->m_surface_source, MFX_ERR_NOT_INITIALIZED);
@@ -1469,6 +1508,293 @@ mfxStatus VideoDECODEMJPEGBase::GetVideoParam(mfxVideoParam *par, UMC::MJPEGVide
     return MFX_ERR_NONE;
 }
 
+VideoDECODEMJPEGBase_SW::VideoDECODEMJPEGBase_SW()
+{
+    m_pLastTask = nullptr;
+    m_tasksCount = 0;
+}
+
+mfxStatus VideoDECODEMJPEGBase_SW::Init(mfxVideoParam *decPar, mfxFrameAllocRequest *, mfxFrameAllocResponse *, mfxFrameAllocRequest *,
+                                            bool, VideoCORE *)
+{
+    ConvertMFXParamsToUMC(decPar, &umcVideoParams);
+    // every task gets JPEG_MAX_THREADS decoders to decode VLC units in parallel,
+    // the scheduler saturates the number of threads
+    umcVideoParams.numThreads = 0;
+
+    m_pLastTask = nullptr;
+    m_tasksCount = 0;
+
+    return MFX_ERR_NONE;
+}
+
+void VideoDECODEMJPEGBase_SW::FreeTask(std::unique_ptr<CJpegTask> &pTask)
+{
+    pTask->m_pMJPEGVideoDecoder->CloseFrame();
+    pTask->Reset();
+    m_freeTasks.push_back(std::move(pTask));
+}
+
+mfxStatus VideoDECODEMJPEGBase_SW::Reset(mfxVideoParam *par)
+{
+    m_vPar = *par;
+
+    {
+        std::lock_guard<std::mutex> guard(m_guard);
+
+        if (m_pReservedTask)
+        {
+            FreeTask(m_pReservedTask);
+        }
+
+        while (!m_decodingTasks.empty())
+        {
+            FreeTask(m_decodingTasks.back());
+            m_decodingTasks.pop_back();
+        }
+    }
+
+    if (m_surface_source->Reset() != UMC::UMC_OK)
+    {
+        MFX_RETURN(MFX_ERR_MEMORY_ALLOC);
+    }
+
+    memset(&m_stat, 0, sizeof(mfxDecodeStat));
+    return MFX_ERR_NONE;
+}
+
+mfxStatus VideoDECODEMJPEGBase_SW::Close(void)
+{
+    {
+        std::lock_guard<std::mutex> guard(m_guard);
+
+        if (m_pReservedTask)
+        {
+            FreeTask(m_pReservedTask);
+        }
+
+        while (!m_decodingTasks.empty())
+        {
+            FreeTask(m_decodingTasks.back());
+            m_decodingTasks.pop_back();
+        }
+
+        m_freeTasks.clear();
+        m_pLastTask = nullptr;
+        m_tasksCount = 0;
+    }
+
+    memset(&m_stat, 0, sizeof(mfxDecodeStat));
+
+    m_surface_source->Close();
+
+    return MFX_ERR_NONE;
+}
+
+mfxStatus VideoDECODEMJPEGBase_SW::GetVideoParam(mfxVideoParam *par)
+{
+    std::lock_guard<std::mutex> guard(m_guard);
+
+    if (!m_pLastTask)
+        return MFX_ERR_NONE;
+
+    return VideoDECODEMJPEGBase::GetVideoParam(par, m_pLastTask->m_pMJPEGVideoDecoder.get());
+}
+
+mfxStatus VideoDECODEMJPEGBase_SW::RunThread(void *pParam, mfxU32 threadNumber, mfxU32 callNumber)
+{
+    MFX_CHECK_NULL_PTR1(pParam);
+
+    CJpegTask *pTask = (CJpegTask *)pParam;
+    UMC::MJPEGVideoDecoderMFX *pMJPEGVideoDecoder = pTask->m_pMJPEGVideoDecoder.get();
+
+    // all pieces are taken, the last one is still being decoded
+    if (callNumber >= pTask->NumPiecesCollected())
+    {
+        return MFX_TASK_BUSY;
+    }
+
+    UMC::Status umcRes = pMJPEGVideoDecoder->DecodePicture(*pTask, threadNumber, callNumber);
+    if (umcRes != UMC::UMC_OK)
+    {
+        return ConvertUMCStatusToMfx(umcRes);
+    }
+
+    // let the thread take the next piece
+    if (++pTask->m_numDecodedPieces < pTask->NumPiecesCollected())
+    {
+        return MFX_TASK_WORKING;
+    }
+
+    umcRes = pMJPEGVideoDecoder->PostProcessing(pTask->GetPictureBuffer(0).timeStamp);
+    if (umcRes != UMC::UMC_OK)
+    {
+        return ConvertUMCStatusToMfx(umcRes);
+    }
+
+    mfxStatus mfxSts = m_surface_source->PrepareToOutput(pTask->surface_out, pTask->dst->GetFrameMID(), &m_vPar, mfxU32(~MFX_COPY_USE_VACOPY_ANY));
+    if (mfxSts < MFX_ERR_NONE)
+    {
+        return mfxSts;
+    }
+
+    return MFX_TASK_DONE;
+}
+
+mfxStatus VideoDECODEMJPEGBase_SW::ReserveUMCDecoder(UMC::MJPEGVideoDecoderBaseMFX* &pMJPEGVideoDecoder, mfxFrameSurface1 *surf)
+{
+    pMJPEGVideoDecoder = nullptr;
+
+    std::lock_guard<std::mutex> guard(m_guard);
+
+    if (!m_pReservedTask)
+    {
+        if (!m_freeTasks.empty())
+        {
+            m_pReservedTask = std::move(m_freeTasks.back());
+            m_freeTasks.pop_back();
+        }
+        else
+        {
+            std::unique_ptr<CJpegTask> pTask(new CJpegTask());
+
+            MFX_SAFE_CALL(pTask->Initialize(umcVideoParams,
+                                            m_surface_source.get(),
+                                            m_vPar.mfx.Rotation,
+                                            m_vPar.mfx.JPEGChromaFormat,
+                                            m_vPar.mfx.JPEGColorFormat));
+
+            m_pReservedTask = std::move(pTask);
+            m_tasksCount += 1;
+        }
+    }
+
+    MFX_SAFE_CALL(m_surface_source->SetCurrentMFXSurface(surf));
+
+    pMJPEGVideoDecoder = m_pReservedTask->m_pMJPEGVideoDecoder.get();
+    return MFX_ERR_NONE;
+}
+
+void VideoDECODEMJPEGBase_SW::ReleaseReservedTask()
+{
+    std::lock_guard<std::mutex> guard(m_guard);
+
+    if (!m_pReservedTask)
+        return;
+
+    mfxU32 picToCollect = (MFX_PICSTRUCT_PROGRESSIVE == m_vPar.mfx.FrameInfo.PicStruct) ?
+        (1) : (2);
+
+    // keep the task until the second field comes
+    if (m_pReservedTask->NumPicCollected() && m_pReservedTask->NumPicCollected() < picToCollect)
+        return;
+
+    FreeTask(m_pReservedTask);
+}
+
+mfxStatus VideoDECODEMJPEGBase_SW::AddPicture(UMC::MediaDataEx *pSrcData, mfxU32 & numPic)
+{
+    MFX_AUTO_LTRACE(MFX_TRACE_LEVEL_INTERNAL, __FUNCTION__);
+    MFX_CHECK(m_pReservedTask, MFX_ERR_UNDEFINED_BEHAVIOR);
+
+    mfxU32 fieldPos = m_pReservedTask->NumPicCollected();
+
+    if (MFX_PICSTRUCT_FIELD_BFF == m_vPar.mfx.FrameInfo.PicStruct)
+    {
+        // change field order in BFF case
+        fieldPos ^= 1;
+    }
+
+    MFX_SAFE_CALL(m_pReservedTask->AddPicture(pSrcData, fieldPos));
+
+    // VLC units of a single scan only can be decoded independently
+    if (1 != m_pReservedTask->GetPictureBuffer(m_pReservedTask->NumPicCollected() - 1).numScans)
+    {
+        m_pReservedTask->m_pMJPEGVideoDecoder->CloseFrame();
+        m_pReservedTask->Reset();
+        MFX_RETURN(MFX_ERR_UNSUPPORTED);
+    }
+
+    // the first picture allocates the frame for the whole task
+    if (1 == m_pReservedTask->NumPicCollected())
+    {
+        UMC::Status umcRes = m_pReservedTask->m_pMJPEGVideoDecoder->AllocateFrame();
+        if (umcRes != UMC::UMC_OK)
+        {
+            m_pReservedTask->m_pMJPEGVideoDecoder->CloseFrame();
+            m_pReservedTask->Reset();
+            return ConvertUMCStatusToMfx(umcRes);
+        }
+    }
+
+    numPic = m_pReservedTask->NumPicCollected();
+
+    return MFX_ERR_NONE;
+}
+
+mfxStatus VideoDECODEMJPEGBase_SW::AllocateFrameData(UMC::FrameData *&data)
+{
+    std::lock_guard<std::mutex> guard(m_guard);
+
+    MFX_CHECK(m_pReservedTask, MFX_ERR_UNDEFINED_BEHAVIOR);
+
+    data = m_pReservedTask->m_pMJPEGVideoDecoder->GetDst();
+    data->SetTime(m_pReservedTask->GetPictureBuffer(0).timeStamp);
+
+    m_pReservedTask->dst = data;
+    m_pLastTask = m_pReservedTask.get();
+    m_decodingTasks.push_back(std::move(m_pReservedTask));
+
+    return MFX_ERR_NONE;
+}
+
+mfxStatus VideoDECODEMJPEGBase_SW::FillEntryPoint(MFX_ENTRY_POINT *pEntryPoint, mfxFrameSurface1 *surface_work, mfxFrameSurface1 *surface_out)
+{
+    std::lock_guard<std::mutex> guard(m_guard);
+
+    if (m_decodingTasks.empty())
+        MFX_RETURN(MFX_ERR_UNDEFINED_BEHAVIOR);
+
+    CJpegTask *pTask = m_decodingTasks.back().get();
+    pTask->surface_work = surface_work;
+    pTask->surface_out = surface_out;
+
+    // every piece is decoded by its own call, threads use own decoders
+    pEntryPoint->requiredNumThreads = std::min(pTask->NumPiecesCollected(),
+                                               pTask->m_pMJPEGVideoDecoder->NumDecodersAllocated());
+    pEntryPoint->pParam = pTask;
+    return MFX_ERR_NONE;
+}
+
+mfxStatus VideoDECODEMJPEGBase_SW::CheckTaskAvailability(mfxU32 maxTaskNumber)
+{
+    std::lock_guard<std::mutex> guard(m_guard);
+
+    if (!m_pReservedTask && m_freeTasks.empty() && m_tasksCount >= maxTaskNumber)
+    {
+        return MFX_WRN_DEVICE_BUSY;
+    }
+
+    return MFX_ERR_NONE;
+}
+
+mfxStatus VideoDECODEMJPEGBase_SW::CompleteTask(void *pParam, mfxStatus)
+{
+    std::lock_guard<std::mutex> guard(m_guard);
+
+    for (size_t i = 0; i < m_decodingTasks.size(); i++)
+    {
+        if (m_decodingTasks[i].get() == pParam)
+        {
+            FreeTask(m_decodingTasks[i]);
+            m_decodingTasks.erase(m_decodingTasks.begin() + i);
+            break;
+        }
+    }
+
+    return MFX_ERR_NONE;
+}
+
 VideoDECODEMJPEGBase_HW::VideoDECODEMJPEGBase_HW()
 {
     m_pMJPEGVideoDecoder.reset(new UMC::MJPEGVideoDecoderMFX_HW()); // HW
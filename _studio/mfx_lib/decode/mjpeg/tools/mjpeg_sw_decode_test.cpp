@@ -0,0 +1,518 @@
+// Copyright (c) 2025 Intel Corporation
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+
+// Conformance of the software MJPEG decode path.
+// Synthetic pictures are encoded by libjpeg as baseline 4:2:0 and 4:2:2
+// streams with and without restart intervals. Every stream is decoded to NV12
+// the way MJPEGVideoDecoderMFX::DecodePicture does it: the entropy coded data
+// is split at RST markers and each piece is decoded by its own CJPEGDecoder
+// on a separate thread. The result is compared with the libjpeg raw
+// (not upsampled) output, and the split decode with the single piece one.
+//
+// Usage:
+//   mjpeg_sw_decode_test
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <thread>
+#include <vector>
+
+#include "jpegdec.h"
+
+// after the UMC headers, jpeglib.h defines DCTSIZE2 and other macros
+#include <jpeglib.h>
+
+// IPP and libjpeg IDCT rounding may differ by one level
+static const int MAX_ALLOWED_DIFF = 2;
+
+struct TestSampling
+{
+    const char* name;
+    int         lumaV;      // vertical luma sampling factor, horizontal one is 2
+};
+
+static const TestSampling samplings[] =
+{
+    { "4:2:0", 2 },
+    { "4:2:2", 1 },
+};
+
+struct TestSize
+{
+    int width;
+    int height;
+};
+
+// MCU aligned sizes and sizes with partial MCUs at the right and bottom
+static const TestSize sizes[] =
+{
+    { 64,   48  },
+    { 200,  120 },
+    { 97,   61  },
+    { 1280, 720 },
+};
+
+struct TestRestart
+{
+    const char* name;
+    int         interval;   // MCUs, 0 - no DRI
+    bool        inRows;     // interval is given in MCU rows
+};
+
+static const TestRestart restarts[] =
+{
+    { "none",  0, false },
+    { "1 row", 1, true  },
+    { "5 MCU", 5, false },
+};
+
+// restart intervals per piece, 0 - the whole scan in one piece
+static const int piecesIntervals[] = { 0, 1, 3 };
+
+struct Planes
+{
+    int                  width;
+    int                  height;
+    int                  pitch;
+    int                  alignedHeight;
+    std::vector<uint8_t> y;
+    std::vector<uint8_t> uv;
+
+    void Init(int w, int h, int alignH)
+    {
+        width  = w;
+        height = h;
+        pitch  = (w + 15) & ~15;
+        alignedHeight = (h + alignH - 1) & ~(alignH - 1);
+        y.assign((size_t)pitch * alignedHeight, 0);
+        uv.assign((size_t)pitch * ((alignedHeight + 1) / 2), 0);
+    }
+};
+
+// smooth gradients with some noise, close to camera content
+static void FillPicture(int width, int height, std::vector<uint8_t>& ycc)
+{
+    unsigned int seed = 12345;
+
+    ycc.resize((size_t)width * height * 3);
+
+    for (int y = 0; y < height; y++)
+    {
+        for (int x = 0; x < width; x++)
+        {
+            uint8_t* pix = &ycc[((size_t)y * width + x) * 3];
+
+            for (int c = 0; c < 3; c++)
+            {
+                seed = seed * 1103515245 + 12345;
+
+                double v = 128 + 90 * std::sin(x * 0.031 * (c + 1) + y * 0.017) * std::cos(y * 0.023 - x * 0.007 * (c + 1));
+                v += (int)((seed >> 16) & 7) - 4;
+
+                pix[c] = (uint8_t)std::min(255.0, std::max(0.0, v));
+            }
+        }
+    }
+
+    return;
+}
+
+static void Encode(
+    const std::vector<uint8_t>& ycc,
+    int                         width,
+    int                         height,
+    const TestSampling&         sampling,
+    const TestRestart&          restart,
+    std::vector<uint8_t>&       out)
+{
+    jpeg_compress_struct cinfo;
+    jpeg_error_mgr       jerr;
+    unsigned char*       buf = 0;
+    unsigned long        bufSize = 0;
+
+    cinfo.err = jpeg_std_error(&jerr);
+    jpeg_create_compress(&cinfo);
+    jpeg_mem_dest(&cinfo, &buf, &bufSize);
+
+    cinfo.image_width      = width;
+    cinfo.image_height     = height;
+    cinfo.input_components = 3;
+    cinfo.in_color_space   = JCS_YCbCr;
+
+    jpeg_set_defaults(&cinfo);
+    jpeg_set_colorspace(&cinfo, JCS_YCbCr);
+    jpeg_set_quality(&cinfo, 85, TRUE);
+
+    cinfo.comp_info[0].h_samp_factor = 2;
+    cinfo.comp_info[0].v_samp_factor = sampling.lumaV;
+    cinfo.comp_info[1].h_samp_factor = cinfo.comp_info[1].v_samp_factor = 1;
+    cinfo.comp_info[2].h_samp_factor = cinfo.comp_info[2].v_samp_factor = 1;
+
+    if (restart.inRows)
+        cinfo.restart_in_rows = restart.interval;
+    else
+        cinfo.restart_interval = restart.interval;
+
+    jpeg_start_compress(&cinfo, TRUE);
+
+    while (cinfo.next_scanline < cinfo.image_height)
+    {
+        JSAMPROW row = (JSAMPROW)&ycc[(size_t)cinfo.next_scanline * width * 3];
+        jpeg_write_scanlines(&cinfo, &row, 1);
+    }
+
+    jpeg_finish_compress(&cinfo);
+    jpeg_destroy_compress(&cinfo);
+
+    out.assign(buf, buf + bufSize);
+    free(buf);
+
+    return;
+}
+
+// libjpeg output of the not upsampled components packed to NV12.
+// Only the even chroma rows of 4:2:2 are kept, as the UMC decoder does.
+static void DecodeReference(const std::vector<uint8_t>& stream, Planes& ref)
+{
+    jpeg_decompress_struct cinfo;
+    jpeg_error_mgr         jerr;
+
+    cinfo.err = jpeg_std_error(&jerr);
+    jpeg_create_decompress(&cinfo);
+    jpeg_mem_src(&cinfo, stream.data(), stream.size());
+    jpeg_read_header(&cinfo, TRUE);
+
+    cinfo.raw_data_out    = TRUE;
+    cinfo.out_color_space = JCS_YCbCr;
+    cinfo.dct_method      = JDCT_ISLOW;
+
+    jpeg_start_decompress(&cinfo);
+
+    int maxV     = cinfo.max_v_samp_factor;
+    int rowsMCU  = maxV * DCTSIZE;
+    int numRows  = cinfo.total_iMCU_rows * rowsMCU;
+
+    std::vector<std::vector<uint8_t>> comp(3);
+    std::vector<int> compPitch(3), compRows(3);
+    for (int c = 0; c < 3; c++)
+    {
+        compPitch[c] = cinfo.comp_info[c].width_in_blocks * DCTSIZE + 2 * DCTSIZE;
+        compRows[c]  = numRows * cinfo.comp_info[c].v_samp_factor / maxV;
+        comp[c].resize((size_t)compPitch[c] * compRows[c]);
+    }
+
+    std::vector<JSAMPROW> rows[3];
+    for (int c = 0; c < 3; c++)
+        rows[c].resize(cinfo.comp_info[c].v_samp_factor * DCTSIZE);
+
+    for (int mcuRow = 0; mcuRow < (int)cinfo.total_iMCU_rows; mcuRow++)
+    {
+        JSAMPARRAY planes[3];
+
+        for (int c = 0; c < 3; c++)
+        {
+            int compRowsMCU = cinfo.comp_info[c].v_samp_factor * DCTSIZE;
+            for (int i = 0; i < compRowsMCU; i++)
+                rows[c][i] = &comp[c][(size_t)(mcuRow * compRowsMCU + i) * compPitch[c]];
+            planes[c] = rows[c].data();
+        }
+
+        jpeg_read_raw_data(&cinfo, planes, rowsMCU);
+    }
+
+    int chromaStep = (maxV == 2) ? 1 : 2;
+
+    ref.Init(cinfo.image_width, cinfo.image_height, 1);
+
+    for (int y = 0; y < ref.height; y++)
+        std::copy(&comp[0][(size_t)y * compPitch[0]], &comp[0][(size_t)y * compPitch[0]] + ref.width, &ref.y[(size_t)y * ref.pitch]);
+
+    for (int y = 0; y < (ref.height + 1) / 2; y++)
+    {
+        for (int x = 0; x < (ref.width + 1) / 2; x++)
+        {
+            ref.uv[(size_t)y * ref.pitch + 2 * x]     = comp[1][(size_t)y * chromaStep * compPitch[1] + x];
+            ref.uv[(size_t)y * ref.pitch + 2 * x + 1] = comp[2][(size_t)y * chromaStep * compPitch[2] + x];
+        }
+    }
+
+    jpeg_finish_decompress(&cinfo);
+    jpeg_destroy_decompress(&cinfo);
+
+    return;
+}
+
+// offsets of the SOS marker and of every RST marker in the entropy coded data
+static bool FindMarkers(const std::vector<uint8_t>& stream, size_t& sos, std::vector<size_t>& rst)
+{
+    size_t pos = 2;
+    while (pos + 3 < stream.size() && !(stream[pos] == 0xff && stream[pos + 1] == 0xda))
+        pos += 2 + ((stream[pos + 2] << 8) | stream[pos + 3]);
+    if (pos + 3 >= stream.size())
+        return false;
+
+    sos = pos;
+    rst.clear();
+
+    // stuffed 0xff bytes are followed by zero, so 0xff 0xd0..0xd7 are markers only
+    for (pos += 2 + ((stream[pos + 2] << 8) | stream[pos + 3]); pos + 1 < stream.size(); pos++)
+    {
+        if (stream[pos] == 0xff && stream[pos + 1] >= 0xd0 && stream[pos + 1] <= 0xd7)
+            rst.push_back(pos);
+    }
+
+    return true;
+}
+
+struct Piece
+{
+    size_t   offset;
+    size_t   size;
+    uint32_t restartNum;
+};
+
+// mirrors MJPEGVideoDecoderMFX::DecodePicture and DecodePiece for one piece
+static JERRCODE DecodePiece(
+    const std::vector<uint8_t>& stream,
+    const std::vector<Piece>&   pieces,
+    size_t                      pieceNum,
+    Planes&                     dst)
+{
+    CJPEGDecoder dec;
+    JERRCODE     jerr;
+
+    mfxSize size = {};
+    int     nchannels, precision;
+    JCOLOR  color;
+    JSS     sampling;
+
+    jerr = dec.SetSource(stream.data(), pieces[0].offset + pieces[0].size);
+    if (JPEG_OK != jerr)
+        return jerr;
+
+    jerr = dec.ReadHeader(&size.width, &size.height, &nchannels, &color, &sampling, &precision);
+    if (JPEG_OK != jerr)
+        return jerr;
+
+    if (size.width != dst.width || size.height != dst.height)
+        return JPEG_ERR_PARAMS;
+
+    uint32_t restartNum = pieces[pieceNum].restartNum;
+    uint32_t restartsToDecode = 0;
+    if (dec.m_scans[0].jpeg_restart_interval)
+    {
+        uint32_t numRestarts = (dec.m_numxMCU * dec.m_numyMCU + dec.m_scans[0].jpeg_restart_interval - 1) /
+                               dec.m_scans[0].jpeg_restart_interval;
+
+        restartsToDecode = (pieceNum + 1 < pieces.size()) ?
+                           pieces[pieceNum + 1].restartNum - restartNum :
+                           numRestarts - restartNum;
+    }
+
+    jerr = dec.SetSource(stream.data() + pieces[pieceNum].offset, pieces[pieceNum].size);
+    if (JPEG_OK != jerr)
+        return jerr;
+
+    uint8_t* pDst[4]    = { dst.y.data(), dst.uv.data(), 0, 0 };
+    int      dstStep[4] = { dst.pitch, dst.pitch, 0, 0 };
+
+    jerr = dec.SetDestination(pDst, dstStep, size, 2, JC_NV12, JS_420);
+    if (JPEG_OK != jerr)
+        return jerr;
+
+    return dec.ReadData(restartNum, restartsToDecode);
+}
+
+static JERRCODE Decode(
+    const std::vector<uint8_t>& stream,
+    int                         intervalsPerPiece,
+    Planes&                     dst,
+    int&                        numPieces)
+{
+    size_t sos = 0;
+    std::vector<size_t> rst;
+
+    if (!FindMarkers(stream, sos, rst))
+        return JPEG_ERR_BUFF;
+
+    // the first piece starts with the SOS marker, the others with a RST one
+    std::vector<Piece> pieces;
+    pieces.push_back({ sos, 0, 0 });
+    if (intervalsPerPiece)
+    {
+        for (size_t i = intervalsPerPiece; i <= rst.size(); i += intervalsPerPiece)
+            pieces.push_back({ rst[i - 1], 0, (uint32_t)i });
+    }
+
+    for (size_t i = 0; i < pieces.size(); i++)
+        pieces[i].size = ((i + 1 < pieces.size()) ? pieces[i + 1].offset : stream.size()) - pieces[i].offset;
+
+    numPieces = (int)pieces.size();
+
+    std::vector<JERRCODE> results(pieces.size(), JPEG_OK);
+    std::vector<std::thread> threads;
+    for (size_t i = 0; i < pieces.size(); i++)
+        threads.emplace_back([&stream, &pieces, &dst, &results, i]() { results[i] = DecodePiece(stream, pieces, i, dst); });
+
+    for (auto& thread : threads)
+        thread.join();
+
+    for (JERRCODE jerr : results)
+    {
+        if (JPEG_OK != jerr)
+            return jerr;
+    }
+
+    return JPEG_OK;
+}
+
+static void Compare(const Planes& a, const Planes& b, int& maxDiff, double& psnr)
+{
+    double sqErr = 0;
+    long   count = 0;
+
+    maxDiff = 0;
+
+    for (int y = 0; y < a.height; y++)
+    {
+        for (int x = 0; x < a.width; x++)
+        {
+            int d = std::abs(a.y[(size_t)y * a.pitch + x] - b.y[(size_t)y * b.pitch + x]);
+            maxDiff = std::max(maxDiff, d);
+            sqErr += d * d;
+            count++;
+        }
+    }
+
+    for (int y = 0; y < (a.height + 1) / 2; y++)
+    {
+        for (int x = 0; x < ((a.width + 1) & ~1); x++)
+        {
+            int d = std::abs(a.uv[(size_t)y * a.pitch + x] - b.uv[(size_t)y * b.pitch + x]);
+            maxDiff = std::max(maxDiff, d);
+            sqErr += d * d;
+            count++;
+        }
+    }
+
+    psnr = (!count || sqErr == 0) ? 99.99 : 10 * std::log10(255.0 * 255.0 * count / sqErr);
+
+    return;
+}
+
+static bool SamePlanes(const Planes& a, const Planes& b)
+{
+    for (int y = 0; y < a.height; y++)
+    {
+        if (!std::equal(&a.y[(size_t)y * a.pitch], &a.y[(size_t)y * a.pitch] + a.width, &b.y[(size_t)y * b.pitch]))
+            return false;
+    }
+
+    for (int y = 0; y < (a.height + 1) / 2; y++)
+    {
+        int width = (a.width + 1) & ~1;
+        if (!std::equal(&a.uv[(size_t)y * a.pitch], &a.uv[(size_t)y * a.pitch] + width, &b.uv[(size_t)y * b.pitch]))
+            return false;
+    }
+
+    return true;
+}
+
+int main(int argc, char* argv[])
+{
+    if (argc != 1)
+    {
+        printf("usage: %s\n", argv[0]);
+        return 1;
+    }
+
+    printf("%-6s %10s %8s %9s %7s %8s %8s %s\n",
+        "format", "size", "restart", "intervals", "pieces", "maxdiff", "PSNR", "result");
+
+    int failures = 0;
+
+    for (const TestSize& testSize : sizes)
+    {
+        std::vector<uint8_t> ycc;
+        FillPicture(testSize.width, testSize.height, ycc);
+
+        for (const TestSampling& sampling : samplings)
+        {
+            for (const TestRestart& restart : restarts)
+            {
+                std::vector<uint8_t> stream;
+                Encode(ycc, testSize.width, testSize.height, sampling, restart, stream);
+
+                Planes ref;
+                DecodeReference(stream, ref);
+
+                Planes whole;
+
+                for (int intervals : piecesIntervals)
+                {
+                    // pieces are defined by restart intervals only
+                    if (intervals && !restart.interval)
+                        continue;
+
+                    // decoded frames are allocated with the height aligned to 8
+                    Planes out;
+                    out.Init(testSize.width, testSize.height, 8);
+
+                    int      numPieces = 0;
+                    JERRCODE jerr = Decode(stream, intervals, out, numPieces);
+
+                    char sizeName[32];
+                    snprintf(sizeName, sizeof(sizeName), "%dx%d", testSize.width, testSize.height);
+
+                    if (JPEG_OK != jerr)
+                    {
+                        printf("%-6s %10s %8s %9d failed, error %d\n", sampling.name, sizeName, restart.name, intervals, (int)jerr);
+                        failures++;
+                        continue;
+                    }
+
+                    int    maxDiff = 0;
+                    double psnr = 0;
+                    Compare(ref, out, maxDiff, psnr);
+
+                    bool ok = (maxDiff <= MAX_ALLOWED_DIFF);
+
+                    // splitting must not change a single sample
+                    if (!intervals)
+                        whole = out;
+                    else
+                        ok = ok && SamePlanes(whole, out);
+
+                    printf("%-6s %10s %8s %9d %7d %8d %8.2f %s\n", sampling.name, sizeName, restart.name,
+                        intervals, numPieces, maxDiff, psnr, ok ? "ok" : "FAILED");
+
+                    if (!ok)
+                        failures++;
+                }
+            }
+        }
+    }
+
+    return failures ? 1 : 0;
+}
@@ -30,6 +30,7 @@
 #include "mfx_umc_alloc_wrapper.h"
 #include "mfx_task.h"
 #include "mfx_critical_error_handler.h"
+#include "mfx_hw_completion_waiter.h"
 #include "umc_mutex.h"
 #include "umc_vp9_dec_defs.h"
 #include "umc_vp9_frame.h"
@@ -134,6 +135,9 @@ private:
 
     UMC::VideoAccelerator * m_va;
 
+    // waits for decoded frames while the task sleeps in the scheduler
+    HwCompletionWaiter m_hwWaiter;
+
     typedef std::list<mfxFrameSurface1 *> StatuReportList;
     StatuReportList m_completedList;
 
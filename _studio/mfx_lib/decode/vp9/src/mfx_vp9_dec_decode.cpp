@@ -63,7 +63,7 @@ mfxStatus DecodeHeader(VideoCORE* core, mfxBitstream* bs, mfxVideoParam* params)
 
     for (;;)
     {
-        VP9Bitstream bsReader(bs->Data + bs->DataOffset,  bs->DataLength - bs->DataOffset);
+        VP9Bitstream bsReader(bs->Data + bs->DataOffset, bs->DataLength);
 
         if (VP9_FRAME_MARKER != bsReader.GetBits(2))
             break; // invalid
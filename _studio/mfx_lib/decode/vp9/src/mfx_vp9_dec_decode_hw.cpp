@@ -45,6 +45,9 @@ using namespace UMC_VP9_DECODER;
 
 #include "mfx_unified_vp9d_logging.h"
 
+#include <cstdlib>
+#include <cstring>
+
 static bool IsSameVideoParam(mfxVideoParam *newPar, mfxVideoParam *oldPar);
 
 // function checks hardware support with IsGuidSupported function and GUIDs
@@ -470,6 +473,15 @@ mfxStatus VideoDECODEVP9_HW::Init(mfxVideoParam *par)
         }
     }
 #endif
+    // the task waits for the frame itself unless VPL_DECODE_HW_EVENT_SYNC=1,
+    // it also falls back to the blocking wait if the scheduler can't wake it up
+    const char *pHwEventSync = std::getenv("VPL_DECODE_HW_EVENT_SYNC");
+    if (pHwEventSync && !strcmp(pHwEventSync, "1") && MFX_ERR_NONE == m_hwWaiter.Init())
+    {
+        if (MFX_ERR_NONE != m_core->RegisterHwCompletionEvent(static_cast<VideoDECODE *>(this), m_hwWaiter.GetEvent()))
+            m_hwWaiter.Close();
+    }
+
     m_frameOrder = 0;
     m_statusReportFeedbackNumber = 0;
     m_isInit = true;
@@ -594,6 +606,12 @@ mfxStatus VideoDECODEVP9_HW::Close()
 
     MFX_CHECK(m_isInit, MFX_ERR_NOT_INITIALIZED);
 
+    if (m_hwWaiter.IsActive())
+    {
+        m_core->UnregisterHwCompletionEvent(static_cast<VideoDECODE *>(this));
+        m_hwWaiter.Close();
+    }
+
     ResetFrameInfo();
     m_surface_source->Close();
 
@@ -894,6 +912,15 @@ enum
     NUMBER_OF_STATUS = 32,
 };
 
+static mfxStatus SyncFrame(UMC::VideoAccelerator *va, UMC::FrameMemID frameId)
+{
+    UMC::Status status = va->SyncTask(frameId);
+    if (status != UMC::UMC_OK && status != UMC::UMC_ERR_TIMEOUT)
+        return (status == UMC::UMC_ERR_GPU_HANG) ? MFX_ERR_GPU_HANG : MFX_ERR_DEVICE_FAILED;
+
+    return MFX_ERR_NONE;
+}
+
 mfxStatus MFX_CDECL VP9DECODERoutine(void *p_state, void * /* pp_param */, mfxU32 /* thread_number */, mfxU32)
 {
     VideoDECODEVP9_HW::VP9DECODERoutineData& data = *(VideoDECODEVP9_HW::VP9DECODERoutineData*)p_state;
@@ -950,12 +977,25 @@ mfxStatus MFX_CDECL VP9DECODERoutine(void *p_state, void * /* pp_param */, mfxU3
 
 
     {
-        UMC::Status status = decoder.m_va->SyncTask(data.currFrameId);
-        if (status != UMC::UMC_OK && status != UMC::UMC_ERR_TIMEOUT)
+        mfxStatus syncSts;
+        if (decoder.m_hwWaiter.IsActive())
+        {
+            UMC::VideoAccelerator *va = decoder.m_va;
+            UMC::FrameMemID frameId = data.currFrameId;
+
+            syncSts = decoder.m_hwWaiter.Wait(&data, [va, frameId]() { return SyncFrame(va, frameId); });
+            if (syncSts == MFX_TASK_BUSY)
+                return MFX_TASK_BUSY;
+        }
+        else
+        {
+            syncSts = SyncFrame(decoder.m_va, data.currFrameId);
+        }
+
+        if (syncSts != MFX_ERR_NONE)
         {
-            mfxStatus CriticalErrorStatus = (status == UMC::UMC_ERR_GPU_HANG) ? MFX_ERR_GPU_HANG : MFX_ERR_DEVICE_FAILED;
-            decoder.SetCriticalErrorOccured(CriticalErrorStatus);
-            return CriticalErrorStatus;
+            decoder.SetCriticalErrorOccured(syncSts);
+            return syncSts;
         }
     }
 
@@ -1389,7 +1429,7 @@ mfxStatus VideoDECODEVP9_HW::DecodeFrameHeader(mfxBitstream *in, VP9DecoderFrame
         MFX_CHECK_STS(sts);
         in = &m_bs;
 
-        VP9Bitstream bsReader(in->Data + in->DataOffset, in->DataOffset + in->DataLength);
+        VP9Bitstream bsReader(in->Data + in->DataOffset, in->DataLength);
 
         if (VP9_FRAME_MARKER != bsReader.GetBits(2))
             MFX_RETURN(MFX_ERR_UNDEFINED_BEHAVIOR);
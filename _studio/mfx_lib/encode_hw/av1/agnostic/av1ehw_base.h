@@ -59,7 +59,29 @@ MFX_FEATURE_BLOCKS_DECLARE_BQ_UTILS_IN_FEATURE_BLOCK
     virtual const char* GetFeatureName(mfxU32 featureID) override;
     virtual const char* GetBlockName(ID id) override;
 
+    // copies final queues into FrozenQueue-s used by per-frame stages,
+    // called before the first frame when all Init() overrides finished reordering
+    void Freeze()
+    {
+        m_bProfile = IsFrozenQueueProfilingOn();
+#define DEF_BLOCK_Q MFX_FEATURE_BLOCKS_FREEZE_QUEUES_IN_FEATURE_BLOCK
+    #include "av1ehw_block_queues.h"
+#undef DEF_BLOCK_Q
+        m_bFrozen = true;
+    }
+
+    void ReportProfile()
+    {
+        if (!m_bProfile)
+            return;
+#define DEF_BLOCK_Q MFX_FEATURE_BLOCKS_REPORT_QUEUES_IN_FEATURE_BLOCK
+    #include "av1ehw_block_queues.h"
+#undef DEF_BLOCK_Q
+    }
+
     std::map<mfxU32, const BlockTracer::TFeatureTrace*> m_trace;
+    bool m_bFrozen  = false;
+    bool m_bProfile = false;
 };
 
 #define DEF_BLOCK_Q MFX_FEATURE_BLOCKS_DECLARE_QUEUES_EXTERNAL
@@ -834,6 +834,7 @@ namespace Base
         mfxBitstream*     pBsOut                 = nullptr;
         mfxFrameSurface1* pSurfReal              = nullptr;
         mfxEncodeCtrl     ctrl                   = {};
+        mfx::ExtBufferIndex ctrlEB;                      // index of ctrl.ExtParam
         mfxU32            SkipCMD                = SKIPCMD_NeedDriverCall;
         Resource          BS;
         Resource          CUQP;
@@ -1398,8 +1398,9 @@ void General::InitTask(const FeatureBlocks& blocks, TPushIT Push)
             {
                 tpar.ctrl.ExtParam = nullptr;
             }
+            tpar.ctrlEB.Build(tpar.ctrl.ExtParam, tpar.ctrl.NumExtParam);
 
-            mfxExtRefListCtrl* refListCtrl = ExtBuffer::Get(tpar.ctrl);
+            mfxExtRefListCtrl* refListCtrl = ExtBuffer::Get(tpar.ctrlEB);
             if (refListCtrl)
             {
                 changed = CheckRefListCtrl(*refListCtrl);
@@ -1761,6 +1762,8 @@ void General::FreeTask(const FeatureBlocks& /*blocks*/, TPushFT Push)
         if(task.ctrl.NumExtParam)
             delete[] task.ctrl.ExtParam;
 
+        task.ctrlEB.Build(nullptr, 0);
+
 #if defined(MFX_ENABLE_ENCTOOLS)
         if(task.saliencyMap.SaliencyMap)
         {
@@ -1836,7 +1839,7 @@ static void FillSortedFwdBwd(
     auto IsBwd = [=](Ref ref) {return ref.first > task.DisplayOrderInGOP; };
 
     DisplayOrderToDPBIndex uniqueRefs;
-    const mfxExtRefListCtrl* refListCtrl = ExtBuffer::Get(task.ctrl);
+    const mfxExtRefListCtrl* refListCtrl = ExtBuffer::Get(task.ctrlEB);
     std::set<mfxU8> preferedFwd;
     if (refListCtrl)
     {
@@ -2108,7 +2111,7 @@ inline std::tuple<mfxU8, mfxU8> GetMaxRefs(
         CO3.NumRefActiveBL0[0] : CO3.NumRefActiveP[0]);
     const mfxU8 maxBwdRefs = static_cast<mfxU8>(CO3.NumRefActiveBL1[0]);
 
-    const mfxExtRefListCtrl* refListCtrl = ExtBuffer::Get(task.ctrl);
+    const mfxExtRefListCtrl* refListCtrl = ExtBuffer::Get(task.ctrlEB);
     if (refListCtrl && refListCtrl->NumRefIdxL0Active > 0)
     {
         maxFwdRefs = std::min(maxFwdRefs, mfxU8(refListCtrl->NumRefIdxL0Active));
@@ -2277,7 +2280,7 @@ inline mfxU8 CountUniqueSTR(DpbType& taskDPB)
 // Return - N/A
 inline void MarkLTR(TaskCommonPar& task)
 {
-    const mfxExtRefListCtrl* refListCtrl = ExtBuffer::Get(task.ctrl);
+    const mfxExtRefListCtrl* refListCtrl = ExtBuffer::Get(task.ctrlEB);
 
     // If external reflist is not used, check for internal reflist
     if (!refListCtrl && task.InternalListCtrlPresent)
@@ -2336,7 +2339,7 @@ inline void UpdateLTRInfo(TaskCommonPar& task, EncodedInfoAv1& encodedInfo)
 // Return - N/A
 inline void MarkRejected(TaskCommonPar& task)
 {
-    const mfxExtRefListCtrl* refListCtrl = ExtBuffer::Get(task.ctrl);
+    const mfxExtRefListCtrl* refListCtrl = ExtBuffer::Get(task.ctrlEB);
 
     // If external reflist is not used, check for internal reflist
     if (!refListCtrl && task.InternalListCtrlPresent) {
@@ -213,7 +213,7 @@ void Hdr::InitTask(const FeatureBlocks& blocks, TPushIT Push)
             , StorageW& /*global*/
             , StorageW& task) -> mfxStatus
         {
-            mfxExtMasteringDisplayColourVolume* pMDCV = ExtBuffer::Get(Task::Common::Get(task).ctrl);
+            mfxExtMasteringDisplayColourVolume* pMDCV = ExtBuffer::Get(Task::Common::Get(task).ctrlEB);
             MFX_CHECK(pMDCV, MFX_ERR_NONE);
             SetDefaultMasteringDisplayColourVolume(pMDCV);
             return CheckAndFixMasteringDisplayColourVolumeInfo(pMDCV);
@@ -227,7 +227,7 @@ void Hdr::InitTask(const FeatureBlocks& blocks, TPushIT Push)
             , StorageW& /*global*/
             , StorageW& task) -> mfxStatus
         {
-            mfxExtContentLightLevelInfo* pCLLI = ExtBuffer::Get(Task::Common::Get(task).ctrl);
+            mfxExtContentLightLevelInfo* pCLLI = ExtBuffer::Get(Task::Common::Get(task).ctrlEB);
             MFX_CHECK(pCLLI, MFX_ERR_NONE);
             SetDefaultContentLightLevel(pCLLI);
             return CheckAndFixContentLightLevelInfo(pCLLI);
@@ -240,13 +240,13 @@ void Hdr::SubmitTask(const FeatureBlocks& /*blocks*/, TPushST Push)
         , [this](StorageW& global, StorageW& s_task) -> mfxStatus
     {
         auto& task = Task::Common::Get(s_task);
-        const mfxExtMasteringDisplayColourVolume* pMDCV = ExtBuffer::Get(task.ctrl);
+        const mfxExtMasteringDisplayColourVolume* pMDCV = ExtBuffer::Get(task.ctrlEB);
         bool bInsertMDCV = false;
         if (pMDCV != NULL)
         {
             bInsertMDCV = true;
         }
-        const mfxExtContentLightLevelInfo* pCLLI = ExtBuffer::Get(task.ctrl);
+        const mfxExtContentLightLevelInfo* pCLLI = ExtBuffer::Get(task.ctrlEB);
         bool bInsertCLLI = false;
         if (pCLLI != NULL)
         {
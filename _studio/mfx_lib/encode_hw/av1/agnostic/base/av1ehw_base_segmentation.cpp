@@ -470,7 +470,7 @@ void Segmentation::InitTask(const FeatureBlocks& blocks, TPushIT Push)
 
             mfxStatus              checkSts  = MFX_ERR_NONE;
 
-            mfxExtAV1Segmentation* pFrameSegPar = ExtBuffer::Get(Task::Common::Get(task).ctrl);
+            mfxExtAV1Segmentation* pFrameSegPar = ExtBuffer::Get(Task::Common::Get(task).ctrlEB);
 
             if (IsSegmentationEnabled(pFrameSegPar))
             {
@@ -257,7 +257,7 @@ mfxStatus TaskManager::RunQueueTaskInit(
 {
     return RunBlocks(
         CheckGE<mfxStatus, MFX_ERR_NONE>
-        , FeatureBlocks::BQ<IT>::Get(*m_pBlocks)
+        , FeatureBlocks::BQ<IT>::GetFrozen(*m_pBlocks)
         , pCtrl, pSurf, pBs, *m_pGlob, task);
 }
 
@@ -265,7 +265,7 @@ mfxStatus TaskManager::RunQueueTaskPreReorder(StorageW& task)
 {
     return RunBlocks(
         Check<mfxStatus, MFX_ERR_NONE>
-        , FeatureBlocks::BQ<PreRT>::Get(*m_pBlocks)
+        , FeatureBlocks::BQ<PreRT>::GetFrozen(*m_pBlocks)
         , *m_pGlob, task);
 }
 
@@ -273,7 +273,7 @@ mfxStatus TaskManager::RunQueueTaskPostReorder(StorageW& task)
 {
     return RunBlocks(
         Check<mfxStatus, MFX_ERR_NONE>
-        , FeatureBlocks::BQ<PostRT>::Get(*m_pBlocks)
+        , FeatureBlocks::BQ<PostRT>::GetFrozen(*m_pBlocks)
         , *m_pGlob
         , task);
 }
@@ -282,7 +282,7 @@ mfxStatus TaskManager::RunQueueTaskSubmit(StorageW& task)
 {
     return RunBlocks(
         Check<mfxStatus, MFX_ERR_NONE>
-        , FeatureBlocks::BQ<ST>::Get(*m_pBlocks)
+        , FeatureBlocks::BQ<ST>::GetFrozen(*m_pBlocks)
         , *m_pGlob
         , task);
 }
@@ -291,8 +291,8 @@ bool TaskManager::RunQueueTaskQuery(
     StorageW& task
     , std::function<bool(const mfxStatus&)> stopAt)
 {
-    auto& q = FeatureBlocks::BQ<QT>::Get(*m_pBlocks);
-    auto RunBlock = [&](FeatureBlocks::BQ<QT>::TQueue::const_reference block)
+    auto& q = FeatureBlocks::BQ<QT>::GetFrozen(*m_pBlocks);
+    auto RunBlock = [&](FeatureBlocks::BQ<QT>::TFrozen::const_reference block)
     {
         return stopAt(block.Call(*m_pGlob, task));
     };
@@ -303,7 +303,7 @@ mfxStatus TaskManager::RunQueueTaskFree(StorageW& task)
 {
     return RunBlocks(
         Check<mfxStatus, MFX_ERR_NONE>
-        , FeatureBlocks::BQ<FT>::Get(*m_pBlocks)
+        , FeatureBlocks::BQ<FT>::GetFrozen(*m_pBlocks)
         , *m_pGlob
         , task);
 }
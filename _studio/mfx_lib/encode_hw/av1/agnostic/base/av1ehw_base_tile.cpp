@@ -633,7 +633,7 @@ void Tile::InitTask(const FeatureBlocks& blocks, TPushIT Push)
             , StorageW& global
             , StorageW& task) -> mfxStatus
     {
-        mfxExtAV1TileParam* pFrameTilePar = ExtBuffer::Get(Task::Common::Get(task).ctrl);
+        mfxExtAV1TileParam* pFrameTilePar = ExtBuffer::Get(Task::Common::Get(task).ctrlEB);
         MFX_CHECK(IsTileUpdated(pFrameTilePar), MFX_ERR_NONE);
 
         auto&                      par      = Glob::VideoParam::Get(global);
@@ -644,7 +644,7 @@ void Tile::InitTask(const FeatureBlocks& blocks, TPushIT Push)
         mfxU16 sbCols = 0, sbRows = 0;
         std::tie(sbCols, sbRows)  = GetSBNum(par);
 
-        mfxExtAV1AuxData* pFrameAuxPar = ExtBuffer::Get(Task::Common::Get(task).ctrl);
+        mfxExtAV1AuxData* pFrameAuxPar = ExtBuffer::Get(Task::Common::Get(task).ctrlEB);
         mfxExtAV1AuxData  tempAuxPar   = {};
         if (!pFrameAuxPar)
         {
@@ -682,7 +682,7 @@ void Tile::PostReorderTask(const FeatureBlocks& blocks, TPushPostRT Push)
             StorageW& /*global*/
             , StorageW& s_task) -> mfxStatus
     {
-        mfxExtAV1TileParam* pFrameTilePar = ExtBuffer::Get(Task::Common::Get(s_task).ctrl);
+        mfxExtAV1TileParam* pFrameTilePar = ExtBuffer::Get(Task::Common::Get(s_task).ctrlEB);
         if (!IsTileUpdated(pFrameTilePar))
         {
             Task::TileGroups::Get(s_task) = {};
@@ -819,6 +819,7 @@ namespace Base
         mfxBitstream*       pBsOut              = nullptr;
         mfxFrameSurface1*   pSurfReal           = nullptr;
         mfxEncodeCtrl       ctrl                = {};
+        mfx::ExtBufferIndex ctrlEB;             // index of ctrl.ExtParam
         mfxU32              SkipCMD             = 0;
         Resource            BS;
         Resource            CUQP;
@@ -1511,7 +1512,7 @@ namespace Base
     template<class TEB>
     inline const TEB& GetRTExtBuffer(const StorageR& glob, const StorageR& task)
     {
-        const TEB* pEB = ExtBuffer::Get(Task::Common::Get(task).ctrl);
+        const TEB* pEB = ExtBuffer::Get(Task::Common::Get(task).ctrlEB);
         if (pEB)
             return *pEB;
         return ExtBuffer::Get(Glob::VideoParam::Get(glob));
@@ -144,7 +144,7 @@ void DirtyRect::PostReorderTask(const FeatureBlocks& /*blocks*/, TPushPostRT Pus
     {
         auto& par = Glob::VideoParam::Get(global);
         mfxExtDirtyRect tmp;
-        mfxExtDirtyRect* pDR = ExtBuffer::Get(Task::Common::Get(s_task).ctrl);
+        mfxExtDirtyRect* pDR = ExtBuffer::Get(Task::Common::Get(s_task).ctrlEB);
 
         if (pDR)
         {
@@ -169,8 +169,8 @@ void HdrSei::SubmitTask(const FeatureBlocks& /*blocks*/, TPushST Push)
         auto& par = Glob::VideoParam::Get(global);
         auto& task = Task::Common::Get(s_task);
 
-        const mfxExtMasteringDisplayColourVolume* pMDCV = ExtBuffer::Get(task.ctrl);
-        const mfxExtContentLightLevelInfo* pCLLI = ExtBuffer::Get(task.ctrl);
+        const mfxExtMasteringDisplayColourVolume* pMDCV = ExtBuffer::Get(task.ctrlEB);
+        const mfxExtContentLightLevelInfo* pCLLI = ExtBuffer::Get(task.ctrlEB);
 
         bool bInsertMDCV = !!pMDCV;
         bool bInsertCLLI = !!pCLLI;
@@ -148,6 +148,9 @@ mfxStatus MFXVideoENCODEH265_HW::Init(mfxVideoParam *par)
 {
     MFX_CHECK_NULL_PTR1(par);
     MFX_CHECK(m_storage.Empty(), MFX_ERR_UNDEFINED_BEHAVIOR);
+
+    // derived Init() overrides reorder queues after this one, they are frozen at the first frame
+    m_bFrozen = false;
     mfxStatus sts = MFX_ERR_NONE, wrn = MFX_ERR_NONE;
     StorageRW local, global;
 
@@ -242,7 +245,10 @@ mfxStatus MFXVideoENCODEH265_HW::EncodeFrameCheck(
             (x < MFX_ERR_NONE && x != MFX_ERR_MORE_DATA_SUBMIT_TASK)
             || x == MFX_WRN_DEVICE_BUSY;
     };
-    sts = RunBlocks(BreakAtSts, BQ<BQ_FrameSubmit>::Get(*this), ctrl, surface, *bs, m_storage, local);
+    if (!m_bFrozen)
+        Freeze();
+
+    sts = RunBlocks(BreakAtSts, BQ<BQ_FrameSubmit>::GetFrozen(*this), ctrl, surface, *bs, m_storage, local);
     MFX_CHECK(!BreakAtSts(sts), sts);
 
     pEntryPoint->pState = this;
@@ -269,7 +275,7 @@ mfxStatus MFXVideoENCODEH265_HW::Execute(mfxThreadTask ptask, mfxU32 /*uid_p*/,
 
     auto& task = *(StorageRW*)ptask;
 
-    return RunBlocks(Check<mfxStatus, MFX_ERR_NONE>, BQ<BQ_AsyncRoutine>::Get(*this), m_storage, task);
+    return RunBlocks(Check<mfxStatus, MFX_ERR_NONE>, BQ<BQ_AsyncRoutine>::GetFrozen(*this), m_storage, task);
 }
 
 mfxStatus MFXVideoENCODEH265_HW::FreeResources(mfxThreadTask /*task*/, mfxStatus /*sts*/)
@@ -283,6 +289,8 @@ mfxStatus MFXVideoENCODEH265_HW::Close(void)
 
     auto sts = RunBlocks(IgnoreSts, BQ<BQ_Close>::Get(*this), m_storage);
 
+    ReportProfile();
+
     m_storage.Clear();
 
     return sts;
@@ -1607,6 +1607,7 @@ void Legacy::InitTask(const FeatureBlocks& /*blocks*/, TPushIT Push)
         if (pCtrl)
         {
             tpar.ctrl = *pCtrl;
+            tpar.ctrlEB.Build(tpar.ctrl.ExtParam, tpar.ctrl.NumExtParam);
         }
         tpar.pSurfReal = tpar.pSurfIn;
 
@@ -1916,7 +1917,7 @@ void Legacy::SubmitTask(const FeatureBlocks& /*blocks*/, TPushST Push)
 
         if (mode == MBQPMode_ExternalMap)
         {
-            mfxExtMBQP* mbqpExt = ExtBuffer::Get(task.ctrl);
+            mfxExtMBQP* mbqpExt = ExtBuffer::Get(task.ctrlEB);
             MFX_CHECK(mbqpExt, MFX_ERR_NONE);
 
             mfxStatus sts = FillCUQPData(mbqpExt,
@@ -1929,7 +1930,7 @@ void Legacy::SubmitTask(const FeatureBlocks& /*blocks*/, TPushST Push)
         }
         else
         {
-            mfxExtEncoderROI* roi = ExtBuffer::Get(task.ctrl);
+            mfxExtEncoderROI* roi = ExtBuffer::Get(task.ctrlEB);
             MFX_CHECK(roi, MFX_ERR_NONE);
 
             // TO DO: it must be called after GetCtrl block
@@ -2382,11 +2383,11 @@ void Legacy::ConfigureTask(
     const bool isP    = IsP(task.FrameType);
     const bool isIDR  = IsIdr(task.FrameType);
 
-    mfxExtAVCRefLists*    pExtLists    = ExtBuffer::Get(task.ctrl);
-    mfxExtAVCRefListCtrl* pExtListCtrl = ExtBuffer::Get(task.ctrl);
+    mfxExtAVCRefLists*    pExtLists    = ExtBuffer::Get(task.ctrlEB);
+    mfxExtAVCRefListCtrl* pExtListCtrl = ExtBuffer::Get(task.ctrlEB);
 
     {
-        const mfxExtCodingOption2* pCO2 = ExtBuffer::Get(task.ctrl);
+        const mfxExtCodingOption2* pCO2 = ExtBuffer::Get(task.ctrlEB);
         SkipMode mode;
 
         SetDefault(pCO2, &CO2);
@@ -2408,7 +2409,7 @@ void Legacy::ConfigureTask(
 
     task.ctrl.MfxNalUnitType &= 0xffff * IsOn(CO3.EnableNalUnitType);
 
-    const mfxExtMBQP *pMBQP = ExtBuffer::Get(task.ctrl);
+    const mfxExtMBQP *pMBQP = ExtBuffer::Get(task.ctrlEB);
     task.bCUQPMap |= (IsOn(CO3.EnableMBQP) && pMBQP && pMBQP->NumQPAlloc > 0); // Do not use IsMBQP()
 
     bool bUpdateIRState = task.TemporalID == 0 && CO2.IntRefType;
@@ -4873,7 +4874,7 @@ mfxStatus Legacy::GetSliceHeader(
 
     if (sps.sample_adaptive_offset_enabled_flag)
     {
-        const mfxExtHEVCParam* rtHEVCParam = ExtBuffer::Get(task.ctrl);
+        const mfxExtHEVCParam* rtHEVCParam = ExtBuffer::Get(task.ctrlEB);
         const mfxExtHEVCParam& HEVCParam   = ExtBuffer::Get(par);
         mfxU16 FrameSAO = (rtHEVCParam && rtHEVCParam->SampleAdaptiveOffset)
             ? rtHEVCParam->SampleAdaptiveOffset
@@ -4903,7 +4904,7 @@ mfxStatus Legacy::GetSliceHeader(
     s.slice_cr_qp_offset = 0;
 
     const mfxExtCodingOption2& CO2  = ExtBuffer::Get(par);
-    const mfxExtCodingOption2* pCO2 = ExtBuffer::Get(task.ctrl);
+    const mfxExtCodingOption2* pCO2 = ExtBuffer::Get(task.ctrlEB);
 
     SetDefault(pCO2, &CO2);
 
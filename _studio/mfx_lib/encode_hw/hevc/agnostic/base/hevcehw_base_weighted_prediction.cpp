@@ -136,7 +136,7 @@ void WeightPred::PostReorderTask(const FeatureBlocks& /*blocks*/, TPushPostRT Pu
         const mfxU16 Y = 0, Cb = 1, Cr = 2, W = 0, O = 1;
         auto& task             = Task::Common::Get(s_task);
         auto& caps             = Glob::EncodeCaps::Get(global);
-        auto  pExtPWT          = (mfxExtPredWeightTable*)ExtBuffer::Get(task.ctrl);
+        auto  pExtPWT          = (mfxExtPredWeightTable*)ExtBuffer::Get(task.ctrlEB);
         auto  SetDefaultWeight = [&](mfxI16 (&pwt)[3][2])
         {
             pwt[Y][W]  = (1 << ssh.luma_log2_weight_denom);
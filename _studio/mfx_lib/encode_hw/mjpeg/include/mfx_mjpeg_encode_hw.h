@@ -56,6 +56,8 @@ private:
 class MFXVideoENCODEMJPEG_HW : public VideoENCODE {
 public:
     static mfxStatus Query(VideoCORE *core, mfxVideoParam *in, mfxVideoParam *out);
+    // checks parameters against given encoder caps, shared with the SW encoder
+    static mfxStatus Query(VideoCORE *core, mfxVideoParam *in, mfxVideoParam *out, MfxHwMJpegEncode::JpegEncCaps const & hwCaps);
     static mfxStatus QueryIOSurf(VideoCORE *core, mfxVideoParam *par, mfxFrameAllocRequest *request);
     static mfxStatus QueryImplsDescription(VideoCORE& core, mfxEncoderDescription::encoder& caps, mfx::PODArraysHolder& ah);
 
@@ -0,0 +1,150 @@
+// Copyright (c) 2025 Intel Corporation
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#ifndef __MFX_MJPEG_ENCODE_SW_H__
+#define __MFX_MJPEG_ENCODE_SW_H__
+
+#include "mfx_common.h"
+
+#if defined (MFX_ENABLE_MJPEG_VIDEO_ENCODE)
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include "mfxvideo++int.h"
+#include "mfx_mjpeg_encode_hw_utils.h"
+#include "jpegenc.h"
+
+// CPU implementation of MJPEG encoder for system memory input.
+// The frame is cut into pieces of whole restart intervals, which are
+// encoded by the scheduler threads in parallel and concatenated in order.
+class MFXVideoENCODEMJPEG_SW : public VideoENCODE {
+public:
+    static mfxStatus Query(VideoCORE *core, mfxVideoParam *in, mfxVideoParam *out);
+    static mfxStatus QueryIOSurf(VideoCORE *core, mfxVideoParam *par, mfxFrameAllocRequest *request);
+    static mfxStatus QueryImplsDescription(VideoCORE& core, mfxEncoderDescription::encoder& caps, mfx::PODArraysHolder& ah);
+
+    // true if enabled by VPL_MJPEG_SW_ENCODE=1
+    static bool UseSoftwareEncoder();
+
+    MFXVideoENCODEMJPEG_SW(VideoCORE *core, mfxStatus *sts);
+    virtual ~MFXVideoENCODEMJPEG_SW() override;
+    virtual mfxStatus Init(mfxVideoParam *par) override;
+    virtual mfxStatus Reset(mfxVideoParam *par) override;
+    virtual mfxStatus Close(void) override;
+
+    virtual mfxStatus GetVideoParam(mfxVideoParam *par) override;
+    virtual mfxStatus GetFrameParam(mfxFrameParam *par) override;
+    virtual mfxStatus GetEncodeStat(mfxEncodeStat *stat) override;
+
+    virtual
+    mfxStatus EncodeFrameCheck(mfxEncodeCtrl *ctrl,
+                               mfxFrameSurface1 *surface,
+                               mfxBitstream *bs,
+                               mfxFrameSurface1 **reordered_surface,
+                               mfxEncodeInternalParams *pInternalParams,
+                               MFX_ENTRY_POINT pEntryPoints[],
+                               mfxU32 &numEntryPoints) override;
+
+   // previous scheduling model - functions are not need to be implemented, only to be compatible
+    virtual mfxStatus EncodeFrameCheck(mfxEncodeCtrl *,
+                                       mfxFrameSurface1 *,
+                                       mfxBitstream *,
+                                       mfxFrameSurface1 **,
+                                       mfxEncodeInternalParams *) override
+    {
+        MFX_RETURN(MFX_ERR_UNDEFINED_BEHAVIOR);
+    }
+    virtual mfxStatus EncodeFrame(mfxEncodeCtrl *,
+                                  mfxEncodeInternalParams *,
+                                  mfxFrameSurface1 *,
+                                  mfxBitstream *) override
+    {
+        MFX_RETURN(MFX_ERR_UNDEFINED_BEHAVIOR);
+    }
+    virtual mfxStatus CancelFrame(mfxEncodeCtrl *,
+                                  mfxEncodeInternalParams *,
+                                  mfxFrameSurface1 *,
+                                  mfxBitstream *) override
+    {
+        MFX_RETURN(MFX_ERR_UNDEFINED_BEHAVIOR);
+    }
+
+    mfxU16 GetMemType(const mfxVideoParam&) override
+    {
+        return mfxU16(MFX_MEMTYPE_FROM_ENCODE | MFX_MEMTYPE_SYSTEM_MEMORY);
+    }
+
+    MFX_PROPAGATE_GetSurface_VideoENCODE_Definition;
+
+protected:
+    struct EncodeTask
+    {
+        EncodeTask();
+
+        mfxFrameSurface1*    surface;
+        mfxBitstream*        bs;
+        mfxFrameData         data;      // surface data locked for the task
+        bool                 locked;
+
+        std::vector<mfxU8>   header;    // SOI .. SOS
+        CJPEGEncoder         encoder;
+        mfxU32               numPieces;
+        std::atomic<mfxU32>  numEncodedPieces;
+        std::atomic<int>     error;     // the first failure of pieces
+    };
+
+    static mfxStatus TaskRoutineEncode(void * state,
+                                       void * param,
+                                       mfxU32 threadNumber,
+                                       mfxU32 callNumber);
+
+    mfxStatus CheckEncodeFrameParam(mfxFrameSurface1    * surface,
+                                    mfxBitstream        * bs,
+                                    bool                  isExternalFrameAllocator);
+
+    mfxStatus SetupTask(EncodeTask & task, mfxEncodeCtrl * ctrl);
+    mfxStatus CompleteTask(EncodeTask & task);
+
+    mfxStatus CheckParams(mfxVideoParam *par, mfxVideoParam & checked);
+
+    VideoCORE*          m_pCore;
+    mfxVideoParam       m_vFirstParam;
+    mfxVideoParam       m_vParam;
+
+    bool                m_bInitialized;
+    mfxU32              m_maxPieces;
+    mfxU32              m_maxTasks;
+
+    std::mutex                                m_guard;
+    std::vector<std::unique_ptr<EncodeTask>>  m_freeTasks;
+    mfxU32                                    m_tasksCount;
+
+    mfxExtJPEGQuantTables    m_checkedJpegQT;
+    mfxExtJPEGHuffmanTables  m_checkedJpegHT;
+
+    mfxExtBuffer*            m_pCheckedExt[3] = {};
+};
+
+#endif // #if defined (MFX_ENABLE_MJPEG_VIDEO_ENCODE)
+#endif // __MFX_MJPEG_ENCODE_SW_H__
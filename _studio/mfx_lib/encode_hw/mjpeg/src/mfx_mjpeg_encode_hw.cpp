@@ -231,6 +231,18 @@ mfxStatus MFXVideoENCODEMJPEG_HW::QueryImplsDescription(
 }
 
 mfxStatus MFXVideoENCODEMJPEG_HW::Query(VideoCORE * core, mfxVideoParam *in, mfxVideoParam *out)
+{
+    MFX_CHECK_NULL_PTR2(core, out);
+
+    // Check HW caps
+    JpegEncCaps hwCaps = {};
+    mfxStatus sts = QueryHwCaps(core, hwCaps);
+    MFX_CHECK(sts == MFX_ERR_NONE, MFX_ERR_UNSUPPORTED);
+
+    return Query(core, in, out, hwCaps);
+}
+
+mfxStatus MFXVideoENCODEMJPEG_HW::Query(VideoCORE * core, mfxVideoParam *in, mfxVideoParam *out, JpegEncCaps const & hwCaps)
 {
     mfxU32 isCorrected = 0;
     mfxU32 isInvalid = 0;
@@ -267,19 +279,10 @@ mfxStatus MFXVideoENCODEMJPEG_HW::Query(VideoCORE * core, mfxVideoParam *in, mfx
         //Extended coding options
         mfxStatus sts = CheckExtBufferId(*out);
         MFX_CHECK(sts == MFX_ERR_NONE, MFX_ERR_UNSUPPORTED);
-
-        JpegEncCaps hwCaps = {};
-        sts = QueryHwCaps(core, hwCaps);
-        MFX_CHECK(sts == MFX_ERR_NONE, MFX_ERR_UNSUPPORTED);
     }
     else
     {
-        // Check HW caps
-        JpegEncCaps hwCaps = {};
-        mfxStatus sts = QueryHwCaps(core, hwCaps);
-        MFX_CHECK(sts == MFX_ERR_NONE, MFX_ERR_UNSUPPORTED);
-
-        sts = CheckJpegParam(core, *in, hwCaps);
+        mfxStatus sts = CheckJpegParam(core, *in, hwCaps);
         if (sts == MFX_ERR_INCOMPATIBLE_VIDEO_PARAM)
             isInvalid++;
 
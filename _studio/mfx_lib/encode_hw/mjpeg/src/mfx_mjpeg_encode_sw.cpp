@@ -0,0 +1,821 @@
+// Copyright (c) 2025 Intel Corporation
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#include "mfx_common.h"
+
+#if defined (MFX_ENABLE_MJPEG_VIDEO_ENCODE)
+
+#include <cstdlib>
+#include <cstring>
+
+#include "mfx_mjpeg_encode_sw.h"
+#include "mfx_mjpeg_encode_hw.h"
+#include "mfx_task.h"
+#include "mfx_ext_buffers.h"
+#include "libmfx_core_interface.h"
+#include "libmfx_core.h"
+
+using namespace MfxHwMJpegEncode;
+
+// upper limit of pieces (restart interval groups) encoded in parallel
+#define JPEG_ENC_MAX_PIECES  16
+
+static JpegEncCaps GetSwCaps()
+{
+    JpegEncCaps caps = {};
+
+    caps.Baseline         = 1;
+    caps.Sequential       = 1;
+    caps.Huffman          = 1;
+    caps.NonInterleaved   = 0;
+    caps.Interleaved      = 1;
+    caps.MaxPicWidth      = 16384;
+    caps.MaxPicHeight     = 16384;
+    caps.SampleBitDepth   = 8;
+    caps.MaxNumComponent  = 3;
+    caps.MaxNumScan       = 1;
+    caps.MaxNumHuffTable  = 2;
+    caps.MaxNumQuantTable = 2;
+
+    return caps;
+}
+
+static mfxStatus ConvertJpegStatusToMfx(JERRCODE jerr)
+{
+    switch (jerr)
+    {
+    case JPEG_OK:
+        return MFX_ERR_NONE;
+    case JPEG_ERR_ALLOC:
+        return MFX_ERR_MEMORY_ALLOC;
+    case JPEG_NOT_IMPLEMENTED:
+    case JPEG_ERR_PARAMS:
+    case JPEG_ERR_DQT_DATA:
+    case JPEG_ERR_DHT_DATA:
+        return MFX_ERR_UNDEFINED_BEHAVIOR;
+    default:
+        return MFX_ERR_UNKNOWN;
+    }
+}
+
+static mfxU32 SumHuffmanBits(const mfxU8 bits[16])
+{
+    mfxU32 sum = 0;
+    for (mfxU32 i = 0; i < 16; i++)
+        sum += bits[i];
+    return sum;
+}
+
+MFXVideoENCODEMJPEG_SW::EncodeTask::EncodeTask()
+    : surface(nullptr)
+    , bs(nullptr)
+    , data()
+    , locked(false)
+    , numPieces(0)
+    , numEncodedPieces(0)
+    , error(JPEG_OK)
+{
+}
+
+MFXVideoENCODEMJPEG_SW::MFXVideoENCODEMJPEG_SW(VideoCORE *core, mfxStatus *sts)
+    : m_pCore(core)
+    , m_bInitialized(false)
+    , m_maxPieces(1)
+    , m_maxTasks(1)
+    , m_tasksCount(0)
+{
+    memset(&m_vFirstParam, 0, sizeof(mfxVideoParam));
+    memset(&m_vParam, 0, sizeof(mfxVideoParam));
+    memset(&m_checkedJpegQT, 0, sizeof(m_checkedJpegQT));
+    memset(&m_checkedJpegHT, 0, sizeof(m_checkedJpegHT));
+
+    *sts = (core ? MFX_ERR_NONE : MFX_ERR_NULL_PTR);
+}
+
+MFXVideoENCODEMJPEG_SW::~MFXVideoENCODEMJPEG_SW()
+{
+    Close();
+}
+
+bool MFXVideoENCODEMJPEG_SW::UseSoftwareEncoder()
+{
+    // without the opt-in JPEG encoding stays unsupported where the HW can't do it
+    const char *pSWEncode = std::getenv("VPL_MJPEG_SW_ENCODE");
+    return pSWEncode && !strcmp(pSWEncode, "1");
+}
+
+mfxStatus MFXVideoENCODEMJPEG_SW::QueryImplsDescription(
+    VideoCORE&
+    , mfxEncoderDescription::encoder& caps
+    , mfx::PODArraysHolder& ah)
+{
+    JpegEncCaps swCaps = GetSwCaps();
+
+    caps.CodecID                    = MFX_CODEC_JPEG;
+    caps.MaxcodecLevel              = 0;
+    caps.BiDirectionalPrediction    = 0;
+
+    auto& profileCaps = ah.PushBack(caps.Profiles);
+
+    profileCaps.Profile = MFX_PROFILE_JPEG_BASELINE;
+
+    auto& memCaps = ah.PushBack(profileCaps.MemDesc);
+
+    memCaps.MemHandleType = MFX_RESOURCE_SYSTEM_SURFACE;
+    memCaps.Width  = { 1, swCaps.MaxPicWidth, 1 };
+    memCaps.Height = { 1, swCaps.MaxPicHeight, 1 };
+
+    ah.PushBack(memCaps.ColorFormats) = MFX_FOURCC_NV12;
+    ah.PushBack(memCaps.ColorFormats) = MFX_FOURCC_YUY2;
+    ah.PushBack(memCaps.ColorFormats) = MFX_FOURCC_RGB4;
+    ah.PushBack(memCaps.ColorFormats) = MFX_FOURCC_BGR4;
+    ah.PushBack(memCaps.ColorFormats) = MFX_FOURCC_YUV400;
+    memCaps.NumColorFormats = 5;
+
+    profileCaps.NumMemTypes = 1;
+    caps.NumProfiles = 1;
+
+    return MFX_ERR_NONE;
+}
+
+mfxStatus MFXVideoENCODEMJPEG_SW::Query(VideoCORE * core, mfxVideoParam *in, mfxVideoParam *out)
+{
+    MFX_CHECK_NULL_PTR2(core, out);
+
+    mfxStatus sts = MFXVideoENCODEMJPEG_HW::Query(core, in, out, GetSwCaps());
+    if (sts < MFX_ERR_NONE)
+        return sts;
+
+    // only system memory input
+    if (in && (in->IOPattern & MFX_IOPATTERN_IN_VIDEO_MEMORY))
+    {
+        out->IOPattern = 0;
+        MFX_RETURN(MFX_ERR_UNSUPPORTED);
+    }
+
+    return sts;
+}
+
+mfxStatus MFXVideoENCODEMJPEG_SW::QueryIOSurf(VideoCORE * core, mfxVideoParam *par, mfxFrameAllocRequest *request)
+{
+    MFX_CHECK_NULL_PTR3(core, par, request);
+
+    mfxStatus sts = CheckJpegParam(core, *par, GetSwCaps());
+    MFX_CHECK(sts == MFX_ERR_NONE, MFX_ERR_INVALID_VIDEO_PARAM);
+
+    mfxU16 IOPatternIn = par->IOPattern & (
+          MFX_IOPATTERN_IN_VIDEO_MEMORY
+        | MFX_IOPATTERN_IN_SYSTEM_MEMORY);
+    MFX_CHECK(IOPatternIn == MFX_IOPATTERN_IN_SYSTEM_MEMORY, MFX_ERR_INVALID_VIDEO_PARAM);
+
+    request->Info = par->mfx.FrameInfo;
+
+    request->NumFrameMin = 1;
+    request->Type = MFX_MEMTYPE_EXTERNAL_FRAME | MFX_MEMTYPE_FROM_ENCODE | MFX_MEMTYPE_SYSTEM_MEMORY;
+    request->NumFrameSuggested = std::max<mfxU16>(request->NumFrameMin, par->AsyncDepth ? par->AsyncDepth : core->GetAutoAsyncDepth());
+
+    return MFX_ERR_NONE;
+}
+
+mfxStatus MFXVideoENCODEMJPEG_SW::CheckParams(mfxVideoParam *par, mfxVideoParam & checked)
+{
+    MFX_CHECK( CheckExtBufferId(*par) == MFX_ERR_NONE, MFX_ERR_INVALID_VIDEO_PARAM );
+
+    mfxExtJPEGQuantTables*    jpegQT       = (mfxExtJPEGQuantTables*)   mfx::GetExtBuffer( par->ExtParam, par->NumExtParam, MFX_EXTBUFF_JPEG_QT );
+    mfxExtJPEGHuffmanTables*  jpegHT       = (mfxExtJPEGHuffmanTables*) mfx::GetExtBuffer( par->ExtParam, par->NumExtParam, MFX_EXTBUFF_JPEG_HUFFMAN );
+
+    mfxU16 ext_counter = 0;
+    checked = *par;
+
+    if (jpegQT)
+    {
+        m_checkedJpegQT = *jpegQT;
+        m_pCheckedExt[ext_counter++] = &m_checkedJpegQT.Header;
+    }
+    else
+    {
+        memset(&m_checkedJpegQT, 0, sizeof(m_checkedJpegQT));
+        m_checkedJpegQT.Header.BufferId = MFX_EXTBUFF_JPEG_QT;
+        m_checkedJpegQT.Header.BufferSz = sizeof(m_checkedJpegQT);
+    }
+    if (jpegHT)
+    {
+        m_checkedJpegHT = *jpegHT;
+        m_pCheckedExt[ext_counter++] = &m_checkedJpegHT.Header;
+    }
+    else
+    {
+        memset(&m_checkedJpegHT, 0, sizeof(m_checkedJpegHT));
+        m_checkedJpegHT.Header.BufferId = MFX_EXTBUFF_JPEG_HUFFMAN;
+        m_checkedJpegHT.Header.BufferSz = sizeof(m_checkedJpegHT);
+    }
+
+    checked.ExtParam = m_pCheckedExt;
+    checked.NumExtParam = ext_counter;
+
+    mfxStatus sts = Query(m_pCore, par, &checked);
+
+    if (sts != MFX_ERR_NONE && sts != MFX_WRN_INCOMPATIBLE_VIDEO_PARAM)
+    {
+        if (sts == MFX_ERR_UNSUPPORTED)
+        {
+            MFX_RETURN(MFX_ERR_INVALID_VIDEO_PARAM);
+        }
+        else
+            return sts;
+    }
+
+    MFX_CHECK(checked.IOPattern == MFX_IOPATTERN_IN_SYSTEM_MEMORY, MFX_ERR_INVALID_VIDEO_PARAM);
+
+    if (checked.mfx.FrameInfo.PicStruct != MFX_PICSTRUCT_UNKNOWN &&
+        checked.mfx.FrameInfo.PicStruct != MFX_PICSTRUCT_PROGRESSIVE)
+    {
+        MFX_RETURN(MFX_ERR_INVALID_VIDEO_PARAM);
+    }
+
+    return sts;
+}
+
+mfxStatus MFXVideoENCODEMJPEG_SW::Init(mfxVideoParam *par)
+{
+    if (m_bInitialized || !m_pCore)
+        MFX_RETURN(MFX_ERR_UNDEFINED_BEHAVIOR);
+
+    MFX_CHECK_NULL_PTR1(par);
+
+    mfxVideoParam checked;
+    mfxStatus sts = CheckParams(par, checked);
+    MFX_CHECK(sts >= MFX_ERR_NONE, sts);
+
+    m_vFirstParam = checked;
+    m_vParam      = checked;
+
+    m_maxTasks  = m_vParam.AsyncDepth ? m_vParam.AsyncDepth : m_pCore->GetAutoAsyncDepth();
+    m_maxPieces = std::min<mfxU32>(std::max<mfxU32>(m_pCore->GetAutoAsyncDepth(), 1), JPEG_ENC_MAX_PIECES);
+
+    m_bInitialized = true;
+    return sts;
+}
+
+mfxStatus MFXVideoENCODEMJPEG_SW::Reset(mfxVideoParam *par)
+{
+    if(!m_bInitialized)
+        return MFX_ERR_NOT_INITIALIZED;
+
+    MFX_CHECK_NULL_PTR1(par);
+
+    mfxVideoParam checked;
+    mfxStatus sts = CheckParams(par, checked);
+    MFX_CHECK(sts >= MFX_ERR_NONE, sts);
+
+    // check that new params don't require allocation of additional memory
+    if (checked.mfx.FrameInfo.Width > m_vFirstParam.mfx.FrameInfo.Width ||
+        checked.mfx.FrameInfo.Height > m_vFirstParam.mfx.FrameInfo.Height ||
+        m_vFirstParam.mfx.FrameInfo.FourCC != checked.mfx.FrameInfo.FourCC ||
+        m_vFirstParam.mfx.FrameInfo.ChromaFormat != checked.mfx.FrameInfo.ChromaFormat)
+        MFX_RETURN(MFX_ERR_INCOMPATIBLE_VIDEO_PARAM);
+
+    if(checked.AsyncDepth != m_vFirstParam.AsyncDepth)
+        MFX_RETURN(MFX_ERR_INVALID_VIDEO_PARAM);
+
+    m_vParam.mfx         = checked.mfx;
+    m_vParam.IOPattern   = checked.IOPattern;
+    m_vParam.Protected   = 0;
+    m_vParam.ExtParam    = checked.ExtParam;
+    m_vParam.NumExtParam = checked.NumExtParam;
+
+    return sts;
+}
+
+mfxStatus MFXVideoENCODEMJPEG_SW::Close(void)
+{
+    std::lock_guard<std::mutex> guard(m_guard);
+
+    m_freeTasks.clear();
+    m_tasksCount = 0;
+    m_bInitialized = false;
+
+    return MFX_ERR_NONE;
+}
+
+mfxStatus MFXVideoENCODEMJPEG_SW::GetVideoParam(mfxVideoParam *par)
+{
+    if (!m_bInitialized)
+        return MFX_ERR_NOT_INITIALIZED;
+
+    MFX_CHECK_NULL_PTR1(par);
+
+    par->mfx = m_vParam.mfx;
+    par->Protected = m_vParam.Protected;
+    par->IOPattern = m_vParam.IOPattern;
+    par->AsyncDepth = m_vParam.AsyncDepth;
+
+    return MFX_ERR_NONE;
+}
+
+mfxStatus MFXVideoENCODEMJPEG_SW::GetFrameParam(mfxFrameParam *par)
+{
+    MFX_CHECK_NULL_PTR1(par);
+    MFX_RETURN(MFX_ERR_UNSUPPORTED);
+}
+
+mfxStatus MFXVideoENCODEMJPEG_SW::GetEncodeStat(mfxEncodeStat *stat)
+{
+    if (!m_bInitialized)
+        return MFX_ERR_NOT_INITIALIZED;
+
+    MFX_CHECK_NULL_PTR1(stat)
+    memset(stat, 0, sizeof(mfxEncodeStat));
+
+    MFX_RETURN(MFX_ERR_UNSUPPORTED);
+}
+
+mfxStatus MFXVideoENCODEMJPEG_SW::EncodeFrameCheck(
+                               mfxEncodeCtrl *ctrl,
+                               mfxFrameSurface1 *surface,
+                               mfxBitstream *bs,
+                               mfxFrameSurface1 ** /*reordered_surface*/,
+                               mfxEncodeInternalParams * /*pInternalParams*/,
+                               MFX_ENTRY_POINT pEntryPoints[],
+                               mfxU32 &numEntryPoints)
+{
+    mfxExtJPEGQuantTables*   jpegQT = NULL;
+    mfxExtJPEGHuffmanTables* jpegHT = NULL;
+
+    bool vpl_interface = SupportsVPLFeatureSet(*m_pCore);
+
+    mfxStatus checkSts = CheckEncodeFrameParam(
+        surface,
+        bs,
+        m_pCore->IsExternalFrameAllocator() || vpl_interface);
+    MFX_CHECK(checkSts >= MFX_ERR_NONE, checkSts);
+
+    if (ctrl && ctrl->ExtParam && ctrl->NumExtParam > 0)
+    {
+        jpegQT = (mfxExtJPEGQuantTables*)   mfx::GetExtBuffer( ctrl->ExtParam, ctrl->NumExtParam, MFX_EXTBUFF_JPEG_QT );
+        jpegHT = (mfxExtJPEGHuffmanTables*) mfx::GetExtBuffer( ctrl->ExtParam, ctrl->NumExtParam, MFX_EXTBUFF_JPEG_HUFFMAN );
+    }
+
+    // Check new tables if exists
+    if (jpegQT || jpegHT)
+    {
+        mfxVideoParam vPar = m_vParam;
+        vPar.ExtParam = ctrl->ExtParam;
+        vPar.NumExtParam = ctrl->NumExtParam;
+
+        mfxStatus mfxRes = CheckJpegParam(m_pCore, vPar, GetSwCaps());
+        if (mfxRes != MFX_ERR_NONE)
+            MFX_RETURN(MFX_ERR_UNDEFINED_BEHAVIOR);
+    }
+
+    mfxExtJPEGQuantTables* jpegQTInitial = (mfxExtJPEGQuantTables*) mfx::GetExtBuffer( m_vParam.ExtParam, m_vParam.NumExtParam, MFX_EXTBUFF_JPEG_QT );
+    if (!(jpegQTInitial || jpegQT || m_vParam.mfx.Quality))
+    {
+        MFX_RETURN(MFX_ERR_UNDEFINED_BEHAVIOR);
+    }
+
+    EncodeTask * task = nullptr;
+    {
+        std::lock_guard<std::mutex> guard(m_guard);
+
+        if (m_freeTasks.empty())
+        {
+            if (m_tasksCount >= m_maxTasks)
+                return MFX_WRN_DEVICE_BUSY;
+
+            m_freeTasks.emplace_back(new EncodeTask);
+            m_tasksCount++;
+        }
+
+        // the task is owned by the scheduler until CompleteTask()
+        task = m_freeTasks.back().release();
+        m_freeTasks.pop_back();
+    }
+
+    task->surface = surface;
+    task->bs      = bs;
+
+    mfxStatus sts = SetupTask(*task, ctrl);
+    if (sts != MFX_ERR_NONE)
+    {
+        if (task->locked)
+            m_pCore->UnlockExternalFrame(surface->Data.MemId, &task->data);
+
+        std::lock_guard<std::mutex> guard(m_guard);
+        m_freeTasks.emplace_back(task);
+        return sts;
+    }
+
+    bs->TimeStamp = surface->Data.TimeStamp;
+    bs->DecodeTimeStamp = surface->Data.TimeStamp;
+    bs->FrameType = MFX_FRAMETYPE_I;
+
+    m_pCore->IncreaseReference(*surface);
+
+    // definition tasks for MSDK scheduler
+    pEntryPoints[0].pState               = this;
+    pEntryPoints[0].pParam               = task;
+    pEntryPoints[0].pCompleteProc        = 0;
+    pEntryPoints[0].pOutputPostProc      = 0;
+    // every piece is encoded by its own call
+    pEntryPoints[0].requiredNumThreads   = task->numPieces;
+    pEntryPoints[0].pRoutineName         = (char *)"Encode";
+    pEntryPoints[0].pRoutine             = TaskRoutineEncode;
+
+    numEntryPoints = 1;
+
+    return checkSts;
+}
+
+mfxStatus MFXVideoENCODEMJPEG_SW::SetupTask(EncodeTask & task, mfxEncodeCtrl * ctrl)
+{
+    mfxExtJPEGQuantTables*   jpegQT = NULL;
+    mfxExtJPEGHuffmanTables* jpegHT = NULL;
+
+    if (ctrl && ctrl->ExtParam && ctrl->NumExtParam > 0)
+    {
+        jpegQT = (mfxExtJPEGQuantTables*)   mfx::GetExtBuffer( ctrl->ExtParam, ctrl->NumExtParam, MFX_EXTBUFF_JPEG_QT );
+        jpegHT = (mfxExtJPEGHuffmanTables*) mfx::GetExtBuffer( ctrl->ExtParam, ctrl->NumExtParam, MFX_EXTBUFF_JPEG_HUFFMAN );
+    }
+
+    mfxExtJPEGQuantTables*   jpegQTInitial = (mfxExtJPEGQuantTables*)   mfx::GetExtBuffer( m_vParam.ExtParam, m_vParam.NumExtParam, MFX_EXTBUFF_JPEG_QT );
+    mfxExtJPEGHuffmanTables* jpegHTInitial = (mfxExtJPEGHuffmanTables*) mfx::GetExtBuffer( m_vParam.ExtParam, m_vParam.NumExtParam, MFX_EXTBUFF_JPEG_HUFFMAN );
+
+    mfxFrameInfo const & info = m_vParam.mfx.FrameInfo;
+    mfxU32 fourCC       = info.FourCC;
+    mfxU16 chromaFormat = info.ChromaFormat;
+
+    JCOLOR srcColor;
+    JSS    srcSampling  = JS_444;
+    JCOLOR jpegColor;
+    JSS    jpegSampling = JS_444;
+
+    if (fourCC == MFX_FOURCC_NV12 && chromaFormat == MFX_CHROMAFORMAT_YUV420)
+    {
+        srcColor     = JC_NV12;
+        srcSampling  = JS_420;
+        jpegColor    = JC_YCBCR;
+        jpegSampling = JS_420;
+    }
+    else if (fourCC == MFX_FOURCC_YUY2 && chromaFormat == MFX_CHROMAFORMAT_YUV422H)
+    {
+        srcColor     = JC_YCBCR;
+        srcSampling  = JS_422H;
+        jpegColor    = JC_YCBCR;
+        jpegSampling = JS_422H;
+    }
+    else if ((fourCC == MFX_FOURCC_NV12 || fourCC == MFX_FOURCC_YUV400) && chromaFormat == MFX_CHROMAFORMAT_YUV400)
+    {
+        srcColor     = JC_GRAY;
+        jpegColor    = JC_GRAY;
+    }
+    else if (fourCC == MFX_FOURCC_RGB4 && chromaFormat == MFX_CHROMAFORMAT_YUV444)
+    {
+        srcColor     = JC_BGRA;
+        jpegColor    = JC_RGB;
+    }
+    else if (fourCC == MFX_FOURCC_BGR4 && chromaFormat == MFX_CHROMAFORMAT_YUV444)
+    {
+        srcColor     = JC_RGBA;
+        jpegColor    = JC_RGB;
+    }
+    else
+        MFX_RETURN(MFX_ERR_UNDEFINED_BEHAVIOR);
+
+    bool   isRGB = (jpegColor == JC_RGB);
+    mfxU32 ncomp = (jpegColor == JC_GRAY) ? 1 : 3;
+
+    mfxSize picSize;
+    picSize.width  = info.CropW ? info.CropW : info.Width;
+    picSize.height = info.CropH ? info.CropH : info.Height;
+
+    // split the picture into MCU rows when the application didn't ask for restart intervals
+    mfxU32 restartInterval = m_vParam.mfx.RestartInterval;
+    if (!restartInterval && m_maxPieces > 1)
+    {
+        mfxU32 mcuWidth  = (jpegSampling == JS_444) ? 8 : 16;
+        mfxU32 mcuHeight = (jpegSampling == JS_420) ? 16 : 8;
+
+        if ((mfxU32)picSize.height > mcuHeight)
+            restartInterval = (picSize.width + mcuWidth - 1) / mcuWidth;
+    }
+
+    CJPEGEncoder & encoder = task.encoder;
+    JERRCODE jerr = encoder.SetParams(jpegColor, jpegSampling, (int)restartInterval);
+    MFX_CHECK(jerr == JPEG_OK, ConvertJpegStatusToMfx(jerr));
+
+    // Quantization tables
+    mfxU8 qntSel[3] = { 0, 1, 1 };
+    if (jpegQT || jpegQTInitial)
+    {
+        // External tables
+        mfxExtJPEGQuantTables *pExtQuant = jpegQT ? jpegQT : jpegQTInitial;
+        MFX_CHECK(pExtQuant->NumTable && pExtQuant->NumTable <= 2, MFX_ERR_UNDEFINED_BEHAVIOR);
+
+        for (mfxU16 i = 0; i < pExtQuant->NumTable; i++)
+        {
+            mfxU8 raw[DCTSIZE2];
+            for (mfxU16 j = 0; j < DCTSIZE2; j++)
+            {
+                raw[j] = (mfxU8)pExtQuant->Qm[i][j];
+                MFX_CHECK(raw[j] != 0, MFX_ERR_UNDEFINED_BEHAVIOR);
+            }
+
+            jerr = encoder.InitQuantTable(i, raw, 0);
+            MFX_CHECK(jerr == JPEG_OK, ConvertJpegStatusToMfx(jerr));
+        }
+
+        if (pExtQuant->NumTable == 1)
+            qntSel[1] = qntSel[2] = 0;
+    }
+    else
+    {
+        // No external tables - use Quality parameter
+        int quality = std::min<int>(m_vParam.mfx.Quality, 100);
+
+        jerr = encoder.InitQuantTable(0, DefaultLuminanceQuant, quality);
+        MFX_CHECK(jerr == JPEG_OK, ConvertJpegStatusToMfx(jerr));
+
+        if (isRGB)
+        {
+            qntSel[1] = qntSel[2] = 0;
+        }
+        else
+        {
+            jerr = encoder.InitQuantTable(1, DefaultChrominanceQuant, quality);
+            MFX_CHECK(jerr == JPEG_OK, ConvertJpegStatusToMfx(jerr));
+        }
+    }
+
+    // Huffman tables
+    mfxU8 huffSel[3] = { 0, 1, 1 };
+    if (jpegHT || jpegHTInitial)
+    {
+        // External tables
+        mfxExtJPEGHuffmanTables *pExtHuffman = jpegHT ? jpegHT : jpegHTInitial;
+        MFX_CHECK(pExtHuffman->NumDCTable &&
+                  pExtHuffman->NumACTable &&
+                  pExtHuffman->NumDCTable <= 2 &&
+                  pExtHuffman->NumACTable <= 2, MFX_ERR_UNDEFINED_BEHAVIOR);
+
+        for (mfxU16 i = 0; i < pExtHuffman->NumDCTable; i++)
+        {
+            MFX_CHECK(SumHuffmanBits(pExtHuffman->DCTables[i].Bits) <= 12, MFX_ERR_UNDEFINED_BEHAVIOR);
+            jerr = encoder.InitHuffmanTable(i, DC, pExtHuffman->DCTables[i].Bits, pExtHuffman->DCTables[i].Values);
+            MFX_CHECK(jerr == JPEG_OK, ConvertJpegStatusToMfx(jerr));
+        }
+        for (mfxU16 i = 0; i < pExtHuffman->NumACTable; i++)
+        {
+            MFX_CHECK(SumHuffmanBits(pExtHuffman->ACTables[i].Bits) <= 162, MFX_ERR_UNDEFINED_BEHAVIOR);
+            jerr = encoder.InitHuffmanTable(i, AC, pExtHuffman->ACTables[i].Bits, pExtHuffman->ACTables[i].Values);
+            MFX_CHECK(jerr == JPEG_OK, ConvertJpegStatusToMfx(jerr));
+        }
+
+        if (isRGB || pExtHuffman->NumDCTable < 2 || pExtHuffman->NumACTable < 2)
+            huffSel[1] = huffSel[2] = 0;
+    }
+    else
+    {
+        // Internal tables
+        jerr = encoder.InitHuffmanTable(0, DC, DefaultLuminanceDCBits, DefaultLuminanceDCValues);
+        MFX_CHECK(jerr == JPEG_OK, ConvertJpegStatusToMfx(jerr));
+        jerr = encoder.InitHuffmanTable(0, AC, DefaultLuminanceACBits, DefaultLuminanceACValues);
+        MFX_CHECK(jerr == JPEG_OK, ConvertJpegStatusToMfx(jerr));
+
+        if (isRGB)
+        {
+            huffSel[1] = huffSel[2] = 0;
+        }
+        else
+        {
+            jerr = encoder.InitHuffmanTable(1, DC, DefaultChrominanceDCBits, DefaultChrominanceDCValues);
+            MFX_CHECK(jerr == JPEG_OK, ConvertJpegStatusToMfx(jerr));
+            jerr = encoder.InitHuffmanTable(1, AC, DefaultChrominanceACBits, DefaultChrominanceACValues);
+            MFX_CHECK(jerr == JPEG_OK, ConvertJpegStatusToMfx(jerr));
+        }
+    }
+
+    for (mfxU32 i = 0; i < ncomp; i++)
+    {
+        jerr = encoder.SetComponentTables(i, qntSel[i], huffSel[i]);
+        MFX_CHECK(jerr == JPEG_OK, ConvertJpegStatusToMfx(jerr));
+    }
+
+    // application data goes right after APP0 or APP14
+    std::vector<mfxU8> appData;
+    if (ctrl && ctrl->Payload && ctrl->NumPayload > 0)
+    {
+        for (mfxU16 i = 0; i < ctrl->NumPayload; i++)
+        {
+            mfxPayload* pExtPayload = ctrl->Payload[i];
+            if (pExtPayload)
+            {
+                MFX_CHECK(pExtPayload->Data && (pExtPayload->NumBit >> 3) > 0, MFX_ERR_INVALID_VIDEO_PARAM);
+                appData.insert(appData.end(), pExtPayload->Data, pExtPayload->Data + (pExtPayload->NumBit >> 3));
+            }
+        }
+    }
+
+    // source
+    task.data   = task.surface->Data;
+    task.locked = false;
+    if (task.data.Y == 0)
+    {
+        mfxStatus sts = m_pCore->LockExternalFrame(task.surface->Data.MemId, &task.data);
+        MFX_CHECK_STS(sts);
+        task.locked = true;
+    }
+    MFX_CHECK(task.data.Y != 0, MFX_ERR_LOCK_MEMORY);
+
+    mfxU32 pitch = task.data.PitchLow + ((mfxU32)task.data.PitchHigh << 16);
+    mfxU32 cropX = info.CropX;
+    mfxU32 cropY = info.CropY;
+
+    const mfxU8* pSrc[2] = {};
+    int          srcStep[2] = { (int)pitch, (int)pitch };
+
+    switch (srcColor)
+    {
+    case JC_NV12:
+        MFX_CHECK(task.data.UV != 0, MFX_ERR_LOCK_MEMORY);
+        pSrc[0] = task.data.Y  + cropY * pitch + cropX;
+        pSrc[1] = task.data.UV + (cropY >> 1) * pitch + (cropX & ~1);
+        break;
+    case JC_YCBCR:
+        pSrc[0] = task.data.Y + cropY * pitch + (cropX & ~1) * 2;
+        break;
+    case JC_GRAY:
+        pSrc[0] = task.data.Y + cropY * pitch + cropX;
+        break;
+    case JC_BGRA:
+        MFX_CHECK(task.data.B != 0, MFX_ERR_LOCK_MEMORY);
+        pSrc[0] = task.data.B + cropY * pitch + cropX * 4;
+        break;
+    default:
+        pSrc[0] = task.data.R + cropY * pitch + cropX * 4;
+        break;
+    }
+
+    jerr = encoder.SetSource(pSrc, srcStep, picSize, srcColor, srcSampling);
+    MFX_CHECK(jerr == JPEG_OK, ConvertJpegStatusToMfx(jerr));
+
+    task.header.clear();
+    jerr = encoder.WriteHeader(task.header, appData.data(), (int)appData.size());
+    MFX_CHECK(jerr == JPEG_OK, ConvertJpegStatusToMfx(jerr));
+
+    jerr = encoder.SetNumPieces((int)m_maxPieces);
+    MFX_CHECK(jerr == JPEG_OK, ConvertJpegStatusToMfx(jerr));
+
+    task.numPieces        = (mfxU32)encoder.GetNumPieces();
+    task.numEncodedPieces = 0;
+    task.error            = JPEG_OK;
+
+    return MFX_ERR_NONE;
+}
+
+mfxStatus MFXVideoENCODEMJPEG_SW::CheckEncodeFrameParam(
+    mfxFrameSurface1    * surface,
+    mfxBitstream        * bs,
+    bool                  isExternalFrameAllocator)
+{
+    if (!m_bInitialized) return MFX_ERR_NOT_INITIALIZED;
+
+    MFX_CHECK_NULL_PTR1(bs);
+    MFX_CHECK_NULL_PTR1(bs->Data);
+
+    // Check for enough bitstream buffer size
+    if ( (0 == bs->MaxLength) || (bs->MaxLength <= (bs->DataOffset + bs->DataLength)) )
+        return MFX_ERR_NOT_ENOUGH_BUFFER;
+
+    if ( NULL == surface )
+    {
+        MFX_RETURN(MFX_ERR_MORE_DATA);
+    }
+
+    if (surface->Info.ChromaFormat != m_vParam.mfx.FrameInfo.ChromaFormat)
+        MFX_RETURN(MFX_ERR_INVALID_VIDEO_PARAM);
+
+    mfxU32 pitch = surface->Data.PitchLow + ((mfxU32)surface->Data.PitchHigh << 16);
+    MFX_CHECK((surface->Data.Y == 0) || (pitch != 0), MFX_ERR_UNDEFINED_BEHAVIOR);
+    MFX_CHECK(surface->Data.Y != 0 || isExternalFrameAllocator, MFX_ERR_UNDEFINED_BEHAVIOR);
+
+    MFX_CHECK(surface->Info.Width >= m_vParam.mfx.FrameInfo.Width, MFX_ERR_INVALID_VIDEO_PARAM);
+    MFX_CHECK(surface->Info.Height >= m_vParam.mfx.FrameInfo.Height, MFX_ERR_INVALID_VIDEO_PARAM);
+
+    return MFX_ERR_NONE;
+}
+
+// Routine to encode one piece of the picture. asyncronous part of encoding
+mfxStatus MFXVideoENCODEMJPEG_SW::TaskRoutineEncode(
+    void * state,
+    void * param,
+    mfxU32 /*threadNumber*/,
+    mfxU32 callNumber)
+{
+    MFXVideoENCODEMJPEG_SW & enc = *(MFXVideoENCODEMJPEG_SW*)state;
+    EncodeTask &task = *(EncodeTask*)param;
+
+    // all pieces are taken, the last one is still being encoded
+    if (callNumber >= task.numPieces)
+    {
+        return MFX_TASK_BUSY;
+    }
+
+    JERRCODE jerr = task.encoder.EncodePiece((int)callNumber);
+    if (jerr != JPEG_OK)
+    {
+        int expected = JPEG_OK;
+        task.error.compare_exchange_strong(expected, jerr);
+    }
+
+    // the last finished piece completes the task
+    if (++task.numEncodedPieces < task.numPieces)
+    {
+        return MFX_TASK_WORKING;
+    }
+
+    return enc.CompleteTask(task);
+}
+
+mfxStatus MFXVideoENCODEMJPEG_SW::CompleteTask(EncodeTask & task)
+{
+    MFX_AUTO_LTRACE(MFX_TRACE_LEVEL_INTERNAL, "JPEG encode write bitstream");
+
+    mfxStatus sts = ConvertJpegStatusToMfx((JERRCODE)task.error.load());
+
+    if (sts == MFX_ERR_NONE)
+    {
+        std::vector<mfxU8> trailer;
+        task.encoder.WriteTrailer(trailer);
+
+        mfxU32 size = (mfxU32)(task.header.size() + trailer.size());
+        for (mfxU32 i = 0; i < task.numPieces; i++)
+        {
+            int len = 0;
+            task.encoder.GetPieceData(i, &len);
+            size += len;
+        }
+
+        mfxBitstream & bs = *task.bs;
+        if (bs.MaxLength - bs.DataOffset - bs.DataLength < size)
+        {
+            sts = MFX_ERR_NOT_ENOUGH_BUFFER;
+        }
+        else
+        {
+            mfxU8* dst = bs.Data + bs.DataOffset + bs.DataLength;
+
+            dst = std::copy(task.header.begin(), task.header.end(), dst);
+            for (mfxU32 i = 0; i < task.numPieces; i++)
+            {
+                int len = 0;
+                const mfxU8* piece = task.encoder.GetPieceData(i, &len);
+                dst = std::copy(piece, piece + len, dst);
+            }
+            std::copy(trailer.begin(), trailer.end(), dst);
+
+            bs.DataLength += size;
+        }
+    }
+
+    if (task.locked)
+    {
+        mfxStatus unlockSts = m_pCore->UnlockExternalFrame(task.surface->Data.MemId, &task.data);
+        if (sts == MFX_ERR_NONE)
+            sts = unlockSts;
+        task.locked = false;
+    }
+
+    m_pCore->DecreaseReference(*task.surface);
+
+    {
+        std::lock_guard<std::mutex> guard(m_guard);
+        m_freeTasks.emplace_back(&task);
+    }
+
+    MFX_CHECK_STS(sts);
+
+    return MFX_TASK_DONE;
+}
+
+MFX_PROPAGATE_GetSurface_VideoENCODE_Impl(MFXVideoENCODEMJPEG_SW)
+
+#endif // #if defined (MFX_ENABLE_MJPEG_VIDEO_ENCODE)
@@ -0,0 +1,350 @@
+// Copyright (c) 2025 Intel Corporation
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+// Throughput and quality of the software MJPEG encoder.
+// A synthetic picture is encoded with the default quantization tables scaled
+// to several quality levels, in one piece and in one piece per MCU row group
+// encoded by concurrent threads. Every stream is decoded back to measure PSNR.
+//
+// Usage:
+//   mjpeg_sw_encode_bench [width height [iterations]]
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <thread>
+#include <vector>
+
+#include "jpegenc.h"
+#include "jpegdec.h"
+
+struct BenchFormat
+{
+    const char* name;
+    JCOLOR      srcColor;
+    JSS         srcSampling;
+    JCOLOR      jpegColor;
+    JSS         jpegSampling;
+    int         bytesPerPixel; // luma plane or packed pixel
+};
+
+static const BenchFormat formats[] =
+{
+    { "NV12", JC_NV12,  JS_420,  JC_YCBCR, JS_420,  1 },
+    { "YUY2", JC_YCBCR, JS_422H, JC_YCBCR, JS_422H, 2 },
+    { "RGB4", JC_BGRA,  JS_444,  JC_RGB,   JS_444,  4 },
+};
+
+static const int qualities[] = { 50, 75, 90, 100 };
+
+struct Picture
+{
+    int                  width;
+    int                  height;
+    int                  pitch;
+    std::vector<uint8_t> data;   // luma or packed plane, then NV12 chroma plane
+};
+
+// smooth gradients with some noise, close to camera content
+static void FillPicture(Picture& pic)
+{
+    unsigned int seed = 12345;
+
+    for (size_t i = 0; i < pic.data.size(); i++)
+    {
+        int x = (int)(i % pic.pitch);
+        int y = (int)(i / pic.pitch);
+
+        seed = seed * 1103515245 + 12345;
+
+        double v = 128 + 90 * std::sin(x * 0.031 + y * 0.017) * std::cos(y * 0.023 - x * 0.007);
+        v += (int)((seed >> 16) & 7) - 4;
+
+        pic.data[i] = (uint8_t)std::min(255.0, std::max(0.0, v));
+    }
+
+    return;
+}
+
+static double Psnr(double sqErr, long count)
+{
+    if (!count || sqErr == 0)
+        return 99.99;
+
+    return 10 * std::log10(255.0 * 255.0 * count / sqErr);
+}
+
+static JERRCODE Encode(
+    const Picture&        pic,
+    const BenchFormat&    fmt,
+    int                   quality,
+    int                   numThreads,
+    std::vector<uint8_t>& out,
+    double&               seconds)
+{
+    CJPEGEncoder encoder;
+    JERRCODE     jerr;
+
+    mfxSize size = { pic.width, pic.height };
+    const uint8_t* pSrc[2] = { pic.data.data(), pic.data.data() + (size_t)pic.pitch * pic.height };
+    int srcStep[2] = { pic.pitch, pic.pitch };
+
+    bool isRGB     = (fmt.jpegColor == JC_RGB);
+    int  mcuWidth  = (fmt.jpegSampling == JS_444) ? 8 : 16;
+    int  restart   = (numThreads > 1) ? (pic.width + mcuWidth - 1) / mcuWidth : 0;
+
+    jerr = encoder.SetParams(fmt.jpegColor, fmt.jpegSampling, restart);
+    if (JPEG_OK != jerr)
+        return jerr;
+
+    jerr = encoder.SetSource(pSrc, srcStep, size, fmt.srcColor, fmt.srcSampling);
+    if (JPEG_OK != jerr)
+        return jerr;
+
+    jerr = encoder.InitQuantTable(0, DefaultLuminanceQuant, quality);
+    if (JPEG_OK != jerr)
+        return jerr;
+
+    jerr = encoder.InitQuantTable(1, DefaultChrominanceQuant, quality);
+    if (JPEG_OK != jerr)
+        return jerr;
+
+    encoder.InitHuffmanTable(0, DC, DefaultLuminanceDCBits, DefaultLuminanceDCValues);
+    encoder.InitHuffmanTable(0, AC, DefaultLuminanceACBits, DefaultLuminanceACValues);
+    encoder.InitHuffmanTable(1, DC, DefaultChrominanceDCBits, DefaultChrominanceDCValues);
+    encoder.InitHuffmanTable(1, AC, DefaultChrominanceACBits, DefaultChrominanceACValues);
+
+    for (int c = 0; c < 3; c++)
+    {
+        int id = (c && !isRGB) ? 1 : 0;
+        encoder.SetComponentTables(c, id, id);
+    }
+
+    out.clear();
+
+    jerr = encoder.WriteHeader(out);
+    if (JPEG_OK != jerr)
+        return jerr;
+
+    jerr = encoder.SetNumPieces(numThreads);
+    if (JPEG_OK != jerr)
+        return jerr;
+
+    int numPieces = encoder.GetNumPieces();
+    std::vector<JERRCODE> results(numPieces, JPEG_OK);
+
+    auto start = std::chrono::steady_clock::now();
+
+    if (numPieces > 1)
+    {
+        std::vector<std::thread> threads;
+        for (int i = 0; i < numPieces; i++)
+            threads.emplace_back([&encoder, &results, i]() { results[i] = encoder.EncodePiece(i); });
+
+        for (auto& thread : threads)
+            thread.join();
+    }
+    else
+    {
+        results[0] = encoder.EncodePiece(0);
+    }
+
+    seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    for (int i = 0; i < numPieces; i++)
+    {
+        if (JPEG_OK != results[i])
+            return results[i];
+
+        int len = 0;
+        const uint8_t* data = encoder.GetPieceData(i, &len);
+        out.insert(out.end(), data, data + len);
+    }
+
+    return encoder.WriteTrailer(out);
+}
+
+static JERRCODE Measure(
+    const Picture&              pic,
+    const BenchFormat&          fmt,
+    const std::vector<uint8_t>& stream,
+    double&                     psnr)
+{
+    CJPEGDecoder decoder;
+    JERRCODE     jerr;
+
+    int    width, height, nchannels, precision;
+    JCOLOR color;
+    JSS    sampling;
+
+    jerr = decoder.SetSource(stream.data(), (int)stream.size());
+    if (JPEG_OK != jerr)
+        return jerr;
+
+    jerr = decoder.ReadHeader(&width, &height, &nchannels, &color, &sampling, &precision);
+    if (JPEG_OK != jerr)
+        return jerr;
+
+    if (width != pic.width || height != pic.height)
+        return JPEG_ERR_PARAMS;
+
+    mfxSize size = { pic.width, pic.height };
+    int     pitch = pic.pitch;
+    std::vector<uint8_t> planes((size_t)pitch * pic.height * 2);
+
+    if (fmt.srcColor == JC_BGRA)
+    {
+        jerr = decoder.SetDestination(planes.data(), pitch, size, 4, JC_BGRA, JS_444);
+    }
+    else
+    {
+        uint8_t* pDst[4]    = { planes.data(), planes.data() + (size_t)pitch * pic.height, 0, 0 };
+        int      dstStep[4] = { pitch, pitch, 0, 0 };
+
+        jerr = decoder.SetDestination(pDst, dstStep, size, 2, JC_NV12, JS_420);
+    }
+    if (JPEG_OK != jerr)
+        return jerr;
+
+    // entropy coded data follows the SOS marker
+    size_t pos = 2;
+    while (pos + 3 < stream.size() && !(stream[pos] == 0xff && stream[pos + 1] == 0xda))
+        pos += 2 + ((stream[pos + 2] << 8) | stream[pos + 3]);
+    if (pos + 3 >= stream.size())
+        return JPEG_ERR_BUFF;
+
+    uint32_t interval = decoder.m_scans[0].jpeg_restart_interval;
+    uint32_t numIntervals = interval ? (decoder.m_numxMCU * decoder.m_numyMCU + interval - 1) / interval : 0;
+
+    decoder.SetSource(stream.data() + pos, (int)(stream.size() - pos));
+
+    jerr = decoder.ReadData(0, numIntervals);
+    if (JPEG_OK != jerr)
+        return jerr;
+
+    // luma of YUV formats, all color channels of RGB
+    double sqErr = 0;
+    long   count = 0;
+    int    channels = (fmt.srcColor == JC_BGRA) ? 4 : 1;
+    int    srcStep  = (fmt.srcColor == JC_BGRA) ? 1 : fmt.bytesPerPixel;
+
+    for (int y = 0; y < pic.height; y++)
+    {
+        const uint8_t* src = pic.data.data() + (size_t)y * pitch;
+        const uint8_t* dst = planes.data() + (size_t)y * pitch;
+
+        for (int x = 0; x < pic.width * channels; x++)
+        {
+            if (channels == 4 && (x & 3) == 3)
+                continue;
+
+            double d = (double)dst[x] - src[x * srcStep];
+            sqErr += d * d;
+            count++;
+        }
+    }
+
+    psnr = Psnr(sqErr, count);
+
+    return JPEG_OK;
+}
+
+int main(int argc, char* argv[])
+{
+    Picture pic;
+    pic.width  = 1920;
+    pic.height = 1080;
+
+    int iterations = 10;
+
+    if (argc == 3 || argc == 4)
+    {
+        pic.width  = atoi(argv[1]);
+        pic.height = atoi(argv[2]);
+        if (argc == 4)
+            iterations = atoi(argv[3]);
+    }
+    else if (argc != 1)
+    {
+        printf("usage: %s [width height [iterations]]\n", argv[0]);
+        return 1;
+    }
+
+    if (pic.width <= 0 || pic.height <= 0 || iterations <= 0)
+    {
+        printf("usage: %s [width height [iterations]]\n", argv[0]);
+        return 1;
+    }
+
+    pic.pitch = (pic.width * 4 + 63) & ~63;
+    pic.data.resize((size_t)pic.pitch * pic.height * 2);
+    FillPicture(pic);
+
+    int maxThreads = std::max(1, std::min((int)std::thread::hardware_concurrency(), 16));
+    std::vector<int> threadCounts = { 1 };
+    if (maxThreads > 1)
+        threadCounts.push_back(maxThreads);
+
+    printf("%dx%d, %d iterations, best time of each run\n", pic.width, pic.height, iterations);
+    printf("%-6s %7s %7s %10s %8s %8s\n", "format", "quality", "threads", "MPixel/s", "bpp", "PSNR");
+
+    int failures = 0;
+
+    for (const BenchFormat& fmt : formats)
+    {
+        for (int quality : qualities)
+        {
+            for (int numThreads : threadCounts)
+            {
+                std::vector<uint8_t> stream;
+                double best = 0;
+                JERRCODE jerr = JPEG_OK;
+
+                for (int i = 0; i < iterations && JPEG_OK == jerr; i++)
+                {
+                    double seconds = 0;
+                    jerr = Encode(pic, fmt, quality, numThreads, stream, seconds);
+                    if (!i || seconds < best)
+                        best = seconds;
+                }
+
+                double psnr = 0;
+                if (JPEG_OK == jerr)
+                    jerr = Measure(pic, fmt, stream, psnr);
+
+                if (JPEG_OK != jerr)
+                {
+                    printf("%-6s %7d %7d failed, error %d\n", fmt.name, quality, numThreads, (int)jerr);
+                    failures++;
+                    continue;
+                }
+
+                double pixels = (double)pic.width * pic.height;
+                printf("%-6s %7d %7d %10.1f %8.3f %8.2f\n", fmt.name, quality, numThreads,
+                    pixels / best * 1e-6, stream.size() * 8 / pixels, psnr);
+            }
+        }
+    }
+
+    return failures ? 1 : 0;
+}
@@ -40,8 +40,7 @@ mfxStatus TaskManager::ManagerInit()
     m_bufferSize         = GetBufferSize();
     m_maxParallelSubmits = GetMaxParallelSubmits();
     m_nTasksInExecution  = 0;
-    m_cachedBitstream    = {};
-    m_outputReady        = {};
+    m_cachedOutput.Reset(GetNumTask());
 
     return sts;
 }
@@ -335,8 +334,7 @@ void TaskManager::CancelTasks()
     m_nTasksInExecution = 0;
     m_nPicBuffered      = 0;
     m_nRecodeTasks      = 0;
-    m_cachedBitstream   = {};
-    m_outputReady       = {};
+    m_cachedOutput.Reset(GetNumTask());
 }
 
 mfxStatus TaskManager::ManagerReset(mfxU32 numTask)
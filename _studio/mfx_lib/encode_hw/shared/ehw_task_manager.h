@@ -49,13 +49,145 @@ namespace MfxEncodeHW
         }
     };
 
+    // Cached bitstreams indexed by frame order in a power-of-2 ring of slots.
+    // Orders in flight are bounded by the number of tasks, the ring grows on collision.
+    class CachedOutput
+    {
+    public:
+        void Reset(mfxU32 minSize)
+        {
+            mfxU32 size = 16;
+            while (size < minSize)
+                size <<= 1;
+
+            m_slots.clear();
+            m_slots.resize(size);
+        }
+
+        bool IsReady(mfxU32 order) const
+        {
+            const Slot* pSlot = Find(order);
+            return pSlot && pSlot->bReady;
+        }
+
+        void Push(mfxU32 order, CachedBitstream&& bs)
+        {
+            Slot& slot = Insert(order);
+
+            assert(!slot.bReady);
+
+            slot.bReady |= !bs.isHiden;
+            slot.bs.push_back(std::move(bs));
+        }
+
+        std::deque<CachedBitstream>& Get(mfxU32 order)
+        {
+            return Insert(order).bs;
+        }
+
+        void Clear(mfxU32 order)
+        {
+            Slot* pSlot = const_cast<Slot*>(Find(order));
+            if (!pSlot)
+                return;
+
+            pSlot->bs.clear();
+            pSlot->bUsed  = false;
+            pSlot->bReady = false;
+        }
+
+        mfxU32 PeekSize(mfxU32 order) const
+        {
+            const Slot* pSlot = Find(order);
+            mfxU32      size  = 0;
+
+            for (size_t i = 0; pSlot && i < pSlot->bs.size(); ++i)
+                size += pSlot->bs[i].BsDataLength;
+
+            return size;
+        }
+
+    private:
+        struct Slot
+        {
+            mfxU32                      order  = 0;
+            bool                        bUsed  = false;
+            bool                        bReady = false;
+            std::deque<CachedBitstream> bs;
+        };
+
+        const Slot* Find(mfxU32 order) const
+        {
+            if (m_slots.empty())
+                return nullptr;
+
+            const Slot& slot = m_slots[order & (m_slots.size() - 1)];
+            return (slot.bUsed && slot.order == order) ? &slot : nullptr;
+        }
+
+        Slot& Insert(mfxU32 order)
+        {
+            if (m_slots.empty())
+                Reset(0);
+
+            while (true)
+            {
+                Slot& slot = m_slots[order & (m_slots.size() - 1)];
+
+                if (!slot.bUsed)
+                {
+                    slot.order = order;
+                    slot.bUsed = true;
+                }
+
+                if (slot.order == order)
+                    return slot;
+
+                Grow();
+            }
+        }
+
+        void Grow()
+        {
+            size_t size = m_slots.size() * 2;
+            auto   NoCollisions = [&]()
+            {
+                std::vector<bool> bUsed(size, false);
+
+                for (auto& slot : m_slots)
+                {
+                    if (!slot.bUsed)
+                        continue;
+                    if (bUsed[slot.order & (size - 1)])
+                        return false;
+                    bUsed[slot.order & (size - 1)] = true;
+                }
+                return true;
+            };
+
+            while (!NoCollisions())
+                size *= 2;
+
+            std::vector<Slot> slots(size);
+
+            for (auto& slot : m_slots)
+            {
+                if (slot.bUsed)
+                    slots[slot.order & (size - 1)] = std::move(slot);
+            }
+
+            m_slots = std::move(slots);
+        }
+
+        std::vector<Slot> m_slots;
+    };
+
     using namespace MfxFeatureBlocks;
 
     class TaskManager
     {
     private:
-        std::map<mfxU32, std::deque<CachedBitstream>> m_cachedBitstream  = {};
-        std::map<mfxU32, bool>                        m_outputReady      = {};
+        CachedOutput                                  m_cachedOutput;
         std::mutex                                    m_mtx;
         std::condition_variable                       m_cv;
 
@@ -189,15 +321,19 @@ namespace MfxEncodeHW
 
         static TTaskIt    FirstTask     (TTaskIt begin, TTaskIt) { return begin; }
         static TTaskIt    EndTask       (TTaskIt, TTaskIt end) { return end; }
-        static TFnGetTask SimpleCheck   (std::function<bool(StorageR&)> cond)
+        // returned functors keep the condition by value, small ones fit into TFnGetTask w/o allocation
+        template<class TCond>
+        static TFnGetTask SimpleCheck   (TCond cond)
         {
-            using namespace std::placeholders;
-            return std::bind(std::find_if<TTaskIt, std::function<bool(StorageR&)>>, _1, _2, cond);
+            return [cond](TTaskIt begin, TTaskIt end) { return std::find_if(begin, end, cond); };
         }
         static TFnGetTask FixedTask(const StorageR& task)
         {
             auto pTask = &task;
-            return SimpleCheck([pTask](StorageR& b) { return &b == pTask; });
+            return [pTask](TTaskIt begin, TTaskIt end)
+            {
+                return std::find_if(begin, end, [pTask](StorageR& b) { return &b == pTask; });
+            };
         }
         mfxU16 Stage(mfxU16 s) { return m_stageID.at(s); }
         mfxU16 NextStage(mfxU16 s) { return Stage(s) + 1; }
@@ -221,42 +357,27 @@ namespace MfxEncodeHW
 
         bool IsCacheReady(mfxU32 order)
         {
-            return m_outputReady[order];
+            return m_cachedOutput.IsReady(order);
         }
 
         void PushBitstream(mfxU32 order, CachedBitstream&& bs)
         {
-            assert(!m_outputReady[order]);
-
-            m_cachedBitstream[order].push_back(bs);
-            if (!bs.isHiden)
-                m_outputReady[order] = true;
+            m_cachedOutput.Push(order, std::move(bs));
         }
 
         std::deque<CachedBitstream>& GetBitstreams(mfxU32 order)
         {
-           return m_cachedBitstream[order];
+           return m_cachedOutput.Get(order);
         }
 
         void ClearBitstreams(mfxU32 order)
         {
-            m_cachedBitstream.erase(order);
-            m_outputReady.erase(order);
+            m_cachedOutput.Clear(order);
         }
 
         mfxU32 PeekCachedSize(mfxU32 order) const
         {
-            auto it = m_cachedBitstream.find(order);
-            if (it == m_cachedBitstream.end())
-                return 0;
-
-            mfxU32 size = 0;
-            for (const auto& bs : it->second)
-            {
-                size += bs.BsDataLength;
-            }
-
-            return size;
+            return m_cachedOutput.PeekSize(order);
         }
 
     };
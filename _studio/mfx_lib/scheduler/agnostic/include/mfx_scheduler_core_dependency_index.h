@@ -0,0 +1,278 @@
+// Copyright (c) 2025 Intel Corporation
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#if !defined(__MFX_SCHEDULER_CORE_DEPENDENCY_INDEX_H)
+#define __MFX_SCHEDULER_CORE_DEPENDENCY_INDEX_H
+
+#include <mfxdefs.h>
+
+#include <stddef.h>
+#include <stdint.h>
+#include <vector>
+
+// Dependency index statistic
+struct MFX_DEPENDENCY_INDEX_STAT
+{
+    // Number of occupied dependency table entries
+    mfxU32 numItems;
+    // Peak number of occupied entries
+    mfxU32 maxItems;
+    // Number of hash look ups and slots examined by them
+    mfxU64 numLookups;
+    mfxU64 numProbes;
+    // The longest probe sequence
+    mfxU32 maxProbeLength;
+};
+
+// Pointer to dependency table entry index. It also allocates table entries.
+// Entries with the same pointer are chained in the ascending order, so the
+// first entry of a pointer is the one a linear table scan would find.
+// The class is not thread-safe, the scheduler guard protects it.
+class mfxDependencyIndex
+{
+public:
+    enum
+    {
+        INVALID_INDEX = 0xffffffff
+    };
+
+    mfxDependencyIndex(void)
+        : m_mask(0)
+        , m_shift(0)
+        , m_tableSize(0)
+        , m_stat()
+    {}
+
+    // Drop all entries, set the size of the dependency table
+    void Reset(mfxU32 tableSize)
+    {
+        mfxU32 numSlots = 2, bits = 1;
+
+        // keep the load factor not above 1/2
+        while (numSlots < 2 * tableSize)
+        {
+            numSlots <<= 1;
+            bits += 1;
+        }
+
+        m_slots.assign(numSlots, SLOT());
+        m_mask = numSlots - 1;
+        m_shift = 64 - bits;
+        m_next.assign(tableSize, (mfxU32) INVALID_INDEX);
+        m_tableSize = tableSize;
+
+        // all entries are free
+        m_free.assign((tableSize + 63) / 64, ~0ULL);
+        if (tableSize % 64)
+        {
+            m_free.back() = (1ULL << (tableSize % 64)) - 1;
+        }
+
+        m_stat = MFX_DEPENDENCY_INDEX_STAT();
+    }
+
+    // Get the first table entry of the pointer
+    mfxU32 Find(const void *p)
+    {
+        if (m_slots.empty())
+        {
+            return (mfxU32) INVALID_INDEX;
+        }
+
+        const SLOT &slot = m_slots[FindSlot(p)];
+
+        return (slot.p) ? (slot.idx) : ((mfxU32) INVALID_INDEX);
+    }
+
+    // Get the following table entry of the same pointer
+    mfxU32 Next(mfxU32 idx) const
+    {
+        return m_next[idx];
+    }
+
+    // Allocate the lowest free table entry for the pointer. Returns
+    // INVALID_INDEX, if the table is full.
+    mfxU32 Insert(const void *p)
+    {
+        mfxU32 idx = (mfxU32) INVALID_INDEX;
+
+        for (size_t word = 0; word < m_free.size(); word += 1)
+        {
+            if (m_free[word])
+            {
+                idx = (mfxU32) (word * 64 + __builtin_ctzll(m_free[word]));
+                m_free[word] &= m_free[word] - 1;
+                break;
+            }
+        }
+        if (INVALID_INDEX == idx)
+        {
+            return idx;
+        }
+
+        SLOT &slot = m_slots[FindSlot(p)];
+        if (nullptr == slot.p)
+        {
+            slot.p = p;
+            slot.idx = idx;
+            m_next[idx] = (mfxU32) INVALID_INDEX;
+        }
+        else if (idx < slot.idx)
+        {
+            m_next[idx] = slot.idx;
+            slot.idx = idx;
+        }
+        else
+        {
+            mfxU32 prev = slot.idx;
+
+            while ((INVALID_INDEX != m_next[prev]) && (m_next[prev] < idx))
+            {
+                prev = m_next[prev];
+            }
+            m_next[idx] = m_next[prev];
+            m_next[prev] = idx;
+        }
+
+        m_stat.numItems += 1;
+        if (m_stat.maxItems < m_stat.numItems)
+        {
+            m_stat.maxItems = m_stat.numItems;
+        }
+
+        return idx;
+    }
+
+    // Release the table entry of the pointer
+    void Remove(const void *p, mfxU32 idx)
+    {
+        if ((nullptr == p) || (m_tableSize <= idx) || (m_slots.empty()))
+        {
+            return;
+        }
+
+        const mfxU32 pos = FindSlot(p);
+        SLOT &slot = m_slots[pos];
+        if (nullptr == slot.p)
+        {
+            return;
+        }
+
+        if (slot.idx == idx)
+        {
+            slot.idx = m_next[idx];
+            if (INVALID_INDEX == slot.idx)
+            {
+                EraseSlot(pos);
+            }
+        }
+        else
+        {
+            mfxU32 prev = slot.idx;
+
+            while ((INVALID_INDEX != m_next[prev]) && (m_next[prev] != idx))
+            {
+                prev = m_next[prev];
+            }
+            if (INVALID_INDEX == m_next[prev])
+            {
+                return;
+            }
+            m_next[prev] = m_next[idx];
+        }
+
+        m_next[idx] = (mfxU32) INVALID_INDEX;
+        m_free[idx / 64] |= 1ULL << (idx % 64);
+        m_stat.numItems -= 1;
+    }
+
+    const MFX_DEPENDENCY_INDEX_STAT &GetStat(void) const
+    {
+        return m_stat;
+    }
+
+protected:
+    struct SLOT
+    {
+        SLOT(void) : p(nullptr), idx(INVALID_INDEX) {}
+
+        const void *p;
+        mfxU32 idx;
+    };
+
+    mfxU32 GetHomeSlot(const void *p) const
+    {
+        // Fibonacci hashing, pointers are aligned and need mixing
+        return (mfxU32) (((uint64_t) (uintptr_t) p * 0x9E3779B97F4A7C15ULL) >> m_shift) & m_mask;
+    }
+
+    // Get the slot of the pointer or the empty slot to put it to
+    mfxU32 FindSlot(const void *p)
+    {
+        mfxU32 pos = GetHomeSlot(p);
+        mfxU32 probeLength = 1;
+
+        while ((m_slots[pos].p) && (m_slots[pos].p != p))
+        {
+            pos = (pos + 1) & m_mask;
+            probeLength += 1;
+        }
+
+        m_stat.numLookups += 1;
+        m_stat.numProbes += probeLength;
+        if (m_stat.maxProbeLength < probeLength)
+        {
+            m_stat.maxProbeLength = probeLength;
+        }
+
+        return pos;
+    }
+
+    // Remove the slot keeping probe sequences unbroken (backward shift)
+    void EraseSlot(mfxU32 hole)
+    {
+        for (mfxU32 pos = (hole + 1) & m_mask; m_slots[pos].p; pos = (pos + 1) & m_mask)
+        {
+            const mfxU32 home = GetHomeSlot(m_slots[pos].p);
+
+            // the slot may move to the hole, if the hole is between its home and it
+            if (((pos - home) & m_mask) >= ((pos - hole) & m_mask))
+            {
+                m_slots[hole] = m_slots[pos];
+                hole = pos;
+            }
+        }
+
+        m_slots[hole] = SLOT();
+    }
+
+    std::vector<SLOT> m_slots;
+    mfxU32 m_mask;
+    mfxU32 m_shift;
+    mfxU32 m_tableSize;
+    // next entry with the same pointer
+    std::vector<mfxU32> m_next;
+    // bit mask of free table entries
+    std::vector<uint64_t> m_free;
+
+    MFX_DEPENDENCY_INDEX_STAT m_stat;
+};
+
+#endif // !defined(__MFX_SCHEDULER_CORE_DEPENDENCY_INDEX_H)
@@ -0,0 +1,240 @@
+// Copyright (c) 2025 Intel Corporation
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#if !defined(__MFX_SCHEDULER_CORE_READY_TASKS_H)
+#define __MFX_SCHEDULER_CORE_READY_TASKS_H
+
+#include <mfx_scheduler_core_handle.h>
+#include <mfx_task.h>
+
+#include <atomic>
+#include <memory>
+#include <vector>
+
+// Ready tasks hints for the MFX_SCHEDULER_WORK_STEALING mode.
+// Queues keep handles of tasks, which were found ready to run. A handle is
+// only a hint: the task is re-checked and assigned under the scheduler guard,
+// so stale and duplicated handles are dropped on claim.
+
+// Bounded Chase-Lev deque. Push and Pop are called by the owning thread only,
+// Steal is called by any thread.
+class mfxWorkStealingDeque
+{
+public:
+    enum
+    {
+        CAPACITY = 256
+    };
+
+    mfxWorkStealingDeque(void)
+        : m_top(0)
+        , m_bottom(0)
+    {
+        for (auto & slot : m_slots)
+            slot.store(0, std::memory_order_relaxed);
+    }
+
+    bool Push(size_t handle)
+    {
+        const int64_t bottom = m_bottom.load(std::memory_order_relaxed);
+        const int64_t top = m_top.load(std::memory_order_acquire);
+
+        if (bottom - top >= CAPACITY)
+            return false;
+
+        m_slots[bottom & (CAPACITY - 1)].store(handle, std::memory_order_relaxed);
+        m_bottom.store(bottom + 1, std::memory_order_release);
+        return true;
+    }
+
+    // take the most recently pushed handle
+    bool Pop(size_t &handle)
+    {
+        const int64_t bottom = m_bottom.load(std::memory_order_relaxed) - 1;
+        m_bottom.store(bottom, std::memory_order_seq_cst);
+        int64_t top = m_top.load(std::memory_order_seq_cst);
+
+        if (top > bottom)
+        {
+            // the deque is empty
+            m_bottom.store(bottom + 1, std::memory_order_relaxed);
+            return false;
+        }
+
+        handle = m_slots[bottom & (CAPACITY - 1)].load(std::memory_order_relaxed);
+        if (top == bottom)
+        {
+            // the last element, race with thieves
+            const bool bWon = m_top.compare_exchange_strong(top, top + 1,
+                std::memory_order_seq_cst, std::memory_order_relaxed);
+            m_bottom.store(bottom + 1, std::memory_order_relaxed);
+            return bWon;
+        }
+
+        return true;
+    }
+
+    // take the oldest handle
+    bool Steal(size_t &handle)
+    {
+        int64_t top = m_top.load(std::memory_order_seq_cst);
+        const int64_t bottom = m_bottom.load(std::memory_order_seq_cst);
+
+        if (top >= bottom)
+            return false;
+
+        handle = m_slots[top & (CAPACITY - 1)].load(std::memory_order_relaxed);
+        return m_top.compare_exchange_strong(top, top + 1,
+            std::memory_order_seq_cst, std::memory_order_relaxed);
+    }
+
+    bool IsEmpty(void) const
+    {
+        return m_top.load(std::memory_order_relaxed) >= m_bottom.load(std::memory_order_relaxed);
+    }
+
+protected:
+    alignas(64) std::atomic<int64_t> m_top;
+    alignas(64) std::atomic<int64_t> m_bottom;
+    alignas(64) std::atomic<size_t> m_slots[CAPACITY];
+};
+
+// Bounded multi-producer multi-consumer queue (D. Vyukov)
+class mfxReadyTaskQueue
+{
+public:
+    enum
+    {
+        CAPACITY = MFX_MAX_NUMBER_TASK
+    };
+
+    mfxReadyTaskQueue(void)
+        : m_enqueuePos(0)
+        , m_dequeuePos(0)
+    {
+        for (size_t i = 0; i < CAPACITY; i += 1)
+        {
+            m_cells[i].sequence.store(i, std::memory_order_relaxed);
+            m_cells[i].handle = 0;
+        }
+    }
+
+    bool Push(size_t handle)
+    {
+        size_t pos = m_enqueuePos.load(std::memory_order_relaxed);
+
+        for (;;)
+        {
+            Cell &cell = m_cells[pos & (CAPACITY - 1)];
+            const size_t sequence = cell.sequence.load(std::memory_order_acquire);
+            const intptr_t diff = (intptr_t) sequence - (intptr_t) pos;
+
+            if (0 == diff)
+            {
+                if (m_enqueuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+                {
+                    cell.handle = handle;
+                    cell.sequence.store(pos + 1, std::memory_order_release);
+                    return true;
+                }
+            }
+            else if (diff < 0)
+            {
+                // the queue is full
+                return false;
+            }
+            else
+            {
+                pos = m_enqueuePos.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    bool Pop(size_t &handle)
+    {
+        size_t pos = m_dequeuePos.load(std::memory_order_relaxed);
+
+        for (;;)
+        {
+            Cell &cell = m_cells[pos & (CAPACITY - 1)];
+            const size_t sequence = cell.sequence.load(std::memory_order_acquire);
+            const intptr_t diff = (intptr_t) sequence - (intptr_t) (pos + 1);
+
+            if (0 == diff)
+            {
+                if (m_dequeuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+                {
+                    handle = cell.handle;
+                    cell.sequence.store(pos + CAPACITY, std::memory_order_release);
+                    return true;
+                }
+            }
+            else if (diff < 0)
+            {
+                // the queue is empty
+                return false;
+            }
+            else
+            {
+                pos = m_dequeuePos.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    bool IsEmpty(void) const
+    {
+        return m_dequeuePos.load(std::memory_order_relaxed) >= m_enqueuePos.load(std::memory_order_relaxed);
+    }
+
+protected:
+    struct Cell
+    {
+        std::atomic<size_t> sequence;
+        size_t handle;
+    };
+
+    alignas(64) std::atomic<size_t> m_enqueuePos;
+    alignas(64) std::atomic<size_t> m_dequeuePos;
+    alignas(64) Cell m_cells[CAPACITY];
+};
+
+// All ready tasks hints of a scheduler
+struct MFX_SCHEDULER_READY_TASKS
+{
+    explicit
+    MFX_SCHEDULER_READY_TASKS(mfxU32 numThreads)
+        : workerTasks(numThreads * MFX_PRIORITY_NUMBER)
+        , priorityMask((1 << MFX_PRIORITY_NUMBER) - 1)
+    {}
+
+    mfxWorkStealingDeque &WorkerTasks(mfxU32 threadNum, int priority)
+    {
+        return workerTasks[threadNum * MFX_PRIORITY_NUMBER + priority];
+    }
+
+    // software tasks made ready by a worker thread, owned by that thread
+    std::vector<mfxWorkStealingDeque> workerTasks;
+    // tasks made ready outside of worker threads and all hardware tasks
+    mfxReadyTaskQueue injectedTasks[MFX_PRIORITY_NUMBER][MFX_TYPE_NUMBER];
+    // bit per priority, which has not utilized its TaskPriorityRatio share yet
+    std::atomic<mfxU32> priorityMask;
+};
+
+#endif // !defined(__MFX_SCHEDULER_CORE_READY_TASKS_H)
@@ -118,6 +118,9 @@ struct MFX_SCHEDULER_TASK : public mfxDependencyItem<MFX_TASK_NUM_DEPENDENCIES>
 
         // task timing parameters
         bool bWaiting;                                              // (bool) task needs some waiting
+        bool bWaitingHwEvent;                                       // (bool) waiting task is resumed by the owner's HW event
+        mfxU32 waitingThreadNum;                                    // (mfxU32) scheduler thread, which got the 'busy' status
+        mfxU32 statSlot;                                            // (mfxU32) statistics slot of the task's owner
         struct
         {
             // Time in msec of the last 'entering' to the task
@@ -132,6 +135,8 @@ struct MFX_SCHEDULER_TASK : public mfxDependencyItem<MFX_TASK_NUM_DEPENDENCIES>
             mfxU64 timeOverhead;
             // HW counter value of the last 'entering' to the task
             mfxU64 hwCounterLastEnter;
+            // Time stamp of adding the task
+            mfxU64 timeSubmitted;
         } timing;
 
         // source file info
@@ -22,6 +22,8 @@
 #include <mfx_scheduler_core_task.h>
 #include <mfx_trace.h>
 
+#include <algorithm>
+
 // declare the static section of the file
 namespace
 {
@@ -217,6 +219,98 @@ mfxStatus mfxSchedulerCore::GetTask(MFX_CALL_INFO &callInfo,
 
 } // mfxStatus mfxSchedulerCore::GetTask(MFX_CALL_INFO &callInfo,
 
+mfxStatus mfxSchedulerCore::GetReadyTask(MFX_CALL_INFO &callInfo,
+                                         const mfxU32 threadNum,
+                                         std::unique_lock<std::mutex> &guard)
+{
+    if (!m_pReadyTasks)
+    {
+        return MFX_ERR_NOT_FOUND;
+    }
+
+    MFX_AUTO_TRACE(__FUNCTION__);
+
+    MFX_SCHEDULER_READY_TASKS &readyTasks = *m_pReadyTasks;
+    const mfxU32 priorityMask = readyTasks.priorityMask.load(std::memory_order_relaxed);
+
+    // hints are taken outside of the protected section,
+    // only assigning of the task requires it.
+    guard.unlock();
+
+    auto claim = [&](size_t value)
+    {
+        mfxTaskHandle handle;
+
+        handle.handle = value;
+        guard.lock();
+        if (MFX_ERR_NONE == ClaimReadyTask(callInfo, handle, threadNum))
+        {
+            return true;
+        }
+        guard.unlock();
+        return false;
+    };
+
+    // the same runs as GetTask does: on the 1st run priorities, which
+    // utilized their share of CPU time, are skipped.
+    for (mfxU32 run = 0; run < NUMBER_OF_RUNS; run += 1)
+    {
+        for (int priority = MFX_PRIORITY_HIGH; priority >= MFX_PRIORITY_LOW; priority -= 1)
+        {
+            const bool bShareUtilized = (0 == (priorityMask & (1 << priority)));
+
+            if ((PRIORITY_RUN == run) == bShareUtilized)
+            {
+                continue;
+            }
+
+            size_t value;
+
+            // only the dedicated thread takes hardware tasks
+            if (0 == threadNum)
+            {
+                while (readyTasks.injectedTasks[priority][MFX_TYPE_HARDWARE].Pop(value))
+                {
+                    if (claim(value))
+                        return MFX_ERR_NONE;
+                }
+            }
+
+            // own tasks are taken in LIFO order, they are likely hot in the cache
+            mfxWorkStealingDeque &ownTasks = readyTasks.WorkerTasks(threadNum, priority);
+            while (ownTasks.Pop(value))
+            {
+                if (claim(value))
+                    return MFX_ERR_NONE;
+            }
+
+            while (readyTasks.injectedTasks[priority][MFX_TYPE_SOFTWARE].Pop(value))
+            {
+                if (claim(value))
+                    return MFX_ERR_NONE;
+            }
+
+            // steal the oldest tasks from other threads
+            for (mfxU32 i = 1; i < m_param.numberOfThreads; i += 1)
+            {
+                mfxWorkStealingDeque &otherTasks =
+                    readyTasks.WorkerTasks((threadNum + i) % m_param.numberOfThreads, priority);
+
+                while (otherTasks.Steal(value))
+                {
+                    if (claim(value))
+                        return MFX_ERR_NONE;
+                }
+            }
+        }
+    }
+
+    guard.lock();
+
+    return MFX_ERR_NOT_FOUND;
+
+} // mfxStatus mfxSchedulerCore::GetReadyTask(MFX_CALL_INFO &callInfo,
+
 mfxStatus mfxSchedulerCore::CanContinuePreviousTask(MFX_CALL_INFO &callInfo,
                                                     mfxTaskHandle previousTask,
                                                     const mfxU32 threadNum)
@@ -312,6 +406,16 @@ bool mfxSchedulerCore::IsReadyToRun(MFX_SCHEDULER_TASK *pTask)
                     return false;
                 }
             }
+        } else if (pTask->param.bWaitingHwEvent && m_bHwEventReactor) {
+            // the task sleeps until a HW event comes after its last call,
+            // the timer only limits waiting for a lost event.
+            if (GetHWEventCounter() == pTask->param.timing.hwCounterLastEnter) {
+                mfxU64 time = GetHighPerformanceCounter() - pTask->param.timing.timeLastEnter;
+
+                if ((mfxU64) m_timer_hw_event * 1000 > time) {
+                    return false;
+                }
+            }
         }
     }
     return true;
@@ -358,6 +462,11 @@ mfxStatus mfxSchedulerCore::WrapUpTask(MFX_CALL_INFO &callInfo,
     pTask->param.occupancy += 1;
     pTask->param.threadMask |= (1LL << callInfo.threadNum);
 
+    if (0 == pTask->param.numberOfCalls)
+    {
+        RecordStat(pTask->param.statSlot, MFX_SCHEDULER_STAT_SUBMIT_TO_START,
+                   m_currentTimeStamp - pTask->param.timing.timeSubmitted);
+    }
     pTask->param.numberOfCalls += 1;
 
     // update the task's timing
@@ -410,9 +519,97 @@ void mfxSchedulerCore::ResetWaitingTasks(const void *pOwner)
 
 } // void mfxSchedulerCore::ResetWaitingTasks(const void *pOwner)
 
+bool mfxSchedulerCore::IsHwEventOwner(const void *pOwner) const
+{
+    for (const MFX_HW_EVENT &event : m_hwEvents)
+    {
+        if (event.pOwner == pOwner)
+        {
+            return true;
+        }
+    }
+
+    return false;
+
+} // bool mfxSchedulerCore::IsHwEventOwner(const void *pOwner) const
+
+void mfxSchedulerCore::OnHwEvent(const void *pOwner)
+{
+    //
+    // THE EXECUTION IS ALREADY IN SECURE SECTION.
+    // Just do what need to do.
+    //
+
+    ForEachTask(
+        [this, pOwner](MFX_SCHEDULER_TASK *pTask)
+        {
+            if ((pTask->param.task.pOwner != pOwner) ||
+                (false == pTask->param.bWaiting) ||
+                (false == pTask->param.bWaitingHwEvent))
+            {
+                return;
+            }
+
+            pTask->param.bWaiting = false;
+            if (false == IsReadyToRun(pTask))
+            {
+                return;
+            }
+
+            PublishReadyTask(pTask);
+
+            if (MFX_TASK_DEDICATED & pTask->param.task.threadingPolicy)
+            {
+                WakeUpThreads(1, 0);
+                return;
+            }
+
+            // wake up the thread, which was running the task
+            MFX_SCHEDULER_THREAD_CONTEXT *pContext = GetThreadCtx(pTask->param.waitingThreadNum);
+            if (MFX_SCHEDULER_THREAD_CONTEXT::Waiting == pContext->state)
+            {
+                pContext->taskAdded.notify_one();
+            }
+            else
+            {
+                WakeUpThreads(0, 1);
+            }
+        }
+    );
+
+} // void mfxSchedulerCore::OnHwEvent(const void *pOwner)
+
+void mfxSchedulerCore::WakeUpHwEventWaiters(void)
+{
+    bool bWaiters = false;
+
+    ForEachTaskWhile(
+        [&bWaiters](MFX_SCHEDULER_TASK *pTask)
+        {
+            bWaiters = (MFX_TASK_NEED_CONTINUE == pTask->curStatus) &&
+                       (pTask->param.bWaiting) &&
+                       (pTask->param.bWaitingHwEvent);
+            return !bWaiters;
+        }
+    );
+
+    if (bWaiters)
+    {
+        WakeUpThreads();
+    }
+
+} // void mfxSchedulerCore::WakeUpHwEventWaiters(void)
+
 void mfxSchedulerCore::OnDependencyResolved(MFX_SCHEDULER_TASK *pTask)
 {
+    if (pTask->IsDependenciesResolved()) {
+        RecordStat(pTask->param.statSlot, MFX_SCHEDULER_STAT_DEPENDENCY_WAIT,
+                   GetHighPerformanceCounter() - pTask->param.timing.timeSubmitted);
+    }
+
     if (IsReadyToRun(pTask)) {
+        PublishReadyTask(pTask);
+
         if (MFX_TASK_DEDICATED & pTask->param.task.threadingPolicy) {
             m_DedicatedThreadsToWakeUp += pTask->param.task.entryPoint.requiredNumThreads;
         } else {
@@ -421,13 +618,101 @@ void mfxSchedulerCore::OnDependencyResolved(MFX_SCHEDULER_TASK *pTask)
     }
 }
 
+void mfxSchedulerCore::PublishReadyTask(MFX_SCHEDULER_TASK *pTask)
+{
+    if (!m_pReadyTasks)
+    {
+        return;
+    }
+
+    //
+    // THE EXECUTION IS ALREADY IN SECURE SECTION.
+    // Just do what need to do.
+    //
+
+    MFX_SCHEDULER_READY_TASKS &readyTasks = *m_pReadyTasks;
+    const int priority = pTask->param.task.priority;
+    mfxTaskHandle handle;
+
+    handle.handle = 0;
+    handle.taskID = pTask->taskID;
+    handle.jobID = pTask->jobID;
+
+    if (MFX_TASK_DEDICATED & pTask->param.task.threadingPolicy)
+    {
+        readyTasks.injectedTasks[priority][MFX_TYPE_HARDWARE].Push(handle.handle);
+        return;
+    }
+
+    // a scheduler thread keeps tasks it made ready,
+    // other threads can steal them.
+    if ((m_pCurrentThreadCtx) &&
+        (this == m_pCurrentThreadCtx->pSchedulerCore) &&
+        (readyTasks.WorkerTasks(m_pCurrentThreadCtx->threadNum, priority).Push(handle.handle)))
+    {
+        return;
+    }
+
+    // a full queue loses the hint only, GetTask still finds the task
+    readyTasks.injectedTasks[priority][MFX_TYPE_SOFTWARE].Push(handle.handle);
+
+} // void mfxSchedulerCore::PublishReadyTask(MFX_SCHEDULER_TASK *pTask)
+
+void mfxSchedulerCore::UpdateReadyTasksPriorityMask(void)
+{
+    mfxU64 totalTimeSpent[MFX_PRIORITY_NUMBER], timeSpent[MFX_PRIORITY_NUMBER];
+    mfxU32 priorityMask = 0;
+
+    GetTimeStat(timeSpent, totalTimeSpent);
+
+    for (int priority = MFX_PRIORITY_LOW; priority < MFX_PRIORITY_NUMBER; priority += 1)
+    {
+        if (TaskPriorityRatio[priority] * totalTimeSpent[priority] >=
+            100 * timeSpent[priority])
+        {
+            priorityMask |= 1 << priority;
+        }
+    }
+
+    m_pReadyTasks->priorityMask.store(priorityMask, std::memory_order_relaxed);
+
+} // void mfxSchedulerCore::UpdateReadyTasksPriorityMask(void)
+
+mfxStatus mfxSchedulerCore::ClaimReadyTask(MFX_CALL_INFO &callInfo,
+                                           mfxTaskHandle handle,
+                                           const mfxU32 threadNum)
+{
+    //
+    // THE EXECUTION IS ALREADY IN SECURE SECTION.
+    // Just do what need to do.
+    //
+
+    // get the current time stamp
+    m_currentTimeStamp = GetHighPerformanceCounter();
+
+    // the hint may be outdated, the task is checked again
+    mfxStatus mfxRes = CanContinuePreviousTask(callInfo, handle, threadNum);
+    if (MFX_ERR_NONE == mfxRes)
+    {
+        MFX_SCHEDULER_TASK *pTask = m_ppTaskLookUpTable[handle.taskID];
+
+        // let other threads join the task
+        if (IsReadyToRun(pTask))
+        {
+            PublishReadyTask(pTask);
+        }
+    }
+
+    return mfxRes;
+
+} // mfxStatus mfxSchedulerCore::ClaimReadyTask(MFX_CALL_INFO &callInfo,
+
 void mfxSchedulerCore::MarkTaskCompleted(const MFX_CALL_INFO *pCallInfo,
                                          const mfxU32 threadNum)
 {
     MFX_AUTO_TRACE(__FUNCTION__);
 
     (void)pCallInfo;
-    (void)threadNum;
 
     MFX_SCHEDULER_TASK *pTask = nullptr;
     pTask = m_ppTaskLookUpTable.at(pCallInfo->taskHandle.taskID);
@@ -503,6 +788,8 @@ void mfxSchedulerCore::MarkTaskCompleted(const MFX_CALL_INFO *pCallInfo,
         if (pTask->param.timing.timeLastCallProcessed <= pCallInfo->timeStamp)
         {
             pTask->param.bWaiting = true;
+            pTask->param.bWaitingHwEvent = IsHwEventOwner(pCallInfo->pTask->pOwner);
+            pTask->param.waitingThreadNum = threadNum;
         }
         pTask->param.timing.timeOverhead += pCallInfo->timeSpend;
     }
@@ -526,6 +813,8 @@ void mfxSchedulerCore::MarkTaskCompleted(const MFX_CALL_INFO *pCallInfo,
             // store TaskId for tracing event
             nTraceTaskId = pCallInfo->pTask->nTaskId;
 
+            RecordStat(pTask->param.statSlot, MFX_SCHEDULER_STAT_RUN, pTask->param.timing.timeSpent);
+
             // get entry point parameters to call FreeResources
             MFX_ENTRY_POINT &entryPoint = pTask->param.task.entryPoint;
 
@@ -582,7 +871,8 @@ void mfxSchedulerCore::MarkTaskCompleted(const MFX_CALL_INFO *pCallInfo,
                 {
                     mfxU32 idx = pTask->param.dependencies.dstIdx[i];
 
-                    m_pDependencyTable.at(idx).p = nullptr;
+                    m_dependencyIndex.Remove(m_pDependencyTable.at(idx).p, idx);
+                    m_pDependencyTable[idx].p = nullptr;
                 }
             }
 
@@ -596,6 +886,17 @@ void mfxSchedulerCore::MarkTaskCompleted(const MFX_CALL_INFO *pCallInfo,
         }
     }
 
+    if (m_pReadyTasks)
+    {
+        UpdateReadyTasksPriorityMask();
+
+        // the thread continues the task, unless other task is more urgent
+        if (IsReadyToRun(pTask))
+        {
+            PublishReadyTask(pTask);
+        }
+    }
+
     // wake up additional threads for this task and tasks dependent
     if (m_DedicatedThreadsToWakeUp || m_RegularThreadsToWakeUp) {
         WakeUpThreads(m_DedicatedThreadsToWakeUp, m_RegularThreadsToWakeUp);
@@ -617,6 +918,55 @@ void mfxSchedulerCore::MarkTaskCompleted(const MFX_CALL_INFO *pCallInfo,
 
 } // void mfxSchedulerCore::MarkTaskCompleted(mfxTaskHandle handle,
 
+mfxU32 mfxSchedulerCore::GetStatSlot(const void *pOwner)
+{
+    mfxU32 slot;
+
+    for (slot = 0; slot < m_numStatOwners; slot += 1)
+    {
+        if (m_statOwners[slot] == pOwner)
+        {
+            return slot;
+        }
+    }
+
+    if (m_numStatOwners < MFX_SCHEDULER_STAT_OWNERS - 1)
+    {
+        m_statOwners[m_numStatOwners] = pOwner;
+        return m_numStatOwners++;
+    }
+
+    // the last slot is shared by the rest owners
+    return MFX_SCHEDULER_STAT_OWNERS - 1;
+
+} // mfxU32 mfxSchedulerCore::GetStatSlot(const void *pOwner)
+
+void mfxSchedulerCore::RecordStat(mfxU32 statSlot, mfxSchedulerStatKind kind, mfxU64 time)
+{
+    //
+    // THE EXECUTION IS ALREADY IN SECURE SECTION.
+    // Just do what need to do.
+    //
+
+    if (m_stat.empty())
+    {
+        return;
+    }
+
+    // scheduler's threads write own statistics to not share cache lines,
+    // the last set is for application's threads
+    const mfxU32 threadNum = (m_pCurrentThreadCtx && (this == m_pCurrentThreadCtx->pSchedulerCore)) ?
+                             (m_pCurrentThreadCtx->threadNum) :
+                             (m_param.numberOfThreads);
+    MFX_LATENCY_HISTOGRAM &histogram = m_stat[threadNum * MFX_SCHEDULER_STAT_OWNERS + statSlot].latency[kind];
+
+    histogram.count += 1;
+    histogram.sum += time;
+    histogram.max = std::max(histogram.max, time);
+    histogram.buckets[GetLatencyBucket(time)] += 1;
+
+} // void mfxSchedulerCore::RecordStat(mfxU32 statSlot, mfxSchedulerStatKind kind, mfxU64 time)
+
 // update dependencies produced from the dependency table
 void mfxSchedulerCore::ResolveDependencyTable(MFX_SCHEDULER_TASK *pTask)
 {
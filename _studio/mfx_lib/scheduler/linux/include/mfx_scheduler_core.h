@@ -26,9 +26,12 @@
 #include <mfx_scheduler_core_thread.h>
 #include <mfx_scheduler_core_handle.h>
 #include <mfx_scheduler_core_task.h>
+#include <mfx_scheduler_core_ready_tasks.h>
+#include <mfx_scheduler_core_dependency_index.h>
 
 #include <mfx_task.h>
 
+#include <memory>
 #include <vector>
 
 #include "mfx_common.h"
@@ -114,7 +117,7 @@ enum eWakeUpReason
 };
 
 
-class mfxSchedulerCore : public MFXIScheduler2
+class mfxSchedulerCore : public MFXIScheduler2, public MFXISchedulerStat
 {
 public:
     // Default constructor
@@ -206,6 +209,31 @@ public:
     // WA for SINGLE THREAD MODE
     virtual
     mfxStatus GetTimeout(mfxU32 & maxTimeToRun);
+
+    // Register an eventfd signaled by the owner on HW completion
+    virtual
+    mfxStatus RegisterHwEvent(const void *pOwner, int eventFd);
+
+    // Stop listening to HW completion events of the owner
+    virtual
+    mfxStatus UnregisterHwEvent(const void *pOwner);
+
+    // Set NUMA node of the device and re-bind threads placed on it
+    virtual
+    mfxStatus SetDeviceNode(mfxI32 deviceNode);
+
+    //
+    // MFXISchedulerStat interface
+    //
+
+    virtual
+    mfxStatus GetStat(const void *pOwner, MFX_SCHEDULER_STAT *pStat);
+
+    virtual
+    mfxStatus GetStatOwners(const void **ppOwners, mfxU32 *pNumOwners);
+
+    virtual
+    mfxStatus ResetStat(void);
 protected:
     // Destructor is protected to avoid deletion the object by occasion.
     virtual
@@ -272,10 +300,24 @@ protected:
 
     inline void call_pRoutine(MFX_CALL_INFO& call);
 
+    // Add the task to the ready tasks hints (MFX_SCHEDULER_WORK_STEALING mode)
+    void PublishReadyTask(MFX_SCHEDULER_TASK *pTask);
+    // Update priorities, which have not utilized their share of CPU time
+    void UpdateReadyTasksPriorityMask(void);
+    // Assign the task taken from the ready tasks hints
+    mfxStatus ClaimReadyTask(MFX_CALL_INFO &callInfo,
+                             mfxTaskHandle handle,
+                             const mfxU32 threadNum);
+
     //
     // End of thread-unsafe functions declarations.
     //
 
+    // Provide a task for an internal thread from the ready tasks hints.
+    // The guard is left while looking for hints and is held on return.
+    mfxStatus GetReadyTask(MFX_CALL_INFO &callInfo,
+                           const mfxU32 threadNum,
+                           std::unique_lock<std::mutex> &guard);
     // Provide a task for an internal thread
     mfxStatus GetTask(MFX_CALL_INFO &callInfo,
                       mfxTaskHandle previousTask,
@@ -285,6 +327,12 @@ protected:
                            const mfxU32 threadNum);
     // Reset 'waiting' state for tasks with given owner
     void ResetWaitingTasks(const void *pOwner);
+    // Check if the owner registered a HW completion event
+    bool IsHwEventOwner(const void *pOwner) const;
+    // Resume tasks waiting for the owner's HW event
+    void OnHwEvent(const void *pOwner);
+    // Wake up threads, if there are tasks waiting for a HW event
+    void WakeUpHwEventWaiters(void);
     // Managing HW event counter functions
     inline
     void IncrementHWEventCounter(void);
@@ -297,8 +345,19 @@ protected:
     // Sets scheduling for the specified thread
     bool SetScheduling(std::thread& handle);
 
+    // Read NUMA nodes and CPUs available to the process from sysfs
+    void LoadCpuTopology(void);
     // Assign socket affinity for every thread
     void SetThreadsAffinityToSockets(void);
+    // Count CPU and NUMA node changes of the thread
+    void UpdateMigrationStat(MFX_SCHEDULER_THREAD_CONTEXT *pContext);
+    // Get NUMA node of the CPU
+    mfxU32 GetCpuNode(mfxI32 cpu) const;
+
+    // Get statistics slot of the owner, register the owner if needed
+    mfxU32 GetStatSlot(const void *pOwner);
+    // Add the latency into the statistics of the current thread
+    void RecordStat(mfxU32 statSlot, mfxSchedulerStatKind kind, mfxU64 time);
 
     inline MFX_SCHEDULER_THREAD_CONTEXT* GetThreadCtx(mfxU32 thread_id)
     { return &m_pThreadCtx[thread_id]; }
@@ -362,6 +421,8 @@ protected:
     mfxStatus StartWakeUpThread(void);
     // Stop and terminate the wake up thread
     mfxStatus StopWakeUpThread(void);
+    // Release epoll and control event of the wake up thread
+    void CloseHwEventPoll(void);
 
     // 'quit' flag for threads
     volatile
@@ -372,6 +433,24 @@ protected:
     // Threads contexts
     MFX_SCHEDULER_THREAD_CONTEXT *m_pThreadCtx;
 
+    // CPUs of NUMA nodes, which the process is allowed to run on
+    std::vector<std::vector<mfxU32>> m_nodeCpus;
+    // NUMA node of every CPU
+    std::vector<mfxU32> m_cpuToNode;
+
+    enum
+    {
+        // number of owners with own statistics, others share the last slot
+        MFX_SCHEDULER_STAT_OWNERS = 8
+    };
+
+    // Owners of statistics slots
+    const void *m_statOwners[MFX_SCHEDULER_STAT_OWNERS];
+    mfxU32 m_numStatOwners;
+    // Statistics of every thread and one more set for external threads,
+    // MFX_SCHEDULER_STAT_OWNERS slots per thread
+    std::vector<MFX_SCHEDULER_STAT> m_stat;
+
 
 
     // Condition variable to wait free task objects
@@ -380,6 +459,22 @@ protected:
     // Handle to the wakeup thread
     std::thread m_hwWakeUpThread;
 
+    struct MFX_HW_EVENT
+    {
+        const void *pOwner;
+        int fd;
+    };
+    // Registered HW completion events, guarded by m_guard
+    std::vector<MFX_HW_EVENT> m_hwEvents;
+    // The wake up thread is listening to HW events, guarded by m_guard
+    bool m_bHwEventReactor;
+    // Guard for starting and stopping the wake up thread
+    std::mutex m_hwEventGuard;
+    // epoll instance of the wake up thread
+    int m_hwEventPoll;
+    // eventfd to interrupt the wake up thread
+    int m_hwEventControl;
+
     // declare thread working routine
     void ThreadProc(MFX_SCHEDULER_THREAD_CONTEXT *pContext);
     void WakeupThreadProc();
@@ -400,6 +495,10 @@ protected:
     mfxU32 m_DedicatedThreadsToWakeUp;
     // Number of tasks for non-dedicated threads
     mfxU32 m_RegularThreadsToWakeUp;
+    // Ready tasks hints, allocated in MFX_SCHEDULER_WORK_STEALING mode only
+    std::unique_ptr<MFX_SCHEDULER_READY_TASKS> m_pReadyTasks;
+    // Context of the scheduler thread running the code, NULL for external threads
+    static thread_local MFX_SCHEDULER_THREAD_CONTEXT *m_pCurrentThreadCtx;
 
     // these members are used only from the main thread,
     // so synchronization is not necessary to access them.
@@ -414,11 +513,9 @@ protected:
     //
 
     // Dependency table.
-    // There are an index: it holds the number of values valid in the array.
-    // The array may have larger size.
     std::vector<MFX_DEPENDENCY_ITEM> m_pDependencyTable;
-    volatile
-    mfxU32 m_numDependencies;
+    // Index of the dependency table by the pointer, it allocates table entries
+    mfxDependencyIndex m_dependencyIndex;
 
     // Threads assignment table.
     std::vector<MFX_THREAD_ASSIGNMENT> m_occupancyTable;
@@ -38,6 +38,10 @@ struct MFX_SCHEDULER_THREAD_CONTEXT
       , threadHandle()
       , workTime(0)
       , sleepTime(0)
+      , node(0)
+      , lastCpu(-1)
+      , numMigrations(0)
+      , numNodeMigrations(0)
     {}
 
     enum State {
@@ -53,6 +57,11 @@ struct MFX_SCHEDULER_THREAD_CONTEXT
 
     mfxU64 workTime;                   // integral working time
     mfxU64 sleepTime;                  // integral sleeping time
+
+    mfxU32 node;                       // NUMA node the thread is bound to
+    mfxI32 lastCpu;                    // CPU the last task was run on
+    mfxU64 numMigrations;              // number of CPU changes between tasks
+    mfxU64 numNodeMigrations;          // number of NUMA node changes between tasks
 };
 
 #endif // #ifndef __MFX_SCHEDULER_CORE_THREAD_H
@@ -24,12 +24,54 @@
 #include <mfx_scheduler_core_handle.h>
 #include <mfx_trace.h>
 
+#include <fstream>
+#include <sstream>
+#include <string>
+
+#include <pthread.h>
+#include <sched.h>
+
+namespace
+{
+
+// parses sysfs lists like "0-3,8-11"
+std::vector<mfxU32> ParseSysfsList(const std::string &list)
+{
+    std::vector<mfxU32> items;
+    std::stringstream ss(list);
+    std::string range;
+
+    while (std::getline(ss, range, ','))
+    {
+        if (range.empty() || !isdigit((unsigned char) range[0]))
+            continue;
+
+        size_t dash = range.find('-');
+        mfxU32 first = (mfxU32) std::stoul(range.substr(0, dash));
+        mfxU32 last = (std::string::npos == dash) ? first : (mfxU32) std::stoul(range.substr(dash + 1));
+
+        for (mfxU32 item = first; item <= last; item += 1)
+        {
+            items.push_back(item);
+        }
+    }
+
+    return items;
+}
+
+} // namespace
+
+thread_local MFX_SCHEDULER_THREAD_CONTEXT *mfxSchedulerCore::m_pCurrentThreadCtx = NULL;
+
 mfxSchedulerCore::mfxSchedulerCore(void)
     :  m_currentTimeStamp(0)
     // since on Linux we have blocking synchronization which means an absence of polling,
     // there is no need to use 'waiting' time period.
     , m_timeWaitPeriod(0)
     , m_hwWakeUpThread()
+    , m_bHwEventReactor(false)
+    , m_hwEventPoll(-1)
+    , m_hwEventControl(-1)
     , m_DedicatedThreadsToWakeUp(0)
     , m_RegularThreadsToWakeUp(0)
 {
@@ -50,12 +92,12 @@ mfxSchedulerCore::mfxSchedulerCore(void)
 
     m_pFreeTasks = NULL;
 
-    // reset dependency table variables
-    m_numDependencies = 0;
-
     // reset busy objects table
     m_numOccupancies = 0;
 
+    memset(m_statOwners, 0, sizeof(m_statOwners));
+    m_numStatOwners = 0;
+
     // reset task counters
     m_taskCounter = 0;
     m_freeTasksCount = 0;
@@ -92,9 +134,159 @@ bool mfxSchedulerCore::SetScheduling(std::thread& handle)
     return true;
 }
 
+void mfxSchedulerCore::LoadCpuTopology(void)
+{
+    cpu_set_t allowed;
+
+    m_nodeCpus.clear();
+    m_cpuToNode.clear();
+
+    CPU_ZERO(&allowed);
+    if (sched_getaffinity(0, sizeof(allowed), &allowed))
+    {
+        return;
+    }
+
+    std::ifstream onlineFile("/sys/devices/system/node/online");
+    std::string online;
+
+    std::getline(onlineFile, online);
+    for (mfxU32 node : ParseSysfsList(online))
+    {
+        std::ifstream file("/sys/devices/system/node/node" + std::to_string(node) + "/cpulist");
+        std::string list;
+
+        std::getline(file, list);
+
+        if (node >= m_nodeCpus.size())
+        {
+            m_nodeCpus.resize(node + 1);
+        }
+
+        for (mfxU32 cpu : ParseSysfsList(list))
+        {
+            if (cpu >= m_cpuToNode.size())
+            {
+                m_cpuToNode.resize(cpu + 1, 0);
+            }
+            m_cpuToNode[cpu] = node;
+
+            // CPUs outside of the process mask (cgroups, taskset) are never used
+            if ((cpu < CPU_SETSIZE) && CPU_ISSET(cpu, &allowed))
+            {
+                m_nodeCpus[node].push_back(cpu);
+            }
+        }
+    }
+
+    if (m_nodeCpus.empty())
+    {
+        // no NUMA information, all allowed CPUs make a single node
+        m_nodeCpus.emplace_back();
+        for (mfxU32 cpu = 0; cpu < CPU_SETSIZE; cpu += 1)
+        {
+            if (CPU_ISSET(cpu, &allowed))
+            {
+                m_nodeCpus[0].push_back(cpu);
+            }
+        }
+    }
+
+} // void mfxSchedulerCore::LoadCpuTopology(void)
+
 void mfxSchedulerCore::SetThreadsAffinityToSockets(void)
 {
-}
+    std::vector<mfxU32> nodes;
+    mfxU32 numCpus = 0;
+
+    if (MFX_SCHEDULER_PLACEMENT_NONE == m_param.placement)
+    {
+        return;
+    }
+
+    for (mfxU32 node = 0; node < m_nodeCpus.size(); node += 1)
+    {
+        if (m_nodeCpus[node].size())
+        {
+            nodes.push_back(node);
+            numCpus += (mfxU32) m_nodeCpus[node].size();
+        }
+    }
+
+    if (nodes.empty())
+    {
+        return;
+    }
+
+    // the device node is unknown or the process may not run on it, let the OS place threads
+    if ((MFX_SCHEDULER_PLACEMENT_DEVICE_NODE == m_param.placement) &&
+        ((0 > m_param.deviceNode) ||
+         ((mfxU32) m_param.deviceNode >= m_nodeCpus.size()) ||
+         (m_nodeCpus[m_param.deviceNode].empty())))
+    {
+        return;
+    }
+
+    for (mfxU32 i = 0; i < m_param.numberOfThreads; i += 1)
+    {
+        mfxU32 node;
+
+        switch (m_param.placement)
+        {
+        case MFX_SCHEDULER_PLACEMENT_COMPACT:
+            {
+                // take nodes one by one until every CPU got a thread, then start over
+                mfxU32 pos = i % numCpus;
+                mfxU32 idx = 0;
+
+                while (pos >= m_nodeCpus[nodes[idx]].size())
+                {
+                    pos -= (mfxU32) m_nodeCpus[nodes[idx]].size();
+                    idx += 1;
+                }
+                node = nodes[idx];
+            }
+            break;
+
+        case MFX_SCHEDULER_PLACEMENT_SCATTER:
+            node = nodes[i % nodes.size()];
+            break;
+
+        default:
+            node = (mfxU32) m_param.deviceNode;
+            break;
+        }
+
+        // threads are bound to nodes, not CPUs, so they still balance inside the node
+        cpu_set_t cpus;
+
+        CPU_ZERO(&cpus);
+        for (mfxU32 cpu : m_nodeCpus[node])
+        {
+            CPU_SET(cpu, &cpus);
+        }
+
+        if (0 == pthread_setaffinity_np(m_pThreadCtx[i].threadHandle.native_handle(), sizeof(cpus), &cpus))
+        {
+            m_pThreadCtx[i].node = node;
+        }
+    }
+
+    MFX_LTRACE_2(MFX_TRACE_LEVEL_SCHED, "^Placement^", "policy=%d nodes=%u",
+                 (int) m_param.placement, (mfxU32) nodes.size());
+
+} // void mfxSchedulerCore::SetThreadsAffinityToSockets(void)
+
+mfxU32 mfxSchedulerCore::GetCpuNode(mfxI32 cpu) const
+{
+    if ((0 > cpu) || ((size_t) cpu >= m_cpuToNode.size()))
+    {
+        return 0;
+    }
+
+    return m_cpuToNode[cpu];
+
+} // mfxU32 mfxSchedulerCore::GetCpuNode(mfxI32 cpu) const
 
 void mfxSchedulerCore::Close(void)
 {
@@ -119,11 +311,24 @@ void mfxSchedulerCore::Close(void)
             // wait for particular thread
             if (m_pThreadCtx[i].threadHandle.joinable())
                 m_pThreadCtx[i].threadHandle.join();
+
+            MFX_LTRACE_2(MFX_TRACE_LEVEL_SCHED, "^Migrations^", "cpu=%llu node=%llu",
+                         (unsigned long long) m_pThreadCtx[i].numMigrations,
+                         (unsigned long long) m_pThreadCtx[i].numNodeMigrations);
         }
 
         delete[] m_pThreadCtx;
     }
 
+    m_pReadyTasks.reset();
+
+    m_nodeCpus.clear();
+    m_cpuToNode.clear();
+
+    m_stat.clear();
+    memset(m_statOwners, 0, sizeof(m_statOwners));
+    m_numStatOwners = 0;
+
     // run over the task lists and abort the existing tasks
     ForEachTask(
         [](MFX_SCHEDULER_TASK* task)
@@ -135,6 +340,8 @@ void mfxSchedulerCore::Close(void)
         }
     );
 
+    m_hwEvents.clear();
+
     // delete task objects
     for (auto & it : m_ppTaskLookUpTable)
     {
@@ -159,7 +366,11 @@ void mfxSchedulerCore::Close(void)
     m_pFreeTasks = NULL;
 
     // reset dependency table variables
-    m_numDependencies = 0;
+    const MFX_DEPENDENCY_INDEX_STAT &dependencyStat = m_dependencyIndex.GetStat();
+    MFX_LTRACE_2(MFX_TRACE_LEVEL_SCHED, "^DependencyIndex^", "maxItems=%u maxProbeLength=%u",
+                 dependencyStat.maxItems, dependencyStat.maxProbeLength);
+    m_pDependencyTable.clear();
+    m_dependencyIndex.Reset(0);
 
     // reset busy objects table
     m_numOccupancies = 0;
@@ -403,8 +614,9 @@ void mfxSchedulerCore::ScrubCompletedTasks(bool bComprehensive)
 
 void mfxSchedulerCore::RegisterTaskDependencies(MFX_SCHEDULER_TASK  *pTask)
 {
-    mfxU32 i, tableIdx, remainInputs;
-    const void *pSrcCopy[MFX_TASK_NUM_DEPENDENCIES];
+    mfxU32 i, j, numInputs;
+    mfxU32 inputIdx[MFX_TASK_NUM_DEPENDENCIES];
+    mfxU32 inputLevel[MFX_TASK_NUM_DEPENDENCIES];
     mfxStatus taskRes = MFX_WRN_IN_EXECUTION;
 
     //
@@ -412,106 +624,80 @@ void mfxSchedulerCore::RegisterTaskDependencies(MFX_SCHEDULER_TASK  *pTask)
     // Just do what need to do.
     //
 
-    // check if the table have empty position(s),
-    // If so decrement the index of the last table entry.
-    if (m_pDependencyTable.size() > m_numDependencies)
-    {
-        auto it = std::find_if(m_pDependencyTable.rend() - m_numDependencies, m_pDependencyTable.rend(),
-                               [](const MFX_DEPENDENCY_ITEM & item){ return item.p != nullptr; });
-
-        m_numDependencies = m_pDependencyTable.rend() - it;
-    }
-
-    // get the number of source dependencies
-    remainInputs = 0;
+    // find table entries of incomplete inputs.
+    // there may be duplicates in the dependency table, the task syncs on
+    // the first matching entry. Duplicated sources take following entries.
+    numInputs = 0;
     for (i = 0; i < MFX_TASK_NUM_DEPENDENCIES; i += 1)
     {
-        // make a copy of source dependencies.
-        // source dependencies have to be swept, because of duplication in
-        // the dependency table. task will sync on the first matching entry.
-        pSrcCopy[i] = pTask->param.task.pSrc[i];
-        if (pSrcCopy[i])
+        const void *pSrc = pTask->param.task.pSrc[i];
+        if (nullptr == pSrc)
         {
-            remainInputs += 1;
+            continue;
         }
-    }
 
-    // run over the table and save the handles of incomplete inputs
-    for (tableIdx = 0; tableIdx < m_numDependencies; tableIdx += 1)
-    {
-        // compare only filled table entries
-        if (m_pDependencyTable[tableIdx].p)
+        mfxU32 tableIdx = m_dependencyIndex.Find(pSrc);
+        for (j = 0; (j < i) && (mfxDependencyIndex::INVALID_INDEX != tableIdx); j += 1)
         {
-            for (i = 0; i < MFX_TASK_NUM_DEPENDENCIES; i += 1)
+            if (pTask->param.task.pSrc[j] == pSrc)
             {
-                // we found the source dependency,
-                // save the handle
-                if (m_pDependencyTable[tableIdx].p == pSrcCopy[i])
-                {
-                    // dependency is fail. The dependency resolved, but failed.
-                    if (MFX_WRN_IN_EXECUTION != m_pDependencyTable[tableIdx].mfxRes)
-                    {
-                        // waiting task inherits status from the parent task
-                        // need to propogate error status to all dependent tasks.
-                        //if (MFX_TASK_WAIT & pTask->param.task.threadingPolicy)
-                        {
-                            taskRes = m_pDependencyTable[tableIdx].mfxRes;
-                        }
-                        //// all other tasks are aborted
-                        //else
-                        //{
-                        //    taskRes = MFX_ERR_ABORTED;
-                        //}
-                    }
-                    // link dependency
-                    else
-                    {
-                        m_pDependencyTable[tableIdx].pTask->SetDependentItem(pTask, i);
-                    }
-                    // sweep already used dependency
-                    pSrcCopy[i] = NULL;
-                    remainInputs -= 1;
-                    break;
-                }
+                tableIdx = m_dependencyIndex.Next(tableIdx);
             }
+        }
+        if (mfxDependencyIndex::INVALID_INDEX == tableIdx)
+        {
+            continue;
+        }
 
-            // is there more source dependencies?
-            if (0 == remainInputs)
-            {
-                break;
-            }
+        // keep the inputs in the table order
+        for (j = numInputs; (j > 0) && (inputIdx[j - 1] > tableIdx); j -= 1)
+        {
+            inputIdx[j] = inputIdx[j - 1];
+            inputLevel[j] = inputLevel[j - 1];
+        }
+        inputIdx[j] = tableIdx;
+        inputLevel[j] = i;
+        numInputs += 1;
+    }
+
+    // save the handles of incomplete inputs
+    for (j = 0; j < numInputs; j += 1)
+    {
+        MFX_DEPENDENCY_ITEM &item = m_pDependencyTable[inputIdx[j]];
+
+        // dependency is fail. The dependency resolved, but failed.
+        if (MFX_WRN_IN_EXECUTION != item.mfxRes)
+        {
+            // waiting task inherits status from the parent task
+            // need to propogate error status to all dependent tasks.
+            taskRes = item.mfxRes;
+        }
+        // link dependency
+        else
+        {
+            item.pTask->SetDependentItem(pTask, inputLevel[j]);
         }
     }
 
-    // run over the table and register generated outputs
-    tableIdx = 0;
+    // register generated outputs
     for (i = 0; i < MFX_TASK_NUM_DEPENDENCIES; i += 1)
     {
         if (pTask->param.task.pDst[i])
         {
-            // find empty table entry
-            while (m_pDependencyTable.at(tableIdx).p)
-            {
-                tableIdx += 1;
-            }
+            // get the lowest empty table entry
+            mfxU32 tableIdx = m_dependencyIndex.Insert(pTask->param.task.pDst[i]);
+            MFX_DEPENDENCY_ITEM &item = m_pDependencyTable.at(tableIdx);
 
             // save the generated dependency
-            m_pDependencyTable[tableIdx].p = pTask->param.task.pDst[i];
-            m_pDependencyTable[tableIdx].mfxRes = taskRes;
-            m_pDependencyTable[tableIdx].pTask = pTask;
+            item.p = pTask->param.task.pDst[i];
+            item.mfxRes = taskRes;
+            item.pTask = pTask;
 
             // save the index of the output
             pTask->param.dependencies.dstIdx[i] = tableIdx;
-            tableIdx += 1;
         }
     }
 
-    // update the dependency table max index
-    if (tableIdx >= m_numDependencies)
-    {
-        m_numDependencies = tableIdx;
-    }
-
     // if dependency were failed,
     // set the task into the 'aborted' state
     if (MFX_WRN_IN_EXECUTION != taskRes)
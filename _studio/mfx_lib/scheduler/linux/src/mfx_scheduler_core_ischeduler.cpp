@@ -25,8 +25,13 @@
 
 #include <mfx_trace.h>
 
+#include <sys/epoll.h>
+
+#include <algorithm>
 #include <functional>
 #include <cassert>
+#include <cstdlib>
+#include <cstring>
 #include <list>
 
 enum
@@ -39,6 +44,7 @@ mfxStatus mfxSchedulerCore::Initialize(const MFX_SCHEDULER_PARAM *pParam)
 {
     MFX_SCHEDULER_PARAM2 param2;
     memset(&param2, 0, sizeof(param2));
+    param2.deviceNode = -1;
     if (pParam) {
         MFX_SCHEDULER_PARAM* casted_param2 = &param2;
         *casted_param2 = *pParam;
@@ -70,6 +76,7 @@ mfxStatus mfxSchedulerCore::Initialize2(const MFX_SCHEDULER_PARAM2 *pParam)
 
     // allocate the dependency table
     m_pDependencyTable.resize(MFX_MAX_NUMBER_TASK * 2, MFX_DEPENDENCY_ITEM());
+    m_dependencyIndex.Reset((mfxU32) m_pDependencyTable.size());
 
     // allocate the thread assignment object table.
     // its size should be equal to the number of task,
@@ -90,12 +97,43 @@ mfxStatus mfxSchedulerCore::Initialize2(const MFX_SCHEDULER_PARAM2 *pParam)
             return MFX_ERR_UNSUPPORTED;
         }
 
+        if (MFX_SCHEDULER_DEFAULT == m_param.flags) {
+            const char *pWorkStealing = std::getenv("VPL_SCHEDULER_WORK_STEALING");
+            if (pWorkStealing && !strcmp(pWorkStealing, "1")) {
+                m_param.flags = MFX_SCHEDULER_WORK_STEALING;
+            }
+        }
+
+        if (MFX_SCHEDULER_PLACEMENT_NONE == m_param.placement) {
+            const char *pPlacement = std::getenv("VPL_SCHEDULER_PLACEMENT");
+            if (pPlacement && !strcmp(pPlacement, "compact")) {
+                m_param.placement = MFX_SCHEDULER_PLACEMENT_COMPACT;
+            }
+            else if (pPlacement && !strcmp(pPlacement, "scatter")) {
+                m_param.placement = MFX_SCHEDULER_PLACEMENT_SCATTER;
+            }
+            else if (pPlacement && !strcmp(pPlacement, "device")) {
+                m_param.placement = MFX_SCHEDULER_PLACEMENT_DEVICE_NODE;
+            }
+        }
+
+        // threads read the topology to count migrations
+        LoadCpuTopology();
+
+        // statistics of every thread and of application's threads
+        m_stat.resize((m_param.numberOfThreads + 1) * MFX_SCHEDULER_STAT_OWNERS, MFX_SCHEDULER_STAT());
+
 
         try
         {
             // allocate thread contexts
             m_pThreadCtx = new MFX_SCHEDULER_THREAD_CONTEXT[m_param.numberOfThreads];
 
+            if (MFX_SCHEDULER_WORK_STEALING == m_param.flags)
+            {
+                m_pReadyTasks.reset(new MFX_SCHEDULER_READY_TASKS(m_param.numberOfThreads));
+            }
+
             // start threads
             for (i = 0; i < m_param.numberOfThreads; i += 1)
             {
@@ -124,6 +162,7 @@ mfxStatus mfxSchedulerCore::Initialize2(const MFX_SCHEDULER_PARAM2 *pParam)
     {
         // to run HW listen thread. Will be enabled if tests are OK
 
+        m_stat.resize((m_param.numberOfThreads + 1) * MFX_SCHEDULER_STAT_OWNERS, MFX_SCHEDULER_STAT());
     }
 
     return MFX_ERR_NONE;
@@ -176,6 +215,9 @@ mfxStatus mfxSchedulerCore::Synchronize(mfxTaskHandle handle, mfxU32 timeToWait)
     }
     PERF_UTILITY_SET_ASYNC_TASK_ID(pTask->param.task.nTaskId);
 
+    const mfxU64 timeStart = GetHighPerformanceCounter();
+    const mfxU32 statSlot = pTask->param.statSlot;
+
     if (MFX_SINGLE_THREAD == m_param.flags)
     {
         //let really run task to
@@ -216,6 +258,11 @@ mfxStatus mfxSchedulerCore::Synchronize(mfxTaskHandle handle, mfxU32 timeToWait)
                 IncrementHWEventCounter();
             }
         }
+
+        {
+            std::lock_guard<std::mutex> guard(m_guard);
+            RecordStat(statSlot, MFX_SCHEDULER_STAT_SYNC_WAIT, GetHighPerformanceCounter() - timeStart);
+        }
         //
         // inspect the task
         //
@@ -257,6 +304,8 @@ mfxStatus mfxSchedulerCore::Synchronize(mfxTaskHandle handle, mfxU32 timeToWait)
            return (pTask->jobID != handle.jobID) || (MFX_WRN_IN_EXECUTION != pTask->opRes);
         });
 
+        RecordStat(statSlot, MFX_SCHEDULER_STAT_SYNC_WAIT, GetHighPerformanceCounter() - timeStart);
+
         if (pTask->jobID == handle.jobID) {
             return pTask->opRes;
         } else {
@@ -276,6 +325,236 @@ mfxStatus mfxSchedulerCore::GetTimeout(mfxU32& maxTimeToRun)
     return MFX_ERR_UNSUPPORTED;
 }
 
+mfxStatus mfxSchedulerCore::RegisterHwEvent(const void *pOwner, int eventFd)
+{
+    // check error(s)
+    if (0 == m_param.numberOfThreads)
+    {
+        return MFX_ERR_NOT_INITIALIZED;
+    }
+    if (NULL == pOwner)
+    {
+        return MFX_ERR_NULL_PTR;
+    }
+    if (0 > eventFd)
+    {
+        return MFX_ERR_INVALID_HANDLE;
+    }
+    // in the single thread mode tasks are run from Synchronize only
+    if (MFX_SINGLE_THREAD == m_param.flags)
+    {
+        return MFX_ERR_UNSUPPORTED;
+    }
+
+    {
+        std::lock_guard<std::mutex> hwGuard(m_hwEventGuard);
+        std::lock_guard<std::mutex> guard(m_guard);
+
+        m_hwEvents.push_back({pOwner, eventFd});
+
+        if (m_hwWakeUpThread.joinable())
+        {
+            epoll_event event = {};
+
+            event.events = EPOLLIN;
+            event.data.fd = eventFd;
+            epoll_ctl(m_hwEventPoll, EPOLL_CTL_ADD, eventFd, &event);
+
+            return MFX_ERR_NONE;
+        }
+    }
+
+    // the wake up thread listens to all registered events
+    return StartWakeUpThread();
+
+} // mfxStatus mfxSchedulerCore::RegisterHwEvent(const void *pOwner, int eventFd)
+
+mfxStatus mfxSchedulerCore::UnregisterHwEvent(const void *pOwner)
+{
+    // check error(s)
+    if (0 == m_param.numberOfThreads)
+    {
+        return MFX_ERR_NOT_INITIALIZED;
+    }
+
+    std::lock_guard<std::mutex> hwGuard(m_hwEventGuard);
+    std::lock_guard<std::mutex> guard(m_guard);
+
+    auto ownerEnd = std::remove_if(m_hwEvents.begin(), m_hwEvents.end(),
+        [pOwner](const MFX_HW_EVENT &event) { return event.pOwner == pOwner; });
+
+    for (auto it = ownerEnd; it != m_hwEvents.end(); ++it)
+    {
+        const int fd = it->fd;
+        bool bShared = std::any_of(m_hwEvents.begin(), ownerEnd,
+            [fd](const MFX_HW_EVENT &event) { return event.fd == fd; });
+
+        if ((0 <= m_hwEventPoll) && (false == bShared))
+        {
+            epoll_ctl(m_hwEventPoll, EPOLL_CTL_DEL, fd, NULL);
+        }
+    }
+    m_hwEvents.erase(ownerEnd, m_hwEvents.end());
+
+    // tasks of the owner must not wait for events any more
+    ResetWaitingTasks(pOwner);
+    WakeUpThreads();
+
+    return MFX_ERR_NONE;
+
+} // mfxStatus mfxSchedulerCore::UnregisterHwEvent(const void *pOwner)
+
+mfxStatus mfxSchedulerCore::SetDeviceNode(mfxI32 deviceNode)
+{
+    // check error(s)
+    if (0 == m_param.numberOfThreads)
+    {
+        return MFX_ERR_NOT_INITIALIZED;
+    }
+
+    std::lock_guard<std::mutex> guard(m_guard);
+
+    if (deviceNode == m_param.deviceNode)
+    {
+        return MFX_ERR_NONE;
+    }
+    m_param.deviceNode = deviceNode;
+
+    // threads of the other policies don't depend on the device
+    if ((MFX_SCHEDULER_PLACEMENT_DEVICE_NODE == m_param.placement) &&
+        (MFX_SINGLE_THREAD != m_param.flags))
+    {
+        SetThreadsAffinityToSockets();
+    }
+
+    return MFX_ERR_NONE;
+
+} // mfxStatus mfxSchedulerCore::SetDeviceNode(mfxI32 deviceNode)
+
+mfxStatus mfxSchedulerCore::GetStat(const void *pOwner, MFX_SCHEDULER_STAT *pStat)
+{
+    // check error(s)
+    if (0 == m_param.numberOfThreads)
+    {
+        return MFX_ERR_NOT_INITIALIZED;
+    }
+    if (NULL == pStat)
+    {
+        return MFX_ERR_NULL_PTR;
+    }
+
+    std::lock_guard<std::mutex> guard(m_guard);
+    mfxU32 firstSlot = 0;
+    mfxU32 lastSlot = MFX_SCHEDULER_STAT_OWNERS - 1;
+
+    if (pOwner)
+    {
+        for (firstSlot = 0; firstSlot < m_numStatOwners; firstSlot += 1)
+        {
+            if (m_statOwners[firstSlot] == pOwner)
+            {
+                break;
+            }
+        }
+        if (firstSlot == m_numStatOwners)
+        {
+            return MFX_ERR_NOT_FOUND;
+        }
+        lastSlot = firstSlot;
+    }
+
+    memset(pStat, 0, sizeof(MFX_SCHEDULER_STAT));
+
+    // merge statistics of all threads
+    for (size_t base = 0; base < m_stat.size(); base += MFX_SCHEDULER_STAT_OWNERS)
+    {
+        for (mfxU32 slot = firstSlot; slot <= lastSlot; slot += 1)
+        {
+            for (int kind = 0; kind < MFX_SCHEDULER_STAT_KINDS; kind += 1)
+            {
+                const MFX_LATENCY_HISTOGRAM &src = m_stat[base + slot].latency[kind];
+                MFX_LATENCY_HISTOGRAM &dst = pStat->latency[kind];
+
+                if (0 == src.count)
+                {
+                    continue;
+                }
+
+                dst.count += src.count;
+                dst.sum += src.sum;
+                dst.max = std::max(dst.max, src.max);
+                for (mfxU32 i = 0; i < MFX_LATENCY_BUCKETS; i += 1)
+                {
+                    dst.buckets[i] += src.buckets[i];
+                }
+            }
+        }
+    }
+
+    // migrations are counted per thread, not per owner
+    if ((NULL == pOwner) && (m_pThreadCtx))
+    {
+        for (mfxU32 i = 0; i < m_param.numberOfThreads; i += 1)
+        {
+            pStat->numMigrations += m_pThreadCtx[i].numMigrations;
+            pStat->numNodeMigrations += m_pThreadCtx[i].numNodeMigrations;
+        }
+    }
+
+    return MFX_ERR_NONE;
+
+} // mfxStatus mfxSchedulerCore::GetStat(const void *pOwner, MFX_SCHEDULER_STAT *pStat)
+
+mfxStatus mfxSchedulerCore::GetStatOwners(const void **ppOwners, mfxU32 *pNumOwners)
+{
+    // check error(s)
+    if (0 == m_param.numberOfThreads)
+    {
+        return MFX_ERR_NOT_INITIALIZED;
+    }
+    if ((NULL == pNumOwners) ||
+        ((NULL == ppOwners) && (*pNumOwners)))
+    {
+        return MFX_ERR_NULL_PTR;
+    }
+
+    std::lock_guard<std::mutex> guard(m_guard);
+    const mfxU32 numOwners = std::min(*pNumOwners, m_numStatOwners);
+
+    std::copy(m_statOwners, m_statOwners + numOwners, ppOwners);
+    mfxStatus mfxRes = (numOwners < m_numStatOwners) ? MFX_ERR_NOT_ENOUGH_BUFFER : MFX_ERR_NONE;
+    *pNumOwners = m_numStatOwners;
+
+    return mfxRes;
+
+} // mfxStatus mfxSchedulerCore::GetStatOwners(const void **ppOwners, mfxU32 *pNumOwners)
+
+mfxStatus mfxSchedulerCore::ResetStat(void)
+{
+    // check error(s)
+    if (0 == m_param.numberOfThreads)
+    {
+        return MFX_ERR_NOT_INITIALIZED;
+    }
+
+    std::lock_guard<std::mutex> guard(m_guard);
+
+    // owners keep their slots, tasks in flight refer to them
+    std::fill(m_stat.begin(), m_stat.end(), MFX_SCHEDULER_STAT());
+
+    if (m_pThreadCtx)
+    {
+        for (mfxU32 i = 0; i < m_param.numberOfThreads; i += 1)
+        {
+            m_pThreadCtx[i].numMigrations = 0;
+            m_pThreadCtx[i].numNodeMigrations = 0;
+        }
+    }
+
+    return MFX_ERR_NONE;
+
+} // mfxStatus mfxSchedulerCore::ResetStat(void)
+
 mfxStatus mfxSchedulerCore::WaitForDependencyResolved(const void *pDependency)
 {
     mfxTaskHandle waitHandle = {};
@@ -294,20 +573,16 @@ mfxStatus mfxSchedulerCore::WaitForDependencyResolved(const void *pDependency)
     // find a handle to wait
     {
         std::lock_guard<std::mutex> guard(m_guard);
-        mfxU32 curIdx;
+        const mfxU32 curIdx = m_dependencyIndex.Find(pDependency);
 
-        for (curIdx = 0; curIdx < m_numDependencies; curIdx += 1)
+        if (mfxDependencyIndex::INVALID_INDEX != curIdx)
         {
-            if (m_pDependencyTable.at(curIdx).p == pDependency)
-            {
-                // get the handle before leaving protected section
-                waitHandle.taskID = m_pDependencyTable[curIdx].pTask->taskID;
-                waitHandle.jobID = m_pDependencyTable[curIdx].pTask->jobID;
+            // get the handle before leaving protected section
+            waitHandle.taskID = m_pDependencyTable.at(curIdx).pTask->taskID;
+            waitHandle.jobID = m_pDependencyTable[curIdx].pTask->jobID;
 
-                // handle is found, go to wait
-                bFind = true;
-                break;
-            }
+            // handle is found, go to wait
+            bFind = true;
         }
         // leave the protected section
     }
@@ -589,6 +864,9 @@ mfxStatus mfxSchedulerCore::AddTask(const MFX_TASK &task, mfxSyncPoint *pSyncPoi
         // set the advanced task's info
         m_pFreeTasks->param.sourceInfo.pFileName = pFileName;
         m_pFreeTasks->param.sourceInfo.lineNumber = lineNumber;
+
+        m_pFreeTasks->param.statSlot = GetStatSlot(task.pOwner);
+        m_pFreeTasks->param.timing.timeSubmitted = GetHighPerformanceCounter();
         // set the sync point for the task
         handle.handle = 0;
         handle.taskID = m_pFreeTasks->taskID;
@@ -634,6 +912,7 @@ mfxStatus mfxSchedulerCore::AddTask(const MFX_TASK &task, mfxSyncPoint *pSyncPoi
 
         // wake up working threads if task has resolved dependencies
         if (IsReadyToRun(pTask)) {
+            PublishReadyTask(pTask);
             WakeUpThreads(num_hw_threads, num_sw_threads);
         }
 
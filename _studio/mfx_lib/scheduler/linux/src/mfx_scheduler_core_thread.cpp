@@ -24,16 +24,77 @@
 #include <mfx_trace.h>
 #include <stdio.h>
 
+#include <sched.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <unistd.h>
+
+namespace
+{
+
+enum
+{
+    // number of events taken by the wake up thread at once
+    MFX_HW_EVENTS_PER_WAIT = 16
+};
+
+void AddToPoll(int poll, int fd)
+{
+    epoll_event event = {};
+
+    event.events = EPOLLIN;
+    event.data.fd = fd;
+    // the same fd may be registered by several owners, EEXIST is fine
+    epoll_ctl(poll, EPOLL_CTL_ADD, fd, &event);
+}
+
+} // namespace
+
 mfxStatus mfxSchedulerCore::StartWakeUpThread(void)
 {
     // stop the thread before creating it again
-    // don't try to check thread status, it might lead to interesting effects.
+    StopWakeUpThread();
+
+    std::lock_guard<std::mutex> hwGuard(m_hwEventGuard);
+
+    // the thread was started by another caller in the meantime
     if (m_hwWakeUpThread.joinable())
-        StopWakeUpThread();
+        return MFX_ERR_NONE;
+
+    m_hwEventPoll = epoll_create1(EPOLL_CLOEXEC);
+    m_hwEventControl = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    if ((0 > m_hwEventPoll) || (0 > m_hwEventControl))
+    {
+        CloseHwEventPoll();
+        return MFX_ERR_UNKNOWN;
+    }
+    AddToPoll(m_hwEventPoll, m_hwEventControl);
+
+    {
+        std::lock_guard<std::mutex> guard(m_guard);
+
+        for (const MFX_HW_EVENT &event : m_hwEvents)
+        {
+            AddToPoll(m_hwEventPoll, event.fd);
+        }
 
-    m_timer_hw_event = MFX_THREAD_TIME_TO_WAIT;
+        m_timer_hw_event = MFX_THREAD_TIME_TO_WAIT;
+        m_bQuitWakeUpThread = false;
+        m_bHwEventReactor = true;
+    }
 
+    try
+    {
+        m_hwWakeUpThread = std::thread(&mfxSchedulerCore::WakeupThreadProc, this);
+    }
+    catch (...)
+    {
+        std::lock_guard<std::mutex> guard(m_guard);
 
+        m_bHwEventReactor = false;
+        CloseHwEventPoll();
+        return MFX_ERR_MEMORY_ALLOC;
+    }
 
     return MFX_ERR_NONE;
 
@@ -41,11 +102,68 @@ mfxStatus mfxSchedulerCore::StartWakeUpThread(void)
 
 mfxStatus mfxSchedulerCore::StopWakeUpThread(void)
 {
+    std::lock_guard<std::mutex> hwGuard(m_hwEventGuard);
+
+    if (false == m_hwWakeUpThread.joinable())
+        return MFX_ERR_NONE;
+
+    {
+        std::lock_guard<std::mutex> guard(m_guard);
+
+        m_bQuitWakeUpThread = true;
+
+        // nobody wakes up tasks waiting for HW events any more
+        m_bHwEventReactor = false;
+        if (m_pThreadCtx)
+        {
+            WakeUpThreads();
+        }
+    }
+
+    const uint64_t value = 1;
+    ssize_t res = write(m_hwEventControl, &value, sizeof(value));
+    (void)res;
+
+    m_hwWakeUpThread.join();
+    CloseHwEventPoll();
 
     return MFX_ERR_NONE;
 
 } // mfxStatus mfxSchedulerCore::StopWakeUpThread(void)
 
+void mfxSchedulerCore::CloseHwEventPoll(void)
+{
+    if (0 <= m_hwEventPoll)
+        close(m_hwEventPoll);
+    if (0 <= m_hwEventControl)
+        close(m_hwEventControl);
+
+    m_hwEventPoll = -1;
+    m_hwEventControl = -1;
+
+} // void mfxSchedulerCore::CloseHwEventPoll(void)
+
+void mfxSchedulerCore::UpdateMigrationStat(MFX_SCHEDULER_THREAD_CONTEXT *pContext)
+{
+    const mfxI32 cpu = sched_getcpu();
+
+    if ((0 > cpu) || (cpu == pContext->lastCpu))
+    {
+        return;
+    }
+
+    if (0 <= pContext->lastCpu)
+    {
+        pContext->numMigrations += 1;
+        if (GetCpuNode(cpu) != GetCpuNode(pContext->lastCpu))
+        {
+            pContext->numNodeMigrations += 1;
+        }
+    }
+    pContext->lastCpu = cpu;
+
+} // void mfxSchedulerCore::UpdateMigrationStat(MFX_SCHEDULER_THREAD_CONTEXT *pContext)
+
 void mfxSchedulerCore::ThreadProc(MFX_SCHEDULER_THREAD_CONTEXT *pContext)
 {
     std::unique_lock<std::mutex> guard(m_guard);
@@ -53,6 +171,8 @@ void mfxSchedulerCore::ThreadProc(MFX_SCHEDULER_THREAD_CONTEXT *pContext)
     mfxU64 start, stop;
     const uint32_t threadNum = pContext->threadNum;
 
+    m_pCurrentThreadCtx = pContext;
+
     {
         char thread_name[30] = {};
         snprintf(thread_name, sizeof(thread_name)-1, "ThreadName=MSDK#%d", threadNum);
@@ -68,7 +188,8 @@ void mfxSchedulerCore::ThreadProc(MFX_SCHEDULER_THREAD_CONTEXT *pContext)
             
             pContext->state = MFX_SCHEDULER_THREAD_CONTEXT::Waiting;
 
-            if (MFX_ERR_NONE == GetTask(call, previousTaskHandle, threadNum))
+            if ((MFX_ERR_NONE == GetReadyTask(call, threadNum, guard)) ||
+                (MFX_ERR_NONE == GetTask(call, previousTaskHandle, threadNum)))
             {
                 pContext->state = MFX_SCHEDULER_THREAD_CONTEXT::Running;
                 guard.unlock();
@@ -80,6 +201,7 @@ void mfxSchedulerCore::ThreadProc(MFX_SCHEDULER_THREAD_CONTEXT *pContext)
                 }
                 guard.lock();
 
+                UpdateMigrationStat(pContext);
                 pContext->workTime += call.timeSpend;
                 // save the previous task's handle
                 previousTaskHandle = call.taskHandle;
@@ -91,6 +213,12 @@ void mfxSchedulerCore::ThreadProc(MFX_SCHEDULER_THREAD_CONTEXT *pContext)
             }
         }
 
+        // GetReadyTask leaves the guard, so the wake up on quit could be missed
+        if (m_bQuit)
+        {
+            break;
+        }
+
         // mark beginning of sleep period
         start = GetHighPerformanceCounter();
 
@@ -114,13 +242,46 @@ void mfxSchedulerCore::WakeupThreadProc()
         MFX_AUTO_LTRACE(MFX_TRACE_LEVEL_SCHED, thread_name);
     }
 
+    epoll_event events[MFX_HW_EVENTS_PER_WAIT];
+
     // main working cycle for threads
-    while (false == m_bQuitWakeUpThread)
+    for (;;)
     {
+        int numEvents = epoll_wait(m_hwEventPoll, events, MFX_HW_EVENTS_PER_WAIT, (int) m_timer_hw_event);
+
+        // reset signaled events
+        for (int i = 0; i < numEvents; i += 1)
+        {
+            uint64_t value;
+            ssize_t res = read(events[i].data.fd, &value, sizeof(value));
+            (void)res;
+        }
+
+        std::lock_guard<std::mutex> guard(m_guard);
+
+        if (m_bQuitWakeUpThread)
+        {
+            break;
+        }
+
+        // no events in time, let waiting tasks run to not lose them forever
+        if (0 == numEvents)
+        {
+            WakeUpHwEventWaiters();
+            continue;
+        }
+
         IncrementHWEventCounter();
+
+        for (int i = 0; i < numEvents; i += 1)
         {
-            std::lock_guard<std::mutex> guard(m_guard);
-            WakeUpThreads(1,1);
+            for (const MFX_HW_EVENT &event : m_hwEvents)
+            {
+                if (event.fd == events[i].data.fd)
+                {
+                    OnHwEvent(event.pOwner);
+                }
+            }
         }
     }
 }
@@ -0,0 +1,252 @@
+// Copyright (c) 2025 Intel Corporation
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+
+// Statuses of scheduler tasks when the HW wait of a frame fails.
+// A mock component decodes a sequence of frames like the VP9 decoder: a task per frame
+// waits for the device, through HwCompletionWaiter with a registered event or blocking
+// in the task, and a failed wait marks the component with the critical error.
+// The device fails one frame with MFX_ERR_GPU_HANG or MFX_ERR_DEVICE_FAILED, the test checks
+// that Synchronize returns the error for this frame only and the earlier frames succeed.
+//
+// Usage:
+//   hw_completion_error_test [frames]
+
+#include <cstdio>
+#include <cstdlib>
+#include <deque>
+#include <vector>
+
+#include "mfx_interface_scheduler.h"
+#include "mfx_task.h"
+#include "mfx_hw_completion_waiter.h"
+
+// frames submitted to the device and not synchronized yet
+static const size_t MAX_FRAMES_IN_FLIGHT = 4;
+
+struct FailureCase
+{
+    mfxU32    frame;        // frame failed by the device, from the end if beyond the sequence
+    mfxStatus sts;
+};
+
+static const FailureCase failureCases[] =
+{
+    { 0,  MFX_ERR_GPU_HANG },
+    { 5,  MFX_ERR_GPU_HANG },
+    { 9,  MFX_ERR_DEVICE_FAILED },
+};
+
+struct Component
+{
+    HwCompletionWaiter waiter;
+    mfxU32             failedFrame;
+    mfxStatus          failure;
+    mfxStatus          criticalError;
+};
+
+struct TaskParam
+{
+    Component *pComponent;
+    mfxU32     frame;
+};
+
+static mfxStatus DeviceWait(const TaskParam *pTask)
+{
+    return (pTask->frame == pTask->pComponent->failedFrame) ? pTask->pComponent->failure : MFX_ERR_NONE;
+}
+
+// follows VP9DECODERoutine
+static mfxStatus TaskRoutine(void *pState, void *pParam, mfxU32, mfxU32)
+{
+    Component *pComponent = (Component *) pState;
+    TaskParam *pTask = (TaskParam *) pParam;
+    mfxStatus sts;
+
+    if (pComponent->waiter.IsActive())
+    {
+        sts = pComponent->waiter.Wait(pTask, [pTask]() { return DeviceWait(pTask); });
+        if (MFX_TASK_BUSY == sts)
+            return MFX_TASK_BUSY;
+    }
+    else
+    {
+        sts = DeviceWait(pTask);
+    }
+
+    if (MFX_ERR_NONE != sts)
+    {
+        pComponent->criticalError = sts;
+        return sts;
+    }
+
+    return MFX_TASK_DONE;
+}
+
+// Returns the number of frames with unexpected status
+static mfxU32 Run(bool useEvent, const FailureCase &failureCase, mfxU32 numFrames, mfxStatus &sts)
+{
+    MFXIUnknown *pUnk = nullptr;
+    MFXIScheduler2 *pScheduler = QueryInterface<MFXIScheduler2>(pUnk, MFXIScheduler2_GUID);
+    if (!pScheduler)
+    {
+        if (pUnk)
+            pUnk->Release();
+
+        sts = MFX_ERR_UNSUPPORTED;
+        return 0;
+    }
+
+    MFX_SCHEDULER_PARAM2 param = {};
+    param.flags = MFX_SCHEDULER_DEFAULT;
+    param.numberOfThreads = 2;
+    param.deviceNode = -1;
+
+    Component component;
+    component.failedFrame = failureCase.frame;
+    component.failure = failureCase.sts;
+    component.criticalError = MFX_ERR_NONE;
+
+    sts = pScheduler->Initialize2(&param);
+    if (MFX_ERR_NONE == sts && useEvent)
+        sts = component.waiter.Init();
+    if (MFX_ERR_NONE == sts && useEvent)
+        sts = pScheduler->RegisterHwEvent(&component, component.waiter.GetEvent());
+
+    mfxU32 mismatches = 0;
+
+    if (MFX_ERR_NONE == sts)
+    {
+        std::vector<TaskParam> params(numFrames);
+        std::vector<mfxStatus> statuses(numFrames, MFX_ERR_NONE);
+        std::deque<std::pair<mfxU32, mfxSyncPoint>> syncPoints;
+
+        for (mfxU32 i = 0; i < numFrames || !syncPoints.empty(); i++)
+        {
+            // the decoder doesn't accept new frames after the critical error
+            if (i < numFrames && MFX_ERR_NONE == component.criticalError)
+            {
+                params[i].pComponent = &component;
+                params[i].frame = i;
+
+                MFX_TASK task = {};
+                task.pOwner = &component;
+                task.entryPoint.pState = &component;
+                task.entryPoint.pParam = &params[i];
+                task.entryPoint.pRoutine = TaskRoutine;
+                task.entryPoint.requiredNumThreads = 1;
+                task.entryPoint.pRoutineName = "test";
+                task.pDst[0] = &params[i];
+                task.priority = MFX_PRIORITY_NORMAL;
+                task.threadingPolicy = MFX_TASK_THREADING_SHARED;
+
+                mfxSyncPoint syncPoint = nullptr;
+                sts = pScheduler->AddTask(task, &syncPoint);
+                if (MFX_ERR_NONE != sts)
+                    break;
+
+                syncPoints.emplace_back(i, syncPoint);
+                if (syncPoints.size() < MAX_FRAMES_IN_FLIGHT && i + 1 < numFrames)
+                    continue;
+            }
+
+            if (!syncPoints.empty())
+            {
+                statuses[syncPoints.front().first] = pScheduler->Synchronize(syncPoints.front().second, MFX_INFINITE);
+                syncPoints.pop_front();
+            }
+        }
+
+        for (mfxU32 i = 0; i < numFrames && MFX_ERR_NONE == sts; i++)
+        {
+            // frames after the failed one may still be decoded or not submitted at all
+            if (i > failureCase.frame)
+                break;
+
+            mfxStatus expected = (i == failureCase.frame) ? failureCase.sts : MFX_ERR_NONE;
+            if (statuses[i] != expected)
+            {
+                printf("  frame %u: status %d, expected %d\n", i, (int) statuses[i], (int) expected);
+                mismatches++;
+            }
+        }
+
+        if (MFX_ERR_NONE == sts && component.criticalError != failureCase.sts)
+        {
+            printf("  critical error %d, expected %d\n", (int) component.criticalError, (int) failureCase.sts);
+            mismatches++;
+        }
+    }
+
+    if (useEvent)
+        pScheduler->UnregisterHwEvent(&component);
+    component.waiter.Close();
+
+    pScheduler->Release();
+    pUnk->Release();
+
+    return mismatches;
+}
+
+int main(int argc, char *argv[])
+{
+    mfxU32 numFrames = 16;
+
+    if (argc == 2)
+    {
+        numFrames = (mfxU32) atoi(argv[1]);
+    }
+    else if (argc != 1)
+    {
+        printf("usage: %s [frames]\n", argv[0]);
+        return 1;
+    }
+
+    if (!numFrames)
+    {
+        printf("usage: %s [frames]\n", argv[0]);
+        return 1;
+    }
+
+    printf("%-8s %6s %6s %8s\n", "mode", "frame", "status", "result");
+
+    int failures = 0;
+
+    for (bool useEvent : { false, true })
+    {
+        for (FailureCase failureCase : failureCases)
+        {
+            if (failureCase.frame >= numFrames)
+                failureCase.frame = numFrames - 1;
+
+            mfxStatus sts = MFX_ERR_NONE;
+            mfxU32 mismatches = Run(useEvent, failureCase, numFrames, sts);
+
+            const char *result = (MFX_ERR_NONE != sts) ? "error" : (mismatches ? "failed" : "ok");
+            if (MFX_ERR_NONE != sts || mismatches)
+                failures++;
+
+            printf("%-8s %6u %6d %8s\n", useEvent ? "event" : "blocking", failureCase.frame, (int) failureCase.sts, result);
+        }
+    }
+
+    return failures ? 1 : 0;
+}
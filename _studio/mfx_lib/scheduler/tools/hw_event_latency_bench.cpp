@@ -0,0 +1,312 @@
+// Copyright (c) 2025 Intel Corporation
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+// Latency of HW completion waits in scheduler tasks with a mock device.
+// Every component has its own device queue, which finishes a frame the given
+// number of microseconds after the previous one. Application threads add one
+// task per frame, and the task waits for the frame:
+//   blocking - the wait runs in the task and holds the worker thread
+//   polling  - HwCompletionWaiter waits, the task returns MFX_TASK_BUSY until done
+//   event    - as polling, the waiter event is registered in the scheduler
+// The wake-up latency is the time from the end of the wait to the task seeing it.
+//
+// Usage:
+//   hw_event_latency_bench [frames [frame_usec]]
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <ctime>
+#include <deque>
+#include <thread>
+#include <vector>
+
+#include "mfx_interface_scheduler.h"
+#include "mfx_task.h"
+#include "mfx_hw_completion_waiter.h"
+
+typedef std::chrono::steady_clock Clock;
+
+struct BenchConfig
+{
+    mfxU32 components;
+    mfxU32 workers;
+};
+
+static const BenchConfig configs[] =
+{
+    { 1, 2 },
+    { 4, 2 },
+    { 4, 4 },
+};
+
+enum WaitMode
+{
+    WAIT_BLOCKING,
+    WAIT_POLLING,
+    WAIT_EVENT
+};
+
+static const char *modeNames[] = { "blocking", "polling", "event" };
+
+// frames submitted to the device and not synchronized yet, per component
+static const size_t MAX_FRAMES_IN_FLIGHT = 4;
+
+struct Component
+{
+    HwCompletionWaiter waiter;
+    Clock::time_point  deviceBusyUntil;
+};
+
+struct TaskParam
+{
+    Clock::time_point ready;        // the mock device finishes the frame
+    Clock::time_point finished;     // the wait returned
+    Clock::time_point seen;         // the task got the result
+    mfxU32            calls;
+};
+
+static mfxStatus DeviceWait(TaskParam *pTask)
+{
+    std::this_thread::sleep_until(pTask->ready);
+    pTask->finished = Clock::now();
+
+    return MFX_ERR_NONE;
+}
+
+static mfxStatus TaskRoutine(void *pState, void *pParam, mfxU32, mfxU32)
+{
+    Component *pComponent = (Component *) pState;
+    TaskParam *pTask = (TaskParam *) pParam;
+    mfxStatus sts;
+
+    pTask->calls++;
+
+    if (pComponent->waiter.IsActive())
+    {
+        sts = pComponent->waiter.Wait(pTask, [pTask]() { return DeviceWait(pTask); });
+        if (MFX_TASK_BUSY == sts)
+            return MFX_TASK_BUSY;
+    }
+    else
+    {
+        sts = DeviceWait(pTask);
+    }
+
+    pTask->seen = Clock::now();
+
+    return (MFX_ERR_NONE == sts) ? MFX_TASK_DONE : sts;
+}
+
+static void Produce(MFXIScheduler2 *pScheduler, Component *pComponent, std::vector<TaskParam> &params,
+    Clock::duration frameTime, mfxStatus &sts)
+{
+    std::deque<mfxSyncPoint> syncPoints;
+
+    sts = MFX_ERR_NONE;
+
+    for (TaskParam &param : params)
+    {
+        // the frame is queued to the device before the task is added, like a decoder does
+        pComponent->deviceBusyUntil = std::max(pComponent->deviceBusyUntil, Clock::now()) + frameTime;
+        param.ready = pComponent->deviceBusyUntil;
+
+        MFX_TASK task = {};
+        task.pOwner = pComponent;
+        task.entryPoint.pState = pComponent;
+        task.entryPoint.pParam = &param;
+        task.entryPoint.pRoutine = TaskRoutine;
+        task.entryPoint.requiredNumThreads = 1;
+        task.entryPoint.pRoutineName = "bench";
+        task.pDst[0] = &param;
+        task.priority = MFX_PRIORITY_NORMAL;
+        task.threadingPolicy = MFX_TASK_THREADING_SHARED;
+
+        mfxSyncPoint syncPoint = nullptr;
+        sts = pScheduler->AddTask(task, &syncPoint);
+        if (MFX_ERR_NONE != sts)
+            break;
+
+        syncPoints.push_back(syncPoint);
+        if (syncPoints.size() >= MAX_FRAMES_IN_FLIGHT)
+        {
+            sts = pScheduler->Synchronize(syncPoints.front(), MFX_INFINITE);
+            syncPoints.pop_front();
+            if (MFX_ERR_NONE != sts)
+                break;
+        }
+    }
+
+    for (mfxSyncPoint syncPoint : syncPoints)
+    {
+        mfxStatus syncSts = pScheduler->Synchronize(syncPoint, MFX_INFINITE);
+        if (MFX_ERR_NONE == sts)
+            sts = syncSts;
+    }
+}
+
+struct RunResult
+{
+    mfxStatus sts;
+    double    seconds;
+    double    cpuSeconds;
+    double    callsPerFrame;
+    double    latencyP50;       // usec
+    double    latencyP99;       // usec
+};
+
+static RunResult Run(const BenchConfig &config, WaitMode mode, mfxU32 numFrames, Clock::duration frameTime)
+{
+    RunResult result = {};
+
+    MFXIUnknown *pUnk = nullptr;
+    MFXIScheduler2 *pScheduler = QueryInterface<MFXIScheduler2>(pUnk, MFXIScheduler2_GUID);
+    if (!pScheduler)
+    {
+        if (pUnk)
+            pUnk->Release();
+
+        result.sts = MFX_ERR_UNSUPPORTED;
+        return result;
+    }
+
+    MFX_SCHEDULER_PARAM2 param = {};
+    param.flags = MFX_SCHEDULER_DEFAULT;
+    param.numberOfThreads = config.workers;
+    param.deviceNode = -1;
+
+    result.sts = pScheduler->Initialize2(&param);
+
+    std::vector<Component> components(config.components);
+
+    for (Component &component : components)
+    {
+        if (MFX_ERR_NONE == result.sts && WAIT_BLOCKING != mode)
+            result.sts = component.waiter.Init();
+        if (MFX_ERR_NONE == result.sts && WAIT_EVENT == mode)
+            result.sts = pScheduler->RegisterHwEvent(&component, component.waiter.GetEvent());
+    }
+
+    if (MFX_ERR_NONE == result.sts)
+    {
+        std::vector<std::vector<TaskParam>> params(config.components, std::vector<TaskParam>(numFrames, TaskParam()));
+        std::vector<mfxStatus>              statuses(config.components, MFX_ERR_NONE);
+        std::vector<std::thread>            threads;
+
+        std::clock_t cpuStart = std::clock();
+        auto start = Clock::now();
+
+        for (mfxU32 i = 0; i < config.components; i++)
+            threads.emplace_back(Produce, pScheduler, &components[i], std::ref(params[i]), frameTime, std::ref(statuses[i]));
+
+        for (auto &thread : threads)
+            thread.join();
+
+        result.seconds = std::chrono::duration<double>(Clock::now() - start).count();
+        result.cpuSeconds = (double) (std::clock() - cpuStart) / CLOCKS_PER_SEC;
+
+        std::vector<double> latencies;
+        mfxU64 calls = 0;
+
+        for (mfxU32 i = 0; i < config.components; i++)
+        {
+            if (MFX_ERR_NONE == result.sts)
+                result.sts = statuses[i];
+
+            for (const TaskParam &task : params[i])
+            {
+                calls += task.calls;
+                latencies.push_back(std::chrono::duration<double, std::micro>(task.seen - task.finished).count());
+            }
+        }
+
+        std::sort(latencies.begin(), latencies.end());
+
+        result.callsPerFrame = (double) calls / latencies.size();
+        result.latencyP50 = latencies[latencies.size() / 2];
+        result.latencyP99 = latencies[std::min(latencies.size() - 1, latencies.size() * 99 / 100)];
+    }
+
+    for (Component &component : components)
+    {
+        if (WAIT_EVENT == mode)
+            pScheduler->UnregisterHwEvent(&component);
+        component.waiter.Close();
+    }
+
+    pScheduler->Release();
+    pUnk->Release();
+
+    return result;
+}
+
+int main(int argc, char *argv[])
+{
+    mfxU32 numFrames = 200;
+    int frameUsec = 2000;
+
+    if (argc == 2 || argc == 3)
+    {
+        numFrames = (mfxU32) atoi(argv[1]);
+        if (argc == 3)
+            frameUsec = atoi(argv[2]);
+    }
+    else if (argc != 1)
+    {
+        printf("usage: %s [frames [frame_usec]]\n", argv[0]);
+        return 1;
+    }
+
+    if (!numFrames || frameUsec <= 0)
+    {
+        printf("usage: %s [frames [frame_usec]]\n", argv[0]);
+        return 1;
+    }
+
+    Clock::duration frameTime = std::chrono::microseconds(frameUsec);
+
+    printf("%u frames of %d usec per component, %u hardware threads\n",
+        numFrames, frameUsec, std::thread::hardware_concurrency());
+    printf("%10s %7s %-8s %9s %6s %11s %8s %8s\n", "components", "workers", "mode", "frames/s", "cpu %", "calls/frame", "p50 us", "p99 us");
+
+    int failures = 0;
+
+    for (const BenchConfig &config : configs)
+    {
+        for (WaitMode mode : { WAIT_BLOCKING, WAIT_POLLING, WAIT_EVENT })
+        {
+            RunResult result = Run(config, mode, numFrames, frameTime);
+            if (MFX_ERR_NONE != result.sts)
+            {
+                printf("%10u %7u %-8s failed, status %d\n", config.components, config.workers, modeNames[mode], (int) result.sts);
+                failures++;
+                continue;
+            }
+
+            printf("%10u %7u %-8s %9.1f %6.1f %11.1f %8.1f %8.1f\n", config.components, config.workers, modeNames[mode],
+                numFrames * config.components / result.seconds, result.cpuSeconds / result.seconds * 100,
+                result.callsPerFrame, result.latencyP50, result.latencyP99);
+        }
+    }
+
+    return failures ? 1 : 0;
+}
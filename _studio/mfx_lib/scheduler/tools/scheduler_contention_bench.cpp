@@ -0,0 +1,312 @@
+// Copyright (c) 2025 Intel Corporation
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+
+// Task throughput of the scheduler under contention.
+// N application threads add tasks organized in dependency chains: every task
+// of a chain takes the output of the previous one, chains are independent.
+// M worker threads run them. Every configuration runs with the default
+// scheduler and with MFX_SCHEDULER_WORK_STEALING. Each task spins for the
+// given number of microseconds, so short tasks stress the scheduler itself.
+//
+// Usage:
+//   scheduler_contention_bench [tasks [task_usec [iterations]]]
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <deque>
+#include <thread>
+#include <vector>
+
+#include "mfx_interface_scheduler.h"
+#include "mfx_task.h"
+
+struct BenchConfig
+{
+    mfxU32 producers;
+    mfxU32 workers;
+    mfxU32 chains;      // per producer
+};
+
+static const BenchConfig configs[] =
+{
+    { 1, 2, 1 },
+    { 1, 2, 8 },
+    { 1, 8, 8 },
+    { 2, 4, 4 },
+    { 4, 4, 4 },
+    { 4, 8, 8 },
+    { 8, 8, 2 },
+};
+
+// tasks which are added and not synchronized yet, per producer
+static const size_t MAX_TASKS_IN_FLIGHT = 64;
+
+struct Chain
+{
+    mfxU32 next;        // index of the task expected to run
+    mfxU32 errors;      // tasks started out of the chain order
+};
+
+struct TaskParam
+{
+    Chain  *pChain;
+    mfxU32  index;
+    double  usec;
+};
+
+static mfxStatus TaskRoutine(void *, void *pParam, mfxU32, mfxU32)
+{
+    TaskParam *pTask = (TaskParam *) pParam;
+
+    if (pTask->pChain->next != pTask->index)
+        pTask->pChain->errors++;
+    pTask->pChain->next = pTask->index + 1;
+
+    auto start = std::chrono::steady_clock::now();
+    while (std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count() < pTask->usec)
+        ;
+
+    return MFX_TASK_DONE;
+}
+
+struct RunResult
+{
+    mfxStatus sts;
+    double    seconds;
+    mfxU32    errors;
+    mfxU64    submitToStartP50;
+    mfxU64    submitToStartP99;
+    mfxU64    numMigrations;
+};
+
+static void Produce(MFXIScheduler2 *pScheduler, std::vector<Chain> &chains, std::vector<TaskParam> &params,
+    std::vector<char> &tokens, mfxU32 numTasks, mfxStatus &sts)
+{
+    std::deque<mfxSyncPoint> syncPoints;
+    mfxU32 numChains = (mfxU32) chains.size();
+
+    sts = MFX_ERR_NONE;
+
+    for (mfxU32 i = 0; i < numTasks && MFX_ERR_NONE == sts; i++)
+    {
+        mfxU32 chain = i % numChains;
+        mfxU32 index = i / numChains;
+
+        params[i] = { &chains[chain], index, params[i].usec };
+
+        // dependencies are only compared by address, one byte per task is a unique address
+        MFX_TASK task = {};
+        task.pOwner = &chains[chain];
+        task.entryPoint.pState = &chains[chain];
+        task.entryPoint.pParam = &params[i];
+        task.entryPoint.pRoutine = TaskRoutine;
+        task.entryPoint.requiredNumThreads = 1;
+        task.entryPoint.pRoutineName = "bench";
+        task.pSrc[0] = index ? &tokens[i - numChains] : nullptr;
+        task.pDst[0] = &tokens[i];
+        task.priority = MFX_PRIORITY_NORMAL;
+        task.threadingPolicy = MFX_TASK_THREADING_INTRA;
+
+        mfxSyncPoint syncPoint = nullptr;
+        sts = pScheduler->AddTask(task, &syncPoint);
+        if (MFX_ERR_NONE != sts)
+            break;
+
+        syncPoints.push_back(syncPoint);
+        if (syncPoints.size() > MAX_TASKS_IN_FLIGHT)
+        {
+            sts = pScheduler->Synchronize(syncPoints.front(), MFX_INFINITE);
+            syncPoints.pop_front();
+        }
+    }
+
+    for (mfxSyncPoint syncPoint : syncPoints)
+    {
+        mfxStatus syncSts = pScheduler->Synchronize(syncPoint, MFX_INFINITE);
+        if (MFX_ERR_NONE == sts)
+            sts = syncSts;
+    }
+}
+
+static RunResult Run(const BenchConfig &config, mfxSchedulerFlags flags, mfxU32 numTasks, double usec)
+{
+    RunResult result = {};
+
+    MFXIUnknown *pUnk = nullptr;
+    MFXIScheduler2 *pScheduler = QueryInterface<MFXIScheduler2>(pUnk, MFXIScheduler2_GUID);
+    MFXISchedulerStat *pStat = pUnk ? (MFXISchedulerStat *) pUnk->QueryInterface(MFXISchedulerStat_GUID) : nullptr;
+    if (!pScheduler || !pStat)
+    {
+        if (pStat)
+            pStat->Release();
+        if (pScheduler)
+            pScheduler->Release();
+        if (pUnk)
+            pUnk->Release();
+
+        result.sts = MFX_ERR_UNSUPPORTED;
+        return result;
+    }
+
+    MFX_SCHEDULER_PARAM2 param = {};
+    param.flags = flags;
+    param.numberOfThreads = config.workers;
+    param.deviceNode = -1;
+
+    result.sts = pScheduler->Initialize2(&param);
+
+    if (MFX_ERR_NONE == result.sts)
+    {
+        mfxU32 tasksPerProducer = numTasks / config.producers;
+
+        std::vector<std::vector<Chain>>     chains(config.producers, std::vector<Chain>(config.chains, Chain()));
+        std::vector<std::vector<TaskParam>> params(config.producers, std::vector<TaskParam>(tasksPerProducer, TaskParam{ nullptr, 0, usec }));
+        std::vector<std::vector<char>>      tokens(config.producers, std::vector<char>(tasksPerProducer));
+        std::vector<mfxStatus>              statuses(config.producers, MFX_ERR_NONE);
+        std::vector<std::thread>            threads;
+
+        auto start = std::chrono::steady_clock::now();
+
+        for (mfxU32 i = 0; i < config.producers; i++)
+            threads.emplace_back(Produce, pScheduler, std::ref(chains[i]), std::ref(params[i]), std::ref(tokens[i]),
+                tasksPerProducer, std::ref(statuses[i]));
+
+        for (auto &thread : threads)
+            thread.join();
+
+        result.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+        for (mfxU32 i = 0; i < config.producers; i++)
+        {
+            if (MFX_ERR_NONE == result.sts)
+                result.sts = statuses[i];
+
+            for (const Chain &chain : chains[i])
+                result.errors += chain.errors;
+        }
+
+        MFX_SCHEDULER_STAT stat = {};
+        if (MFX_ERR_NONE == pStat->GetStat(nullptr, &stat))
+        {
+            result.submitToStartP50 = GetLatencyPercentile(stat.latency[MFX_SCHEDULER_STAT_SUBMIT_TO_START], 50);
+            result.submitToStartP99 = GetLatencyPercentile(stat.latency[MFX_SCHEDULER_STAT_SUBMIT_TO_START], 99);
+            result.numMigrations = stat.numMigrations;
+        }
+    }
+
+    pStat->Release();
+    pScheduler->Release();
+    pUnk->Release();
+
+    return result;
+}
+
+int main(int argc, char *argv[])
+{
+    mfxU32 numTasks = 100000;
+    double usec = 1;
+    int iterations = 3;
+
+    if (argc >= 2 && argc <= 4)
+    {
+        numTasks = (mfxU32) atoi(argv[1]);
+        if (argc >= 3)
+            usec = atof(argv[2]);
+        if (argc == 4)
+            iterations = atoi(argv[3]);
+    }
+    else if (argc != 1)
+    {
+        printf("usage: %s [tasks [task_usec [iterations]]]\n", argv[0]);
+        return 1;
+    }
+
+    if (!numTasks || usec < 0 || iterations <= 0)
+    {
+        printf("usage: %s [tasks [task_usec [iterations]]]\n", argv[0]);
+        return 1;
+    }
+
+    // the mode is selected explicitly below
+    unsetenv("VPL_SCHEDULER_WORK_STEALING");
+
+    printf("%u tasks of %.1f usec, %d iterations, best time of each run, %u hardware threads\n",
+        numTasks, usec, iterations, std::thread::hardware_concurrency());
+    printf("%9s %7s %6s %-8s %10s %8s %8s %8s %10s\n", "producers", "workers", "chains", "mode", "Ktasks/s", "speedup", "p50 us", "p99 us", "migrations");
+
+    int failures = 0;
+
+    for (const BenchConfig &config : configs)
+    {
+        double defaultTime = 0;
+
+        for (mfxSchedulerFlags flags : { MFX_SCHEDULER_DEFAULT, MFX_SCHEDULER_WORK_STEALING })
+        {
+            const char *mode = (MFX_SCHEDULER_DEFAULT == flags) ? "default" : "stealing";
+            RunResult best = {};
+
+            for (int i = 0; i < iterations; i++)
+            {
+                RunResult result = Run(config, flags, numTasks, usec);
+                if (MFX_ERR_NONE != result.sts || result.errors)
+                {
+                    best = result;
+                    break;
+                }
+
+                if (!i || result.seconds < best.seconds)
+                    best = result;
+            }
+
+            if (MFX_ERR_NONE != best.sts || best.errors)
+            {
+                printf("%9u %7u %6u %-8s failed, status %d, %u tasks out of order\n",
+                    config.producers, config.workers, config.chains, mode, (int) best.sts, best.errors);
+                failures++;
+                continue;
+            }
+
+            mfxU32 tasksRun = numTasks / config.producers * config.producers;
+
+            if (MFX_SCHEDULER_DEFAULT == flags)
+            {
+                defaultTime = best.seconds;
+                printf("%9u %7u %6u %-8s %10.1f %8s %8llu %8llu %10llu\n", config.producers, config.workers, config.chains, mode,
+                    tasksRun / best.seconds * 1e-3, "",
+                    (unsigned long long) best.submitToStartP50, (unsigned long long) best.submitToStartP99,
+                    (unsigned long long) best.numMigrations);
+            }
+            else
+            {
+                printf("%9u %7u %6u %-8s %10.1f %7.2fx %8llu %8llu %10llu\n", config.producers, config.workers, config.chains, mode,
+                    tasksRun / best.seconds * 1e-3, defaultTime ? defaultTime / best.seconds : 0.,
+                    (unsigned long long) best.submitToStartP50, (unsigned long long) best.submitToStartP99,
+                    (unsigned long long) best.numMigrations);
+            }
+        }
+    }
+
+    return failures ? 1 : 0;
+}
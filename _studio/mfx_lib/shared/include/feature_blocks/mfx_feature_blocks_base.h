@@ -25,6 +25,11 @@
 
 #include <list>
 #include <map>
+#include <vector>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
 #include <exception>
 #include <functional>
 
@@ -185,6 +190,100 @@ public:
     std::map<mfxU32, mfxU32> m_initialized; //FeatureID -> FeatureMode
 };
 
+// VPL_FEATURE_BLOCKS_PROFILE=1 enables per block time accounting in frozen queues
+inline bool IsFrozenQueueProfilingOn()
+{
+    const char* pProfile = std::getenv("VPL_FEATURE_BLOCKS_PROFILE");
+    return pProfile && !std::strcmp(pProfile, "1");
+}
+
+// Contiguous copy of a block queue made once the queue is final (before the first frame).
+// Runtime stages iterate it instead of the list. With profiling on every block
+// is wrapped to accumulate its calls and time, Report() prints them.
+template<class TBlock>
+class FrozenQueue
+{
+public:
+    using value_type      = TBlock;
+    using const_reference = const TBlock&;
+    using const_iterator  = typename std::vector<TBlock>::const_iterator;
+
+    template<class TQ>
+    void Freeze(const TQ& queue, bool bProfile)
+    {
+        m_blocks.assign(queue.begin(), queue.end());
+        m_stat.reset(bProfile ? new Stat[m_blocks.size()] : nullptr);
+
+        for (size_t i = 0; bProfile && i < m_blocks.size(); ++i)
+        {
+            typename TBlock::TCall call = std::move(m_blocks[i].m_call);
+            Stat* pStat = &m_stat[i];
+
+            m_blocks[i].m_call = [call, pStat](auto&&... args) -> typename TBlock::TCall::result_type
+            {
+                ProfileScope scope(*pStat);
+                return call(std::forward<decltype(args)>(args)...);
+            };
+        }
+    }
+
+    void Report(const char* stage) const
+    {
+        for (size_t i = 0; m_stat && i < m_blocks.size(); ++i)
+        {
+            const TBlock& blk   = m_blocks[i];
+            mfxU64        calls = m_stat[i].calls;
+            mfxU64        ns    = m_stat[i].ns;
+
+            if (!calls)
+                continue;
+
+            MfxLogPrint("FeatureBlocks %s: %s::%s (%u:%u) calls %llu total %.3f ms avg %.3f us\n"
+                , stage
+                , blk.m_featureName ? blk.m_featureName : "?"
+                , blk.m_blockName ? blk.m_blockName : "?"
+                , blk.FeatureID, blk.BlockID
+                , (unsigned long long)calls, ns / 1e6, ns / 1e3 / calls);
+        }
+    }
+
+    const_iterator begin() const { return m_blocks.begin(); }
+    const_iterator end()   const { return m_blocks.end(); }
+    size_t         size()  const { return m_blocks.size(); }
+    bool           empty() const { return m_blocks.empty(); }
+
+private:
+    struct Stat
+    {
+        std::atomic<mfxU64> calls{ 0 };
+        std::atomic<mfxU64> ns{ 0 };
+    };
+
+    class ProfileScope
+    {
+    public:
+        ProfileScope(Stat& stat)
+            : m_stat(stat)
+            , m_start(std::chrono::steady_clock::now())
+        {}
+
+        ~ProfileScope()
+        {
+            auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - m_start);
+
+            m_stat.calls.fetch_add(1, std::memory_order_relaxed);
+            m_stat.ns.fetch_add(mfxU64(ns.count()), std::memory_order_relaxed);
+        }
+
+    private:
+        Stat&                                 m_stat;
+        std::chrono::steady_clock::time_point m_start;
+    };
+
+    std::vector<TBlock>     m_blocks;
+    std::unique_ptr<Stat[]> m_stat;
+};
+
 class IBlockTracer
 {
 public:
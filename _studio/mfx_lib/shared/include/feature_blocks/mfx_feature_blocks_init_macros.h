@@ -32,15 +32,24 @@ template<mfxU32 QID> void Push(const ID id, typename BQ<QID>::TCall&& call) \
 
 #define MFX_FEATURE_BLOCKS_DECLARE_QUEUES_IN_FEATURE_BLOCK(NAME, ABR, RTYPE, ...)\
     static const mfxU32 BQ_##NAME = __LINE__;\
-    std::list<Block<std::function<RTYPE(__VA_ARGS__)>>> m_q##NAME;
+    std::list<Block<std::function<RTYPE(__VA_ARGS__)>>> m_q##NAME;\
+    FrozenQueue<Block<std::function<RTYPE(__VA_ARGS__)>>> m_f##NAME;
+
+#define MFX_FEATURE_BLOCKS_FREEZE_QUEUES_IN_FEATURE_BLOCK(NAME, ABR, RTYPE, ...)\
+    m_f##NAME.Freeze(m_q##NAME, m_bProfile);
+
+#define MFX_FEATURE_BLOCKS_REPORT_QUEUES_IN_FEATURE_BLOCK(NAME, ABR, RTYPE, ...)\
+    m_f##NAME.Report(#NAME);
 
 #define MFX_FEATURE_BLOCKS_DECLARE_QUEUES_EXTERNAL(NAME, ABR, RTYPE, ...)\
 template<> struct FeatureBlocks::BQ <FeatureBlocks::BQ_##NAME>\
 {\
     typedef std::function<RTYPE(__VA_ARGS__)> TCall;\
     typedef std::list<FeatureBlocks::Block<TCall>> TQueue;\
+    typedef FrozenQueue<FeatureBlocks::Block<TCall>> TFrozen;\
     static TQueue& Get(FeatureBlocks& blk) { return blk.m_q##NAME;}\
     static const TQueue& Get(const FeatureBlocks& blk) { return blk.m_q##NAME;}\
+    static const TFrozen& GetFrozen(const FeatureBlocks& blk) { return blk.m_f##NAME;}\
     static void Push(FeatureBlocks& blks, const ID id, TCall&& call)\
     { blks.Push(blks.m_q##NAME, id, std::move(call)); }\
 };
@@ -24,8 +24,10 @@
 #include "mfxvideo.h"
 #include "mfx_utils_logging.h"
 
+#include <array>
 #include <memory>
 #include <list>
+#include <vector>
 #include <exception>
 #include <functional>
 #include <algorithm>
@@ -94,37 +96,113 @@ std::unique_ptr<typename std::conditional<std::is_base_of<Storable, T>::value, T
         (std::forward<Args>(args)...);
 }
 
+// Keys are dense indices (see __LINE__ - _KD in codec data headers), so objects are kept
+// in flat slots indexed by key. Lower keys are kept inline, task and local storages
+// don't allocate slots at all.
 class StorageR
 {
 public:
     typedef mfxU32 TKey;
     static const TKey KEY_INVALID = TKey(-1);
+    static const TKey NUM_INLINE_KEYS = 16;
+    static const TKey MAX_KEYS = 1024;
+
+    StorageR() = default;
+
+    StorageR(StorageR&& other)
+    {
+        *this = std::move(other);
+    }
+
+    StorageR& operator=(StorageR&& other)
+    {
+        if (this == &other)
+            return *this;
+
+        Reset();
+        m_inline = std::move(other.m_inline);
+        m_extra  = std::move(other.m_extra);
+        m_size   = other.m_size;
+        other.m_extra.clear();
+        other.m_size = 0;
+        return *this;
+    }
+
+    ~StorageR()
+    {
+        Reset();
+    }
 
     template<class T>
     const T& Read(TKey key) const
     {
-        auto it = m_map.find(key);
-        if (it == m_map.end())
+        return dynamic_cast<T&>(Get(key));
+    }
+
+    bool Contains(TKey key) const
+    {
+        return !!Find(key);
+    }
+
+    bool Empty() const
+    {
+        return !m_size;
+    }
+
+protected:
+    using TSlot = std::unique_ptr<Storable>;
+
+    std::array<TSlot, NUM_INLINE_KEYS> m_inline;
+    std::vector<TSlot>                 m_extra;
+    size_t                             m_size = 0;
+
+    Storable* Find(TKey key) const
+    {
+        if (key < NUM_INLINE_KEYS)
+            return m_inline[key].get();
+
+        key -= NUM_INLINE_KEYS;
+        return key < m_extra.size() ? m_extra[key].get() : nullptr;
+    }
+
+    Storable& Get(TKey key) const
+    {
+        auto pObj = Find(key);
+        if (!pObj)
         {
             std::stringstream ss;
             ss << "Requested object with Key " << key << " was not found in storage";
             throw std::logic_error(ss.str());
         }
-        return dynamic_cast<T&>(*it->second);
+        return *pObj;
     }
 
-    bool Contains(TKey key) const
+    TSlot& Slot(TKey key)
     {
-        return (m_map.find(key) != m_map.end());
+        if (key >= MAX_KEYS)
+            throw std::logic_error("Storage keys must be dense");
+
+        if (key < NUM_INLINE_KEYS)
+            return m_inline[key];
+
+        key -= NUM_INLINE_KEYS;
+        if (key >= m_extra.size())
+            m_extra.resize(key + 1);
+
+        return m_extra[key];
     }
 
-    bool Empty() const
+    // objects are destroyed in key order as it was with ordered map
+    void Reset()
     {
-        return m_map.empty();
-    }
+        for (auto& slot : m_inline)
+            slot.reset();
+        for (auto& slot : m_extra)
+            slot.reset();
 
-protected:
-    std::map<TKey, std::unique_ptr<Storable>> m_map;
+        m_extra.clear();
+        m_size = 0;
+    }
 };
 
 class StorageW : public StorageR
@@ -133,14 +211,7 @@ public:
     template<class T>
     T& Write(TKey key) const
     {
-        auto it = m_map.find(key);
-        if (it == m_map.end())
-        {
-            std::stringstream ss;
-            ss << "Requested object with Key " << key << " was not found in storage";
-            throw std::logic_error(ss.str());
-        }
-        return dynamic_cast<T&>(*it->second);
+        return dynamic_cast<T&>(Get(key));
     }
 };
 
@@ -149,7 +220,13 @@ class StorageRW : public StorageW
 public:
     bool TryInsert(TKey key, std::unique_ptr<Storable>&& pObj)
     {
-        return m_map.emplace(key, std::move(pObj)).second;
+        auto& slot = Slot(key);
+        if (slot)
+            return false;
+
+        slot = std::move(pObj);
+        ++m_size;
+        return true;
     }
 
     void Insert(TKey key, std::unique_ptr<Storable>&& pObj)
@@ -172,12 +249,16 @@ public:
 
     void Erase(TKey key)
     {
-        m_map.erase(key);
+        if (!Find(key))
+            return;
+
+        Slot(key).reset();
+        --m_size;
     }
 
     void Clear()
     {
-        m_map.clear();
+        Reset();
     }
 };
 
@@ -0,0 +1,60 @@
+// Copyright (c) 2025 Intel Corporation
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#ifndef __MFX_CAPS_CACHE_H__
+#define __MFX_CAPS_CACHE_H__
+
+#include "mfx_common.h"
+#include "mfx_utils.h"
+
+#include <string>
+
+// On-disk cache of MFXQueryImplsDescription results.
+// Enabled by VPL_CAPS_CACHE=1, files are kept in $XDG_CACHE_HOME/libmfx-gen
+// (or ~/.cache/libmfx-gen), one file per render node.
+namespace mfx
+{
+namespace caps_cache
+{
+    enum class Result
+    {
+        Miss,        // no valid cache entry, capabilities have to be queried
+        Unsupported, // the adapter was queried before and has no VPL support
+        Hit          // the description is restored
+    };
+
+    struct Key
+    {
+        mfxU32      deviceId;
+        mfxU32      adapterNum;
+        std::string driver;   // driver vendor string, it includes the driver version
+    };
+
+    bool IsEnabled();
+
+    // Restore the adapter description stored with the same key by the same library build
+    Result Load(const Key& key, mfxImplDescription& impl, PODArraysHolder& ah);
+
+    // Store the adapter description, nullptr marks the adapter as not supported
+    void Store(const Key& key, const mfxImplDescription* pImpl);
+}
+}
+
+#endif // __MFX_CAPS_CACHE_H__
@@ -37,11 +37,19 @@ static const
 MFX_GUID MFXIScheduler2_GUID =
 { 0xdc775b1c, 0x951d, 0x421f, { 0xbf, 0xd8, 0xca, 0x56, 0x2d, 0x95, 0xa4, 0x18 } };
 
+// {FF0BAB39-6614-4B4D-A0B5-6438FBA506B4}
+static const
+MFX_GUID MFXISchedulerStat_GUID =
+{ 0xff0bab39, 0x6614, 0x4b4d, { 0xa0, 0xb5, 0x64, 0x38, 0xfb, 0xa5, 0x06, 0xb4 } };
+
 enum mfxSchedulerFlags
 {
     // default behaviour policy
     MFX_SCHEDULER_DEFAULT = 0,
-    MFX_SINGLE_THREAD = 1
+    MFX_SINGLE_THREAD = 1,
+    // threads keep ready tasks in own work-stealing queues,
+    // also enabled by VPL_SCHEDULER_WORK_STEALING=1 environment variable
+    MFX_SCHEDULER_WORK_STEALING = 2
 };
 
 enum mfxSchedulerMessage
@@ -132,10 +140,28 @@ public:
 #endif // defined(SCHEDULER_DEBUG)
 };
 
+// Placement of worker threads over NUMA nodes
+enum mfxSchedulerPlacement
+{
+    // threads are not bound, the OS places them
+    MFX_SCHEDULER_PLACEMENT_NONE = 0,
+    // fill NUMA nodes one after another
+    MFX_SCHEDULER_PLACEMENT_COMPACT = 1,
+    // distribute threads over NUMA nodes round robin
+    MFX_SCHEDULER_PLACEMENT_SCATTER = 2,
+    // bind all threads to the NUMA node owning the device
+    MFX_SCHEDULER_PLACEMENT_DEVICE_NODE = 3
+};
+
 struct MFX_SCHEDULER_PARAM2: public MFX_SCHEDULER_PARAM
 {
     // user-adjustable extended parameters
     mfxExtThreadsParam params;
+
+    // placement of worker threads
+    mfxSchedulerPlacement placement;
+    // NUMA node of the device, -1 if unknown
+    mfxI32 deviceNode;
 };
 
 class MFXIScheduler2 : public MFXIScheduler
@@ -150,6 +176,126 @@ public:
     virtual
     mfxStatus GetTimeout(mfxU32 & maxTimeToRun) = 0;
 
+    // Register an eventfd, which the owner signals on HW completion.
+    // 'Busy' tasks of the owner sleep until the event, instead of being respun.
+    virtual
+    mfxStatus RegisterHwEvent(const void *pOwner, int eventFd) = 0;
+
+    // Stop listening to HW completion events of the owner
+    virtual
+    mfxStatus UnregisterHwEvent(const void *pOwner) = 0;
+
+    // Set NUMA node of the device, when the device handle is known.
+    // Threads placed on the device node are moved to it.
+    virtual
+    mfxStatus SetDeviceNode(mfxI32 deviceNode) = 0;
+
+};
+
+// Kinds of task latencies collected by the scheduler
+enum mfxSchedulerStatKind
+{
+    // from AddTask to the first call of the task's routine
+    MFX_SCHEDULER_STAT_SUBMIT_TO_START = 0,
+    // integral time of all calls of the task's routine
+    MFX_SCHEDULER_STAT_RUN = 1,
+    // from AddTask until the dependencies of the task are resolved
+    MFX_SCHEDULER_STAT_DEPENDENCY_WAIT = 2,
+    // time spent in Synchronize on the task
+    MFX_SCHEDULER_STAT_SYNC_WAIT = 3,
+
+    MFX_SCHEDULER_STAT_KINDS = 4
+};
+
+enum
+{
+    // values below MFX_LATENCY_SUB_BUCKETS are exact,
+    // larger ones are kept with 1/MFX_LATENCY_SUB_BUCKETS relative precision
+    MFX_LATENCY_SUB_BUCKET_BITS = 3,
+    MFX_LATENCY_SUB_BUCKETS = 1 << MFX_LATENCY_SUB_BUCKET_BITS,
+    // values of 2^MFX_LATENCY_MAX_BITS usec and above go to the last bucket
+    MFX_LATENCY_MAX_BITS = 32,
+    MFX_LATENCY_BUCKETS = (MFX_LATENCY_MAX_BITS - MFX_LATENCY_SUB_BUCKET_BITS + 1) * MFX_LATENCY_SUB_BUCKETS
+};
+
+// Log-linear histogram of latencies in microseconds
+struct MFX_LATENCY_HISTOGRAM
+{
+    mfxU64 count;                           // number of values
+    mfxU64 sum;                             // sum of values
+    mfxU64 max;                             // the largest value
+    mfxU32 buckets[MFX_LATENCY_BUCKETS];    // number of values in every bucket
+};
+
+struct MFX_SCHEDULER_STAT
+{
+    MFX_LATENCY_HISTOGRAM latency[MFX_SCHEDULER_STAT_KINDS];
+
+    // CPU and NUMA node changes of worker threads between tasks,
+    // counted for all tasks, zero in statistics of an owner
+    mfxU64 numMigrations;
+    mfxU64 numNodeMigrations;
+};
+
+inline
+mfxU32 GetLatencyBucket(mfxU64 value)
+{
+    if (value < MFX_LATENCY_SUB_BUCKETS)
+        return (mfxU32) value;
+
+    const mfxU32 msb = 63 - __builtin_clzll(value);
+    if (msb >= MFX_LATENCY_MAX_BITS)
+        return MFX_LATENCY_BUCKETS - 1;
+
+    const mfxU32 sub = (mfxU32) (value >> (msb - MFX_LATENCY_SUB_BUCKET_BITS)) & (MFX_LATENCY_SUB_BUCKETS - 1);
+    return (msb - MFX_LATENCY_SUB_BUCKET_BITS + 1) * MFX_LATENCY_SUB_BUCKETS + sub;
+}
+
+// the smallest value of the bucket
+inline
+mfxU64 GetLatencyBucketValue(mfxU32 bucket)
+{
+    if (bucket < MFX_LATENCY_SUB_BUCKETS)
+        return bucket;
+
+    const mfxU32 msb = bucket / MFX_LATENCY_SUB_BUCKETS + MFX_LATENCY_SUB_BUCKET_BITS - 1;
+    const mfxU64 sub = bucket % MFX_LATENCY_SUB_BUCKETS;
+    return (MFX_LATENCY_SUB_BUCKETS + sub) << (msb - MFX_LATENCY_SUB_BUCKET_BITS);
+}
+
+// the value, which 'percentile' percents of values do not exceed, rounded down to the bucket
+inline
+mfxU64 GetLatencyPercentile(const MFX_LATENCY_HISTOGRAM &histogram, mfxF64 percentile)
+{
+    const mfxU64 target = (mfxU64) (histogram.count * percentile / 100.);
+    mfxU64 count = 0;
+
+    for (mfxU32 i = 0; i < MFX_LATENCY_BUCKETS; i += 1)
+    {
+        count += histogram.buckets[i];
+        if (count > target)
+            return GetLatencyBucketValue(i);
+    }
+
+    return histogram.max;
+}
+
+class MFXISchedulerStat : public MFXIUnknown
+{
+public:
+    // Get latency histograms of the owner's tasks, or of all tasks if pOwner is NULL.
+    // Owners registered beyond the scheduler's limit are counted in all tasks only.
+    virtual
+    mfxStatus GetStat(const void *pOwner, MFX_SCHEDULER_STAT *pStat) = 0;
+
+    // Get owners having statistics. pNumOwners is the size of ppOwners on input,
+    // the number of owners on output.
+    virtual
+    mfxStatus GetStatOwners(const void **ppOwners, mfxU32 *pNumOwners) = 0;
+
+    // Drop collected statistics
+    virtual
+    mfxStatus ResetStat(void) = 0;
 };
 
 #endif // __MFX_INTERFACE_SCHEDULER_H
@@ -178,15 +178,19 @@ namespace MfxExtBuffer
     class CastExtractor
     {
     private:
-        mfxExtBuffer**      m_b;
-        mfxU16              m_n;
-        const ParamBase*    m_p;
+        mfxExtBuffer**              m_b;
+        mfxU16                      m_n;
+        const ParamBase*            m_p;
+        const mfx::ExtBufferIndex*  m_i = nullptr;
 
         mfxExtBuffer* _Get(mfxU32 id) const
         {
             if (m_p)
                 return m_p->Get(id);
 
+            if (m_i)
+                return m_i->Get(id);
+
             if (m_b)
             {
                 auto pIt = std::find_if(m_b, m_b + m_n
@@ -212,6 +216,13 @@ namespace MfxExtBuffer
             , m_p(nullptr)
         {}
 
+        CastExtractor(const mfx::ExtBufferIndex& index)
+            : m_b(nullptr)
+            , m_n(0)
+            , m_p(nullptr)
+            , m_i(&index)
+        {}
+
         template <class T>
         operator T*()
         {
@@ -253,6 +264,9 @@ namespace MfxExtBuffer
     template <class P>
     const CastExtractor Get(const Param<P>& par) { return CastExtractor(par); }
 
+    inline CastExtractor Get(mfx::ExtBufferIndex& index) { return CastExtractor(index); }
+    inline const CastExtractor Get(const mfx::ExtBufferIndex& index) { return CastExtractor(index); }
+
     template <class P>
     mfxExtBuffer* Get(P& par, mfxU32 BufferId)
     {
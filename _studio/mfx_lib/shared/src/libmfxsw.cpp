@@ -38,6 +38,7 @@
 #include "mfx_interface_scheduler.h"
 #include "libmfx_core_interface.h"
 #include "mfx_platform_caps.h"
+#include "mfx_caps_cache.h"
 
 #include "mfx_unified_decode_logging.h"
 
@@ -629,7 +630,9 @@ GetAdapterInfo(mfxU64 adapterId)
     return result;
 }
 
-static bool QueryImplCaps(std::function < bool (VideoCORE&, mfxU32, mfxU32 , mfxU64, const std::vector<bool>& ) > QueryImpls)
+// QueryCached is called before the core is created, true means the adapter is handled without it
+static bool QueryImplCaps(std::function < bool (VideoCORE&, mfxU32, mfxU32 , mfxU64, const std::vector<bool>& ) > QueryImpls
+    , std::function < bool (VADisplay, mfxU32, mfxU32) > QueryCached = nullptr)
 {
     for (int i = 0; i < 64; ++i)
     {
@@ -683,6 +686,9 @@ static bool QueryImplCaps(std::function < bool (VideoCORE&, mfxU32, mfxU32 , mfx
 
             std::shared_ptr<VADisplay> closeVA(&displ, [displ](VADisplay*) { vaTerminate(displ); });
 
+            if (QueryCached && QueryCached(displ, deviceId, i))
+                continue;
+
             VADisplayAttribute attr = {};
             attr.type = VADisplayAttribSubDevice;
             auto sts = vaGetDisplayAttributes(displ, &attr, 1);
@@ -896,18 +902,56 @@ mfxHDL* MFX_CDECL MFXQueryImplsDescription(mfxImplCapsDeliveryFormat format, mfx
         {
             std::unique_ptr<mfx::ImplDescriptionHolder> holder(new mfx::ImplDescriptionHolder);
 
+            const bool bUseCache = mfx::caps_cache::IsEnabled();
+            mfx::caps_cache::Key cacheKey = {};
+
+            auto QueryCachedDesc = [&](VADisplay displ, mfxU32 deviceId, mfxU32 adapterNum) -> bool
+            {
+                if (!bUseCache)
+                    return false;
+
+                const char* vendor = vaQueryVendorString(displ);
+
+                cacheKey.deviceId   = deviceId;
+                cacheKey.adapterNum = adapterNum;
+                cacheKey.driver     = vendor ? vendor : "";
+
+                mfxImplDescription   desc = {};
+                mfx::PODArraysHolder arrays;
+
+                auto sts = mfx::caps_cache::Load(cacheKey, desc, arrays);
+                if (sts == mfx::caps_cache::Result::Hit)
+                {
+                    // list nodes are moved, so pointers in desc stay valid
+                    auto& impl = holder->PushBack();
+                    static_cast<mfxImplDescription&>(impl) = desc;
+                    static_cast<mfx::PODArraysHolder&>(impl) = std::move(arrays);
+                }
+
+                return sts != mfx::caps_cache::Result::Miss;
+            };
+
             auto QueryImplDesc = [&](VideoCORE& core, mfxU32 deviceId, mfxU32 adapterNum, mfxU64, const std::vector<bool>& subDevMask) -> bool
             {
                 if (!CommonCaps::IsVplHW(core.GetHWType(), deviceId))
+                {
+                    if (bUseCache)
+                        mfx::caps_cache::Store(cacheKey, nullptr);
                     return true;
+                }
 
                 auto& impl = holder->PushBack();
 
                 FillImplsDescription(impl, core, deviceId, adapterNum, subDevMask);
 
-                return (MFX_ERR_NONE == QueryImplsDescription(core, impl.Enc, impl) &&
+                bool bOk = (MFX_ERR_NONE == QueryImplsDescription(core, impl.Enc, impl) &&
                     MFX_ERR_NONE == QueryImplsDescription(core, impl.Dec, impl) &&
                     MFX_ERR_NONE == QueryImplsDescription(core, impl.VPP, impl));
+
+                if (bOk && bUseCache)
+                    mfx::caps_cache::Store(cacheKey, &impl);
+
+                return bOk;
             };
 
             {
@@ -917,7 +961,7 @@ mfxHDL* MFX_CDECL MFXQueryImplsDescription(mfxImplCapsDeliveryFormat format, mfx
                 InitMfxLogging();
                 MFX_LOG_API_TRACE("----------------MFXQueryImplsDescription----------------\n");
 
-                if (!QueryImplCaps(QueryImplDesc))
+                if (!QueryImplCaps(QueryImplDesc, QueryCachedDesc))
                     return impl;
             }
 
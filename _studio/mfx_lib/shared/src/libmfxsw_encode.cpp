@@ -44,6 +44,7 @@
 
 #if defined (MFX_ENABLE_MJPEG_VIDEO_ENCODE)
 #include "mfx_mjpeg_encode_hw.h"
+#include "mfx_mjpeg_encode_sw.h"
 #endif
 
 #if defined (MFX_ENABLE_H265_VIDEO_ENCODE)
@@ -188,26 +189,60 @@ static const CodecId2Handlers codecId2Handlers =
                 [](VideoCORE* core, mfxU16 /*codecProfile*/, mfxStatus *mfxRes)
                 -> VideoENCODE*
                 {
+                    if (MFXVideoENCODEMJPEG_SW::UseSoftwareEncoder())
+                        return new MFXVideoENCODEMJPEG_SW(core, mfxRes);
                     return new MFXVideoENCODEMJPEG_HW(core, mfxRes);
                 },
                 // .query =
                 [](mfxSession session, mfxVideoParam *in, mfxVideoParam *out)
                 {
+                    if (MFXVideoENCODEMJPEG_SW::UseSoftwareEncoder())
+                        return MFXVideoENCODEMJPEG_SW::Query(session->m_pCORE.get(), in, out);
                     return MFXVideoENCODEMJPEG_HW::Query(session->m_pCORE.get(), in, out);
                 },
                 // .queryIOSurf =
                 [](mfxSession session, mfxVideoParam *par, mfxFrameAllocRequest *request)
                 {
+                    if (MFXVideoENCODEMJPEG_SW::UseSoftwareEncoder())
+                        return MFXVideoENCODEMJPEG_SW::QueryIOSurf(session->m_pCORE.get(), par, request);
                     return MFXVideoENCODEMJPEG_HW::QueryIOSurf(session->m_pCORE.get(), par, request);
                 }
                 // .QueryImplsDescription =
                 , [](VideoCORE& core, mfxEncoderDescription::encoder& caps, mfx::PODArraysHolder& ah)
                 {
+                    if (MFXVideoENCODEMJPEG_SW::UseSoftwareEncoder())
+                        return MFXVideoENCODEMJPEG_SW::QueryImplsDescription(core, caps, ah);
                     return MFXVideoENCODEMJPEG_HW::QueryImplsDescription(core, caps, ah);
                 }
             },
             // .fallback =
             {
+                // .ctor =
+                [](VideoCORE* core, mfxU16 /*codecProfile*/, mfxStatus *mfxRes)
+                -> VideoENCODE*
+                {
+                    if (!MFXVideoENCODEMJPEG_SW::UseSoftwareEncoder())
+                        return nullptr;
+                    return new MFXVideoENCODEMJPEG_SW(core, mfxRes);
+                },
+                // .query =
+                [](mfxSession session, mfxVideoParam *in, mfxVideoParam *out)
+                {
+                    MFX_CHECK(MFXVideoENCODEMJPEG_SW::UseSoftwareEncoder(), MFX_ERR_UNSUPPORTED);
+                    return MFXVideoENCODEMJPEG_SW::Query(session->m_pCORE.get(), in, out);
+                },
+                // .queryIOSurf =
+                [](mfxSession session, mfxVideoParam *par, mfxFrameAllocRequest *request)
+                {
+                    MFX_CHECK(MFXVideoENCODEMJPEG_SW::UseSoftwareEncoder(), MFX_ERR_UNSUPPORTED);
+                    return MFXVideoENCODEMJPEG_SW::QueryIOSurf(session->m_pCORE.get(), par, request);
+                }
+                // .QueryImplsDescription =
+                , [](VideoCORE& core, mfxEncoderDescription::encoder& caps, mfx::PODArraysHolder& ah)
+                {
+                    MFX_CHECK(MFXVideoENCODEMJPEG_SW::UseSoftwareEncoder(), MFX_ERR_UNSUPPORTED);
+                    return MFXVideoENCODEMJPEG_SW::QueryImplsDescription(core, caps, ah);
+                }
             }
         }
     },
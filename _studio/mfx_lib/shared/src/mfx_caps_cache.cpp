@@ -0,0 +1,515 @@
+// Copyright (c) 2025 Intel Corporation
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "mfx_caps_cache.h"
+
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+
+#include <dlfcn.h>
+#include <elf.h>
+#include <link.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace mfx
+{
+namespace caps_cache
+{
+namespace
+{
+    const mfxU32 CACHE_MAGIC   = 0x50414358; // "XCAP"
+    const mfxU32 CACHE_VERSION = 1;
+
+    struct FileHeader
+    {
+        mfxU32 magic;
+        mfxU32 version;
+        mfxU32 deviceId;
+        mfxU32 adapterNum;
+        mfxU32 numImpls;    // 0 for adapters without VPL support
+        mfxU32 driverSize;
+        mfxU32 buildSize;
+        mfxU32 dataSize;
+        mfxU64 checksum;    // of the data following the strings
+    };
+
+    mfxU64 Checksum(const uint8_t* data, size_t size)
+    {
+        // FNV-1a
+        mfxU64 hash = 0xcbf29ce484222325ull;
+        for (size_t i = 0; i < size; ++i)
+        {
+            hash ^= data[i];
+            hash *= 0x100000001b3ull;
+        }
+        return hash;
+    }
+
+    class Writer
+    {
+    public:
+        template <class T>
+        bool Pod(T& item)
+        {
+            Put(&item, sizeof(T));
+            return true;
+        }
+
+        template <class T>
+        bool Array(T*& items, mfxU32 count)
+        {
+            if (count && !items)
+                return false;
+
+            Put(items, sizeof(T) * count);
+            return true;
+        }
+
+        template <class T>
+        bool Optional(T*& item)
+        {
+            mfxU8 present = !!item;
+
+            Put(&present, sizeof(present));
+            if (item)
+                Put(item, sizeof(T));
+            return true;
+        }
+
+        std::vector<uint8_t> m_data;
+
+    private:
+        void Put(const void* p, size_t size)
+        {
+            auto bytes = (const uint8_t*)p;
+            m_data.insert(m_data.end(), bytes, bytes + size);
+        }
+    };
+
+    // Items are read with pointers of the writing process, every pointer is replaced
+    // by the array attached to the description before its items are read.
+    class Reader
+    {
+    public:
+        Reader(const uint8_t* data, size_t size, PODArraysHolder& ah)
+            : m_data(data)
+            , m_size(size)
+            , m_ah(ah)
+        {}
+
+        template <class T>
+        bool Pod(T& item)
+        {
+            return Get(&item, sizeof(T));
+        }
+
+        template <class T>
+        bool Array(T*& items, mfxU32 count)
+        {
+            // counts are read from the file, the array must fit into the data left
+            // (the division keeps sizeof(T) * count from overflowing)
+            if (count > (m_size - m_pos) / sizeof(T))
+            {
+                items = nullptr;
+                return false;
+            }
+
+            m_ah.PushArray(items, count);
+            return Get(items, sizeof(T) * count);
+        }
+
+        template <class T>
+        bool Optional(T*& item)
+        {
+            mfxU8 present = 0;
+
+            item = nullptr;
+            if (!Get(&present, sizeof(present)))
+                return false;
+
+            return !present || Array(item, 1);
+        }
+
+    private:
+        bool Get(void* p, size_t size)
+        {
+            if (size > m_size - m_pos)
+                return false;
+
+            if (size)
+                std::memcpy(p, m_data + m_pos, size);
+            m_pos += size;
+            return true;
+        }
+
+        const uint8_t*   m_data;
+        size_t           m_size;
+        size_t           m_pos = 0;
+        PODArraysHolder& m_ah;
+    };
+
+    template <class S>
+    bool Visit(S& s, mfxDecoderDescription& dec)
+    {
+        if (!s.Array(dec.Codecs, dec.NumCodecs))
+            return false;
+
+        for (mfxU32 c = 0; c < dec.NumCodecs; ++c)
+        {
+            auto& codec = dec.Codecs[c];
+
+#if defined(ONEVPL_EXPERIMENTAL)
+            if (!s.Optional(codec.DecExtDesc))
+                return false;
+            if (codec.DecExtDesc && !s.Array(codec.DecExtDesc->ExtBufferIDs, codec.DecExtDesc->NumExtBufferIDs))
+                return false;
+#endif
+            if (!s.Array(codec.Profiles, codec.NumProfiles))
+                return false;
+
+            for (mfxU32 p = 0; p < codec.NumProfiles; ++p)
+            {
+                auto& profile = codec.Profiles[p];
+
+                if (!s.Array(profile.MemDesc, profile.NumMemTypes))
+                    return false;
+
+                for (mfxU32 m = 0; m < profile.NumMemTypes; ++m)
+                {
+                    auto& mem = profile.MemDesc[m];
+
+#if defined(ONEVPL_EXPERIMENTAL)
+                    if (!s.Optional(mem.MemExtDesc))
+                        return false;
+                    if (mem.MemExtDesc && !s.Array(mem.MemExtDesc->ChromaSubsamplings, mem.MemExtDesc->NumChromaSubsamplings))
+                        return false;
+#endif
+                    if (!s.Array(mem.ColorFormats, mem.NumColorFormats))
+                        return false;
+                }
+            }
+        }
+
+        return true;
+    }
+
+    template <class S>
+    bool Visit(S& s, mfxEncoderDescription& enc)
+    {
+        if (!s.Array(enc.Codecs, enc.NumCodecs))
+            return false;
+
+        for (mfxU32 c = 0; c < enc.NumCodecs; ++c)
+        {
+            auto& codec = enc.Codecs[c];
+
+#if defined(ONEVPL_EXPERIMENTAL)
+            if (!s.Optional(codec.EncExtDesc))
+                return false;
+            if (codec.EncExtDesc &&
+                (!s.Array(codec.EncExtDesc->RateControlMethods, codec.EncExtDesc->NumRateControlMethods) ||
+                 !s.Array(codec.EncExtDesc->ExtBufferIDs, codec.EncExtDesc->NumExtBufferIDs)))
+                return false;
+#endif
+            if (!s.Array(codec.Profiles, codec.NumProfiles))
+                return false;
+
+            for (mfxU32 p = 0; p < codec.NumProfiles; ++p)
+            {
+                auto& profile = codec.Profiles[p];
+
+                if (!s.Array(profile.MemDesc, profile.NumMemTypes))
+                    return false;
+
+                for (mfxU32 m = 0; m < profile.NumMemTypes; ++m)
+                {
+                    auto& mem = profile.MemDesc[m];
+
+#if defined(ONEVPL_EXPERIMENTAL)
+                    if (!s.Optional(mem.MemExtDesc))
+                        return false;
+                    if (mem.MemExtDesc && !s.Array(mem.MemExtDesc->TargetChromaSubsamplings, mem.MemExtDesc->NumTargetChromaSubsamplings))
+                        return false;
+#endif
+                    if (!s.Array(mem.ColorFormats, mem.NumColorFormats))
+                        return false;
+                }
+            }
+        }
+
+        return true;
+    }
+
+    template <class S>
+    bool Visit(S& s, mfxVPPDescription& vpp)
+    {
+        if (!s.Array(vpp.Filters, vpp.NumFilters))
+            return false;
+
+        for (mfxU32 f = 0; f < vpp.NumFilters; ++f)
+        {
+            auto& filter = vpp.Filters[f];
+
+            if (!s.Array(filter.MemDesc, filter.NumMemTypes))
+                return false;
+
+            for (mfxU32 m = 0; m < filter.NumMemTypes; ++m)
+            {
+                auto& mem = filter.MemDesc[m];
+
+                if (!s.Array(mem.Formats, mem.NumInFormats))
+                    return false;
+
+                for (mfxU32 i = 0; i < mem.NumInFormats; ++i)
+                {
+                    if (!s.Array(mem.Formats[i].OutFormats, mem.Formats[i].NumOutFormat))
+                        return false;
+                }
+            }
+        }
+
+        return true;
+    }
+
+    template <class S>
+    bool Visit(S& s, mfxImplDescription& impl)
+    {
+        return s.Pod(impl)
+            && s.Array(impl.Dev.SubDevices, impl.Dev.NumSubDevices)
+            && s.Array(impl.AccelerationModeDescription.Mode, impl.AccelerationModeDescription.NumAccelerationModes)
+            && s.Array(impl.PoolPolicies.Policy, impl.PoolPolicies.NumPoolPolicies)
+            && Visit(s, impl.Dec)
+            && Visit(s, impl.Enc)
+            && Visit(s, impl.VPP);
+    }
+
+    std::string GetCacheDir()
+    {
+        const char* xdgCache = std::getenv("XDG_CACHE_HOME");
+        if (xdgCache && xdgCache[0] == '/')
+            return std::string(xdgCache) + "/libmfx-gen";
+
+        const char* home = std::getenv("HOME");
+        if (home && home[0] == '/')
+            return std::string(home) + "/.cache/libmfx-gen";
+
+        return std::string();
+    }
+
+    std::string GetCachePath(const Key& key)
+    {
+        return GetCacheDir() + "/caps_renderD" + std::to_string(128 + key.adapterNum) + ".bin";
+    }
+
+    int FindBuildId(dl_phdr_info* info, size_t, void* data)
+    {
+        auto& buildId = *(std::string*)data;
+        auto  addr    = (ElfW(Addr))&FindBuildId;
+        bool  bOwn    = false;
+
+        for (int i = 0; i < info->dlpi_phnum && !bOwn; ++i)
+        {
+            const ElfW(Phdr)& phdr = info->dlpi_phdr[i];
+            ElfW(Addr) start = info->dlpi_addr + phdr.p_vaddr;
+
+            bOwn = phdr.p_type == PT_LOAD && addr >= start && addr < start + phdr.p_memsz;
+        }
+
+        if (!bOwn)
+            return 0;
+
+        for (int i = 0; i < info->dlpi_phnum; ++i)
+        {
+            const ElfW(Phdr)& phdr = info->dlpi_phdr[i];
+            if (phdr.p_type != PT_NOTE)
+                continue;
+
+            auto note = (const uint8_t*)(info->dlpi_addr + phdr.p_vaddr);
+            auto end  = note + phdr.p_memsz;
+
+            while (note + sizeof(ElfW(Nhdr)) <= end)
+            {
+                auto nhdr = (const ElfW(Nhdr)*)note;
+                auto name = note + sizeof(ElfW(Nhdr));
+                auto desc = name + ((nhdr->n_namesz + 3) & ~3u);
+
+                if (desc + nhdr->n_descsz > end)
+                    break;
+
+                if (nhdr->n_type == NT_GNU_BUILD_ID && nhdr->n_namesz == 4 && !std::memcmp(name, "GNU", 4))
+                {
+                    static const char hex[] = "0123456789abcdef";
+                    for (ElfW(Word) j = 0; j < nhdr->n_descsz; ++j)
+                    {
+                        buildId += hex[desc[j] >> 4];
+                        buildId += hex[desc[j] & 15];
+                    }
+                    return 1;
+                }
+
+                note = desc + ((nhdr->n_descsz + 3) & ~3u);
+            }
+        }
+
+        return 1;
+    }
+
+    // GNU build id of the library, or size and time of the library file if there is no build id
+    const std::string& GetBuildId()
+    {
+        static const std::string buildId = []()
+        {
+            std::string id;
+            dl_iterate_phdr(FindBuildId, &id);
+
+            Dl_info info = {};
+            struct stat st = {};
+            if (id.empty() && dladdr((void*)&FindBuildId, &info) && info.dli_fname && !stat(info.dli_fname, &st))
+            {
+                id = std::string(info.dli_fname) + ":" + std::to_string(st.st_size) + ":" + std::to_string(st.st_mtime);
+            }
+            return id;
+        }();
+
+        return buildId;
+    }
+
+    void MakeDirs(const std::string& path)
+    {
+        for (size_t pos = path.find('/', 1); ; pos = path.find('/', pos + 1))
+        {
+            mkdir(path.substr(0, pos).c_str(), 0755);
+            if (pos == std::string::npos)
+                break;
+        }
+    }
+}
+
+bool IsEnabled()
+{
+    const char* enabled = std::getenv("VPL_CAPS_CACHE");
+
+    return enabled && !std::strcmp(enabled, "1") && !GetCacheDir().empty() && !GetBuildId().empty();
+}
+
+Result Load(const Key& key, mfxImplDescription& impl, PODArraysHolder& ah)
+{
+    std::ifstream file(GetCachePath(key), std::ios::binary);
+    if (!file.good())
+        return Result::Miss;
+
+    std::vector<uint8_t> content((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+
+    FileHeader header = {};
+    if (content.size() < sizeof(header))
+        return Result::Miss;
+    std::memcpy(&header, content.data(), sizeof(header));
+
+    const std::string& buildId = GetBuildId();
+    const uint8_t*     strings = content.data() + sizeof(header);
+    const uint8_t*     data    = strings + header.driverSize + header.buildSize;
+
+    // any change of the key invalidates the file, it is rewritten after the query
+    bool bValid =
+           header.magic == CACHE_MAGIC
+        && header.version == CACHE_VERSION
+        && header.deviceId == key.deviceId
+        && header.adapterNum == key.adapterNum
+        && header.numImpls <= 1
+        && header.driverSize == key.driver.size()
+        && header.buildSize == buildId.size()
+        && content.size() == sizeof(header) + size_t(header.driverSize) + header.buildSize + header.dataSize
+        && !std::memcmp(strings, key.driver.data(), key.driver.size())
+        && !std::memcmp(strings + header.driverSize, buildId.data(), buildId.size())
+        && header.checksum == Checksum(data, header.dataSize);
+
+    if (!bValid)
+        return Result::Miss;
+
+    if (!header.numImpls)
+        return Result::Unsupported;
+
+    Reader reader(data, header.dataSize, ah);
+    if (!Visit(reader, impl))
+    {
+        impl = mfxImplDescription();
+        return Result::Miss;
+    }
+
+    impl.NumExtParam = 0;
+    impl.ExtParams.ExtParam = nullptr;
+
+    return Result::Hit;
+}
+
+void Store(const Key& key, const mfxImplDescription* pImpl)
+{
+    Writer writer;
+
+    if (pImpl)
+    {
+        // extension buffers are not serialized
+        mfxImplDescription impl = *pImpl;
+        if (impl.NumExtParam || !Visit(writer, impl))
+            return;
+    }
+
+    const std::string& buildId = GetBuildId();
+    FileHeader header = {};
+
+    header.magic      = CACHE_MAGIC;
+    header.version    = CACHE_VERSION;
+    header.deviceId   = key.deviceId;
+    header.adapterNum = key.adapterNum;
+    header.numImpls   = pImpl ? 1 : 0;
+    header.driverSize = mfxU32(key.driver.size());
+    header.buildSize  = mfxU32(buildId.size());
+    header.dataSize   = mfxU32(writer.m_data.size());
+    header.checksum   = Checksum(writer.m_data.data(), writer.m_data.size());
+
+    MakeDirs(GetCacheDir());
+
+    // concurrent processes may store the same file, readers see either old or new one
+    std::string path    = GetCachePath(key);
+    std::string tmpPath = path + "." + std::to_string(getpid()) + ".tmp";
+    {
+        std::ofstream file(tmpPath, std::ios::binary | std::ios::trunc);
+
+        file.write((const char*)&header, sizeof(header));
+        file.write(key.driver.data(), key.driver.size());
+        file.write(buildId.data(), buildId.size());
+        file.write((const char*)writer.m_data.data(), writer.m_data.size());
+
+        if (!file.good())
+        {
+            file.close();
+            unlink(tmpPath.c_str());
+            return;
+        }
+    }
+
+    if (rename(tmpPath.c_str(), path.c_str()))
+        unlink(tmpPath.c_str());
+}
+}
+}
@@ -418,6 +418,8 @@ mfxStatus _mfxVersionedSessionImpl::InitEx(mfxInitParam& par, bool isSingleThrea
 #endif
         schedParam.numberOfThreads = maxNumThreads;
         schedParam.pCore = m_pCORE.get();
+        // the core sets the node, when the device handle is known
+        schedParam.deviceNode = -1;
         if (threadsParam)
         {
             schedParam.params = *threadsParam;
@@ -0,0 +1,464 @@
+// Copyright (c) 2025 Intel Corporation
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+// Cold and warm paths of the MFXQueryImplsDescription capability cache.
+// A stub device builds an adapter description the way QueryImplsDescription
+// does, without VA. The cold path is the stub query followed by Store, the
+// warm path is Load of the stored file. Files which must not be accepted
+// (another key, corrupted, truncated, oversized arrays) are checked as well.
+// The cache directory is created in /tmp and removed at exit.
+//
+// Usage:
+//   caps_cache_bench [iterations]
+
+#include <chrono>
+#include <cstddef>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <vector>
+
+#include <unistd.h>
+
+#include "mfx_caps_cache.h"
+
+typedef mfx::caps_cache::Result CacheResult;
+
+// must match the file header of mfx_caps_cache.cpp
+struct FileHeader
+{
+    mfxU32 magic;
+    mfxU32 version;
+    mfxU32 deviceId;
+    mfxU32 adapterNum;
+    mfxU32 numImpls;
+    mfxU32 driverSize;
+    mfxU32 buildSize;
+    mfxU32 dataSize;
+    mfxU64 checksum;
+};
+
+static const mfxU32 stubFormats[] =
+{
+    MFX_FOURCC_NV12, MFX_FOURCC_P010, MFX_FOURCC_YUY2, MFX_FOURCC_Y210,
+    MFX_FOURCC_AYUV, MFX_FOURCC_Y410, MFX_FOURCC_P016, MFX_FOURCC_Y416
+};
+
+static const mfxU32 stubCodecs[] =
+{
+    MFX_CODEC_AVC, MFX_CODEC_HEVC, MFX_CODEC_MPEG2, MFX_CODEC_VC1,
+    MFX_CODEC_JPEG, MFX_CODEC_VP8, MFX_CODEC_VP9, MFX_CODEC_AV1
+};
+
+static const mfxResourceType stubMemTypes[] =
+{
+    MFX_RESOURCE_SYSTEM_SURFACE, MFX_RESOURCE_VA_SURFACE
+};
+
+// the description of a device with 8 decoders, 5 encoders and 20 VPP filters
+static void QueryStubDevice(mfxImplDescription& impl, mfx::PODArraysHolder& ah)
+{
+    impl = mfxImplDescription();
+    impl.Version.Version = MFX_IMPLDESCRIPTION_VERSION;
+    impl.Impl = MFX_IMPL_TYPE_HARDWARE;
+    impl.AccelerationMode = MFX_ACCEL_MODE_VIA_VAAPI;
+    impl.VendorID = 0x8086;
+    strcpy(impl.ImplName, "stub");
+    strcpy(impl.Dev.DeviceID, "a7a0/0");
+
+    ah.PushBack(impl.AccelerationModeDescription.Mode) = MFX_ACCEL_MODE_VIA_VAAPI;
+    impl.AccelerationModeDescription.NumAccelerationModes = 1;
+
+    for (auto policy : { MFX_ALLOCATION_OPTIMAL, MFX_ALLOCATION_UNLIMITED, MFX_ALLOCATION_LIMITED })
+    {
+        ah.PushBack(impl.PoolPolicies.Policy) = policy;
+        impl.PoolPolicies.NumPoolPolicies++;
+    }
+
+    for (mfxU32 codecId : stubCodecs)
+    {
+        auto& codec = ah.PushBack(impl.Dec.Codecs);
+        codec.CodecID = codecId;
+        impl.Dec.NumCodecs++;
+
+        for (mfxU32 profile = 1; profile <= 3; profile++)
+        {
+            auto& pfCaps = ah.PushBack(codec.Profiles);
+            pfCaps.Profile = profile;
+            codec.NumProfiles++;
+
+            for (auto memType : stubMemTypes)
+            {
+                auto& memCaps = ah.PushBack(pfCaps.MemDesc);
+                memCaps.MemHandleType = memType;
+                memCaps.Width = { 16, 16384, 16 };
+                memCaps.Height = { 16, 16384, 16 };
+                pfCaps.NumMemTypes++;
+
+                for (mfxU32 fcc : stubFormats)
+                {
+                    ah.PushBack(memCaps.ColorFormats) = fcc;
+                    memCaps.NumColorFormats++;
+                }
+            }
+        }
+    }
+
+    for (mfxU32 c = 0; c < 5; c++)
+    {
+        auto& codec = ah.PushBack(impl.Enc.Codecs);
+        codec.CodecID = stubCodecs[c];
+        codec.BiDirectionalPrediction = 1;
+        impl.Enc.NumCodecs++;
+
+        for (mfxU32 profile = 1; profile <= 3; profile++)
+        {
+            auto& pfCaps = ah.PushBack(codec.Profiles);
+            pfCaps.Profile = profile;
+            codec.NumProfiles++;
+
+            for (auto memType : stubMemTypes)
+            {
+                auto& memCaps = ah.PushBack(pfCaps.MemDesc);
+                memCaps.MemHandleType = memType;
+                memCaps.Width = { 16, 8192, 16 };
+                memCaps.Height = { 16, 8192, 16 };
+                pfCaps.NumMemTypes++;
+
+                for (mfxU32 i = 0; i < 4; i++)
+                {
+                    ah.PushBack(memCaps.ColorFormats) = stubFormats[i];
+                    memCaps.NumColorFormats++;
+                }
+            }
+        }
+    }
+
+    for (mfxU32 f = 0; f < 20; f++)
+    {
+        auto& filter = ah.PushBack(impl.VPP.Filters);
+        filter.FilterFourCC = MFX_MAKEFOURCC('F', 'L', 'T', '0' + f);
+        impl.VPP.NumFilters++;
+
+        for (auto memType : stubMemTypes)
+        {
+            auto& memCaps = ah.PushBack(filter.MemDesc);
+            memCaps.MemHandleType = memType;
+            memCaps.Width = { 16, 16384, 16 };
+            memCaps.Height = { 16, 16384, 16 };
+            filter.NumMemTypes++;
+
+            for (mfxU32 inFormat : stubFormats)
+            {
+                auto& format = ah.PushBack(memCaps.Formats);
+                format.InFormat = inFormat;
+                memCaps.NumInFormats++;
+
+                for (mfxU32 outFormat : stubFormats)
+                {
+                    ah.PushBack(format.OutFormats) = outFormat;
+                    format.NumOutFormat++;
+                }
+            }
+        }
+    }
+}
+
+static void PutRange(std::vector<mfxU32>& out, const mfxRange32U& range)
+{
+    out.insert(out.end(), { range.Min, range.Max, range.Step });
+}
+
+// values of the description in the order of nesting, pointers are left out
+static std::vector<mfxU32> Flatten(const mfxImplDescription& impl)
+{
+    std::vector<mfxU32> out = { impl.Impl, impl.AccelerationMode, impl.VendorID, impl.VendorImplID };
+
+    out.insert(out.end(), impl.ImplName, impl.ImplName + sizeof(impl.ImplName));
+    out.insert(out.end(), impl.Dev.DeviceID, impl.Dev.DeviceID + sizeof(impl.Dev.DeviceID));
+
+    out.push_back(impl.AccelerationModeDescription.NumAccelerationModes);
+    for (mfxU32 i = 0; i < impl.AccelerationModeDescription.NumAccelerationModes; i++)
+        out.push_back(impl.AccelerationModeDescription.Mode[i]);
+
+    out.push_back(impl.PoolPolicies.NumPoolPolicies);
+    for (mfxU32 i = 0; i < impl.PoolPolicies.NumPoolPolicies; i++)
+        out.push_back(impl.PoolPolicies.Policy[i]);
+
+    out.push_back(impl.Dec.NumCodecs);
+    for (mfxU32 c = 0; c < impl.Dec.NumCodecs; c++)
+    {
+        const auto& codec = impl.Dec.Codecs[c];
+        out.insert(out.end(), { codec.CodecID, codec.MaxcodecLevel, codec.NumProfiles });
+
+        for (mfxU32 p = 0; p < codec.NumProfiles; p++)
+        {
+            const auto& profile = codec.Profiles[p];
+            out.insert(out.end(), { profile.Profile, profile.NumMemTypes });
+
+            for (mfxU32 m = 0; m < profile.NumMemTypes; m++)
+            {
+                const auto& mem = profile.MemDesc[m];
+                out.push_back(mem.MemHandleType);
+                PutRange(out, mem.Width);
+                PutRange(out, mem.Height);
+                out.push_back(mem.NumColorFormats);
+                out.insert(out.end(), mem.ColorFormats, mem.ColorFormats + mem.NumColorFormats);
+            }
+        }
+    }
+
+    out.push_back(impl.Enc.NumCodecs);
+    for (mfxU32 c = 0; c < impl.Enc.NumCodecs; c++)
+    {
+        const auto& codec = impl.Enc.Codecs[c];
+        out.insert(out.end(), { codec.CodecID, codec.MaxcodecLevel, codec.BiDirectionalPrediction, codec.NumProfiles });
+
+        for (mfxU32 p = 0; p < codec.NumProfiles; p++)
+        {
+            const auto& profile = codec.Profiles[p];
+            out.insert(out.end(), { profile.Profile, profile.NumMemTypes });
+
+            for (mfxU32 m = 0; m < profile.NumMemTypes; m++)
+            {
+                const auto& mem = profile.MemDesc[m];
+                out.push_back(mem.MemHandleType);
+                PutRange(out, mem.Width);
+                PutRange(out, mem.Height);
+                out.push_back(mem.NumColorFormats);
+                out.insert(out.end(), mem.ColorFormats, mem.ColorFormats + mem.NumColorFormats);
+            }
+        }
+    }
+
+    out.push_back(impl.VPP.NumFilters);
+    for (mfxU32 f = 0; f < impl.VPP.NumFilters; f++)
+    {
+        const auto& filter = impl.VPP.Filters[f];
+        out.insert(out.end(), { filter.FilterFourCC, filter.MaxDelayInFrames, filter.NumMemTypes });
+
+        for (mfxU32 m = 0; m < filter.NumMemTypes; m++)
+        {
+            const auto& mem = filter.MemDesc[m];
+            out.push_back(mem.MemHandleType);
+            PutRange(out, mem.Width);
+            PutRange(out, mem.Height);
+            out.push_back(mem.NumInFormats);
+
+            for (mfxU32 i = 0; i < mem.NumInFormats; i++)
+            {
+                const auto& format = mem.Formats[i];
+                out.insert(out.end(), { format.InFormat, format.NumOutFormat });
+                out.insert(out.end(), format.OutFormats, format.OutFormats + format.NumOutFormat);
+            }
+        }
+    }
+
+    return out;
+}
+
+static std::vector<char> ReadFile(const std::string& path)
+{
+    std::ifstream file(path, std::ios::binary);
+
+    return std::vector<char>((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+}
+
+static void WriteFile(const std::string& path, const std::vector<char>& content)
+{
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+
+    file.write(content.data(), content.size());
+}
+
+static mfxU64 Checksum(const char* data, size_t size)
+{
+    // FNV-1a, as in mfx_caps_cache.cpp
+    mfxU64 hash = 0xcbf29ce484222325ull;
+    for (size_t i = 0; i < size; ++i)
+    {
+        hash ^= (uint8_t)data[i];
+        hash *= 0x100000001b3ull;
+    }
+    return hash;
+}
+
+// sets the number of decoders to the largest value and fixes the checksum,
+// so only the array size check can reject the file
+static void OversizeDecoders(std::vector<char>& content)
+{
+    FileHeader header = {};
+    std::memcpy(&header, content.data(), sizeof(header));
+
+    size_t data = sizeof(header) + header.driverSize + header.buildSize;
+    mfxU16 numCodecs = 0xffff;
+
+    std::memcpy(&content[data + offsetof(mfxImplDescription, Dec) + offsetof(mfxDecoderDescription, NumCodecs)],
+        &numCodecs, sizeof(numCodecs));
+
+    header.checksum = Checksum(&content[data], header.dataSize);
+    std::memcpy(content.data(), &header, sizeof(header));
+}
+
+static CacheResult Load(const mfx::caps_cache::Key& key)
+{
+    mfxImplDescription   impl = {};
+    mfx::PODArraysHolder ah;
+
+    return mfx::caps_cache::Load(key, impl, ah);
+}
+
+int main(int argc, char* argv[])
+{
+    int iterations = 1000;
+
+    if (argc == 2)
+    {
+        iterations = atoi(argv[1]);
+    }
+    else if (argc != 1)
+    {
+        printf("usage: %s [iterations]\n", argv[0]);
+        return 1;
+    }
+
+    if (iterations <= 0)
+    {
+        printf("usage: %s [iterations]\n", argv[0]);
+        return 1;
+    }
+
+    char dirTemplate[] = "/tmp/caps_cache_bench.XXXXXX";
+    const char* dir = mkdtemp(dirTemplate);
+    if (!dir)
+    {
+        printf("can't create the cache directory\n");
+        return 1;
+    }
+
+    setenv("XDG_CACHE_HOME", dir, 1);
+    setenv("VPL_CAPS_CACHE", "1", 1);
+
+    if (!mfx::caps_cache::IsEnabled())
+    {
+        printf("the cache is disabled, the library has no build id\n");
+        rmdir(dir);
+        return 1;
+    }
+
+    const mfx::caps_cache::Key key = { 0xa7a0, 0, "Intel iHD driver - stub" };
+    const std::string path = std::string(dir) + "/libmfx-gen/caps_renderD128.bin";
+
+    int failures = 0;
+    auto Check = [&failures](const char* name, bool bOk)
+    {
+        printf("%-40s %s\n", name, bOk ? "ok" : "FAILED");
+        failures += !bOk;
+    };
+
+    // cold: stub query and store, warm: load
+    double coldBest = 0, warmBest = 0;
+    bool bRoundTrip = true;
+
+    for (int i = 0; i < iterations; i++)
+    {
+        unlink(path.c_str());
+
+        auto start = std::chrono::steady_clock::now();
+        {
+            bRoundTrip = bRoundTrip && (CacheResult::Miss == Load(key));
+
+            mfxImplDescription   impl = {};
+            mfx::PODArraysHolder ah;
+
+            QueryStubDevice(impl, ah);
+            mfx::caps_cache::Store(key, &impl);
+        }
+        double cold = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count();
+
+        start = std::chrono::steady_clock::now();
+        bRoundTrip = bRoundTrip && (CacheResult::Hit == Load(key));
+        double warm = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count();
+
+        if (!i || cold < coldBest)
+            coldBest = cold;
+        if (!i || warm < warmBest)
+            warmBest = warm;
+    }
+
+    const std::vector<char> stored = ReadFile(path);
+
+    Check("cold miss, warm hit", bRoundTrip && !stored.empty());
+
+    {
+        mfxImplDescription   queried = {}, restored = {};
+        mfx::PODArraysHolder queriedArrays, restoredArrays;
+
+        QueryStubDevice(queried, queriedArrays);
+        bool bHit = (CacheResult::Hit == mfx::caps_cache::Load(key, restored, restoredArrays));
+
+        Check("restored description is unchanged", bHit && Flatten(restored) == Flatten(queried));
+    }
+
+    {
+        mfx::caps_cache::Key other = key;
+        other.deviceId += 1;
+        Check("another device id is a miss", CacheResult::Miss == Load(other));
+
+        other = key;
+        other.driver += ".1";
+        Check("another driver version is a miss", CacheResult::Miss == Load(other));
+
+        other = key;
+        other.adapterNum = 1;
+        mfx::caps_cache::Store(other, nullptr);
+        Check("unsupported adapter is remembered", CacheResult::Unsupported == Load(other));
+    }
+
+    {
+        std::vector<char> content = stored;
+        content[content.size() / 2] ^= 1;
+        WriteFile(path, content);
+        Check("corrupted file is a miss", CacheResult::Miss == Load(key));
+
+        content = stored;
+        content.resize(content.size() - 1);
+        WriteFile(path, content);
+        Check("truncated file is a miss", CacheResult::Miss == Load(key));
+
+        content = stored;
+        OversizeDecoders(content);
+        WriteFile(path, content);
+        Check("oversized array is a miss", CacheResult::Miss == Load(key));
+    }
+
+    printf("%d iterations, %zu bytes in the file, best time\n", iterations, stored.size());
+    printf("%-40s %10.1f us\n", "cold: stub query + store", coldBest);
+    printf("%-40s %10.1f us\n", "warm: load", warmBest);
+
+    std::string rm = std::string("rm -rf ") + dir;
+    if (system(rm.c_str()))
+        printf("can't remove %s\n", dir);
+
+    return failures ? 1 : 0;
+}
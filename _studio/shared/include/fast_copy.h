@@ -31,6 +31,8 @@
 #include "umc_mutex.h"
 #include "fast_copy_c_impl.h"
 #include "fast_copy_sse4_impl.h"
+#include "fast_copy_avx2_impl.h"
+#include "fast_copy_avx512_impl.h"
 
 enum
 {
@@ -88,12 +90,6 @@ public:
             return MFX_ERR_NULL_PTR;
         }
 
-        /* The purpose of mutex here is to make the Copy() atomic.
-         * Without it CPU utilization grows dramatically due to cache trashing.
-         */
-        static UMC::Mutex mutex; // This is thread-safe since C++11
-        UMC::AutomaticUMCMutex guard(mutex);
-
         mfxCopyRect<mfxU8>(pSrc, srcPitch, pDst, dstPitch, roi, flag);
 
         return MFX_ERR_NONE;
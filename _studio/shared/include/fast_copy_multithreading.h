@@ -0,0 +1,43 @@
+// Copyright (c) 2025 Intel Corporation
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#ifndef __FAST_COPY_MULTITHREADING_H__
+#define __FAST_COPY_MULTITHREADING_H__
+
+#include "fast_copy.h"
+
+// Striped frame copy engine.
+// A frame is split into horizontal stripes which are copied by the calling thread
+// together with a small persistent pool of helper threads. Pools are created lazily,
+// one per NUMA node, and helpers only pick up work submitted from their own node.
+// Stripe size is derived from the L2 cache size, so small copies never leave the
+// calling thread. There is no process-wide lock around the copy itself: concurrent
+// callers only contend for the short queue push/pop of their node pool.
+class FastCopyMultithreading
+{
+public:
+    // copy memory by streaming, rows are distributed across helper threads
+    static mfxStatus Copy(mfxU8 *pDst, mfxU32 dstPitch, mfxU8 *pSrc, mfxU32 srcPitch, IppiSize roi, int flag);
+
+    // same as FastCopy::CopyAndShift, rows are distributed across helper threads
+    static mfxStatus CopyAndShift(mfxU16 *pDst, mfxU32 dstPitch, mfxU16 *pSrc, mfxU32 srcPitch, IppiSize roi, mfxU8 lshift, mfxU8 rshift, int flag);
+};
+
+#endif // __FAST_COPY_MULTITHREADING_H__
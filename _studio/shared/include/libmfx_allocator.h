@@ -494,6 +494,111 @@ inline mfxU16 AdjustTypeInternal(mfxU16 type)
 {
     return (type & ~MFX_MEMTYPE_EXTERNAL_FRAME) | MFX_MEMTYPE_INTERNAL_FRAME;
 }
+// Open addressing (linear probing) map from mid to the owning entry of allocator's surface pool.
+// Deletion uses backward shift, so lookups never walk over tombstones.
+template <class Iterator>
+class MidIndex
+{
+public:
+    const Iterator* Find(mfxMemId mid) const
+    {
+        if (!m_size)
+            return nullptr;
+
+        for (size_t pos = Hash(mid); ; pos = (pos + 1) & m_mask)
+        {
+            if (m_slots[pos].mid == mid)
+                return &m_slots[pos].it;
+
+            if (!m_slots[pos].mid)
+                return nullptr;
+        }
+    }
+
+    void Insert(mfxMemId mid, Iterator it)
+    {
+        // Keep load factor below 1/2
+        if ((m_size + 1) * 2 > m_slots.size())
+            Rehash(std::max<size_t>(m_slots.size() * 2, 16));
+
+        InsertUnique(mid, it);
+        ++m_size;
+    }
+
+    bool Erase(mfxMemId mid)
+    {
+        if (!m_size)
+            return false;
+
+        size_t pos = Hash(mid);
+        for (; m_slots[pos].mid != mid; pos = (pos + 1) & m_mask)
+        {
+            if (!m_slots[pos].mid)
+                return false;
+        }
+
+        // Move back entries of the probe chain into the hole, so the chain stays contiguous
+        for (size_t next = (pos + 1) & m_mask; m_slots[next].mid; next = (next + 1) & m_mask)
+        {
+            size_t home = Hash(m_slots[next].mid);
+
+            // Entry can be moved only if the hole lies cyclically within [home, next)
+            if (((next - home) & m_mask) >= ((next - pos) & m_mask))
+            {
+                m_slots[pos] = m_slots[next];
+                pos          = next;
+            }
+        }
+
+        m_slots[pos] = Slot();
+        --m_size;
+
+        return true;
+    }
+
+    size_t Size() const { return m_size; }
+
+private:
+    struct Slot
+    {
+        mfxMemId mid = nullptr;
+        Iterator it  = {};
+    };
+
+    size_t Hash(mfxMemId mid) const
+    {
+        // Fibonacci hashing spreads mids of different allocators (differ in high bits only)
+        return size_t((uint64_t(size_t(mid)) * 0x9E3779B97F4A7C15ull) >> 32) & m_mask;
+    }
+
+    void InsertUnique(mfxMemId mid, Iterator it)
+    {
+        size_t pos = Hash(mid);
+        while (m_slots[pos].mid)
+            pos = (pos + 1) & m_mask;
+
+        m_slots[pos].mid = mid;
+        m_slots[pos].it  = it;
+    }
+
+    void Rehash(size_t capacity)
+    {
+        std::vector<Slot> old(capacity);
+        std::swap(old, m_slots);
+        m_mask = capacity - 1;
+
+        for (auto& slot : old)
+        {
+            if (slot.mid)
+                InsertUnique(slot.mid, slot.it);
+        }
+    }
+
+    std::vector<Slot> m_slots;
+    size_t            m_mask = 0;
+    size_t            m_size = 0;
+};
+
 template <class T, class U>
 class FlexibleFrameAllocator : public FrameAllocatorBase
 {
@@ -517,6 +622,7 @@ public:
         , m_mid_low_part_modulo((size_t(1) << m_bits_n_surf) - 1)
         , m_device(device)
         , m_staging_adapter(std::make_shared<U>(device))
+        , m_used_mids((size_t(1) << m_bits_n_surf) / 64)
     {
     }
 
@@ -545,7 +651,7 @@ public:
 
             std::lock_guard<std::shared_timed_mutex> guard(m_mutex);
 
-            m_allocated_pool.splice(m_allocated_pool.end(), alloc_list);
+            AddToPool(alloc_list);
 
             m_returned_mids.emplace_back(std::move(mids));
 
@@ -572,14 +678,13 @@ public:
 
         std::shared_lock<std::shared_timed_mutex> guard(m_mutex);
 
-        auto it = std::find_if(std::begin(m_allocated_pool), std::end(m_allocated_pool),
-            [mid](const pT& surf) { return surf->GetMid() == mid; });
+        auto it = m_mid_index.Find(mid);
 
-        MFX_CHECK(it != std::end(m_allocated_pool), MFX_ERR_NOT_FOUND);
+        MFX_CHECK(it, MFX_ERR_NOT_FOUND);
 
-        MFX_SAFE_CALL((*it)->Lock(flags));
+        MFX_SAFE_CALL((**it)->Lock(flags));
 
-        (*it)->CopyPointers(frame_data);
+        (**it)->CopyPointers(frame_data);
 
         return MFX_ERR_NONE;
     }
@@ -590,14 +695,13 @@ public:
 
         std::shared_lock<std::shared_timed_mutex> guard(m_mutex);
 
-        auto it = std::find_if(std::begin(m_allocated_pool), std::end(m_allocated_pool),
-            [mid](const pT& surf) { return surf->GetMid() == mid; });
+        auto it = m_mid_index.Find(mid);
 
-        MFX_CHECK(it != std::end(m_allocated_pool), MFX_ERR_NOT_FOUND);
+        MFX_CHECK(it, MFX_ERR_NOT_FOUND);
 
-        MFX_SAFE_CALL((*it)->Unlock());
+        MFX_SAFE_CALL((**it)->Unlock());
 
-        (*it)->CopyPointers(frame_data);
+        (**it)->CopyPointers(frame_data);
 
         return MFX_ERR_NONE;
     }
@@ -608,12 +712,11 @@ public:
 
         std::shared_lock<std::shared_timed_mutex> guard(m_mutex);
 
-        auto it = std::find_if(std::begin(m_allocated_pool), std::end(m_allocated_pool),
-            [mid](const pT& surf) { return surf->GetMid() == mid; });
+        auto it = m_mid_index.Find(mid);
 
-        MFX_CHECK(it != std::end(m_allocated_pool), MFX_ERR_INVALID_HANDLE);
+        MFX_CHECK(it, MFX_ERR_INVALID_HANDLE);
 
-        return (*it)->GetHDL(handle);
+        return (**it)->GetHDL(handle);
     }
 
     mfxStatus Free(mfxFrameAllocResponse& response) override
@@ -645,11 +748,13 @@ public:
             // This mid was already deleted by calling Release (object is deleted when it's refcounter reaches zero)
             if (mid == ALREADY_REMOVED_MID) continue;
 
-            auto it_alloc = std::find_if(std::begin(m_allocated_pool), std::end(m_allocated_pool), [mid](const pT& surf) { return surf->GetMid() == mid; });
+            auto it_alloc = m_mid_index.Find(mid);
 
-            if (it_alloc != std::end(m_allocated_pool))
+            if (it_alloc)
             {
-                frames_to_erase.splice(frames_to_erase.end(), m_allocated_pool, it_alloc);
+                auto it = *it_alloc;
+                RemoveFromIndex(mid);
+                frames_to_erase.splice(frames_to_erase.end(), m_allocated_pool, it);
             }
             else
             {
@@ -674,7 +779,7 @@ public:
 
             std::lock_guard<std::shared_timed_mutex> guard(m_mutex);
 
-            m_allocated_pool.splice(m_allocated_pool.end(), alloc_list);
+            AddToPool(alloc_list);
 
             // Fill mfxFrameSurface1 object and return to user
             output_surf = &(m_allocated_pool.back()->m_exported_surface);
@@ -697,16 +802,15 @@ public:
 
         std::shared_lock<std::shared_timed_mutex> guard(m_mutex);
 
-        auto it = std::find_if(std::begin(m_allocated_pool), std::end(m_allocated_pool),
-            [mid](const pT& surf) { return surf->GetMid() == mid; });
-        MFX_CHECK(it != std::end(m_allocated_pool), MFX_ERR_NOT_FOUND);
+        auto it = m_mid_index.Find(mid);
+        MFX_CHECK(it, MFX_ERR_NOT_FOUND);
 
         // Will not reallocate surface which is locked by someone
-        MFX_CHECK(!(*it)->Locked(),                 MFX_ERR_LOCK_MEMORY);
+        MFX_CHECK(!(**it)->Locked(),                 MFX_ERR_LOCK_MEMORY);
 
-        MFX_CHECK((*it)->ReallocAllowed(info),      MFX_ERR_INVALID_VIDEO_PARAM);
+        MFX_CHECK((**it)->ReallocAllowed(info),      MFX_ERR_INVALID_VIDEO_PARAM);
 
-        return (*it)->Realloc(info);
+        return (**it)->Realloc(info);
     }
 
     void SetDevice(mfxHDL device) override
@@ -721,15 +825,17 @@ protected:
     {
         std::lock_guard<std::shared_timed_mutex> guard(m_mutex);
 
-        auto it = std::find_if(std::begin(m_allocated_pool), std::end(m_allocated_pool),
-            [mid](const pT& surf) { return surf->GetMid() == mid; });
+        auto it_alloc = m_mid_index.Find(mid);
 
-        if (it == std::end(m_allocated_pool))
+        if (!it_alloc)
         {
             std::ignore = MFX_STS_TRACE(MFX_ERR_NOT_FOUND);
             return;
         }
 
+        auto it = *it_alloc;
+        RemoveFromIndex(mid);
+
         // Surface is being deleted after decreasing refcount to zero, no need decrease refcount in destructor of holder
         it->release();
 
@@ -766,10 +872,38 @@ private:
 
     std::list<pT>                          m_allocated_pool;  // Pool of allocated surfaces
 
+    MidIndex<typename std::list<pT>::iterator> m_mid_index; // Mid -> position in m_allocated_pool
+    std::vector<uint64_t>                  m_used_mids;       // Bitmap of low parts of mids present in m_allocated_pool
+
     std::list<std::vector<mfxMemId>>       m_returned_mids;   // Storage of memory for mids returned to MSDK lib
 
     const mfxMemId ALREADY_REMOVED_MID = mfxMemId(std::numeric_limits<size_t>::max());
 
+    // These methods are called with m_mutex being locked exclusively
+    void AddToPool(std::list<pT>& alloc_list)
+    {
+        auto first = std::begin(alloc_list);
+
+        m_allocated_pool.splice(m_allocated_pool.end(), alloc_list);
+
+        // Iterators stay valid after splice and now point into m_allocated_pool
+        for (auto it = first; it != std::end(m_allocated_pool); ++it)
+        {
+            size_t low = size_t((*it)->GetMid()) & m_mid_low_part_modulo;
+
+            m_mid_index.Insert((*it)->GetMid(), it);
+            m_used_mids[low / 64] |= uint64_t(1) << (low % 64);
+        }
+    }
+
+    void RemoveFromIndex(mfxMemId mid)
+    {
+        size_t low = size_t(mid) & m_mid_low_part_modulo;
+
+        m_mid_index.Erase(mid);
+        m_used_mids[low / 64] &= ~(uint64_t(1) << (low % 64));
+    }
+
     // This method always called without m_mutex being locked
     mfxMemId GenerateMid()
     {
@@ -778,18 +912,30 @@ private:
         // Check that pool is not already full
         MFX_CHECK_WITH_THROW_STS(m_allocated_pool.size() <= (m_mid_low_part_modulo + 1), MFX_ERR_MEMORY_ALLOC);
 
-        mfxMemId new_memid;
-        // There is only m_mid_low_part_modulo + 1 possible mids within one allocator
-        for (size_t i = 0; i < m_mid_low_part_modulo + 1; ++i)
+        // There is only m_mid_low_part_modulo + 1 possible mids within one allocator,
+        // look for the first one not present in pool starting after the last generated
+        const size_t n_words = m_used_mids.size();
+        const size_t start   = (m_mid_low_part + 1) & m_mid_low_part_modulo;
+
+        // Last iteration revisits the start word to cover its bits below start (wrap around)
+        for (size_t i = 0; i <= n_words; ++i)
         {
-            new_memid = mfxMemId(m_mid_high_part | ((++m_mid_low_part) & m_mid_low_part_modulo));
-
-            if (
-                // Check if current mid is already in pool
-                std::find_if(std::begin(m_allocated_pool), std::end(m_allocated_pool),
-                    [new_memid](const pT& surf) { return surf->GetMid() == new_memid; }) == std::end(m_allocated_pool)
-                )
-                return new_memid;
+            size_t   word = (start / 64 + i) % n_words;
+            uint64_t free = ~m_used_mids[word];
+
+            if (i == 0)
+                free &= ~uint64_t(0) << (start % 64);
+
+            if (!free)
+                continue;
+
+            size_t bit = 0;
+            while (!(free & (uint64_t(1) << bit)))
+                ++bit;
+
+            m_mid_low_part = word * 64 + bit;
+
+            return mfxMemId(m_mid_high_part | m_mid_low_part);
         }
 
         // Couldn't find suitable mid
@@ -34,7 +34,9 @@
 #include <memory>
 #include <deque>
 #include <chrono>
+#include <atomic>
 #include <limits>
+#include <unordered_map>
 
 
 using AffinityMaskType = std::pair<mfxU32/*size*/, std::vector<mfxU8>/*mask*/>;
@@ -112,6 +114,8 @@ public:
     // Get the current number of working threads
     virtual mfxU32 GetNumWorkingThreads()                       override { return m_numThreadsAvailable; }
     virtual void INeedMoreThreadsInside(const void *pComponent) override;
+    virtual mfxStatus RegisterHwCompletionEvent(const void *pComponent, int eventFd) override;
+    virtual void UnregisterHwCompletionEvent(const void *pComponent) override;
 
     virtual mfxStatus DoFastCopy(mfxFrameSurface1 *pDst, mfxFrameSurface1 *pSrc)                      override;
     virtual mfxStatus DoFastCopyExtended(mfxFrameSurface1 *pDst, mfxFrameSurface1 *pSrc, mfxU32 = MFX_COPY_USE_ANY) override;
@@ -528,6 +532,14 @@ class SurfaceCache
     : public mfxRefCountableImpl<mfxSurfacePoolInterface>
 {
 public:
+    // Core-internal counters of GetSurface calls, the application API has no place for them
+    struct Statistics
+    {
+        mfxU64 NumHits   = 0; // GetSurface returned already cached surface
+        mfxU64 NumMisses = 0; // GetSurface allocated new surface
+        mfxU64 NumWaits  = 0; // GetSurface had to wait for surface return because cache limit was reached
+    };
+
     static SurfaceCache* Create(CommonCORE_VPL& core, mfxU16 type, const mfxFrameInfo& frame_info)
     {
         auto cache = new SurfaceCache(core, type, frame_info);
@@ -622,6 +634,7 @@ public:
             output_surface = FreeSurfaceLookup(emulate_zero_refcount_base);
             if (output_surface)
             {
+                m_num_hits.fetch_add(1, std::memory_order_relaxed);
                 return MFX_ERR_NONE;
             }
 
@@ -631,6 +644,8 @@ public:
 
                 MFX_CHECK(current_time_to_wait != 0ms, MFX_WRN_ALLOC_TIMEOUT_EXPIRED);
 
+                m_num_waits.fetch_add(1, std::memory_order_relaxed);
+
                 // Cannot allocate (no free slots) surface, but we can wait
                 bool wait_succeeded = m_cv_wait_free_surface.wait_for(lock, current_time_to_wait,
                     [&output_surface, emulate_zero_refcount_base, this]()
@@ -642,6 +657,7 @@ public:
 
                 MFX_CHECK(wait_succeeded, MFX_WRN_ALLOC_TIMEOUT_EXPIRED);
 
+                m_num_hits.fetch_add(1, std::memory_order_relaxed);
                 return MFX_ERR_NONE;
             }
         }
@@ -649,26 +665,29 @@ public:
         else if (m_cached_surfaces.size() + m_num_pending_insertion >= m_limit)
         {
             // We try to reallocate one of the existing free surfaces if cache limit reached, but user asks to import surface
-            auto it = std::find_if(std::begin(m_cached_surfaces), std::end(m_cached_surfaces), [](const SurfaceHolder& surface) { return !surface.m_in_use; });
-
-            if (it == std::end(m_cached_surfaces))
+            if (!m_free_surfaces_head)
             {
                 using namespace std::chrono;
 
                 MFX_CHECK(current_time_to_wait != 0ms, MFX_WRN_ALLOC_TIMEOUT_EXPIRED);
 
+                m_num_waits.fetch_add(1, std::memory_order_relaxed);
+
+                SurfaceHolder* free_holder = nullptr;
+
                 // Cannot allocate (no free slots) surface, but we can wait
                 bool wait_succeeded = m_cv_wait_free_surface.wait_for(lock, current_time_to_wait,
-                    [&it, this]()
+                    [&free_holder, this]()
                     {
-                        it = std::find_if(std::begin(m_cached_surfaces), std::end(m_cached_surfaces), [](const SurfaceHolder& surface) { return !surface.m_in_use; });
+                        free_holder = PopFreeSurface();
 
-                        return it != std::end(m_cached_surfaces);
+                        return free_holder != nullptr;
                     });
 
                 MFX_CHECK(wait_succeeded, MFX_WRN_ALLOC_TIMEOUT_EXPIRED);
 
-                m_cached_surfaces.erase(it);
+                std::list<SurfaceHolder> surface_to_delete;
+                ExtractSurface(surface_to_delete, free_holder->Data.MemId);
             }
         }
 
@@ -683,7 +702,9 @@ public:
 
         lock.lock();
         m_cached_surfaces.emplace_back(*surf, *this);
+        m_surface_by_mid[surf->Data.MemId] = std::prev(std::end(m_cached_surfaces));
         --m_num_pending_insertion;
+        m_num_misses.fetch_add(1, std::memory_order_relaxed);
         m_cached_surfaces.back().m_in_use = true;
         // We can relax this in future if actually copy happened during import
         m_cached_surfaces.back().m_created_from_external_handle = !!import_surface;
@@ -704,9 +725,19 @@ public:
     {
         std::lock_guard<std::mutex> guard(m_mutex);
 
-        auto it = std::find_if(std::begin(m_cached_surfaces), std::end(m_cached_surfaces), [memid](const SurfaceHolder& surface) { return surface.Data.MemId == memid; });
+        auto it = m_surface_by_mid.find(memid);
 
-        return it != std::end(m_cached_surfaces) ? &(*it) : nullptr;
+        return it != std::end(m_surface_by_mid) ? &(*it->second) : nullptr;
+    }
+
+    Statistics GetStatistics() const
+    {
+        Statistics stats;
+        stats.NumHits   = m_num_hits.load(std::memory_order_relaxed);
+        stats.NumMisses = m_num_misses.load(std::memory_order_relaxed);
+        stats.NumWaits  = m_num_waits.load(std::memory_order_relaxed);
+
+        return stats;
     }
 
     mfxStatus SetupPolicy(const mfxExtAllocationHints& hints_buffer)
@@ -738,6 +769,15 @@ public:
             }
 
             m_cached_surfaces = std::move(preallocated_surfaces);
+
+            m_surface_by_mid.clear();
+            m_free_surfaces_head = nullptr;
+
+            for (auto it = std::begin(m_cached_surfaces); it != std::end(m_cached_surfaces); ++it)
+            {
+                m_surface_by_mid[it->Data.MemId] = it;
+                PushFreeSurface(*it);
+            }
         }
 
         m_time_to_wait = std::chrono::milliseconds(hints_buffer.Wait);
@@ -814,22 +854,11 @@ public:
 
         std::unique_lock<std::mutex> lock(std::move(outer_lock));
 
-        auto should_remove_predicate =
-            [](const SurfaceHolder& surface_holder)
+        // Only surfaces not owned by anybody can be decommitted, all of them are in free stack
+        for (SurfaceHolder* free_holder = nullptr; m_num_to_revoke && (free_holder = PopFreeSurface());)
         {
-            // Check if surface is still owned by somebody
-            return !surface_holder.m_in_use;
-        };
-
-        // splice_if
-        for (auto it = std::begin(m_cached_surfaces); it != std::end(m_cached_surfaces) && m_num_to_revoke;)
-        {
-            auto it_to_transfer = it++;
-            if (should_remove_predicate(*it_to_transfer))
-            {
-                surfaces_to_decommit.splice(std::end(surfaces_to_decommit), m_cached_surfaces, it_to_transfer);
-                --m_num_to_revoke;
-            }
+            ExtractSurface(surfaces_to_decommit, free_holder->Data.MemId);
+            --m_num_to_revoke;
         }
     }
 
@@ -858,8 +887,10 @@ public:
 
         std::unique_lock<std::mutex> lock(m_mutex);
 
-        auto p_holder = std::find_if(std::begin(m_cached_surfaces), std::end(m_cached_surfaces), [mid](const SurfaceHolder& surface) { return surface.Data.MemId == mid; });
-        MFX_CHECK(p_holder != std::end(m_cached_surfaces), MFX_ERR_NOT_FOUND);
+        auto it_holder = m_surface_by_mid.find(mid);
+        MFX_CHECK(it_holder != std::end(m_surface_by_mid), MFX_ERR_NOT_FOUND);
+
+        auto p_holder = it_holder->second;
 
         // Mark as free
         p_holder->m_in_use = false;
@@ -871,7 +902,7 @@ public:
         // For imported surfaces we delete it immidiately, without returning to cache (since we don't control lifetime of HW handle)
         if (p_holder->m_created_from_external_handle)
         {
-            surface_to_delete.splice(std::end(surface_to_delete), m_cached_surfaces, p_holder);
+            ExtractSurface(surface_to_delete, mid);
 
             return MFX_ERR_NONE;
         }
@@ -879,6 +910,8 @@ public:
         // Remove surfaces from pool if required or notify waiters about free surface
         if (!m_num_to_revoke)
         {
+            PushFreeSurface(*p_holder);
+
             // If no surfaces to decommit, notify some waiter
             lock.unlock();
             m_cv_wait_free_surface.notify_one();
@@ -886,7 +919,7 @@ public:
         }
 
         // Decommit current surface
-        surface_to_delete.splice(std::end(surface_to_delete), m_cached_surfaces, p_holder);
+        ExtractSurface(surface_to_delete, mid);
         --m_num_to_revoke;
 
         return MFX_ERR_NONE;
@@ -912,9 +945,9 @@ private:
     {
         // This function is called only from thread safe context, so no mutex acquiring here
 
-        auto it = std::find_if(std::begin(m_cached_surfaces), std::end(m_cached_surfaces), [](const SurfaceHolder& surface) { return !surface.m_in_use; });
+        SurfaceHolder* it = PopFreeSurface();
 
-        if (it == std::end(m_cached_surfaces))
+        if (!it)
             return nullptr;
 
         it->m_in_use = true;
@@ -925,7 +958,7 @@ private:
 #ifndef NDEBUG
         it->m_was_released = false;
 #endif
-        return &(*it);
+        return it;
     }
 
     static mfxStatus skip_one_addref(mfxFrameSurface1* surface)
@@ -949,6 +982,8 @@ private:
 #ifndef NDEBUG
         bool m_was_released = false;
 #endif
+        // Next entry of cache's free stack
+        SurfaceHolder* m_next_free          = nullptr;
 
         SurfaceHolder(mfxFrameSurface1& surf, SurfaceCache& cache)
             : mfxFrameSurface1(surf)
@@ -1012,6 +1047,38 @@ private:
         }
     };
 
+    // Free stack operations and ExtractSurface are called only from thread safe context
+
+    void PushFreeSurface(SurfaceHolder& holder)
+    {
+        holder.m_next_free   = m_free_surfaces_head;
+        m_free_surfaces_head = &holder;
+    }
+
+    SurfaceHolder* PopFreeSurface()
+    {
+        SurfaceHolder* holder = m_free_surfaces_head;
+
+        if (holder)
+        {
+            m_free_surfaces_head = holder->m_next_free;
+            holder->m_next_free  = nullptr;
+        }
+
+        return holder;
+    }
+
+    // Moves holder out of cache to dst, surface must not be in free stack
+    void ExtractSurface(std::list<SurfaceHolder>& dst, mfxMemId mid)
+    {
+        auto it = m_surface_by_mid.find(mid);
+        if (it == std::end(m_surface_by_mid))
+            return;
+
+        dst.splice(std::end(dst), m_cached_surfaces, it->second);
+        m_surface_by_mid.erase(it);
+    }
+
     mutable std::mutex        m_mutex;
     std::condition_variable   m_cv_wait_free_surface;
 
@@ -1030,6 +1097,16 @@ private:
 
     std::list<SurfaceHolder>  m_cached_surfaces;
     std::list<mfxU32>         m_requests;
+
+    // Index of m_cached_surfaces by mid, to find surface returned by release in O(1)
+    std::unordered_map<mfxMemId, std::list<SurfaceHolder>::iterator> m_surface_by_mid;
+    // Intrusive stack of surfaces from m_cached_surfaces which are not in use
+    SurfaceHolder*            m_free_surfaces_head    = nullptr;
+
+    // Statistics counters, they are read without the lock
+    std::atomic<mfxU64>       m_num_hits{ 0 };
+    std::atomic<mfxU64>       m_num_misses{ 0 };
+    std::atomic<mfxU64>       m_num_waits{ 0 };
 };
 
 inline bool SupportsVPLFeatureSet(VideoCORE& core)
@@ -42,6 +42,14 @@
     #define MFX_SSE_4_1
 #endif
 
+#if defined(__AVX2__)
+    #define MFX_AVX2
+#endif
+
+#if defined(__AVX512F__) && defined(__AVX512BW__)
+    #define MFX_AVX512
+#endif
+
 #define UMC_VA
 #if defined(UNICODE) || defined(_UNICODE)
     #define MFX_UNICODE
@@ -0,0 +1,92 @@
+// Copyright (c) 2025 Intel Corporation
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#ifndef __MFX_HW_COMPLETION_WAITER_H__
+#define __MFX_HW_COMPLETION_WAITER_H__
+
+#include "mfxdefs.h"
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <thread>
+
+// Moves blocking waits for HW completion off the scheduler threads.
+// The wait of a task runs on a helper thread, which signals an eventfd when it
+// returns. A component registers the event with VideoCORE::RegisterHwCompletionEvent,
+// so while the wait lasts its task returns MFX_TASK_BUSY and sleeps in the scheduler
+// instead of holding a worker thread or being respun.
+// Waits run one by one in the order of submission, like the HW executes the tasks.
+class HwCompletionWaiter
+{
+public:
+    typedef std::function<mfxStatus()> WaitFunc;
+
+    HwCompletionWaiter() = default;
+    ~HwCompletionWaiter();
+
+    HwCompletionWaiter(const HwCompletionWaiter &) = delete;
+    HwCompletionWaiter & operator = (const HwCompletionWaiter &) = delete;
+
+    // create the event and start the helper thread
+    mfxStatus Init();
+
+    // finish the waits submitted already and release the event
+    void Close();
+
+    bool IsActive() const
+    {
+        return 0 <= m_event;
+    }
+
+    // eventfd signaled after each finished wait
+    int GetEvent() const
+    {
+        return m_event;
+    }
+
+    // Submits the wait of the task on the first call.
+    // Returns MFX_TASK_BUSY until the wait is finished, then the status of the wait.
+    mfxStatus Wait(const void *pTask, WaitFunc wait);
+
+protected:
+    void ThreadProc();
+
+    struct Job
+    {
+        const void *pTask;
+        WaitFunc    wait;
+    };
+
+    int                          m_event = -1;
+    bool                         m_bQuit = false;
+
+    std::mutex                   m_guard;
+    std::condition_variable      m_cv;
+    std::deque<Job>              m_queued;
+    const void                  *m_pRunning = nullptr;
+    std::map<const void *, mfxStatus> m_done;
+
+    std::thread                  m_thread;
+};
+
+#endif // __MFX_HW_COMPLETION_WAITER_H__
@@ -713,6 +713,17 @@ public:
 
         return *(T*)&*itNew;
     }
+
+    // Attach a new zeroed array of 'count' items, p must not point to attached data yet
+    template<typename T>
+    T* PushArray(T*& p, size_t count)
+    {
+        if (!count)
+            return p = nullptr;
+
+        m_attachedData.emplace_back(std::vector<uint8_t>(sizeof(T) * count, 0));
+        return p = (T*)m_attachedData.back().data();
+    }
 protected:
     std::list<std::vector<uint8_t>> m_attachedData;
 };
@@ -808,6 +819,85 @@ inline mfxExtBuffer* GetExtBuffer(mfxExtBuffer** ExtParam, mfxU32 NumExtParam, m
 
     return nullptr;
 }
+
+// Index of ExtParam array built once per call, it maps BufferId to the first attached
+// buffer with this Id. Doesn't allocate, so it can be kept on stack or in task data.
+// Buffers are referenced, they must outlive the index.
+class ExtBufferIndex
+{
+public:
+    ExtBufferIndex() = default;
+
+    ExtBufferIndex(mfxExtBuffer** ExtParam, mfxU32 NumExtParam)
+    {
+        Build(ExtParam, NumExtParam);
+    }
+
+    template<class T>
+    explicit ExtBufferIndex(const T& par)
+        : ExtBufferIndex(par.ExtParam, par.NumExtParam)
+    {}
+
+    void Build(mfxExtBuffer** ExtParam, mfxU32 NumExtParam)
+    {
+        m_ExtParam    = ExtParam;
+        m_NumExtParam = ExtParam ? NumExtParam : 0;
+        std::fill(std::begin(m_slots), std::end(m_slots), nullptr);
+
+        // too many buffers for the table, lookups fall back to linear search
+        m_bLinear = m_NumExtParam > MAX_INDEXED;
+        if (m_bLinear)
+            return;
+
+        for (mfxU32 i = 0; i < m_NumExtParam; ++i)
+        {
+            if (!ExtParam[i])
+                continue;
+
+            mfxExtBuffer*& slot = m_slots[FindSlot(ExtParam[i]->BufferId)];
+            if (!slot)
+                slot = ExtParam[i];
+        }
+    }
+
+    mfxExtBuffer* Get(mfxU32 BufferId, mfxU32 offset = 0) const
+    {
+        if (m_bLinear || offset)
+            return GetExtBuffer(m_ExtParam, m_NumExtParam, BufferId, offset);
+
+        return m_slots[FindSlot(BufferId)];
+    }
+
+    mfxExtBuffer** ExtParam() const { return m_ExtParam; }
+    mfxU32 NumExtParam() const { return m_NumExtParam; }
+
+private:
+    static constexpr mfxU32 SLOTS_LOG2  = 6;
+    static constexpr mfxU32 SLOTS       = 1 << SLOTS_LOG2;
+    static constexpr mfxU32 MAX_INDEXED = SLOTS / 2;
+
+    // open addressing with linear probing, the table is never filled by more than half
+    mfxU32 FindSlot(mfxU32 BufferId) const
+    {
+        mfxU32 slot = (BufferId * 0x9E3779B1u) >> (32 - SLOTS_LOG2);
+
+        while (m_slots[slot] && m_slots[slot]->BufferId != BufferId)
+            slot = (slot + 1) & (SLOTS - 1);
+
+        return slot;
+    }
+
+    mfxExtBuffer*  m_slots[SLOTS] = {};
+    mfxExtBuffer** m_ExtParam     = nullptr;
+    mfxU32         m_NumExtParam  = 0;
+    bool           m_bLinear      = false;
+};
+
+inline mfxExtBuffer* GetExtBuffer(const ExtBufferIndex& index, mfxU32 BufferId, mfxU32 offset = 0)
+{
+    return index.Get(BufferId, offset);
+}
+
 using mfx_shared_lib_path_string = std::string;
 
 inline mfxHDL shared_lib_load(const mfx_shared_lib_path_string& shared_lib_file_name)
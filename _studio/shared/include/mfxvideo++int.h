@@ -178,6 +178,9 @@ public:
     // Get the current number of working threads
     virtual mfxU32 GetNumWorkingThreads(void) = 0;
     virtual void INeedMoreThreadsInside(const void *pComponent) = 0;
+    // Let the scheduler resume component's tasks, which returned MFX_TASK_BUSY, once eventFd is signaled
+    virtual mfxStatus RegisterHwCompletionEvent(const void *pComponent, int eventFd) = 0;
+    virtual void UnregisterHwCompletionEvent(const void *pComponent) = 0;
 
     // need for correct video accelerator creation
     virtual mfxStatus DoFastCopy(mfxFrameSurface1 *dst, mfxFrameSurface1 *src) = 0;
@@ -6,63 +6,184 @@
 #include <map>
 #include <memory>
 #include <mutex>
+#include <condition_variable>
+#include <thread>
 #include <fstream>
 #include <sstream>
+#include <unordered_map>
 #include <vector>
 
 #define MFX_MAX_PERF_FILENAME_LEN 260
 #define MFX_MAX_PATH_LENGTH       256
+
 //For perf log
-typedef struct _Tick
+//Every thread writes fixed size binary records into its own ring, a background
+//thread drains the rings to <VPL PERF PATH>/perf_pid<pid>.bin.
+//mfx_perf_convert turns the file into perf_details_pid*_tid*.txt or Chrome trace JSON.
+enum PerfLevel : uint8_t
+{
+    PERF_LEVEL_ID_API      = 0,
+    PERF_LEVEL_ID_DDI      = 1,
+    PERF_LEVEL_ID_HW       = 2,
+    PERF_LEVEL_ID_ROUTINE  = 3,
+    PERF_LEVEL_ID_INTERNAL = 4,
+};
+
+enum PerfRecordType : uint8_t
+{
+    PERF_RECORD_ENTER   = 0,
+    PERF_RECORD_EXIT    = 1,
+    PERF_RECORD_TASK_ID = 2, // follows EXIT record, value is async task id
+};
+
+// perf file layout: PerfFileHeader followed by chunks, every chunk starts with PerfChunkHeader
+#define MFX_PERF_FILE_MAGIC   0x004652455058464DULL // "MFXPERF"
+#define MFX_PERF_FILE_VERSION 1
+
+enum PerfChunkType : uint32_t
+{
+    PERF_CHUNK_CLOCK   = 0, // PerfClockChunk
+    PERF_CHUNK_TAG     = 1, // uint32_t id + tag characters, no terminating zero
+    PERF_CHUNK_RECORDS = 2, // uint32_t tid + PerfRecord[]
+    PERF_CHUNK_DROPPED = 3, // uint32_t tid + uint32_t number of records lost on ring overflow
+};
+
+#pragma pack(push, 1)
+struct PerfFileHeader
+{
+    uint64_t magic;
+    uint32_t version;
+    uint32_t pid;
+};
+
+struct PerfChunkHeader
+{
+    uint32_t type;
+    uint32_t size; // in bytes, without header
+};
+
+// pairs of (tick, ns) let the converter map ticks to CLOCK_MONOTONIC time
+struct PerfClockChunk
+{
+    uint64_t tick;
+    uint64_t ns;
+};
+
+struct PerfRecord
+{
+    uint64_t tick;
+    uint32_t value; // tag id or task id
+    uint8_t  level;
+    uint8_t  type;
+    uint16_t reserved;
+};
+#pragma pack(pop)
+
+static_assert(sizeof(PerfRecord) == 16, "PerfRecord is written to file as is");
+
+// Single producer (owning thread), single consumer (drain thread) ring
+struct PerfRing
 {
-    std::string tag;
-    int64_t timestamp;
-    int64_t freq;
-    std::string functionType;
-    std::string level;
-}Tick;
+    static const uint32_t CAPACITY = 1 << 16;
+
+    PerfRecord            records[CAPACITY];
+    std::atomic<uint32_t> head{ 0 };    // written by owner
+    std::atomic<uint32_t> tail{ 0 };    // written by drain thread
+    std::atomic<uint32_t> dropped{ 0 };
+    std::atomic<bool>     retired{ false };
+    std::atomic<bool>     wakeRequested{ false }; // ring is half full, drain thread was notified
+    uint32_t              tid = 0;
+
+    bool Push(PerfRecord const& record)
+    {
+        uint32_t const h = head.load(std::memory_order_relaxed);
+        if (h - tail.load(std::memory_order_acquire) == CAPACITY)
+        {
+            dropped.fetch_add(1, std::memory_order_relaxed);
+            return false;
+        }
+
+        records[h % CAPACITY] = record;
+        head.store(h + 1, std::memory_order_release);
+        return true;
+    }
+
+    // true once per drain when the ring is filled by half, owner wakes the drain thread then
+    bool NeedsDrain()
+    {
+        return head.load(std::memory_order_relaxed) - tail.load(std::memory_order_relaxed) >= CAPACITY / 2
+            && !wakeRequested.exchange(true, std::memory_order_relaxed);
+    }
+};
 
 class PerfUtility
 {
 public:
     static PerfUtility* getInstance();
     ~PerfUtility();
-    PerfUtility() = default;
+    PerfUtility();
     int32_t getPid();
     int32_t getTid();
-    void timeStampTick(const std::string &tag, const std::string &level, const std::string &flag, const std::vector<uint32_t> &taskIds);
+    uint32_t getTagId(const char* tag);
+    uint32_t getTagId(const std::string& tag);
+    void timeStampTick(uint32_t tagId, PerfLevel level, PerfRecordType flag, const std::vector<uint32_t> &taskIds);
     void savePerfData();
     static std::string perfFilePath;
-    static std::atomic<double> timeStamp;
+
+    static uint64_t getTick();
+    static uint64_t getClockNs();
 
 private:
-    void printPerfTimeStamp(Tick* newTick, const std::vector<uint32_t>& taskIds);
+    PerfRing* getRing();
+    uint32_t internTag(const std::string& tag);
+    void drainThread();
+    bool openFile();
+    void writeChunk(PerfChunkType type, const void* data, uint32_t size, const void* data2 = nullptr, uint32_t size2 = 0);
+    void writeClock();
 
 private:
     static std::shared_ptr<PerfUtility> instance;
     static std::mutex perfMutex;
-    std::map<int32_t, std::string> log_buffer{};
+
+    // tags are interned once per process, threads keep own tag caches
+    std::mutex                                tagGuard;
+    std::unordered_map<std::string, uint32_t> tagIds;
+    std::vector<std::string>                  tags;
+    size_t                                    tagsWritten = 0;
+
+    std::mutex                                ringGuard;
+    std::vector<std::shared_ptr<PerfRing>>    rings;
+
+    std::mutex                                drainGuard;
+    std::condition_variable                   drainCond;
+    bool                                      stopDrain = false;
+    std::thread                               drainWorker;
+
+    PerfClockChunk                            startClock = {};
+    std::ofstream                             perfFile;
+    bool                                      fileFailed = false;
+    std::vector<PerfRecord>                   drainBuffer;
 };
 
 
 extern PerfUtility* g_perfutility;
 
-#define PERF_LEVEL_API "API"
-#define PERF_LEVEL_DDI "DDI"
-#define PERF_LEVEL_HW "HW"
-#define PERF_LEVEL_ROUTINE "Routine"
-#define PERF_LEVEL_INTERNAL "INTERNAL"
-
-#define MFX_FLAG_ENTER ": ENTER"
-#define MFX_FLAG_EXIT  ": EXIT"
-
-#define PERF_UTILITY_TIMESTAMP(TAG,LEVEL,FLAG)                                       \
-    do                                                                               \
-    {                                                                                \
-        if (g_perfutility)                                                           \
-        {                                                                            \
-            g_perfutility->timeStampTick(TAG, LEVEL, FLAG, std::vector<uint32_t>()); \
-        }                                                                            \
+#define PERF_LEVEL_API      PERF_LEVEL_ID_API
+#define PERF_LEVEL_DDI      PERF_LEVEL_ID_DDI
+#define PERF_LEVEL_HW       PERF_LEVEL_ID_HW
+#define PERF_LEVEL_ROUTINE  PERF_LEVEL_ID_ROUTINE
+#define PERF_LEVEL_INTERNAL PERF_LEVEL_ID_INTERNAL
+
+#define MFX_FLAG_ENTER PERF_RECORD_ENTER
+#define MFX_FLAG_EXIT  PERF_RECORD_EXIT
+
+#define PERF_UTILITY_TIMESTAMP(TAG,LEVEL,FLAG)                                                             \
+    do                                                                                                     \
+    {                                                                                                      \
+        if (g_perfutility)                                                                                 \
+        {                                                                                                  \
+            g_perfutility->timeStampTick(g_perfutility->getTagId(TAG), LEVEL, FLAG, std::vector<uint32_t>()); \
+        }                                                                                                  \
     } while(0)
 
 #define PERF_UTILITY_AUTO(TAG,LEVEL) AutoPerfUtility apu(TAG,LEVEL)
@@ -72,13 +193,15 @@ class AutoPerfUtility
 {
 public:
     static void SetTaskId(uint32_t id);
-    AutoPerfUtility(const std::string &tag, const std::string &level);
+    AutoPerfUtility(const char* tag, PerfLevel level);
+    AutoPerfUtility(const std::string &tag, PerfLevel level);
     ~AutoPerfUtility();
 
 private:
-    static std::mutex map_guard;
-    static std::map<uint64_t, std::vector<uint32_t>> tid2taskIds;
-    bool bPrintTaskIds = false;
-    std::string autotag = "intialized";
-    std::string autolevel = "intialized";
-};
\ No newline at end of file
+    void enter(uint32_t tagId, PerfLevel level);
+
+    bool      bActive = false;
+    bool      bPrintTaskIds = false;
+    uint32_t  autotag = 0;
+    PerfLevel autolevel = PERF_LEVEL_ID_API;
+};
@@ -4,6 +4,11 @@
 #include <pthread.h>
 #include "unistd.h"
 #include <sys/stat.h> 
+#include <sys/syscall.h>
+#include <time.h>
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
 
 #include "mfx_utils_perf.h"
 
@@ -67,8 +72,29 @@ PerfUtility* g_perfutility = nullptr;
 std::string PerfUtility::perfFilePath = "Initialize";
 std::shared_ptr<PerfUtility> PerfUtility::instance = nullptr;
 std::mutex PerfUtility::perfMutex;
-std::mutex AutoPerfUtility::map_guard;
-std::map<uint64_t, std::vector<uint32_t>> AutoPerfUtility::tid2taskIds;
+
+namespace
+{
+    // Everything a thread needs to record without taking locks
+    struct PerfThreadState
+    {
+        std::shared_ptr<PerfRing>                  ring;
+        std::unordered_map<const char*, uint32_t>  literalTags;
+        std::unordered_map<std::string, uint32_t>  stringTags;
+        std::vector<uint32_t>                      taskIds;
+
+        ~PerfThreadState()
+        {
+            // drain thread releases the ring once its records are written
+            if (ring)
+                ring->retired.store(true, std::memory_order_release);
+        }
+    };
+
+    thread_local PerfThreadState t_perfState;
+
+    const uint32_t PERF_DRAIN_PERIOD_MS = 100;
+}
 
 void AutoPerfUtility::SetTaskId(uint32_t id)
 {
@@ -77,36 +103,42 @@ void AutoPerfUtility::SetTaskId(uint32_t id)
         return;
     }
 
-    uint64_t tid = pthread_self();
+    t_perfState.taskIds.push_back(id);
+}
 
-    decltype(tid2taskIds)::iterator it;
-    if ((it = tid2taskIds.find(tid)) == tid2taskIds.end())
+AutoPerfUtility::AutoPerfUtility(const char* tag, PerfLevel level)
+{
+    if (!g_perfutility)
     {
-        std::lock_guard<std::mutex> lg(map_guard);
-        tid2taskIds[tid] = {};
-        it = tid2taskIds.find(tid);
+        return;
     }
-    it->second.push_back(id);
+
+    enter(g_perfutility->getTagId(tag), level);
 }
 
-AutoPerfUtility::AutoPerfUtility(const std::string& tag, const std::string& level)
+AutoPerfUtility::AutoPerfUtility(const std::string& tag, PerfLevel level)
 {
     if (!g_perfutility)
     {
         return;
     }
 
-    std::string flag = MFX_FLAG_ENTER;
+    enter(g_perfutility->getTagId(tag), level);
+}
+
+void AutoPerfUtility::enter(uint32_t tagId, PerfLevel level)
+{
     try
     {
-        g_perfutility->timeStampTick(tag, level, flag, std::vector<uint32_t>());
+        g_perfutility->timeStampTick(tagId, level, PERF_RECORD_ENTER, std::vector<uint32_t>());
     }
-    catch(...)
+    catch (...)
     {
         return;
     }
 
-    autotag = tag;
+    bActive = true;
+    autotag = tagId;
     autolevel = level;
     if (level == PERF_LEVEL_API || level == PERF_LEVEL_ROUTINE)
     {
@@ -116,25 +148,22 @@ AutoPerfUtility::AutoPerfUtility(const std::string& tag, const std::string& leve
 
 AutoPerfUtility::~AutoPerfUtility()
 {
-    if (!g_perfutility)
+    if (!g_perfutility || !bActive)
     {
         return;
     }
 
-    std::string flag = MFX_FLAG_EXIT;
     std::vector<uint32_t> ids;
-    uint64_t tid = pthread_self();
-
-    if (bPrintTaskIds && tid2taskIds.find(tid) != tid2taskIds.end())
+    if (bPrintTaskIds)
     {
-        tid2taskIds[tid].swap(ids);
+        t_perfState.taskIds.swap(ids);
     }
 
     try
     {
-        g_perfutility->timeStampTick(autotag, autolevel, flag, ids);
+        g_perfutility->timeStampTick(autotag, autolevel, PERF_RECORD_EXIT, ids);
     }
-    catch (std::bad_array_new_length&)
+    catch (...)
     {
 
     }
@@ -142,6 +171,7 @@ AutoPerfUtility::~AutoPerfUtility()
 
 PerfUtility* PerfUtility::getInstance()
 {
+    std::lock_guard<std::mutex> lock(perfMutex);
     if (instance == nullptr)
     {
         instance = std::make_shared<PerfUtility>();
@@ -150,19 +180,39 @@ PerfUtility* PerfUtility::getInstance()
     return instance.get();
 }
 
+PerfUtility::PerfUtility()
+{
+    startClock.tick = getTick();
+    startClock.ns   = getClockNs();
+    drainWorker = std::thread([this]() { drainThread(); });
+}
+
 PerfUtility::~PerfUtility()
 {
     // save perf data here
-    if (instance)
+    if (g_perfutility == this)
+    {
+        g_perfutility = nullptr;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(drainGuard);
+        stopDrain = true;
+    }
+    drainCond.notify_one();
+
+    if (drainWorker.joinable())
+    {
+        drainWorker.join();
+    }
+
+    try
+    {
+        savePerfData();
+    }
+    catch (...)
     {
-        try
-        {
-            instance->savePerfData();
-        }
-        catch (...)
-        {
 
-        }
     }
 }
 
@@ -174,95 +224,277 @@ int32_t PerfUtility::getPid()
 
 int32_t PerfUtility::getTid()
 {
-    int32_t tid = pthread_self();
+    int32_t tid = (int32_t)syscall(SYS_gettid);
     return tid;
 }
 
-void PerfUtility::savePerfData()
+uint64_t PerfUtility::getTick()
+{
+#if defined(__x86_64__) || defined(__i386__)
+    return __rdtsc();
+#else
+    return getClockNs();
+#endif
+}
+
+uint32_t PerfUtility::internTag(const std::string& tag)
+{
+    std::lock_guard<std::mutex> lock(tagGuard);
+
+    auto it = tagIds.find(tag);
+    if (it != tagIds.end())
+    {
+        return it->second;
+    }
+
+    uint32_t id = (uint32_t)tags.size();
+    tags.push_back(tag);
+    tagIds.emplace(tag, id);
+    return id;
+}
+
+// tag pointers passed here are string literals or __FUNCTION__, so the pointer identifies the tag
+uint32_t PerfUtility::getTagId(const char* tag)
+{
+    auto it = t_perfState.literalTags.find(tag);
+    if (it != t_perfState.literalTags.end())
+    {
+        return it->second;
+    }
+
+    uint32_t id = internTag(tag);
+    t_perfState.literalTags.emplace(tag, id);
+    return id;
+}
+
+uint32_t PerfUtility::getTagId(const std::string& tag)
+{
+    auto it = t_perfState.stringTags.find(tag);
+    if (it != t_perfState.stringTags.end())
+    {
+        return it->second;
+    }
+
+    uint32_t id = internTag(tag);
+    t_perfState.stringTags.emplace(tag, id);
+    return id;
+}
+
+PerfRing* PerfUtility::getRing()
+{
+    if (!t_perfState.ring)
+    {
+        auto ring = std::make_shared<PerfRing>();
+        ring->tid = getTid();
+
+        std::lock_guard<std::mutex> lock(ringGuard);
+        rings.push_back(ring);
+        t_perfState.ring = ring;
+    }
+
+    return t_perfState.ring.get();
+}
+
+void PerfUtility::timeStampTick(uint32_t tagId, PerfLevel level, PerfRecordType flag, const std::vector<uint32_t>& taskIds)
 {
-    std::fstream pTimeStampFile;
-    int32_t pid = getPid();
+    PerfRing* ring = getRing();
+
+    PerfRecord record = {};
+    record.tick  = getTick();
+    record.value = tagId;
+    record.level = level;
+    record.type  = flag;
+    ring->Push(record);
 
-        const char* const perf_log_path_fmt = "%s/perf_details_pid%d_tid%d.txt";
-    for (auto it : log_buffer)
+    record.type = PERF_RECORD_TASK_ID;
+    for (auto id : taskIds)
     {
-        char sDetailsFileName[MFX_MAX_PERF_FILENAME_LEN + 1] = { '\0' };
-        MFX_SecureStringPrint(sDetailsFileName, MFX_MAX_PATH_LENGTH + 1, MFX_MAX_PATH_LENGTH + 1,
-                              perf_log_path_fmt, perfFilePath.c_str(), pid, it.first);
+        record.value = id;
+        ring->Push(record);
+    }
 
-        if (access(perfFilePath.c_str(), 0) == -1)
+    if (ring->NeedsDrain())
+    {
+        drainCond.notify_one();
+    }
+}
+
+void PerfUtility::drainThread()
+{
+    std::unique_lock<std::mutex> lock(drainGuard);
+    while (!stopDrain)
+    {
+        drainCond.wait_for(lock, std::chrono::milliseconds(PERF_DRAIN_PERIOD_MS));
+        if (stopDrain)
+        {
+            break;
+        }
+
+        lock.unlock();
+        try
+        {
+            savePerfData();
+        }
+        catch (...)
         {
-            int folder_exist_status = mkdir(perfFilePath.c_str(), S_IRWXU);
-            if (folder_exist_status == -1)
-            {
-                return;
-            }
+
         }
-        pTimeStampFile.open(sDetailsFileName, std::ios::app);
-        if (pTimeStampFile.good() == false)
+        lock.lock();
+    }
+}
+
+bool PerfUtility::openFile()
+{
+    if (perfFile.is_open())
+    {
+        return true;
+    }
+
+    if (fileFailed)
+    {
+        return false;
+    }
+
+    fileFailed = true;
+
+    if (access(perfFilePath.c_str(), 0) == -1)
+    {
+        int folder_exist_status = mkdir(perfFilePath.c_str(), S_IRWXU);
+        if (folder_exist_status == -1)
         {
-            pTimeStampFile.close();
-            return;
+            return false;
         }
-        pTimeStampFile << it.second;
-        pTimeStampFile.close();
-        pTimeStampFile.clear();
     }
+
+    char sFileName[MFX_MAX_PERF_FILENAME_LEN + 1] = { '\0' };
+    MFX_SecureStringPrint(sFileName, MFX_MAX_PATH_LENGTH + 1, MFX_MAX_PATH_LENGTH + 1,
+                          "%s/perf_pid%d.bin", perfFilePath.c_str(), getPid());
+
+    perfFile.open(sFileName, std::ios::binary | std::ios::trunc);
+    if (perfFile.good() == false)
+    {
+        perfFile.close();
+        return false;
+    }
+
+    PerfFileHeader header = {};
+    header.magic   = MFX_PERF_FILE_MAGIC;
+    header.version = MFX_PERF_FILE_VERSION;
+    header.pid     = getPid();
+    perfFile.write(reinterpret_cast<const char*>(&header), sizeof(header));
+
+    // first clock sample is taken at start, so short runs still have two points for the converter
+    writeChunk(PERF_CHUNK_CLOCK, &startClock, sizeof(startClock));
+
+    fileFailed = false;
+    return true;
 }
 
-void PerfUtility::timeStampTick(const std::string &tag, const std::string &level, const std::string &flag, const std::vector<uint32_t>& taskIds)
+void PerfUtility::writeChunk(PerfChunkType type, const void* data, uint32_t size, const void* data2, uint32_t size2)
 {
-    Tick newTick;
-    newTick.tag = tag;
-    int64_t _freq = 0;
-    QueryPerformanceFrequency(_freq);
-    newTick.freq = _freq / 1000;     // ms
-    QueryPerformanceCounter(newTick.timestamp);
-    newTick.functionType = flag;
-    newTick.level = level;
-    printPerfTimeStamp(&newTick, taskIds);
+    PerfChunkHeader header = {};
+    header.type = type;
+    header.size = size + size2;
+    perfFile.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    perfFile.write(reinterpret_cast<const char*>(data), size);
+    if (size2)
+    {
+        perfFile.write(reinterpret_cast<const char*>(data2), size2);
+    }
 }
 
-void PerfUtility::printPerfTimeStamp(Tick *newTick, const std::vector<uint32_t>& taskIds)
+uint64_t PerfUtility::getClockNs()
 {
-    int32_t current_tid = getTid();
+    struct timespec t;
+    clock_gettime(CLOCK_MONOTONIC, &t);
+    return 1000000000ULL * t.tv_sec + t.tv_nsec;
+}
 
-    std::map<int32_t, std::string>::iterator it;
+void PerfUtility::writeClock()
+{
+    PerfClockChunk clock = {};
+    clock.tick = getTick();
+    clock.ns   = getClockNs();
+    writeChunk(PERF_CHUNK_CLOCK, &clock, sizeof(clock));
+}
 
-    it = log_buffer.find(current_tid);
-    if (it == log_buffer.end()) 
+// Called from drain thread and on destruction, moves records from all rings to the file
+void PerfUtility::savePerfData()
+{
+    std::lock_guard<std::mutex> lock(perfMutex);
+
+    std::vector<std::shared_ptr<PerfRing>> snapshot;
+    {
+        std::lock_guard<std::mutex> ringLock(ringGuard);
+        snapshot = rings;
+    }
+
+    // positions are taken before tags are written, so every record read below has its tag in file
+    std::vector<uint32_t> heads(snapshot.size());
+    bool bHasData = false;
+    for (size_t i = 0; i < snapshot.size(); ++i)
     {
-        std::lock_guard<std::mutex> lock(perfMutex);
-        log_buffer[current_tid] = {};
-        it = log_buffer.find(current_tid);
+        heads[i] = snapshot[i]->head.load(std::memory_order_acquire);
+        bHasData |= heads[i] != snapshot[i]->tail.load(std::memory_order_relaxed);
     }
 
-    if (newTick->level == PERF_LEVEL_DDI || newTick->level == PERF_LEVEL_HW)
+    if (!bHasData || !openFile())
     {
-        it->second.append("    ");
+        return;
     }
-    else if(newTick->level == PERF_LEVEL_ROUTINE)
+
+    writeClock();
+
     {
-        it->second.append("  ");
+        std::lock_guard<std::mutex> tagLock(tagGuard);
+        for (; tagsWritten < tags.size(); ++tagsWritten)
+        {
+            uint32_t id = (uint32_t)tagsWritten;
+            writeChunk(PERF_CHUNK_TAG, &id, sizeof(id), tags[tagsWritten].data(), (uint32_t)tags[tagsWritten].size());
+        }
     }
-    else if (newTick->level == PERF_LEVEL_INTERNAL)
+
+    for (size_t i = 0; i < snapshot.size(); ++i)
     {
-        log_buffer[current_tid].append("   ");
+        PerfRing& ring = *snapshot[i];
+        uint32_t tail = ring.tail.load(std::memory_order_relaxed);
+
+        drainBuffer.clear();
+        for (; tail != heads[i]; ++tail)
+        {
+            drainBuffer.push_back(ring.records[tail % PerfRing::CAPACITY]);
+        }
+        ring.tail.store(tail, std::memory_order_release);
+        ring.wakeRequested.store(false, std::memory_order_relaxed);
+
+        if (!drainBuffer.empty())
+        {
+            writeChunk(PERF_CHUNK_RECORDS, &ring.tid, sizeof(ring.tid),
+                       drainBuffer.data(), (uint32_t)(drainBuffer.size() * sizeof(PerfRecord)));
+        }
+
+        uint32_t dropped = ring.dropped.exchange(0, std::memory_order_relaxed);
+        if (dropped)
+        {
+            uint32_t payload[2] = { ring.tid, dropped };
+            writeChunk(PERF_CHUNK_DROPPED, payload, sizeof(payload));
+        }
     }
-    
-    it->second.append(newTick->tag);
-    it->second.append(newTick->functionType);
-    it->second.append("\tTimeStamp: ");
-    it->second.append(std::to_string(newTick->timestamp));
-    it->second.append("\tFreq: ");
-    it->second.append(std::to_string(newTick->freq));
-    if (!taskIds.empty())
+
+    perfFile.flush();
+
+    // rings of finished threads are released once they are empty
+    std::lock_guard<std::mutex> ringLock(ringGuard);
+    for (auto it = rings.begin(); it != rings.end();)
     {
-        it->second.append("\tAsync Task ID: ");
-        for (auto id : taskIds)
+        if ((*it)->retired.load(std::memory_order_acquire) &&
+            (*it)->head.load(std::memory_order_acquire) == (*it)->tail.load(std::memory_order_relaxed))
+        {
+            it = rings.erase(it);
+        }
+        else
         {
-            it->second.append(std::to_string(id));
+            ++it;
         }
     }
-    it->second.append("\n");
-}
\ No newline at end of file
+}
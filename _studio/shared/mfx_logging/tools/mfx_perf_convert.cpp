@@ -0,0 +1,347 @@
+// Copyright (c) 2025 Intel Corporation
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+// Converts binary VPL PERF LOG file (perf_pid<pid>.bin) to
+//  - text logs in the format of former perf_details_pid<pid>_tid<tid>.txt files
+//  - Chrome trace JSON (chrome://tracing, Perfetto)
+
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <string>
+#include <vector>
+
+#include "mfx_utils_perf.h"
+
+namespace
+{
+    struct ThreadRecords
+    {
+        std::vector<PerfRecord> records;
+        uint64_t                dropped = 0;
+    };
+
+    struct PerfLog
+    {
+        uint32_t                          pid = 0;
+        std::vector<PerfClockChunk>       clocks;
+        std::map<uint32_t, std::string>   tags;
+        std::map<uint32_t, ThreadRecords> threads;
+    };
+
+    const char* LevelName(uint8_t level)
+    {
+        switch (level)
+        {
+        case PERF_LEVEL_ID_API:      return "API";
+        case PERF_LEVEL_ID_DDI:      return "DDI";
+        case PERF_LEVEL_ID_HW:       return "HW";
+        case PERF_LEVEL_ID_ROUTINE:  return "Routine";
+        case PERF_LEVEL_ID_INTERNAL: return "INTERNAL";
+        default:                     return "Unknown";
+        }
+    }
+
+    const char* LevelIndent(uint8_t level)
+    {
+        switch (level)
+        {
+        case PERF_LEVEL_ID_DDI:
+        case PERF_LEVEL_ID_HW:       return "    ";
+        case PERF_LEVEL_ID_ROUTINE:  return "  ";
+        case PERF_LEVEL_ID_INTERNAL: return "   ";
+        default:                     return "";
+        }
+    }
+
+    bool Load(const char* fileName, PerfLog& log)
+    {
+        std::ifstream file(fileName, std::ios::binary);
+        if (!file.good())
+        {
+            std::cerr << "can't open " << fileName << std::endl;
+            return false;
+        }
+
+        PerfFileHeader header = {};
+        file.read(reinterpret_cast<char*>(&header), sizeof(header));
+        if (!file || header.magic != MFX_PERF_FILE_MAGIC || header.version != MFX_PERF_FILE_VERSION)
+        {
+            std::cerr << fileName << " is not a perf log" << std::endl;
+            return false;
+        }
+        log.pid = header.pid;
+
+        std::vector<char> payload;
+        PerfChunkHeader chunk = {};
+        while (file.read(reinterpret_cast<char*>(&chunk), sizeof(chunk)))
+        {
+            payload.resize(chunk.size);
+            if (!file.read(payload.data(), chunk.size))
+            {
+                // file of killed process may end with incomplete chunk
+                std::cerr << "truncated chunk at the end of file is skipped" << std::endl;
+                break;
+            }
+
+            uint32_t id = 0;
+            switch (chunk.type)
+            {
+            case PERF_CHUNK_CLOCK:
+                if (chunk.size == sizeof(PerfClockChunk))
+                {
+                    PerfClockChunk clock = {};
+                    std::memcpy(&clock, payload.data(), sizeof(clock));
+                    log.clocks.push_back(clock);
+                }
+                break;
+            case PERF_CHUNK_TAG:
+                if (chunk.size >= sizeof(id))
+                {
+                    std::memcpy(&id, payload.data(), sizeof(id));
+                    log.tags[id].assign(payload.data() + sizeof(id), chunk.size - sizeof(id));
+                }
+                break;
+            case PERF_CHUNK_RECORDS:
+                if (chunk.size >= sizeof(id))
+                {
+                    std::memcpy(&id, payload.data(), sizeof(id));
+                    auto& records = log.threads[id].records;
+                    size_t count = (chunk.size - sizeof(id)) / sizeof(PerfRecord);
+                    size_t offset = records.size();
+                    records.resize(offset + count);
+                    std::memcpy(records.data() + offset, payload.data() + sizeof(id), count * sizeof(PerfRecord));
+                }
+                break;
+            case PERF_CHUNK_DROPPED:
+                if (chunk.size == 2 * sizeof(uint32_t))
+                {
+                    uint32_t dropped = 0;
+                    std::memcpy(&id, payload.data(), sizeof(id));
+                    std::memcpy(&dropped, payload.data() + sizeof(id), sizeof(dropped));
+                    log.threads[id].dropped += dropped;
+                }
+                break;
+            default:
+                // unknown chunks are skipped, so newer writers stay readable
+                break;
+            }
+        }
+
+        return true;
+    }
+
+    // Maps ticks to CLOCK_MONOTONIC ns using first and last clock samples
+    class TickConverter
+    {
+    public:
+        explicit TickConverter(std::vector<PerfClockChunk> const& clocks)
+        {
+            if (clocks.empty())
+                return;
+
+            m_base = clocks.front();
+            PerfClockChunk const& last = clocks.back();
+            if (last.tick > m_base.tick && last.ns > m_base.ns)
+                m_nsPerTick = double(last.ns - m_base.ns) / double(last.tick - m_base.tick);
+        }
+
+        uint64_t ToNs(uint64_t tick) const
+        {
+            double const delta = (double(tick) - double(m_base.tick)) * m_nsPerTick;
+            return uint64_t(int64_t(m_base.ns) + int64_t(delta));
+        }
+
+    private:
+        PerfClockChunk m_base = {};
+        double         m_nsPerTick = 1.0;
+    };
+
+    std::string TagName(PerfLog const& log, uint32_t id)
+    {
+        auto it = log.tags.find(id);
+        return it != log.tags.end() ? it->second : "tag" + std::to_string(id);
+    }
+
+    std::string JsonEscape(std::string const& str)
+    {
+        std::string out;
+        for (char c : str)
+        {
+            if (c == '"' || c == '\\')
+            {
+                out += '\\';
+                out += c;
+            }
+            else if ((unsigned char)c < 0x20)
+            {
+                char buf[8];
+                std::snprintf(buf, sizeof(buf), "\\u%04x", c);
+                out += buf;
+            }
+            else
+                out += c;
+        }
+        return out;
+    }
+
+    // Same lines as PerfUtility produced before binary records: TimeStamp is in ns, Freq is ticks per ms
+    bool WriteText(PerfLog const& log, std::string const& dir)
+    {
+        TickConverter converter(log.clocks);
+
+        for (auto const& thread : log.threads)
+        {
+            std::string const fileName = dir + "/perf_details_pid" + std::to_string(log.pid) +
+                "_tid" + std::to_string(thread.first) + ".txt";
+            std::ofstream out(fileName, std::ios::app);
+            if (!out.good())
+            {
+                std::cerr << "can't create " << fileName << std::endl;
+                return false;
+            }
+
+            auto const& records = thread.second.records;
+            for (size_t i = 0; i < records.size(); ++i)
+            {
+                PerfRecord const& record = records[i];
+                if (record.type == PERF_RECORD_TASK_ID)
+                    continue;
+
+                out << LevelIndent(record.level) << TagName(log, record.value)
+                    << (record.type == PERF_RECORD_ENTER ? ": ENTER" : ": EXIT")
+                    << "\tTimeStamp: " << converter.ToNs(record.tick)
+                    << "\tFreq: " << 1000000;
+
+                if (i + 1 < records.size() && records[i + 1].type == PERF_RECORD_TASK_ID)
+                {
+                    out << "\tAsync Task ID: ";
+                    for (; i + 1 < records.size() && records[i + 1].type == PERF_RECORD_TASK_ID; ++i)
+                        out << records[i + 1].value;
+                }
+                out << "\n";
+            }
+
+            if (thread.second.dropped)
+                out << "Dropped records: " << thread.second.dropped << "\n";
+        }
+
+        return true;
+    }
+
+    bool WriteJson(PerfLog const& log, std::string const& fileName)
+    {
+        std::ofstream out(fileName);
+        if (!out.good())
+        {
+            std::cerr << "can't create " << fileName << std::endl;
+            return false;
+        }
+
+        TickConverter converter(log.clocks);
+        uint64_t const origin = log.clocks.empty() ? 0 : log.clocks.front().ns;
+
+        out << "{\"traceEvents\":[\n";
+        bool bFirst = true;
+        for (auto const& thread : log.threads)
+        {
+            auto const& records = thread.second.records;
+            for (size_t i = 0; i < records.size(); ++i)
+            {
+                PerfRecord const& record = records[i];
+                if (record.type == PERF_RECORD_TASK_ID)
+                    continue;
+
+                double const ts = (double(converter.ToNs(record.tick)) - double(origin)) / 1000.;
+
+                out << (bFirst ? "" : ",\n");
+                bFirst = false;
+
+                char tsText[32];
+                std::snprintf(tsText, sizeof(tsText), "%.3f", ts);
+                out << "{\"name\":\"" << JsonEscape(TagName(log, record.value)) << "\""
+                    << ",\"cat\":\"" << LevelName(record.level) << "\""
+                    << ",\"ph\":\"" << (record.type == PERF_RECORD_ENTER ? "B" : "E") << "\""
+                    << ",\"ts\":" << tsText
+                    << ",\"pid\":" << log.pid
+                    << ",\"tid\":" << thread.first;
+
+                if (i + 1 < records.size() && records[i + 1].type == PERF_RECORD_TASK_ID)
+                {
+                    out << ",\"args\":{\"task_ids\":[";
+                    for (bool bFirstId = true; i + 1 < records.size() && records[i + 1].type == PERF_RECORD_TASK_ID; ++i, bFirstId = false)
+                        out << (bFirstId ? "" : ",") << records[i + 1].value;
+                    out << "]}";
+                }
+                out << "}";
+            }
+        }
+        out << "\n]}\n";
+
+        return out.good();
+    }
+
+    void PrintUsage(const char* app)
+    {
+        std::cout << "Usage: " << app << " <perf_pid*.bin> [-text <output dir>] [-json <output file>]" << std::endl
+                  << "  -text  write perf_details_pid*_tid*.txt files (default: current dir)" << std::endl
+                  << "  -json  write Chrome trace events" << std::endl;
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    if (argc < 2)
+    {
+        PrintUsage(argv[0]);
+        return 1;
+    }
+
+    std::string textDir, jsonFile;
+    for (int i = 2; i < argc; ++i)
+    {
+        if (!std::strcmp(argv[i], "-text") && i + 1 < argc)
+            textDir = argv[++i];
+        else if (!std::strcmp(argv[i], "-json") && i + 1 < argc)
+            jsonFile = argv[++i];
+        else
+        {
+            PrintUsage(argv[0]);
+            return 1;
+        }
+    }
+
+    if (textDir.empty() && jsonFile.empty())
+        textDir = ".";
+
+    PerfLog log;
+    if (!Load(argv[1], log))
+        return 1;
+
+    if (!textDir.empty() && !WriteText(log, textDir))
+        return 1;
+
+    if (!jsonFile.empty() && !WriteJson(log, jsonFile))
+        return 1;
+
+    return 0;
+}
@@ -22,44 +22,65 @@
 
 #define FAFT_COPY_CPU_DISP_INIT_C(func)           (func ## _C)
 #define FAFT_COPY_CPU_DISP_INIT_SSE4(func)        (func ## _SSE4)
+#define FAFT_COPY_CPU_DISP_INIT_AVX2(func)        (func ## _AVX2)
+#define FAFT_COPY_CPU_DISP_INIT_AVX512(func)      (func ## _AVX512)
 #define FAFT_COPY_CPU_DISP_INIT_SSE4_C(func)      (m_SSE4_available ? FAFT_COPY_CPU_DISP_INIT_SSE4(func) : FAFT_COPY_CPU_DISP_INIT_C(func))
+#define FAFT_COPY_CPU_DISP_INIT(func)             (m_AVX512_available ? FAFT_COPY_CPU_DISP_INIT_AVX512(func) : \
+                                                   m_AVX2_available   ? FAFT_COPY_CPU_DISP_INIT_AVX2(func)   : \
+                                                   FAFT_COPY_CPU_DISP_INIT_SSE4_C(func))
 
 mfxI32 CpuFeature_SSE41() {
     return((__builtin_cpu_supports("sse4.1")));
 }
 
+mfxI32 CpuFeature_AVX2() {
+    return((__builtin_cpu_supports("avx2")));
+}
+
+mfxI32 CpuFeature_AVX512() {
+    return((__builtin_cpu_supports("avx512f") && __builtin_cpu_supports("avx512bw")));
+}
+
 void copyVideoToSys(const mfxU8* src, mfxU8* dst, int width)
 {
-    static const int m_SSE4_available = CpuFeature_SSE41();
+    static const int m_SSE4_available   = CpuFeature_SSE41();
+    static const int m_AVX2_available   = CpuFeature_AVX2();
+    static const int m_AVX512_available = CpuFeature_AVX512();
 
-    static const t_copyVideoToSys copyVideoToSys_impl = FAFT_COPY_CPU_DISP_INIT_SSE4_C(copyVideoToSys);
+    static const t_copyVideoToSys copyVideoToSys_impl = FAFT_COPY_CPU_DISP_INIT(copyVideoToSys);
 
     copyVideoToSys_impl(src, dst, width);
 }
 
 void copyVideoToSysShift(const mfxU16* src, mfxU16* dst, int width, int shift)
 {
-    static const int m_SSE4_available = CpuFeature_SSE41();
+    static const int m_SSE4_available   = CpuFeature_SSE41();
+    static const int m_AVX2_available   = CpuFeature_AVX2();
+    static const int m_AVX512_available = CpuFeature_AVX512();
 
-    static const t_copyVideoToSysShift copyVideoToSysShift_impl = FAFT_COPY_CPU_DISP_INIT_SSE4_C(copyVideoToSysShift);
+    static const t_copyVideoToSysShift copyVideoToSysShift_impl = FAFT_COPY_CPU_DISP_INIT(copyVideoToSysShift);
 
     copyVideoToSysShift_impl(src, dst, width, shift);
 }
 
 void copySysToVideoShift(const mfxU16* src, mfxU16* dst, int width, int shift)
 {
-    static const int m_SSE4_available = CpuFeature_SSE41();
+    static const int m_SSE4_available   = CpuFeature_SSE41();
+    static const int m_AVX2_available   = CpuFeature_AVX2();
+    static const int m_AVX512_available = CpuFeature_AVX512();
 
-    static const t_copySysToVideoShift copySysToVideoShift_impl = FAFT_COPY_CPU_DISP_INIT_SSE4_C(copySysToVideoShift);
+    static const t_copySysToVideoShift copySysToVideoShift_impl = FAFT_COPY_CPU_DISP_INIT(copySysToVideoShift);
 
     copySysToVideoShift_impl(src, dst, width, shift);
 }
 
 void copySysVariantToVideo(const mfxU8* src, int loffset, mfxU16* dst, int width)
 {
-    static const int m_SSE4_available = CpuFeature_SSE41();
+    static const int m_SSE4_available   = CpuFeature_SSE41();
+    static const int m_AVX2_available   = CpuFeature_AVX2();
+    static const int m_AVX512_available = CpuFeature_AVX512();
 
-    static const t_copySysVariantToVideo copySysVariantToVideo_impl = FAFT_COPY_CPU_DISP_INIT_SSE4_C(copySysVariantToVideo);
+    static const t_copySysVariantToVideo copySysVariantToVideo_impl = FAFT_COPY_CPU_DISP_INIT(copySysVariantToVideo);
 
     copySysVariantToVideo_impl(src, loffset, dst, width);
 }
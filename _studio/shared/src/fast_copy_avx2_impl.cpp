@@ -0,0 +1,227 @@
+// Copyright (c) 2025 Intel Corporation
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "fast_copy_avx2_impl.h"
+#include "mfx_config.h"
+
+#if defined(MFX_AVX2)
+
+#include <immintrin.h>
+
+// Video memory is read with non-temporal stream loads and written with non-temporal
+// stores, system memory side goes through the cache as it is consumed right after the copy.
+
+void copyVideoToSys_AVX2(const mfxU8* src, mfxU8* dst, int width)
+{
+    static const int item_size = 4 * sizeof(__m256i);
+
+    int align32 = std::min(width, int((0x20 - (reinterpret_cast<size_t>(src) & 0x1f)) & 0x1f));
+    for (int i = 0; i < align32; i++)
+        *dst++ = *src++;
+
+    int w = width - align32;
+    int width4 = w & (-item_size);
+
+    __m256i * src_reg = (__m256i *)src;
+    __m256i * dst_reg = (__m256i *)dst;
+
+    for (int i = 0; i < width4; i += item_size)
+    {
+        __m256i ymm0 = _mm256_stream_load_si256(src_reg);
+        __m256i ymm1 = _mm256_stream_load_si256(src_reg + 1);
+        __m256i ymm2 = _mm256_stream_load_si256(src_reg + 2);
+        __m256i ymm3 = _mm256_stream_load_si256(src_reg + 3);
+        _mm256_storeu_si256(dst_reg, ymm0);
+        _mm256_storeu_si256(dst_reg + 1, ymm1);
+        _mm256_storeu_si256(dst_reg + 2, ymm2);
+        _mm256_storeu_si256(dst_reg + 3, ymm3);
+
+        src_reg += 4;
+        dst_reg += 4;
+    }
+
+    int tail_data_sz = w - width4;
+    for (; tail_data_sz >= (int)sizeof(__m256i); tail_data_sz -= sizeof(__m256i))
+    {
+        _mm256_storeu_si256(dst_reg, _mm256_stream_load_si256(src_reg));
+        src_reg += 1;
+        dst_reg += 1;
+    }
+
+    src = (const mfxU8 *)src_reg;
+    dst = (mfxU8 *)dst_reg;
+
+    for (; tail_data_sz > 0; tail_data_sz--)
+        *dst++ = *src++;
+}
+
+void copyVideoToSysShift_AVX2(const mfxU16* src, mfxU16* dst, int width, int shift)
+{
+    static const int item_size = 4 * sizeof(__m256i) / sizeof(mfxU16);
+    static const int reg_size  = sizeof(__m256i) / sizeof(mfxU16);
+
+    // stream loads need aligned source, odd addresses are never aligned
+    int align32 = (reinterpret_cast<size_t>(src) & 1) ? width :
+        std::min(width, int(((0x20 - (reinterpret_cast<size_t>(src) & 0x1f)) & 0x1f) / sizeof(mfxU16)));
+    for (int i = 0; i < align32; i++)
+        *dst++ = (*src++) >> shift;
+
+    int w = width - align32;
+    int width4 = w & (-item_size);
+
+    __m256i * src_reg = (__m256i *)src;
+    __m256i * dst_reg = (__m256i *)dst;
+    __m128i   count   = _mm_cvtsi32_si128(shift);
+
+    for (int i = 0; i < width4; i += item_size)
+    {
+        __m256i ymm0 = _mm256_stream_load_si256(src_reg);
+        __m256i ymm1 = _mm256_stream_load_si256(src_reg + 1);
+        __m256i ymm2 = _mm256_stream_load_si256(src_reg + 2);
+        __m256i ymm3 = _mm256_stream_load_si256(src_reg + 3);
+        _mm256_storeu_si256(dst_reg, _mm256_srl_epi16(ymm0, count));
+        _mm256_storeu_si256(dst_reg + 1, _mm256_srl_epi16(ymm1, count));
+        _mm256_storeu_si256(dst_reg + 2, _mm256_srl_epi16(ymm2, count));
+        _mm256_storeu_si256(dst_reg + 3, _mm256_srl_epi16(ymm3, count));
+
+        src_reg += 4;
+        dst_reg += 4;
+    }
+
+    int tail_data_sz = w - width4;
+    for (; tail_data_sz >= reg_size; tail_data_sz -= reg_size)
+    {
+        _mm256_storeu_si256(dst_reg, _mm256_srl_epi16(_mm256_stream_load_si256(src_reg), count));
+        src_reg += 1;
+        dst_reg += 1;
+    }
+
+    src = (const mfxU16 *)src_reg;
+    dst = (mfxU16 *)dst_reg;
+
+    for (; tail_data_sz > 0; tail_data_sz--)
+        *dst++ = (*src++) >> shift;
+}
+
+void copySysToVideoShift_AVX2(const mfxU16* src, mfxU16* dst, int width, int shift)
+{
+    static const int item_size = 4 * sizeof(__m256i) / sizeof(mfxU16);
+    static const int reg_size  = sizeof(__m256i) / sizeof(mfxU16);
+
+    // non-temporal stores need aligned destination, odd addresses are never aligned
+    int align32 = (reinterpret_cast<size_t>(dst) & 1) ? width :
+        std::min(width, int(((0x20 - (reinterpret_cast<size_t>(dst) & 0x1f)) & 0x1f) / sizeof(mfxU16)));
+    for (int i = 0; i < align32; i++)
+        *dst++ = (*src++) << shift;
+
+    int w = width - align32;
+    int width4 = w & (-item_size);
+
+    const __m256i * src_reg = (const __m256i *)src;
+    __m256i *       dst_reg = (__m256i *)dst;
+    __m128i         count   = _mm_cvtsi32_si128(shift);
+
+    for (int i = 0; i < width4; i += item_size)
+    {
+        __m256i ymm0 = _mm256_loadu_si256(src_reg);
+        __m256i ymm1 = _mm256_loadu_si256(src_reg + 1);
+        __m256i ymm2 = _mm256_loadu_si256(src_reg + 2);
+        __m256i ymm3 = _mm256_loadu_si256(src_reg + 3);
+        _mm256_stream_si256(dst_reg, _mm256_sll_epi16(ymm0, count));
+        _mm256_stream_si256(dst_reg + 1, _mm256_sll_epi16(ymm1, count));
+        _mm256_stream_si256(dst_reg + 2, _mm256_sll_epi16(ymm2, count));
+        _mm256_stream_si256(dst_reg + 3, _mm256_sll_epi16(ymm3, count));
+
+        src_reg += 4;
+        dst_reg += 4;
+    }
+
+    int tail_data_sz = w - width4;
+    for (; tail_data_sz >= reg_size; tail_data_sz -= reg_size)
+    {
+        _mm256_stream_si256(dst_reg, _mm256_sll_epi16(_mm256_loadu_si256(src_reg), count));
+        src_reg += 1;
+        dst_reg += 1;
+    }
+
+    src = (const mfxU16 *)src_reg;
+    dst = (mfxU16 *)dst_reg;
+
+    for (; tail_data_sz > 0; tail_data_sz--)
+        *dst++ = (*src++) << shift;
+
+    // make non-temporal stores visible before the copy is reported as done
+    _mm_sfence();
+}
+
+void copySysVariantToVideo_AVX2(const mfxU8* src, int loffset, mfxU16* dst, int width)
+{
+    static const int item_size = 2 * sizeof(__m256i) / sizeof(mfxU16);
+    static const int reg_size  = sizeof(__m256i) / sizeof(mfxU16);
+
+    const mfxU8 *src2 = src + loffset;
+
+    int align32 = (reinterpret_cast<size_t>(dst) & 1) ? width :
+        std::min(width, int(((0x20 - (reinterpret_cast<size_t>(dst) & 0x1f)) & 0x1f) / sizeof(mfxU16)));
+    for (int i = 0; i < align32; i++)
+        *dst++ = ((mfxU16)(*src++) << 8) + ((mfxU16)(*src2++) << 6);
+
+    int w = width - align32;
+    int width2 = w & (-item_size);
+
+    __m256i *dst_reg = (__m256i *)dst;
+
+    for (int i = 0; i < width2; i += item_size)
+    {
+        __m256i ymm0 = _mm256_cvtepu8_epi16(_mm_loadu_si128((const __m128i *)&src[0]));
+        __m256i ymm1 = _mm256_cvtepu8_epi16(_mm_loadu_si128((const __m128i *)&src[16]));
+        __m256i ymm2 = _mm256_cvtepu8_epi16(_mm_loadu_si128((const __m128i *)&src2[0]));
+        __m256i ymm3 = _mm256_cvtepu8_epi16(_mm_loadu_si128((const __m128i *)&src2[16]));
+
+        ymm0 = _mm256_add_epi16(_mm256_slli_epi16(ymm0, 8), _mm256_slli_epi16(ymm2, 6));
+        ymm1 = _mm256_add_epi16(_mm256_slli_epi16(ymm1, 8), _mm256_slli_epi16(ymm3, 6));
+
+        _mm256_stream_si256(dst_reg, ymm0);
+        _mm256_stream_si256(dst_reg + 1, ymm1);
+
+        src += 32;
+        src2 += 32;
+        dst_reg += 2;
+    }
+
+    int tail_data_sz = w - width2;
+    for (; tail_data_sz >= reg_size; tail_data_sz -= reg_size)
+    {
+        __m256i ymm0 = _mm256_cvtepu8_epi16(_mm_loadu_si128((const __m128i *)&src[0]));
+        __m256i ymm1 = _mm256_cvtepu8_epi16(_mm_loadu_si128((const __m128i *)&src2[0]));
+        _mm256_stream_si256(dst_reg, _mm256_add_epi16(_mm256_slli_epi16(ymm0, 8), _mm256_slli_epi16(ymm1, 6)));
+        src += 16;
+        src2 += 16;
+        dst_reg += 1;
+    }
+
+    dst = (mfxU16 *)dst_reg;
+
+    for (; tail_data_sz > 0; tail_data_sz--)
+        *dst++ = ((mfxU16)(*src++) << 8) + ((mfxU16)(*src2++) << 6);
+
+    _mm_sfence();
+}
+#endif // MFX_AVX2
@@ -0,0 +1,226 @@
+// Copyright (c) 2025 Intel Corporation
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "fast_copy_avx512_impl.h"
+#include "mfx_config.h"
+
+#if defined(MFX_AVX512)
+
+#include <immintrin.h>
+
+// Same access pattern as the AVX2 variant, AVX512BW is required for 16-bit shifts.
+
+void copyVideoToSys_AVX512(const mfxU8* src, mfxU8* dst, int width)
+{
+    static const int item_size = 4 * sizeof(__m512i);
+
+    int align64 = std::min(width, int((0x40 - (reinterpret_cast<size_t>(src) & 0x3f)) & 0x3f));
+    for (int i = 0; i < align64; i++)
+        *dst++ = *src++;
+
+    int w = width - align64;
+    int width4 = w & (-item_size);
+
+    __m512i * src_reg = (__m512i *)src;
+    __m512i * dst_reg = (__m512i *)dst;
+
+    for (int i = 0; i < width4; i += item_size)
+    {
+        __m512i zmm0 = _mm512_stream_load_si512(src_reg);
+        __m512i zmm1 = _mm512_stream_load_si512(src_reg + 1);
+        __m512i zmm2 = _mm512_stream_load_si512(src_reg + 2);
+        __m512i zmm3 = _mm512_stream_load_si512(src_reg + 3);
+        _mm512_storeu_si512(dst_reg, zmm0);
+        _mm512_storeu_si512(dst_reg + 1, zmm1);
+        _mm512_storeu_si512(dst_reg + 2, zmm2);
+        _mm512_storeu_si512(dst_reg + 3, zmm3);
+
+        src_reg += 4;
+        dst_reg += 4;
+    }
+
+    int tail_data_sz = w - width4;
+    for (; tail_data_sz >= (int)sizeof(__m512i); tail_data_sz -= sizeof(__m512i))
+    {
+        _mm512_storeu_si512(dst_reg, _mm512_stream_load_si512(src_reg));
+        src_reg += 1;
+        dst_reg += 1;
+    }
+
+    src = (const mfxU8 *)src_reg;
+    dst = (mfxU8 *)dst_reg;
+
+    for (; tail_data_sz > 0; tail_data_sz--)
+        *dst++ = *src++;
+}
+
+void copyVideoToSysShift_AVX512(const mfxU16* src, mfxU16* dst, int width, int shift)
+{
+    static const int item_size = 4 * sizeof(__m512i) / sizeof(mfxU16);
+    static const int reg_size  = sizeof(__m512i) / sizeof(mfxU16);
+
+    // stream loads need aligned source, odd addresses are never aligned
+    int align64 = (reinterpret_cast<size_t>(src) & 1) ? width :
+        std::min(width, int(((0x40 - (reinterpret_cast<size_t>(src) & 0x3f)) & 0x3f) / sizeof(mfxU16)));
+    for (int i = 0; i < align64; i++)
+        *dst++ = (*src++) >> shift;
+
+    int w = width - align64;
+    int width4 = w & (-item_size);
+
+    __m512i * src_reg = (__m512i *)src;
+    __m512i * dst_reg = (__m512i *)dst;
+    __m128i   count   = _mm_cvtsi32_si128(shift);
+
+    for (int i = 0; i < width4; i += item_size)
+    {
+        __m512i zmm0 = _mm512_stream_load_si512(src_reg);
+        __m512i zmm1 = _mm512_stream_load_si512(src_reg + 1);
+        __m512i zmm2 = _mm512_stream_load_si512(src_reg + 2);
+        __m512i zmm3 = _mm512_stream_load_si512(src_reg + 3);
+        _mm512_storeu_si512(dst_reg, _mm512_srl_epi16(zmm0, count));
+        _mm512_storeu_si512(dst_reg + 1, _mm512_srl_epi16(zmm1, count));
+        _mm512_storeu_si512(dst_reg + 2, _mm512_srl_epi16(zmm2, count));
+        _mm512_storeu_si512(dst_reg + 3, _mm512_srl_epi16(zmm3, count));
+
+        src_reg += 4;
+        dst_reg += 4;
+    }
+
+    int tail_data_sz = w - width4;
+    for (; tail_data_sz >= reg_size; tail_data_sz -= reg_size)
+    {
+        _mm512_storeu_si512(dst_reg, _mm512_srl_epi16(_mm512_stream_load_si512(src_reg), count));
+        src_reg += 1;
+        dst_reg += 1;
+    }
+
+    src = (const mfxU16 *)src_reg;
+    dst = (mfxU16 *)dst_reg;
+
+    for (; tail_data_sz > 0; tail_data_sz--)
+        *dst++ = (*src++) >> shift;
+}
+
+void copySysToVideoShift_AVX512(const mfxU16* src, mfxU16* dst, int width, int shift)
+{
+    static const int item_size = 4 * sizeof(__m512i) / sizeof(mfxU16);
+    static const int reg_size  = sizeof(__m512i) / sizeof(mfxU16);
+
+    // non-temporal stores need aligned destination, odd addresses are never aligned
+    int align64 = (reinterpret_cast<size_t>(dst) & 1) ? width :
+        std::min(width, int(((0x40 - (reinterpret_cast<size_t>(dst) & 0x3f)) & 0x3f) / sizeof(mfxU16)));
+    for (int i = 0; i < align64; i++)
+        *dst++ = (*src++) << shift;
+
+    int w = width - align64;
+    int width4 = w & (-item_size);
+
+    const __m512i * src_reg = (const __m512i *)src;
+    __m512i *       dst_reg = (__m512i *)dst;
+    __m128i         count   = _mm_cvtsi32_si128(shift);
+
+    for (int i = 0; i < width4; i += item_size)
+    {
+        __m512i zmm0 = _mm512_loadu_si512(src_reg);
+        __m512i zmm1 = _mm512_loadu_si512(src_reg + 1);
+        __m512i zmm2 = _mm512_loadu_si512(src_reg + 2);
+        __m512i zmm3 = _mm512_loadu_si512(src_reg + 3);
+        _mm512_stream_si512(dst_reg, _mm512_sll_epi16(zmm0, count));
+        _mm512_stream_si512(dst_reg + 1, _mm512_sll_epi16(zmm1, count));
+        _mm512_stream_si512(dst_reg + 2, _mm512_sll_epi16(zmm2, count));
+        _mm512_stream_si512(dst_reg + 3, _mm512_sll_epi16(zmm3, count));
+
+        src_reg += 4;
+        dst_reg += 4;
+    }
+
+    int tail_data_sz = w - width4;
+    for (; tail_data_sz >= reg_size; tail_data_sz -= reg_size)
+    {
+        _mm512_stream_si512(dst_reg, _mm512_sll_epi16(_mm512_loadu_si512(src_reg), count));
+        src_reg += 1;
+        dst_reg += 1;
+    }
+
+    src = (const mfxU16 *)src_reg;
+    dst = (mfxU16 *)dst_reg;
+
+    for (; tail_data_sz > 0; tail_data_sz--)
+        *dst++ = (*src++) << shift;
+
+    // make non-temporal stores visible before the copy is reported as done
+    _mm_sfence();
+}
+
+void copySysVariantToVideo_AVX512(const mfxU8* src, int loffset, mfxU16* dst, int width)
+{
+    static const int item_size = 2 * sizeof(__m512i) / sizeof(mfxU16);
+    static const int reg_size  = sizeof(__m512i) / sizeof(mfxU16);
+
+    const mfxU8 *src2 = src + loffset;
+
+    int align64 = (reinterpret_cast<size_t>(dst) & 1) ? width :
+        std::min(width, int(((0x40 - (reinterpret_cast<size_t>(dst) & 0x3f)) & 0x3f) / sizeof(mfxU16)));
+    for (int i = 0; i < align64; i++)
+        *dst++ = ((mfxU16)(*src++) << 8) + ((mfxU16)(*src2++) << 6);
+
+    int w = width - align64;
+    int width2 = w & (-item_size);
+
+    __m512i *dst_reg = (__m512i *)dst;
+
+    for (int i = 0; i < width2; i += item_size)
+    {
+        __m512i zmm0 = _mm512_cvtepu8_epi16(_mm256_loadu_si256((const __m256i *)&src[0]));
+        __m512i zmm1 = _mm512_cvtepu8_epi16(_mm256_loadu_si256((const __m256i *)&src[32]));
+        __m512i zmm2 = _mm512_cvtepu8_epi16(_mm256_loadu_si256((const __m256i *)&src2[0]));
+        __m512i zmm3 = _mm512_cvtepu8_epi16(_mm256_loadu_si256((const __m256i *)&src2[32]));
+
+        zmm0 = _mm512_add_epi16(_mm512_slli_epi16(zmm0, 8), _mm512_slli_epi16(zmm2, 6));
+        zmm1 = _mm512_add_epi16(_mm512_slli_epi16(zmm1, 8), _mm512_slli_epi16(zmm3, 6));
+
+        _mm512_stream_si512(dst_reg, zmm0);
+        _mm512_stream_si512(dst_reg + 1, zmm1);
+
+        src += 64;
+        src2 += 64;
+        dst_reg += 2;
+    }
+
+    int tail_data_sz = w - width2;
+    for (; tail_data_sz >= reg_size; tail_data_sz -= reg_size)
+    {
+        __m512i zmm0 = _mm512_cvtepu8_epi16(_mm256_loadu_si256((const __m256i *)&src[0]));
+        __m512i zmm1 = _mm512_cvtepu8_epi16(_mm256_loadu_si256((const __m256i *)&src2[0]));
+        _mm512_stream_si512(dst_reg, _mm512_add_epi16(_mm512_slli_epi16(zmm0, 8), _mm512_slli_epi16(zmm1, 6)));
+        src += 32;
+        src2 += 32;
+        dst_reg += 1;
+    }
+
+    dst = (mfxU16 *)dst_reg;
+
+    for (; tail_data_sz > 0; tail_data_sz--)
+        *dst++ = ((mfxU16)(*src++) << 8) + ((mfxU16)(*src2++) << 6);
+
+    _mm_sfence();
+}
+#endif // MFX_AVX512
@@ -1,4 +1,4 @@
-// Copyright (c) 2009-2020 Intel Corporation
+// Copyright (c) 2009-2025 Intel Corporation
 //
 // Permission is hereby granted, free of charge, to any person obtaining a copy
 // of this software and associated documentation files (the "Software"), to deal
@@ -18,240 +18,404 @@
 // OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
 // SOFTWARE.
 
-#include "fast_copy.h"
-
-#include "umc_event.h"
+#include "fast_copy_multithreading.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cctype>
+#include <condition_variable>
+#include <deque>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <sstream>
+#include <string>
 #include <thread>
-#include "libmfx_allocator.h"
-
-struct FC_TASK
-{
-    // pointers to source and destination
-    Ipp8u *pS;
-    Ipp8u *pD;
-
-    // size of chunk to copy
-    Ipp32u chunkSize;
+#include <vector>
 
-    // pitches and frame size
-    IppiSize roi;
-    Ipp32u srcPitch, dstPitch;
-    int flag;
-
-    // event handles
-    UMC::Event EventStart;
-    UMC::Event EventEnd;
-};
+#include <sched.h>
 
-class FastCopyMultithreading : public FastCopy
+namespace
 {
-public:
-
-    // constructor
-    FastCopyMultithreading(void);
 
-    // destructor
-    virtual ~FastCopyMultithreading(void);
+// upper limit of helper threads per NUMA node, the calling thread always copies too
+constexpr mfxU32 FC_MAX_HELPERS_PER_NODE = 3;
+// one helper per this number of cpus in the node
+constexpr mfxU32 FC_CPUS_PER_HELPER      = 8;
+// stripes smaller than this are not worth a cross-thread hand-off
+constexpr mfxU32 FC_MIN_STRIPE_SIZE      = 128 * 1024;
+// used when L2 size can't be read from sysfs
+constexpr mfxU32 FC_DEFAULT_L2_SIZE      = 1024 * 1024;
 
-    // initialize available functionality
-    mfxStatus Initialize(void);
+struct FC_JOB
+{
+    mfxU8   *pS;
+    mfxU8   *pD;
+    mfxU32   srcPitch;
+    mfxU32   dstPitch;
+    IppiSize roi;
+    int      flag;
 
-    // release object
-    mfxStatus Release(void);
+    bool     shift;
+    mfxU8    lshift;
+    mfxU8    rshift;
 
-    // copy memory by streaming
-    mfxStatus Copy(mfxU8 *pDst, mfxU32 dstPitch, mfxU8 *pSrc, mfxU32 srcPitch, IppiSize roi, int flag);
+    mfxI32   rowsPerStripe;
+    mfxI32   numStripes;
 
-protected:
+    std::atomic<mfxI32> next{ 0 };
+    std::atomic<mfxI32> done{ 0 };
 
-   // synchronize threads
-    mfxStatus Synchronize(void);
+    void Run(mfxI32 stripe)
+    {
+        mfxI32 firstRow = stripe * rowsPerStripe;
+        IppiSize part   = { roi.width, std::min(rowsPerStripe, roi.height - firstRow) };
 
-    static mfxU32 __STDCALL CopyByThread(void *object);
-    static IppBool m_bCopyQuit;
+        mfxU8 *pSrc = pS + size_t(firstRow) * srcPitch;
+        mfxU8 *pDst = pD + size_t(firstRow) * dstPitch;
 
-    // handles
-    std::thread *m_pThreads;
-    Ipp32u m_numThreads;
+        if (shift)
+            FastCopy::CopyAndShift((mfxU16*)pDst, dstPitch, (mfxU16*)pSrc, srcPitch, part, lshift, rshift, flag);
+        else
+            FastCopy::Copy(pDst, dstPitch, pSrc, srcPitch, part, flag);
+    }
 
-    FC_TASK *m_tasks;
+    // claims and copies stripes until none left, returns when own share is done
+    void Drain()
+    {
+        for (mfxI32 stripe = next.fetch_add(1); stripe < numStripes; stripe = next.fetch_add(1))
+        {
+            Run(stripe);
+            done.fetch_add(1, std::memory_order_release);
+        }
+    }
 };
 
-IppBool FastCopyMultithreading::m_bCopyQuit = ippFalse;
-
-FastCopyMultithreading::FastCopyMultithreading(void)
+// parses sysfs cpu lists like "0-15,32-47"
+std::vector<mfxU32> ParseCpuList(const std::string& list)
 {
-    m_pThreads = NULL;
-    m_tasks = NULL;
+    std::vector<mfxU32> cpus;
+    std::stringstream ss(list);
+    std::string range;
 
-    m_numThreads = 0;
+    while (std::getline(ss, range, ','))
+    {
+        if (range.empty() || !isdigit((unsigned char)range[0]))
+            continue;
 
-} // FastCopy::FastCopy(void)
+        size_t dash  = range.find('-');
+        mfxU32 first = (mfxU32)std::stoul(range.substr(0, dash));
+        mfxU32 last  = (dash == std::string::npos) ? first : (mfxU32)std::stoul(range.substr(dash + 1));
 
-FastCopyMultithreading::~FastCopyMultithreading(void)
-{
-    Release();
+        for (mfxU32 cpu = first; cpu <= last; ++cpu)
+            cpus.push_back(cpu);
+    }
 
-} // FastCopy::~FastCopy(void)
+    return cpus;
+}
 
-mfxStatus FastCopyMultithreading::Initialize(void)
+// parses sysfs cache sizes like "2048K"
+mfxU32 ReadCacheSize(const char* path)
 {
-    mfxStatus sts = MFX_ERR_NONE;
-    mfxU32 i = 0;
+    std::ifstream file(path);
+    std::string   value;
+
+    if (!(file >> value) || value.empty() || !isdigit((unsigned char)value[0]))
+        return 0;
 
-    // release object before allocation
-    Release();
+    mfxU32 size = (mfxU32)std::stoul(value);
 
-    if (MFX_ERR_NONE == sts)
+    switch (value.back())
     {
-        // streaming is on
-        m_numThreads = 1;
+    case 'K': return size << 10;
+    case 'M': return size << 20;
+    default:  return size;
     }
-    if (MFX_ERR_NONE == sts)
+}
+
+class FastCopyNodePool
+{
+public:
+    FastCopyNodePool(const std::vector<mfxU32>& cpus)
+        : m_cpus(cpus)
     {
-        m_pThreads = new std::thread[m_numThreads];
-        m_tasks = new FC_TASK[m_numThreads];
+        mfxU32 numCpus    = m_cpus.empty() ? std::thread::hardware_concurrency() : mfxU32(m_cpus.size());
+        mfxU32 numHelpers = std::max<mfxU32>(1, numCpus / FC_CPUS_PER_HELPER);
+        numHelpers        = std::min(numHelpers, FC_MAX_HELPERS_PER_NODE);
 
-        if (!m_pThreads || !m_tasks) sts = MFX_ERR_MEMORY_ALLOC;
+        for (mfxU32 i = 0; i < numHelpers; ++i)
+        {
+            m_threads.emplace_back([this]() { CopyByThread(); });
+        }
     }
-    // initialize events
-    for (i = 0; (MFX_ERR_NONE == sts) && (i < m_numThreads - 1); i += 1)
+
+    ~FastCopyNodePool()
     {
-        if (UMC::UMC_OK != m_tasks[i].EventStart.Init(0, 0))
         {
-            sts = MFX_ERR_UNKNOWN;
+            std::lock_guard<std::mutex> guard(m_mutex);
+            m_bQuit = true;
         }
-        if (UMC::UMC_OK != m_tasks[i].EventEnd.Init(0, 0))
+        m_cv.notify_all();
+
+        for (auto& thread : m_threads)
         {
-            sts = MFX_ERR_UNKNOWN;
+            if (thread.joinable())
+                thread.join();
         }
     }
-    // run threads
-    for (i = 0; (MFX_ERR_NONE == sts) && (i < m_numThreads - 1); i += 1)
+
+    mfxU32 GetNumHelpers() const
     {
-        m_pThreads[i] = std::thread([this, i]() { CopyByThread((void *)(m_tasks + i)); });
+        return mfxU32(m_threads.size());
     }
 
-    return MFX_ERR_NONE;
-} // mfxStatus FastCopy::Initialize(void)
-
-mfxStatus FastCopyMultithreading::Release(void)
-{
-    m_bCopyQuit = ippTrue;
-
-    if ((m_numThreads > 1) && m_tasks && m_pThreads)
+    void Submit(FC_JOB& job)
     {
-        // set event
-        for (mfxU32 i = 0; i < m_numThreads - 1; i += 1)
         {
-            m_tasks[i].EventStart.Set();
-            if (m_pThreads[i].joinable())
-                m_pThreads[i].join();
+            std::lock_guard<std::mutex> guard(m_mutex);
+            m_jobs.push_back(&job);
         }
-    }
 
-    m_numThreads = 0;
+        for (mfxI32 i = 1; i < job.numStripes; ++i)
+            m_cv.notify_one();
+    }
 
-    if (m_pThreads)
+    // job must not be reachable by helpers after this call, stripes already claimed are still running
+    void Retire(FC_JOB& job)
     {
-        delete [] m_pThreads;
-        m_pThreads = NULL;
+        std::lock_guard<std::mutex> guard(m_mutex);
+
+        auto it = std::find(m_jobs.begin(), m_jobs.end(), &job);
+        if (it != m_jobs.end())
+            m_jobs.erase(it);
     }
 
-    if (m_tasks)
+protected:
+    void BindToNode()
     {
-        delete [] m_tasks;
-        m_tasks = NULL;
-    }
+        if (m_cpus.empty())
+            return;
 
-    m_bCopyQuit = ippFalse;
+        cpu_set_t mask;
+        CPU_ZERO(&mask);
 
-    return MFX_ERR_NONE;
+        for (mfxU32 cpu : m_cpus)
+        {
+            if (cpu < CPU_SETSIZE)
+                CPU_SET(cpu, &mask);
+        }
 
-} // mfxStatus FastCopy::Release(void)
+        if (CPU_COUNT(&mask))
+            sched_setaffinity(0, sizeof(mask), &mask);
+    }
 
-mfxStatus FastCopyMultithreading::Copy(mfxU8 *pDst, mfxU32 dstPitch, mfxU8 *pSrc, mfxU32 srcPitch, IppiSize roi, int flag)
-{
-    if (NULL == pDst || NULL == pSrc)
+    void CopyByThread()
     {
-        return MFX_ERR_NULL_PTR;
+        MFX_AUTO_LTRACE(MFX_TRACE_LEVEL_INTERNAL, "ThreadName=FastCopy");
+
+        BindToNode();
+
+        for (;;)
+        {
+            FC_JOB *job     = nullptr;
+            mfxI32  stripe  = 0;
+            bool    claimed = false;
+
+            {
+                std::unique_lock<std::mutex> lock(m_mutex);
+                m_cv.wait(lock, [this] { return m_bQuit || !m_jobs.empty(); });
+
+                if (m_bQuit)
+                    return;
+
+                // stripe is claimed under the lock, so the owner can't retire the job in between
+                job    = m_jobs.front();
+                stripe = job->next.fetch_add(1);
+
+                claimed = stripe < job->numStripes;
+
+                if (stripe + 1 >= job->numStripes)
+                    m_jobs.pop_front();
+            }
+
+            // job may be already gone if nothing was claimed
+            if (!claimed)
+                continue;
+
+            {
+                MFX_AUTO_LTRACE(MFX_TRACE_LEVEL_INTERNAL, "FastCopy::Copy");
+                job->Run(stripe);
+            }
+
+            job->done.fetch_add(1, std::memory_order_release);
+        }
     }
 
-    mfxU32 partSize = roi.height / m_numThreads;
-    mfxU32 rest = roi.height % m_numThreads;
+    std::vector<mfxU32>      m_cpus;
+    std::vector<std::thread> m_threads;
 
-    roi.height = partSize;
+    std::mutex               m_mutex;
+    std::condition_variable  m_cv;
+    std::deque<FC_JOB*>      m_jobs;
+    bool                     m_bQuit = false;
+};
 
-    // distribute tasks
-    for (mfxU32 i = 0; i < m_numThreads - 1; i += 1)
+class FastCopyEngine
+{
+public:
+    static FastCopyEngine& Instance()
     {
-        m_tasks[i].pS = pSrc + i * (partSize * srcPitch);
-        m_tasks[i].pD = pDst + i * (partSize * dstPitch);
-        m_tasks[i].srcPitch = srcPitch;
-        m_tasks[i].dstPitch = dstPitch;
-        m_tasks[i].roi = roi;
-        m_tasks[i].flag = flag;
-
-        m_tasks[i].EventStart.Set();
+        static FastCopyEngine engine; // This is thread-safe since C++11
+        return engine;
     }
 
-    if (rest != 0)
+    mfxStatus Copy(FC_JOB& job, mfxU32 rowSize)
     {
-        roi.height = rest;
+        size_t frameSize   = size_t(rowSize) * job.roi.height;
+        FastCopyNodePool& pool = GetPool(GetCurrentNode());
+
+        mfxU32 maxStripes  = pool.GetNumHelpers() + 1;
+        size_t numStripes  = std::min<size_t>(maxStripes, frameSize / m_stripeSize);
+
+        if (numStripes < 2)
+        {
+            // not worth splitting, copy in the calling thread
+            job.rowsPerStripe = job.roi.height;
+            job.numStripes    = 1;
+            job.Run(0);
+            return MFX_ERR_NONE;
+        }
+
+        job.rowsPerStripe = (job.roi.height + mfxI32(numStripes) - 1) / mfxI32(numStripes);
+        job.numStripes    = (job.roi.height + job.rowsPerStripe - 1) / job.rowsPerStripe;
+
+        pool.Submit(job);
+
+        job.Drain();
+
+        pool.Retire(job);
+
+        // wait for stripes claimed by helpers
+        while (job.done.load(std::memory_order_acquire) < job.numStripes)
+            std::this_thread::yield();
+
+        return MFX_ERR_NONE;
     }
 
-    pSrc = pSrc + (m_numThreads - 1) * (partSize * srcPitch);
-    pDst = pDst + (m_numThreads - 1) * (partSize * dstPitch);
+protected:
+    FastCopyEngine()
+    {
+        for (mfxU32 node = 0; ; ++node)
+        {
+            std::ifstream file("/sys/devices/system/node/node" + std::to_string(node) + "/cpulist");
+            std::string   list;
 
-    FastCopy::Copy(pDst, dstPitch, pSrc, srcPitch, roi, flag);
+            if (!std::getline(file, list))
+                break;
 
-    Synchronize();
+            m_nodeCpus.push_back(ParseCpuList(list));
 
-    return MFX_ERR_NONE;
+            for (mfxU32 cpu : m_nodeCpus.back())
+            {
+                if (cpu >= m_cpuToNode.size())
+                    m_cpuToNode.resize(cpu + 1, 0);
+                m_cpuToNode[cpu] = node;
+            }
+        }
 
-} // mfxStatus FastCopy::Copy(mfxU8 *pDst, mfxU32 dstPitch, mfxU8 *pSrc, mfxU32 srcPitch, IppiSize roi)
+        if (m_nodeCpus.empty())
+        {
+            // no NUMA information, single pool without affinity
+            m_nodeCpus.emplace_back();
+        }
 
-mfxStatus FastCopyMultithreading::Synchronize(void)
-{
-    for (mfxU32 i = 0; i < m_numThreads - 1; i += 1)
+        m_pools.resize(m_nodeCpus.size());
+        m_poolInit.reset(new std::once_flag[m_nodeCpus.size()]);
+
+        // stripe covers about a half of L2 so source and destination lines of a stripe stay cached
+        mfxU32 l2Size = ReadCacheSize("/sys/devices/system/cpu/cpu0/cache/index2/size");
+        m_stripeSize  = std::max(FC_MIN_STRIPE_SIZE, (l2Size ? l2Size : FC_DEFAULT_L2_SIZE) / 2);
+    }
+
+    mfxU32 GetCurrentNode() const
     {
-        m_tasks[i].EventEnd.Wait();
+        int cpu = sched_getcpu();
+
+        if (cpu < 0 || size_t(cpu) >= m_cpuToNode.size())
+            return 0;
+
+        return m_cpuToNode[cpu];
     }
 
-    return MFX_ERR_NONE;
+    FastCopyNodePool& GetPool(mfxU32 node)
+    {
+        std::call_once(m_poolInit[node], [this, node]() { m_pools[node].reset(new FastCopyNodePool(m_nodeCpus[node])); });
+        return *m_pools[node];
+    }
 
-} // mfxStatus FastCopy::Synchronize(void)
+    std::vector<std::vector<mfxU32>>               m_nodeCpus;
+    std::vector<mfxU32>                            m_cpuToNode;
+    std::vector<std::unique_ptr<FastCopyNodePool>> m_pools;
+    std::unique_ptr<std::once_flag[]>              m_poolInit;
+    mfxU32                                         m_stripeSize = FC_MIN_STRIPE_SIZE;
+};
+
+} // namespace
 
-// thread function
-mfxU32 __STDCALL FastCopyMultithreading::CopyByThread(void *arg)
+mfxStatus FastCopyMultithreading::Copy(mfxU8 *pDst, mfxU32 dstPitch, mfxU8 *pSrc, mfxU32 srcPitch, IppiSize roi, int flag)
 {
-    FC_TASK *task = (FC_TASK *)arg;
-    MFX_AUTO_LTRACE(MFX_TRACE_LEVEL_INTERNAL, "ThreadName=FastCopy");
+    MFX_AUTO_LTRACE(MFX_TRACE_LEVEL_HOTSPOTS, "FastCopyMultithreading::Copy");
 
-    // wait to event
-    task->EventStart.Wait();
+    if (NULL == pDst || NULL == pSrc)
+    {
+        return MFX_ERR_NULL_PTR;
+    }
 
-    while (!m_bCopyQuit)
+    if (roi.width <= 0 || roi.height <= 0)
     {
-        mfxU32 srcPitch = task->srcPitch;
-        mfxU32 dstPitch = task->dstPitch;
-        IppiSize roi = task->roi;
+        return MFX_ERR_NONE;
+    }
 
-        Ipp8u *pSrc = task->pS;
-        Ipp8u *pDst = task->pD;
+    FC_JOB job;
+    job.pS       = pSrc;
+    job.pD       = pDst;
+    job.srcPitch = srcPitch;
+    job.dstPitch = dstPitch;
+    job.roi      = roi;
+    job.flag     = flag;
+    job.shift    = false;
+    job.lshift   = 0;
+    job.rshift   = 0;
 
-        {
-            MFX_AUTO_LTRACE(MFX_TRACE_LEVEL_INTERNAL, "FastCopy::Copy");
-            FastCopy::Copy(pDst, dstPitch, pSrc, srcPitch, roi, task->flag);
-        }
+    return FastCopyEngine::Instance().Copy(job, mfxU32(roi.width));
 
-        // done copy
-        task->EventEnd.Set();
+} // mfxStatus FastCopyMultithreading::Copy(mfxU8 *pDst, mfxU32 dstPitch, mfxU8 *pSrc, mfxU32 srcPitch, IppiSize roi, int flag)
 
-        // wait for the next frame
-        task->EventStart.Wait();
+mfxStatus FastCopyMultithreading::CopyAndShift(mfxU16 *pDst, mfxU32 dstPitch, mfxU16 *pSrc, mfxU32 srcPitch, IppiSize roi, mfxU8 lshift, mfxU8 rshift, int flag)
+{
+    MFX_AUTO_LTRACE(MFX_TRACE_LEVEL_HOTSPOTS, "FastCopyMultithreading::CopyAndShift");
+
+    if (NULL == pDst || NULL == pSrc)
+    {
+        return MFX_ERR_NULL_PTR;
+    }
+
+    if (roi.width <= 0 || roi.height <= 0)
+    {
+        return MFX_ERR_NONE;
     }
 
-    return 0;
+    FC_JOB job;
+    job.pS       = (mfxU8*)pSrc;
+    job.pD       = (mfxU8*)pDst;
+    job.srcPitch = srcPitch;
+    job.dstPitch = dstPitch;
+    job.roi      = roi;
+    job.flag     = flag;
+    job.shift    = true;
+    job.lshift   = lshift;
+    job.rshift   = rshift;
+
+    return FastCopyEngine::Instance().Copy(job, mfxU32(roi.width) * sizeof(mfxU16));
 
-} // mfxU32 __stdcall FastCopyMultithreading::CopyByThread(void *arg)
+} // mfxStatus FastCopyMultithreading::CopyAndShift(mfxU16 *pDst, mfxU32 dstPitch, mfxU16 *pSrc, mfxU32 srcPitch, IppiSize roi, mfxU8 lshift, mfxU8 rshift, int flag)
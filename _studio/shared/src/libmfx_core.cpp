@@ -33,6 +33,7 @@
 #include "ippi.h"
 
 #include "mfx_umc_alloc_wrapper.h"
+#include "fast_copy_multithreading.h"
 
 using namespace std;
 //
@@ -700,6 +701,37 @@ void CommonCORE::INeedMoreThreadsInside(const void *pComponent)
 
 } // void CommonCORE::INeedMoreThreadsInside(const void *pComponent)
 
+mfxStatus CommonCORE::RegisterHwCompletionEvent(const void *pComponent, int eventFd)
+{
+    MFX_CHECK(m_session && m_session->m_pScheduler, MFX_ERR_NOT_INITIALIZED);
+
+    MFXIUnknown *pInt = m_session->m_pScheduler;
+    MFXIScheduler2 *pScheduler = QueryInterface<MFXIScheduler2>(pInt, MFXIScheduler2_GUID);
+    MFX_CHECK(pScheduler, MFX_ERR_UNSUPPORTED);
+
+    mfxStatus sts = pScheduler->RegisterHwEvent(pComponent, eventFd);
+    pScheduler->Release();
+
+    MFX_RETURN(sts);
+
+} // mfxStatus CommonCORE::RegisterHwCompletionEvent(const void *pComponent, int eventFd)
+
+void CommonCORE::UnregisterHwCompletionEvent(const void *pComponent)
+{
+    if ((m_session) &&
+        (m_session->m_pScheduler))
+    {
+        MFXIUnknown *pInt = m_session->m_pScheduler;
+        MFXIScheduler2 *pScheduler = QueryInterface<MFXIScheduler2>(pInt, MFXIScheduler2_GUID);
+        if (pScheduler)
+        {
+            ignore = MFX_STS_TRACE(pScheduler->UnregisterHwEvent(pComponent));
+            pScheduler->Release();
+        }
+    }
+
+} // void CommonCORE::UnregisterHwCompletionEvent(const void *pComponent)
+
 bool CommonCORE::IsExternalFrameAllocator() const
 {
     return m_bSetExtFrameAlloc;
@@ -952,7 +984,7 @@ mfxStatus CoreDoSWFastCopy(mfxFrameSurface1 & dst, const mfxFrameSurface1 & src,
     case MFX_FOURCC_R16:
         roi.width *= 2;
 
-        MFX_SAFE_CALL(FastCopy::Copy(dst.Data.R, dstPitch, src.Data.R, srcPitch, roi, copyFlag));
+        MFX_SAFE_CALL(FastCopyMultithreading::Copy(dst.Data.R, dstPitch, src.Data.R, srcPitch, roi, copyFlag));
         return MFX_ERR_NONE;
 
     case MFX_FOURCC_P010:
@@ -968,45 +1000,45 @@ mfxStatus CoreDoSWFastCopy(mfxFrameSurface1 & dst, const mfxFrameSurface1 & src,
                 lshift = (uint8_t)(16 - dst.Info.BitDepthLuma);
 
             // CopyAndShift operates with 2-byte words, no need to multiply width by 2
-            MFX_SAFE_CALL(FastCopy::CopyAndShift((mfxU16*)(dst.Data.Y), dstPitch, (mfxU16 *)src.Data.Y, srcPitch, roi, lshift, rshift, copyFlag));
+            MFX_SAFE_CALL(FastCopyMultithreading::CopyAndShift((mfxU16*)(dst.Data.Y), dstPitch, (mfxU16 *)src.Data.Y, srcPitch, roi, lshift, rshift, copyFlag));
 
             roi.height >>= 1;
 
-            return FastCopy::CopyAndShift((mfxU16*)(dst.Data.UV), dstPitch, (mfxU16 *)src.Data.UV, srcPitch, roi, lshift, rshift, copyFlag);
+            return FastCopyMultithreading::CopyAndShift((mfxU16*)(dst.Data.UV), dstPitch, (mfxU16 *)src.Data.UV, srcPitch, roi, lshift, rshift, copyFlag);
         }
         else
         {
             roi.width <<= 1;
 
-            MFX_SAFE_CALL(FastCopy::Copy(dst.Data.Y, dstPitch, src.Data.Y, srcPitch, roi, copyFlag));
+            MFX_SAFE_CALL(FastCopyMultithreading::Copy(dst.Data.Y, dstPitch, src.Data.Y, srcPitch, roi, copyFlag));
 
             roi.height >>= 1;
 
-            return FastCopy::Copy(dst.Data.UV, dstPitch, src.Data.UV, srcPitch, roi, copyFlag);
+            return FastCopyMultithreading::Copy(dst.Data.UV, dstPitch, src.Data.UV, srcPitch, roi, copyFlag);
         }
 
 
     case MFX_FOURCC_P210:
         roi.width <<= 1;
 
-        MFX_SAFE_CALL(FastCopy::Copy(dst.Data.Y, dstPitch, src.Data.Y, srcPitch, roi, copyFlag));
+        MFX_SAFE_CALL(FastCopyMultithreading::Copy(dst.Data.Y, dstPitch, src.Data.Y, srcPitch, roi, copyFlag));
 
-        return FastCopy::Copy(dst.Data.UV, dstPitch, src.Data.UV, srcPitch, roi, copyFlag);
+        return FastCopyMultithreading::Copy(dst.Data.UV, dstPitch, src.Data.UV, srcPitch, roi, copyFlag);
 
     case MFX_FOURCC_NV12:
-        MFX_SAFE_CALL(FastCopy::Copy(dst.Data.Y, dstPitch, src.Data.Y, srcPitch, roi, copyFlag));
+        MFX_SAFE_CALL(FastCopyMultithreading::Copy(dst.Data.Y, dstPitch, src.Data.Y, srcPitch, roi, copyFlag));
 
         roi.height >>= 1;
-        return FastCopy::Copy(dst.Data.UV, dstPitch, src.Data.UV, srcPitch, roi, copyFlag);
+        return FastCopyMultithreading::Copy(dst.Data.UV, dstPitch, src.Data.UV, srcPitch, roi, copyFlag);
 
     case MFX_FOURCC_NV16:
-        MFX_SAFE_CALL(FastCopy::Copy(dst.Data.Y, dstPitch, src.Data.Y, srcPitch, roi, copyFlag));
+        MFX_SAFE_CALL(FastCopyMultithreading::Copy(dst.Data.Y, dstPitch, src.Data.Y, srcPitch, roi, copyFlag));
 
-        return FastCopy::Copy(dst.Data.UV, dstPitch, src.Data.UV, srcPitch, roi, copyFlag);
+        return FastCopyMultithreading::Copy(dst.Data.UV, dstPitch, src.Data.UV, srcPitch, roi, copyFlag);
 
     case MFX_FOURCC_YV12:
 
-        MFX_SAFE_CALL(FastCopy::Copy(dst.Data.Y, dstPitch, src.Data.Y, srcPitch, roi, copyFlag));
+        MFX_SAFE_CALL(FastCopyMultithreading::Copy(dst.Data.Y, dstPitch, src.Data.Y, srcPitch, roi, copyFlag));
 
         roi.width  >>= 1;
         roi.height >>= 1;
@@ -1014,13 +1046,13 @@ mfxStatus CoreDoSWFastCopy(mfxFrameSurface1 & dst, const mfxFrameSurface1 & src,
         srcPitch >>= 1;
         dstPitch >>= 1;
 
-        MFX_SAFE_CALL(FastCopy::Copy(dst.Data.U, dstPitch, src.Data.U, srcPitch, roi, copyFlag));
+        MFX_SAFE_CALL(FastCopyMultithreading::Copy(dst.Data.U, dstPitch, src.Data.U, srcPitch, roi, copyFlag));
 
-        return FastCopy::Copy(dst.Data.V, dstPitch, src.Data.V, srcPitch, roi, copyFlag);
+        return FastCopyMultithreading::Copy(dst.Data.V, dstPitch, src.Data.V, srcPitch, roi, copyFlag);
 
     case MFX_FOURCC_I420:
 
-        MFX_SAFE_CALL(FastCopy::Copy(dst.Data.Y, dstPitch, src.Data.Y, srcPitch, roi, copyFlag));
+        MFX_SAFE_CALL(FastCopyMultithreading::Copy(dst.Data.Y, dstPitch, src.Data.Y, srcPitch, roi, copyFlag));
 
         roi.width  >>= 1;
         roi.height >>= 1;
@@ -1028,19 +1060,19 @@ mfxStatus CoreDoSWFastCopy(mfxFrameSurface1 & dst, const mfxFrameSurface1 & src,
         srcPitch >>= 1;
         dstPitch >>= 1;
 
-        MFX_SAFE_CALL(FastCopy::Copy(dst.Data.U, dstPitch, src.Data.U, srcPitch, roi, copyFlag));
+        MFX_SAFE_CALL(FastCopyMultithreading::Copy(dst.Data.U, dstPitch, src.Data.U, srcPitch, roi, copyFlag));
 
-        return FastCopy::Copy(dst.Data.V, dstPitch, src.Data.V, srcPitch, roi, copyFlag);
+        return FastCopyMultithreading::Copy(dst.Data.V, dstPitch, src.Data.V, srcPitch, roi, copyFlag);
 
     case MFX_FOURCC_UYVY:
         roi.width *= 2;
 
-        return FastCopy::Copy(dst.Data.U, dstPitch, src.Data.U, srcPitch, roi, copyFlag);
+        return FastCopyMultithreading::Copy(dst.Data.U, dstPitch, src.Data.U, srcPitch, roi, copyFlag);
 
     case MFX_FOURCC_YUY2:
         roi.width *= 2;
 
-        return FastCopy::Copy(dst.Data.Y, dstPitch, src.Data.Y, srcPitch, roi, copyFlag);
+        return FastCopyMultithreading::Copy(dst.Data.Y, dstPitch, src.Data.Y, srcPitch, roi, copyFlag);
 
     case MFX_FOURCC_Y210:
     case MFX_FOURCC_Y216:
@@ -1058,12 +1090,12 @@ mfxStatus CoreDoSWFastCopy(mfxFrameSurface1 & dst, const mfxFrameSurface1 & src,
             else
                 lshift = (mfxU8)(16 - dst.Info.BitDepthLuma);
 
-            return FastCopy::CopyAndShift((mfxU16*)(dst.Data.Y), dstPitch, (mfxU16 *)src.Data.Y, srcPitch, roi, lshift, rshift, copyFlag);
+            return FastCopyMultithreading::CopyAndShift((mfxU16*)(dst.Data.Y), dstPitch, (mfxU16 *)src.Data.Y, srcPitch, roi, lshift, rshift, copyFlag);
         }
         else
         {
             roi.width *= 4;
-            return FastCopy::Copy(dst.Data.Y, dstPitch, src.Data.Y, srcPitch, roi, copyFlag);
+            return FastCopyMultithreading::Copy(dst.Data.Y, dstPitch, src.Data.Y, srcPitch, roi, copyFlag);
         }
 
     case MFX_FOURCC_Y410:
@@ -1075,7 +1107,7 @@ mfxStatus CoreDoSWFastCopy(mfxFrameSurface1 & dst, const mfxFrameSurface1 & src,
 
         roi.width *= 4;
 
-        return FastCopy::Copy(ptrDst, dstPitch, ptrSrc, srcPitch, roi, copyFlag);
+        return FastCopyMultithreading::Copy(ptrDst, dstPitch, ptrSrc, srcPitch, roi, copyFlag);
     }
 
     case MFX_FOURCC_Y416:
@@ -1092,12 +1124,12 @@ mfxStatus CoreDoSWFastCopy(mfxFrameSurface1 & dst, const mfxFrameSurface1 & src,
             else
                 lshift = (mfxU8)(16 - dst.Info.BitDepthLuma);
 
-            return FastCopy::CopyAndShift(dst.Data.U16, dstPitch, src.Data.U16, srcPitch, roi, lshift, rshift, copyFlag);
+            return FastCopyMultithreading::CopyAndShift(dst.Data.U16, dstPitch, src.Data.U16, srcPitch, roi, lshift, rshift, copyFlag);
         }
         else
         {
             roi.width *= 8;
-            return FastCopy::Copy((mfxU8*)dst.Data.U16, dstPitch, (mfxU8*)src.Data.U16, srcPitch, roi, copyFlag);
+            return FastCopyMultithreading::Copy((mfxU8*)dst.Data.U16, dstPitch, (mfxU8*)src.Data.U16, srcPitch, roi, copyFlag);
         }
 
 #if defined (MFX_ENABLE_FOURCC_RGB565)
@@ -1108,7 +1140,7 @@ mfxStatus CoreDoSWFastCopy(mfxFrameSurface1 & dst, const mfxFrameSurface1 & src,
 
         roi.width *= 2;
 
-        return FastCopy::Copy(ptrDst, dstPitch, ptrSrc, srcPitch, roi, copyFlag);
+        return FastCopyMultithreading::Copy(ptrDst, dstPitch, ptrSrc, srcPitch, roi, copyFlag);
     }
 #endif // MFX_ENABLE_FOURCC_RGB565
 
@@ -1119,7 +1151,7 @@ mfxStatus CoreDoSWFastCopy(mfxFrameSurface1 & dst, const mfxFrameSurface1 & src,
 
         roi.width *= 3;
 
-        return FastCopy::Copy(ptrDst, dstPitch, ptrSrc, srcPitch, roi, copyFlag);
+        return FastCopyMultithreading::Copy(ptrDst, dstPitch, ptrSrc, srcPitch, roi, copyFlag);
     }
 #ifdef MFX_ENABLE_RGBP
     case MFX_FOURCC_RGBP:
@@ -1127,16 +1159,16 @@ mfxStatus CoreDoSWFastCopy(mfxFrameSurface1 & dst, const mfxFrameSurface1 & src,
     {
         mfxU8* ptrSrc = src.Data.B;
         mfxU8* ptrDst = dst.Data.B;
-        MFX_SAFE_CALL(FastCopy::Copy(ptrDst, dstPitch, ptrSrc, srcPitch, roi, copyFlag));
+        MFX_SAFE_CALL(FastCopyMultithreading::Copy(ptrDst, dstPitch, ptrSrc, srcPitch, roi, copyFlag));
 
         ptrSrc = src.Data.G;
         ptrDst = dst.Data.G;
-        MFX_SAFE_CALL(FastCopy::Copy(ptrDst, dstPitch, ptrSrc, srcPitch, roi, copyFlag));
+        MFX_SAFE_CALL(FastCopyMultithreading::Copy(ptrDst, dstPitch, ptrSrc, srcPitch, roi, copyFlag));
 
         ptrSrc = src.Data.R;
         ptrDst = dst.Data.R;
 
-        return FastCopy::Copy(ptrDst, dstPitch, ptrSrc, srcPitch, roi, copyFlag);
+        return FastCopyMultithreading::Copy(ptrDst, dstPitch, ptrSrc, srcPitch, roi, copyFlag);
     }
 #endif
     case MFX_FOURCC_AYUV:
@@ -1149,7 +1181,7 @@ mfxStatus CoreDoSWFastCopy(mfxFrameSurface1 & dst, const mfxFrameSurface1 & src,
 
         roi.width *= 4;
 
-        return FastCopy::Copy(ptrDst, dstPitch, ptrSrc, srcPitch, roi, copyFlag);
+        return FastCopyMultithreading::Copy(ptrDst, dstPitch, ptrSrc, srcPitch, roi, copyFlag);
     }
     case MFX_FOURCC_ARGB16:
     case MFX_FOURCC_ABGR16:
@@ -1159,10 +1191,10 @@ mfxStatus CoreDoSWFastCopy(mfxFrameSurface1 & dst, const mfxFrameSurface1 & src,
 
         roi.width *= 8;
 
-        return FastCopy::Copy(ptrDst, dstPitch, ptrSrc, srcPitch, roi, copyFlag);
+        return FastCopyMultithreading::Copy(ptrDst, dstPitch, ptrSrc, srcPitch, roi, copyFlag);
     }
     case MFX_FOURCC_P8:
-        return FastCopy::Copy(dst.Data.Y, dstPitch, src.Data.Y, srcPitch, roi, copyFlag);
+        return FastCopyMultithreading::Copy(dst.Data.Y, dstPitch, src.Data.Y, srcPitch, roi, copyFlag);
     case MFX_FOURCC_ABGR16F:
     case MFX_FOURCC_ARGB16F:
     {
@@ -1172,7 +1204,7 @@ mfxStatus CoreDoSWFastCopy(mfxFrameSurface1 & dst, const mfxFrameSurface1 & src,
 
         roi.width *= 8;
 
-        return FastCopy::Copy(ptrDst, dstPitch, ptrSrc, srcPitch, roi, copyFlag);
+        return FastCopyMultithreading::Copy(ptrDst, dstPitch, ptrSrc, srcPitch, roi, copyFlag);
     }
 
     default:
@@ -41,6 +41,9 @@
 #endif
 
 #include <sys/ioctl.h>
+#include <sys/stat.h>
+#include <sys/sysmacros.h>
+#include <fstream>
 
 #include "va/va.h"
 #include <va/va_backend.h>
@@ -116,6 +119,30 @@ mfx_device_item getDeviceItem(VADisplay pVaDisplay)
     return retDeviceItem;
 } // eMFXHWType getDeviceItem (VADisplay pVaDisplay)
 
+// NUMA node of the DRM device opened by the display, -1 if unknown
+static
+mfxI32 getDeviceNumaNode(VADisplay pVaDisplay)
+{
+    VADisplayContextP pDisplayContext = reinterpret_cast<VADisplayContextP>(pVaDisplay);
+    if (!pDisplayContext || !pDisplayContext->pDriverContext || !pDisplayContext->pDriverContext->drm_state)
+        return -1;
+
+    int fd = *(int*)pDisplayContext->pDriverContext->drm_state;
+
+    struct stat st = {};
+    if (fd < 0 || fstat(fd, &st) || !S_ISCHR(st.st_mode))
+        return -1;
+
+    // the kernel reports -1 for devices without NUMA affinity
+    mfxI32 node = -1;
+    std::ifstream numaNode("/sys/dev/char/" + std::to_string(major(st.st_rdev)) + ":" +
+        std::to_string(minor(st.st_rdev)) + "/device/numa_node");
+    numaNode >> node;
+
+    return node;
+
+} // mfxI32 getDeviceNumaNode(VADisplay pVaDisplay)
+
 class VACopyWrapper
 {
 public:
@@ -844,6 +871,18 @@ mfxStatus VAAPIVideoCORE_T<Base>::SetHandle(
 
             std::ignore = MFX_STS_TRACE(TryInitializeCm(false));
 
+            // scheduler threads placed on the device node follow the display
+            if (this->m_session && this->m_session->m_pScheduler)
+            {
+                MFXIUnknown *pInt = this->m_session->m_pScheduler;
+                MFXIScheduler2 *pScheduler = QueryInterface<MFXIScheduler2>(pInt, MFXIScheduler2_GUID);
+                if (pScheduler)
+                {
+                    std::ignore = MFX_STS_TRACE(pScheduler->SetDeviceNode(getDeviceNumaNode(reinterpret_cast<VADisplay>(this->m_hdl))));
+                    pScheduler->Release();
+                }
+            }
+
             if (VACopyWrapper::IsSupportedByPlatform(m_HWType))
             {
                 this->m_pVaCopy.reset(new VACopyWrapper(*m_p_display_wrapper));
@@ -0,0 +1,133 @@
+// Copyright (c) 2025 Intel Corporation
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "mfx_hw_completion_waiter.h"
+
+#include <algorithm>
+#include <system_error>
+
+#include <sys/eventfd.h>
+#include <unistd.h>
+
+HwCompletionWaiter::~HwCompletionWaiter()
+{
+    Close();
+}
+
+mfxStatus HwCompletionWaiter::Init()
+{
+    if (IsActive())
+        return MFX_ERR_NONE;
+
+    m_event = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    if (0 > m_event)
+        return MFX_ERR_UNSUPPORTED;
+
+    m_bQuit = false;
+
+    try
+    {
+        m_thread = std::thread([this]() { ThreadProc(); });
+    }
+    catch (const std::system_error &)
+    {
+        close(m_event);
+        m_event = -1;
+
+        return MFX_ERR_MEMORY_ALLOC;
+    }
+
+    return MFX_ERR_NONE;
+}
+
+void HwCompletionWaiter::Close()
+{
+    if (!IsActive())
+        return;
+
+    {
+        std::lock_guard<std::mutex> guard(m_guard);
+        m_bQuit = true;
+    }
+    m_cv.notify_one();
+
+    if (m_thread.joinable())
+        m_thread.join();
+
+    m_queued.clear();
+    m_done.clear();
+
+    close(m_event);
+    m_event = -1;
+}
+
+mfxStatus HwCompletionWaiter::Wait(const void *pTask, WaitFunc wait)
+{
+    std::unique_lock<std::mutex> guard(m_guard);
+
+    auto it = m_done.find(pTask);
+    if (it != m_done.end())
+    {
+        mfxStatus sts = it->second;
+        m_done.erase(it);
+
+        return sts;
+    }
+
+    bool bSubmitted = (m_pRunning == pTask) ||
+        std::any_of(m_queued.begin(), m_queued.end(), [pTask](const Job &job) { return job.pTask == pTask; });
+
+    if (!bSubmitted)
+    {
+        m_queued.push_back({pTask, std::move(wait)});
+        guard.unlock();
+        m_cv.notify_one();
+    }
+
+    return MFX_TASK_BUSY;
+}
+
+void HwCompletionWaiter::ThreadProc()
+{
+    std::unique_lock<std::mutex> guard(m_guard);
+
+    for (;;)
+    {
+        // submitted waits are finished on quit, the HW is still running them
+        m_cv.wait(guard, [this]() { return m_bQuit || !m_queued.empty(); });
+        if (m_queued.empty())
+            break;
+
+        Job job = std::move(m_queued.front());
+        m_queued.pop_front();
+        m_pRunning = job.pTask;
+
+        guard.unlock();
+        mfxStatus sts = job.wait();
+        guard.lock();
+
+        m_pRunning = nullptr;
+        m_done[job.pTask] = sts;
+
+        uint64_t value = 1;
+        ssize_t res = write(m_event, &value, sizeof(value));
+        (void)res;
+    }
+}
@@ -0,0 +1,282 @@
+// Copyright (c) 2025 Intel Corporation
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+
+// Throughput of the fast copy row kernels.
+// Every kernel variant the CPU supports copies NV12 (8-bit kernels) or P010
+// (16-bit kernels) frames at 1080p, 4K and 8K; the best time of several runs
+// is reported in GB/s of destination data and every output is checked
+// against the C variant.
+//
+// Usage:
+//   fast_copy_bench [iterations]
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+#include "fast_copy_c_impl.h"
+#include "fast_copy_sse4_impl.h"
+#include "fast_copy_avx2_impl.h"
+#include "fast_copy_avx512_impl.h"
+
+struct BenchResolution
+{
+    const char* name;
+    int         width;
+    int         height;
+};
+
+static const BenchResolution resolutions[] =
+{
+    { "1080p", 1920, 1080 },
+    { "4K",    3840, 2160 },
+    { "8K",    7680, 4320 },
+};
+
+typedef void(*t_copyVideoToSys)(const mfxU8* src, mfxU8* dst, int width);
+typedef void(*t_copyVideoToSysShift)(const mfxU16* src, mfxU16* dst, int width, int shift);
+typedef void(*t_copySysToVideoShift)(const mfxU16* src, mfxU16* dst, int width, int shift);
+typedef void(*t_copySysVariantToVideo)(const mfxU8* src, int loffset, mfxU16* dst, int width);
+
+static bool IsSupported_C()      { return true; }
+static bool IsSupported_SSE4()   { return __builtin_cpu_supports("sse4.1"); }
+static bool IsSupported_AVX2()   { return __builtin_cpu_supports("avx2"); }
+static bool IsSupported_AVX512() { return __builtin_cpu_supports("avx512f") && __builtin_cpu_supports("avx512bw"); }
+
+struct BenchVariant
+{
+    const char*             name;
+    bool                    (*isSupported)();
+    t_copyVideoToSys        videoToSys;
+    t_copyVideoToSysShift   videoToSysShift;
+    t_copySysToVideoShift   sysToVideoShift;
+    t_copySysVariantToVideo sysVariantToVideo;
+};
+
+static const BenchVariant variants[] =
+{
+    { "C",       IsSupported_C,
+      copyVideoToSys_C,      copyVideoToSysShift_C,      copySysToVideoShift_C,      copySysVariantToVideo_C },
+    { "SSE4.1",  IsSupported_SSE4,
+      copyVideoToSys_SSE4,   copyVideoToSysShift_SSE4,   copySysToVideoShift_SSE4,   copySysVariantToVideo_SSE4 },
+    { "AVX2",    IsSupported_AVX2,
+      copyVideoToSys_AVX2,   copyVideoToSysShift_AVX2,   copySysToVideoShift_AVX2,   copySysVariantToVideo_AVX2 },
+    { "AVX-512", IsSupported_AVX512,
+      copyVideoToSys_AVX512, copyVideoToSysShift_AVX512, copySysToVideoShift_AVX512, copySysVariantToVideo_AVX512 },
+};
+
+enum
+{
+    KERNEL_VIDEO_TO_SYS = 0,
+    KERNEL_VIDEO_TO_SYS_SHIFT,
+    KERNEL_SYS_TO_VIDEO_SHIFT,
+    KERNEL_SYS_VARIANT_TO_VIDEO,
+    KERNEL_COUNT
+};
+
+static const char* kernelNames[KERNEL_COUNT] =
+{
+    "VideoToSys",
+    "VideoToSysShift",
+    "SysToVideoShift",
+    "SysVariantToVideo",
+};
+
+// pitches are 64 byte aligned like the ones of video memory surfaces
+struct Frame
+{
+    int                 rowBytes;   // bytes of destination data in a row
+    int                 rows;       // luma and chroma rows
+    int                 pitch;
+    std::vector<mfxU8>  src;
+    std::vector<mfxU8>  dst;
+    std::vector<mfxU8>  ref;
+};
+
+static mfxU8* Align64(std::vector<mfxU8>& buf)
+{
+    return (mfxU8*)(((size_t)buf.data() + 63) & ~(size_t)63);
+}
+
+static void CopyFrame(const BenchVariant& variant, int kernel, Frame& frame, mfxU8* dst)
+{
+    const mfxU8* src   = Align64(frame.src);
+    int          width = frame.rowBytes;
+    // low bits of SysVariantToVideo are in a second plane behind the first one
+    int          loffset = frame.pitch * frame.rows;
+
+    for (int y = 0; y < frame.rows; y++)
+    {
+        const mfxU8* s = src + (size_t)y * frame.pitch;
+        mfxU8*       d = dst + (size_t)y * frame.pitch;
+
+        switch (kernel)
+        {
+        case KERNEL_VIDEO_TO_SYS:
+            variant.videoToSys(s, d, width);
+            break;
+        case KERNEL_VIDEO_TO_SYS_SHIFT:
+            variant.videoToSysShift((const mfxU16*)s, (mfxU16*)d, width / 2, 6);
+            break;
+        case KERNEL_SYS_TO_VIDEO_SHIFT:
+            variant.sysToVideoShift((const mfxU16*)s, (mfxU16*)d, width / 2, 6);
+            break;
+        case KERNEL_SYS_VARIANT_TO_VIDEO:
+            variant.sysVariantToVideo(s, loffset, (mfxU16*)d, width / 2);
+            break;
+        }
+    }
+}
+
+static void InitFrame(Frame& frame, const BenchResolution& res, int kernel)
+{
+    // 8-bit kernels copy NV12, 16-bit kernels P010
+    int bytesPerSample = (kernel == KERNEL_VIDEO_TO_SYS) ? 1 : 2;
+
+    frame.rowBytes = res.width * bytesPerSample;
+    frame.rows     = res.height * 3 / 2;
+    frame.pitch    = (frame.rowBytes + 63) & ~63;
+
+    size_t planeSize = (size_t)frame.pitch * frame.rows;
+
+    frame.src.assign(planeSize * 2 + 64, 0);
+    frame.dst.assign(planeSize + 64, 0);
+    frame.ref.assign(planeSize + 64, 0);
+
+    unsigned int seed = 12345;
+    for (auto& byte : frame.src)
+    {
+        seed = seed * 1103515245 + 12345;
+        byte = (mfxU8)(seed >> 16);
+    }
+
+    // P010 samples are MSB aligned in video memory and LSB aligned in system memory,
+    // the SIMD variants rely on the unused bits being zero
+    mfxU16* samples = (mfxU16*)Align64(frame.src);
+    size_t  count   = planeSize / 2;
+
+    if (kernel == KERNEL_VIDEO_TO_SYS_SHIFT)
+    {
+        for (size_t i = 0; i < count; i++)
+            samples[i] &= 0xffc0;
+    }
+    else if (kernel == KERNEL_SYS_TO_VIDEO_SHIFT)
+    {
+        for (size_t i = 0; i < count; i++)
+            samples[i] &= 0x03ff;
+    }
+}
+
+static bool CompareFrames(Frame& frame)
+{
+    mfxU8* dst = Align64(frame.dst);
+    mfxU8* ref = Align64(frame.ref);
+
+    for (int y = 0; y < frame.rows; y++)
+    {
+        if (memcmp(dst + (size_t)y * frame.pitch, ref + (size_t)y * frame.pitch, frame.rowBytes))
+            return false;
+    }
+
+    return true;
+}
+
+int main(int argc, char* argv[])
+{
+    int iterations = 20;
+
+    if (argc == 2)
+    {
+        iterations = atoi(argv[1]);
+    }
+    else if (argc != 1)
+    {
+        printf("usage: %s [iterations]\n", argv[0]);
+        return 1;
+    }
+
+    if (iterations <= 0)
+    {
+        printf("usage: %s [iterations]\n", argv[0]);
+        return 1;
+    }
+
+    printf("%d iterations, best time of each run, GB/s of destination data\n", iterations);
+    printf("%-18s %-6s", "kernel", "frame");
+    for (const BenchVariant& variant : variants)
+        printf(" %9s", variant.name);
+    printf("\n");
+
+    int failures = 0;
+
+    for (int kernel = 0; kernel < KERNEL_COUNT; kernel++)
+    {
+        for (const BenchResolution& res : resolutions)
+        {
+            Frame frame;
+            InitFrame(frame, res, kernel);
+
+            CopyFrame(variants[0], kernel, frame, Align64(frame.ref));
+
+            printf("%-18s %-6s", kernelNames[kernel], res.name);
+
+            for (const BenchVariant& variant : variants)
+            {
+                if (!variant.isSupported())
+                {
+                    printf(" %9s", "n/a");
+                    continue;
+                }
+
+                std::fill(frame.dst.begin(), frame.dst.end(), 0);
+
+                double best = 0;
+                for (int i = 0; i < iterations; i++)
+                {
+                    auto start = std::chrono::steady_clock::now();
+                    CopyFrame(variant, kernel, frame, Align64(frame.dst));
+                    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+                    if (!i || seconds < best)
+                        best = seconds;
+                }
+
+                if (!CompareFrames(frame))
+                {
+                    printf(" %9s", "MISMATCH");
+                    failures++;
+                    continue;
+                }
+
+                double bytes = (double)frame.rowBytes * frame.rows;
+                printf(" %9.2f", bytes / best * 1e-9);
+            }
+
+            printf("\n");
+        }
+    }
+
+    return failures ? 1 : 0;
+}
@@ -0,0 +1,149 @@
+// Copyright (c) 2025 Intel Corporation
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+
+// Throughput of surface lookups in FlexibleFrameAllocator.
+// Pools of 16 to 1024 system memory surfaces are allocated, then every
+// thread locks and unlocks surfaces of the pool picked in pseudo random
+// order. Allocation time per surface is reported too, as it includes
+// generation of a unique mid for every surface.
+//
+// Usage:
+//   frame_allocator_bench [lock_unlock_pairs [threads]]
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <thread>
+#include <vector>
+
+#include "libmfx_allocator.h"
+
+static const mfxU16 poolSizes[] = { 16, 32, 64, 128, 256, 512, 1024 };
+
+static int LockUnlock(FlexibleFrameAllocatorSW& allocator, const std::vector<mfxMemId>& mids, int pairs, unsigned int seed)
+{
+    int failures = 0;
+
+    for (int i = 0; i < pairs; i++)
+    {
+        seed = seed * 1103515245 + 12345;
+
+        mfxMemId     mid  = mids[(seed >> 8) % mids.size()];
+        mfxFrameData data = {};
+
+        if (MFX_ERR_NONE != allocator.Lock(mid, &data, MFX_MAP_READ) || !data.Y)
+            failures++;
+
+        if (MFX_ERR_NONE != allocator.Unlock(mid, &data))
+            failures++;
+    }
+
+    return failures;
+}
+
+int main(int argc, char* argv[])
+{
+    int pairs      = 1000000;
+    int numThreads = std::max(1, std::min((int)std::thread::hardware_concurrency(), 8));
+
+    if (argc == 2 || argc == 3)
+    {
+        pairs = atoi(argv[1]);
+        if (argc == 3)
+            numThreads = atoi(argv[2]);
+    }
+    else if (argc != 1)
+    {
+        printf("usage: %s [lock_unlock_pairs [threads]]\n", argv[0]);
+        return 1;
+    }
+
+    if (pairs <= 0 || numThreads <= 0)
+    {
+        printf("usage: %s [lock_unlock_pairs [threads]]\n", argv[0]);
+        return 1;
+    }
+
+    printf("%d Lock/Unlock pairs per thread\n", pairs);
+    printf("%8s %14s %16s %16s\n", "surfaces", "alloc us/surf", "Mpairs/s 1 thr", "Mpairs/s N thr");
+
+    int failures = 0;
+
+    for (mfxU16 poolSize : poolSizes)
+    {
+        FlexibleFrameAllocatorSW allocator;
+
+        mfxFrameAllocRequest request = {};
+        request.Info.FourCC        = MFX_FOURCC_NV12;
+        request.Info.ChromaFormat  = MFX_CHROMAFORMAT_YUV420;
+        request.Info.Width         = 64;
+        request.Info.Height        = 64;
+        request.Info.CropW         = 64;
+        request.Info.CropH         = 64;
+        request.Type               = MFX_MEMTYPE_SYSTEM_MEMORY | MFX_MEMTYPE_FROM_DECODE;
+        request.NumFrameSuggested  = poolSize;
+
+        mfxFrameAllocResponse response = {};
+
+        auto start = std::chrono::steady_clock::now();
+        mfxStatus sts = allocator.Alloc(request, response);
+        double allocTime = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+        if (MFX_ERR_NONE != sts || response.NumFrameActual != poolSize)
+        {
+            printf("%8d allocation failed, status %d\n", poolSize, sts);
+            failures++;
+            continue;
+        }
+
+        std::vector<mfxMemId> mids(response.mids, response.mids + response.NumFrameActual);
+
+        start = std::chrono::steady_clock::now();
+        failures += LockUnlock(allocator, mids, pairs, 1);
+        double singleTime = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+        std::vector<std::thread> threads;
+        std::vector<int>         results(numThreads, 0);
+
+        start = std::chrono::steady_clock::now();
+        for (int t = 0; t < numThreads; t++)
+            threads.emplace_back([&, t]() { results[t] = LockUnlock(allocator, mids, pairs, t + 1); });
+        for (auto& thread : threads)
+            thread.join();
+        double multiTime = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+        for (int result : results)
+            failures += result;
+
+        printf("%8d %14.2f %16.2f %16.2f\n", poolSize,
+            allocTime * 1e6 / poolSize,
+            pairs / singleTime * 1e-6,
+            (double)pairs * numThreads / multiTime * 1e-6);
+
+        std::ignore = allocator.Free(response);
+    }
+
+    printf("N = %d threads\n", numThreads);
+
+    return failures ? 1 : 0;
+}
@@ -46,6 +46,7 @@ namespace UMC_AV1_DECODER
         void ReadTileListEntryData(size_t const tileSizeBytes, size_t& actualSize);
         void ReadByteAlignment();
         uint64_t GetLE(uint32_t);
+        size_t GetLeb128();
         void ReadSequenceHeader(SequenceHeader&);
         void ReadUncompressedHeader(FrameHeader&, SequenceHeader const&, DPBType const&, OBUHeader const&, uint32_t&);
         void ReadMetaData(FrameHeader& fh);
@@ -55,8 +55,7 @@ namespace UMC_AV1_DECODER
 
     inline uint32_t read_uvlc(AV1Bitstream& bs)
     {
-        uint32_t leading_zeros = 0;
-        while (!bs.GetBit()) ++leading_zeros;
+        const uint32_t leading_zeros = bs.GetLeadingZeros();
 
         // Maximum 32 bits.
         if (leading_zeros >= 32)
@@ -150,17 +149,7 @@ namespace UMC_AV1_DECODER
 
     inline size_t read_leb128(AV1Bitstream& bs)
     {
-        size_t value = 0;
-        for (size_t i = 0; i < MAX_LEB128_SIZE; ++i)
-        {
-            const uint8_t cur_byte = static_cast<uint8_t>(bs.GetBits(8));
-            const uint8_t decoded_byte = cur_byte & LEB128_BYTE_MASK;
-            value |= ((uint64_t)decoded_byte) << (i * 7);
-            if ((cur_byte & ~LEB128_BYTE_MASK) == 0)
-                return value;
-        }
-
-        throw av1_exception(UMC::UMC_ERR_INVALID_STREAM);
+        return bs.GetLeb128();
     }
 
     const uint8_t DIV_LUT_PREC_BITS = 14;
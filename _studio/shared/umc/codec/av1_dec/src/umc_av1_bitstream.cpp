@@ -1219,9 +1219,10 @@ namespace UMC_AV1_DECODER
 
     void AV1Bitstream::ReadByteAlignment()
     {
-        if (m_bitOffset)
+        const uint32_t bitOffset = BitsDecoded() % 8;
+        if (bitOffset)
         {
-            const uint32_t bitsToRead = 8 - m_bitOffset;
+            const uint32_t bitsToRead = 8 - bitOffset;
             const uint32_t bits = GetBits(bitsToRead);
             if (bits)
                 throw av1_exception(UMC::UMC_ERR_INVALID_STREAM);
@@ -1277,7 +1278,7 @@ namespace UMC_AV1_DECODER
 
     uint64_t AV1Bitstream::GetLE(uint32_t n)
     {
-        assert(m_bitOffset == 0);
+        assert(BitsDecoded() % 8 == 0);
         assert(n <= 8);
 
         uint64_t t = 0;
@@ -1285,12 +1286,51 @@ namespace UMC_AV1_DECODER
         {
             if (BytesLeft() <= 0)
                 throw av1_exception(UMC::UMC_ERR_INVALID_STREAM);
-            t += (uint32_t)((*m_pbs++) << (i * 8));
+            t += uint64_t(GetBits(8)) << (i * 8);
         }
 
         return t;
     }
 
+    size_t AV1Bitstream::GetLeb128()
+    {
+        if (m_cacheBits < 8 * MAX_LEB128_SIZE)
+            Refill();
+
+        // a set bit marks the last byte of the value in the cache, only whole cached bytes take part
+        const uint32_t cachedBytes = m_cacheBits / 8;
+        const uint64_t lastByteMask = cachedBytes ?
+            0x8080808080808080ull & (~0ull << (64 - 8 * cachedBytes)) : 0;
+        const uint64_t last = ~m_cache & lastByteMask;
+        if (last)
+        {
+            const uint32_t length = static_cast<uint32_t>(__builtin_clzll(last)) / 8 + 1;
+
+            uint64_t value = 0;
+            for (uint32_t i = 0; i < length; ++i)
+                value |= ((m_cache >> (56 - 8 * i)) & LEB128_BYTE_MASK) << (i * 7);
+
+            // length < 8 here, so the shift is defined
+            m_cache <<= 8 * length;
+            m_cacheBits -= 8 * length;
+
+            return static_cast<size_t>(value);
+        }
+
+        // value is longer than the cache or the data is over, go byte by byte to get the same errors
+        size_t value = 0;
+        for (size_t i = 0; i < MAX_LEB128_SIZE; ++i)
+        {
+            const uint8_t cur_byte = static_cast<uint8_t>(GetBits(8));
+            const uint8_t decoded_byte = cur_byte & LEB128_BYTE_MASK;
+            value |= ((uint64_t)decoded_byte) << (i * 7);
+            if ((cur_byte & ~LEB128_BYTE_MASK) == 0)
+                return value;
+        }
+
+        throw av1_exception(UMC::UMC_ERR_INVALID_STREAM);
+    }
+
     void AV1Bitstream::ReadTile(uint32_t const tileSizeBytes, size_t& reportedSize, size_t& actualSize)
     {
         const size_t tile_size_minus_1 = static_cast<size_t>(GetLE(tileSizeBytes));
@@ -1299,7 +1339,7 @@ namespace UMC_AV1_DECODER
         if (BytesLeft() < reportedSize)
             actualSize = BytesLeft();
 
-        m_pbs += actualSize;
+        SkipBytes(actualSize);
     }
 
     void AV1Bitstream::ReadTileListEntryData(size_t const tileSizeBytes, size_t& actualSize)
@@ -1308,7 +1348,7 @@ namespace UMC_AV1_DECODER
         if (BytesLeft() < tileSizeBytes)
             actualSize = BytesLeft();
 
-        m_pbs += actualSize;
+        SkipBytes(actualSize);
     }
 
     void AV1Bitstream::ReadSequenceHeader(SequenceHeader& sh)
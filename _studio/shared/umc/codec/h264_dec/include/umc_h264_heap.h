@@ -27,6 +27,7 @@
 #define __UMC_H264_HEAP_H
 
 #include <memory>
+#include <unordered_set>
 #include "umc_mutex.h"
 #include "umc_h264_dec_defs_dec.h"
 #include "umc_media_data.h"
@@ -141,6 +142,7 @@ public:
         , m_Size(size)
         , m_isTyped(isTyped)
         , m_heap(heap)
+        , m_isFree(false)
     {
     }
 
@@ -153,6 +155,7 @@ public:
     size_t m_Size;
     bool   m_isTyped;
     H264_Heap_Objects * m_heap;
+    bool   m_isFree;                                            // item is in the free list of its heap
 
     static Item * Allocate(H264_Heap_Objects * heap, size_t size, bool isTyped = false)
     {
@@ -179,14 +182,35 @@ public:
 
 //////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 // H264_Heap_Objects class
+//
+// Free items are kept in per size class lists. Untyped buffers are rounded up to the class size and
+// serve any request of their class, typed items keep constructed objects and are reused for the same size only.
+// Free lists retain up to m_maxRetainedSize bytes, past it the largest free items are deleted.
+// Allocated items are registered, so a repeated Free of the same pointer is ignored even if the item was deleted.
 //////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 class H264_Heap_Objects
 {
 public:
 
-    H264_Heap_Objects()
-        : m_pFirstFree(0)
+    enum
     {
+        MIN_CLASS_SIZE_LOG  = 6,                                // class 0 holds sizes up to 64 bytes
+        MAX_CLASS_SIZE_LOG  = 32,                               // larger buffers share the last list
+        LARGE_SIZE_CLASS    = 1 + 4 * (MAX_CLASS_SIZE_LOG - MIN_CLASS_SIZE_LOG),
+        NUM_SIZE_CLASSES    = LARGE_SIZE_CLASS + 1
+    };
+
+    static const size_t DEFAULT_MAX_RETAINED_SIZE = 64 * 1024 * 1024;
+
+    H264_Heap_Objects(size_t maxRetainedSize = DEFAULT_MAX_RETAINED_SIZE)
+        : m_retainedSize(0)
+        , m_maxRetainedSize(maxRetainedSize)
+    {
+        for (uint32_t i = 0; i < NUM_SIZE_CLASSES; i++)
+        {
+            m_pFirstFree[i] = 0;
+            m_pFirstFreeTyped[i] = 0;
+        }
     }
 
     virtual ~H264_Heap_Objects()
@@ -194,43 +218,58 @@ public:
         Release();
     }
 
-    Item * GetItemForAllocation(size_t size, bool typed = false)
+    // Returns size class index and the size of buffers of this class (4 classes per power of 2)
+    static uint32_t GetSizeClass(size_t size, size_t &classSize)
     {
-        if (!m_pFirstFree)
+        if (size <= (size_t(1) << MIN_CLASS_SIZE_LOG))
         {
+            classSize = size_t(1) << MIN_CLASS_SIZE_LOG;
             return 0;
         }
 
-        if (m_pFirstFree->m_Size == size && m_pFirstFree->m_isTyped == typed)
+        uint32_t sizeLog = 63 - __builtin_clzll((unsigned long long)(size - 1));
+        if (sizeLog >= MAX_CLASS_SIZE_LOG)
         {
-            Item * ptr = m_pFirstFree;
-            m_pFirstFree = m_pFirstFree->m_pNext;
-            return ptr;
+            classSize = size;
+            return LARGE_SIZE_CLASS;
         }
 
-        Item * temp = m_pFirstFree;
+        size_t step = size_t(1) << (sizeLog - 2);
+        classSize = (size + step - 1) & ~(step - 1);
+        return 1 + 4 * (sizeLog - MIN_CLASS_SIZE_LOG) + uint32_t(classSize >> (sizeLog - 2)) - 5;
+    }
 
-        while (temp->m_pNext)
-        {
-            if (temp->m_pNext->m_Size == size && temp->m_pNext->m_isTyped == typed)
-            {
-                Item * ptr = temp->m_pNext;
-                temp->m_pNext = temp->m_pNext->m_pNext;
-                return ptr;
-            }
+    Item * GetItemForAllocation(size_t size, bool typed = false)
+    {
+        size_t classSize;
+        uint32_t sizeClass = GetSizeClass(size, classSize);
+        bool exactSize = typed || sizeClass == LARGE_SIZE_CLASS;
 
-            temp = temp->m_pNext;
-        }
+        Item ** head = typed ? &m_pFirstFreeTyped[sizeClass] : &m_pFirstFree[sizeClass];
 
-        return 0;
+        // untyped items of a class are interchangeable, objects and large buffers are reused for the same size only
+        while (*head && exactSize && (*head)->m_Size != size)
+            head = &(*head)->m_pNext;
+
+        Item * item = *head;
+        if (!item)
+            return 0;
+
+        *head = item->m_pNext;
+        item->m_isFree = false;
+        m_retainedSize -= item->m_Size;
+        assert(item->m_Size >= size);
+        return item;
     }
 
     void* Allocate(size_t size, bool isTyped = false)
     {
-        Item * item = GetItemForAllocation(size);
+        Item * item = GetItemForAllocation(size, isTyped);
         if (!item)
         {
-            item = Item::Allocate(this, size, isTyped);
+            size_t classSize;
+            GetSizeClass(size, classSize);
+            item = AllocateItem(isTyped ? size : classSize, isTyped);
         }
 
         return item->m_Ptr;
@@ -249,7 +288,7 @@ public:
 
         if (!item)
         {
-            void * ptr = Allocate(sizeof(T), true);
+            void * ptr = AllocateItem(sizeof(T), true)->m_Ptr;
             return new(ptr) T();
         }
 
@@ -268,21 +307,18 @@ public:
 
         Item * item = (Item *) ((uint8_t*)obj - sizeof(Item));
 
-        // check
-        Item * temp = m_pFirstFree;
-
-        while (temp)
-        {
-            if (temp == item)
-            { //was removed yet
-                return;
-            }
+        // the item is not dereferenced before it is found among allocated ones
+        if (m_allocatedItems.find(item) == m_allocatedItems.end())
+            return;
 
-            temp = temp->m_pNext;
+        if (item->m_isFree)
+        { //was removed yet
+            return;
         }
 
         if (force)
         {
+            m_allocatedItems.erase(item);
             Item::Free(item);
             return;
         }
@@ -295,23 +331,84 @@ public:
             }
         }
 
-        item->m_pNext = m_pFirstFree;
-        m_pFirstFree = item;
+        size_t classSize;
+        uint32_t sizeClass = GetSizeClass(item->m_Size, classSize);
+
+        Item ** head = item->m_isTyped ? &m_pFirstFreeTyped[sizeClass] : &m_pFirstFree[sizeClass];
+
+        item->m_isFree = true;
+        item->m_pNext = *head;
+        *head = item;
+
+        m_retainedSize += item->m_Size;
+        if (m_retainedSize > m_maxRetainedSize)
+            Trim(m_maxRetainedSize / 2);
     }
 
     void Release()
     {
-        while (m_pFirstFree)
+        for (uint32_t i = 0; i < NUM_SIZE_CLASSES; i++)
+        {
+            Release(m_pFirstFree[i]);
+            Release(m_pFirstFreeTyped[i]);
+        }
+    }
+
+    // Deletes free items starting from the largest class until free lists retain no more than targetSize bytes
+    void Trim(size_t targetSize)
+    {
+        for (uint32_t i = NUM_SIZE_CLASSES; i-- > 0 && m_retainedSize > targetSize; )
         {
-            Item *pTemp = m_pFirstFree->m_pNext;
-            Item::Free(m_pFirstFree);
-            m_pFirstFree = pTemp;
+            Trim(m_pFirstFree[i], targetSize);
+            Trim(m_pFirstFreeTyped[i], targetSize);
         }
     }
 
 private:
 
-    Item * m_pFirstFree;
+    Item * AllocateItem(size_t size, bool isTyped)
+    {
+        Item * item = Item::Allocate(this, size, isTyped);
+        m_allocatedItems.insert(item);
+        return item;
+    }
+
+    // Deletes an item taken off a free list, a later Free of its pointer doesn't find it among allocated ones
+    void DeleteItem(Item * item)
+    {
+        m_retainedSize -= item->m_Size;
+        m_allocatedItems.erase(item);
+        Item::Free(item);
+    }
+
+    // items are unlinked before deletion, as destructors of typed items may free into the heap
+    void Release(Item *& head)
+    {
+        while (head)
+        {
+            Item *pTemp = head;
+            head = head->m_pNext;
+            DeleteItem(pTemp);
+        }
+    }
+
+    void Trim(Item *& head, size_t targetSize)
+    {
+        while (head && m_retainedSize > targetSize)
+        {
+            Item *pTemp = head;
+            head = head->m_pNext;
+            DeleteItem(pTemp);
+        }
+    }
+
+    Item * m_pFirstFree[NUM_SIZE_CLASSES];
+    Item * m_pFirstFreeTyped[NUM_SIZE_CLASSES];
+
+    size_t m_retainedSize;                                      // bytes kept by free lists
+    size_t m_maxRetainedSize;
+
+    std::unordered_set<Item *> m_allocatedItems;                // items which are not deleted yet
 };
 
 
@@ -32,6 +32,29 @@ namespace UMC_HEVC_DECODER
 {
 
 // Headers container class
+// Payload of parameter set NAL unit and decoder state its parsing depends on
+struct HeaderKey
+{
+    HeaderKey(const uint8_t *data, size_t size, uint32_t context)
+        : m_data(data)
+        , m_size(size)
+        , m_context(context)
+        , m_hash(0xcbf29ce484222325ull)
+    {
+        // FNV-1a
+        for (size_t i = 0; i < size; i++)
+        {
+            m_hash ^= data[i];
+            m_hash *= 0x100000001b3ull;
+        }
+    }
+
+    const uint8_t *m_data;
+    size_t         m_size;
+    uint32_t       m_context;
+    uint64_t       m_hash;
+};
+
 template <typename T>
 class HeaderSet
 {
@@ -41,6 +64,8 @@ public:
         : m_Header()
         ,m_pObjHeap(pObjHeap)
         , m_currentID(-1)
+        , m_generation(0)
+        , m_isCurrentUnchanged(false)
     {
     }
 
@@ -49,16 +74,29 @@ public:
         Reset(false);
     }
 
-    T * AddHeader(T* hdr)
+    // Stores a copy of parsed header, the key allows to reuse it when the same payload is received again
+    T * AddHeader(T* hdr, const HeaderKey *key = 0)
     {
         uint32_t id = hdr->GetID();
 
         if (id >= m_Header.size())
         {
             m_Header.resize(id + 1);
+            m_Keys.resize(id + 1);
         }
 
         m_currentID = id;
+        m_isCurrentUnchanged = false;
+        m_generation++;
+
+        StoredKey &stored = m_Keys[id];
+        stored.payload.clear();
+        if (key)
+        {
+            stored.payload.assign(key->m_data, key->m_data + key->m_size);
+            stored.context = key->m_context;
+            stored.hash = key->m_hash;
+        }
 
         if (m_Header[id])
         {
@@ -76,6 +114,29 @@ public:
         return header;
     }
 
+    // Returns the header parsed from the same payload and makes it current,
+    // parameter sets resent on every IRAP skip parsing and keep their heap object
+    T * FindHeader(const HeaderKey &key)
+    {
+        for (uint32_t id = 0; id < m_Header.size(); id++)
+        {
+            StoredKey const& stored = m_Keys[id];
+
+            if (!m_Header[id] || stored.hash != key.m_hash || stored.context != key.m_context ||
+                stored.payload.size() != key.m_size || !key.m_size)
+                continue;
+
+            if (memcmp(stored.payload.data(), key.m_data, key.m_size))
+                continue;
+
+            m_currentID = id;
+            m_isCurrentUnchanged = true;
+            return m_Header[id];
+        }
+
+        return 0;
+    }
+
     T * GetHeader(int32_t id)
     {
         if ((uint32_t)id >= m_Header.size())
@@ -122,6 +183,8 @@ public:
         assert(m_Header[id] == hdr);
         m_Header[id]->DecrementReference();
         m_Header[id] = 0;
+        m_Keys[id].payload.clear();
+        m_generation++;
     }
 
     void Reset(bool isPartialReset = false)
@@ -134,7 +197,9 @@ public:
             }
 
             m_Header.clear();
+            m_Keys.clear();
             m_currentID = -1;
+            m_isCurrentUnchanged = false;
         }
     }
 
@@ -165,11 +230,33 @@ public:
         return GetHeader(m_currentID);
     }
 
+    // The current header was received again with the same content
+    bool IsCurrentUnchanged() const
+    {
+        return m_isCurrentUnchanged;
+    }
+
+    // Changes each time a header with new content is stored
+    uint32_t GetGeneration() const
+    {
+        return m_generation;
+    }
+
 private:
+    struct StoredKey
+    {
+        std::vector<uint8_t> payload;
+        uint64_t             hash;
+        uint32_t             context;
+    };
+
     std::vector<T*>           m_Header;
+    std::vector<StoredKey>    m_Keys;
     Heap_Objects             *m_pObjHeap;
 
     int32_t                    m_currentID;
+    uint32_t                   m_generation;
+    bool                       m_isCurrentUnchanged;
 };
 
 /****************************************************************************************************/
@@ -362,6 +362,13 @@ public:
     // Attempt to recover after something unexpectedly went wrong
     virtual void AfterErrorRestore();
 
+    // Finish submission of the frame which was packed but not executed yet,
+    // if it fails and ppFailedFrame is set, the frame is returned there and the caller reports the error
+    virtual UMC::Status SubmitPendingFrame(H265DecoderFrame ** /*ppFailedFrame*/ = 0)
+    {
+        return UMC::UMC_OK;
+    }
+
     SEI_Storer_H265 * GetSEIStorer() const { return m_sei_messages;}
 
     Headers * GetHeaders() { return &m_Headers;}
@@ -481,12 +488,14 @@ protected:
     UMC::Mutex m_mGuard;
 
 private:
+    // Take the header parsed from the same parameter set payload before
+    bool xReuseHeader(NalUnitType nal_unit_type, const HeaderKey &key, UMC::Status &sts);
     // Decode video parameters set NAL unit
-    UMC::Status xDecodeVPS(H265HeadersBitstream *);
+    UMC::Status xDecodeVPS(H265HeadersBitstream *, const HeaderKey &key);
     // Decode sequence parameters set NAL unit
-    UMC::Status xDecodeSPS(H265HeadersBitstream *);
+    UMC::Status xDecodeSPS(H265HeadersBitstream *, const HeaderKey &key);
     // Decode picture parameters set NAL unit
-    UMC::Status xDecodePPS(H265HeadersBitstream *);
+    UMC::Status xDecodePPS(H265HeadersBitstream *, const HeaderKey &key);
 
     TaskSupplier_H265 & operator = (TaskSupplier_H265 &)
     {
@@ -26,6 +26,7 @@
 
 #include "umc_h265_mfx_supplier.h"
 #include "umc_h265_segment_decoder_dxva.h"
+#include "umc_mutex.h"
 
 namespace UMC_HEVC_DECODER
 {
@@ -51,12 +52,40 @@ public:
 
     virtual void Reset();
 
+    virtual void Close();
+
+    virtual void AfterErrorRestore();
+
     virtual void CreateTaskBroker();
 
     mfxStatus ChangeVideoDecodingSpeed(int32_t& num);
 
     void SetBufferedFramesNumber(uint32_t buffered);
 
+    // Slices refer to the application bitstream while the call lasts,
+    // slices of the access unit which is not submitted yet are copied before return
+    virtual UMC::Status AddSource(UMC::MediaData *pSource);
+
+    // Amount of bitstream data copied to slice buffers instead of being referenced
+    struct CopyStatistics
+    {
+        uint64_t lastFrameBytes;
+        uint64_t totalBytes;
+    };
+
+    CopyStatistics GetCopyStatistics() const
+    {
+        return m_copyStatistics;
+    }
+
+    // Leaves execution of the packed frame to the scheduler thread,
+    // so the next access unit is parsed while the driver submits the previous one
+    void SetParseAhead(bool enable)
+    {
+        m_parseAhead = enable;
+    }
+
+    virtual UMC::Status SubmitPendingFrame(H265DecoderFrame **ppFailedFrame = 0);
 
 protected:
     virtual UMC::Status AllocateFrameData(H265DecoderFrame * pFrame, mfxSize dimensions, const H265SeqParamSet* pSeqParamSet, const H265PicParamSet *pPicParamSet);
@@ -69,8 +98,26 @@ protected:
 
     virtual H265DecoderFrame *GetFrameToDisplayInternal(bool force);
 
+    // Copies data of the slices which still refer to the application bitstream
+    void DetachPendingSlices();
+
+    // Throws the error of the frame executed on the scheduler thread
+    void CheckPendingStatus();
+
     uint32_t m_bufferedFrameNumber;
 
+    // Application bitstream of the current AddSource call
+    const uint8_t *m_pSourceBegin;
+    const uint8_t *m_pSourceEnd;
+
+    CopyStatistics m_copyStatistics;
+
+    // VA context keeps one picture between BeginFrame and EndFrame, so at most one frame is pending
+    bool m_parseAhead;
+    H265DecoderFrame *m_pPendingFrame;
+    UMC::Status m_pendingStatus;
+    UMC::Mutex m_pendingGuard;
+
     uint16_t m_drcFrameWidth;
     uint16_t m_drcFrameHeight;
 
@@ -301,7 +301,9 @@ UMC::Status MFXTaskSupplier_H265::DecodeHeaders(UMC::MediaDataEx *nalUnit)
                     H265SeqParamSet * currSPS = isSPS ? m_Headers.m_SeqParams.GetCurrentHeader() : nullptr;
                     H265PicParamSet * currPPS = isSPS ? nullptr : m_Headers.m_PicParams.GetCurrentHeader();
                     int32_t id = isSPS ? m_Headers.m_SeqParams.GetCurrentID() : m_Headers.m_PicParams.GetCurrentID();
-                    if (hdr->GetPointer() != nullptr && hdr->GetID() == id)
+                    // reused header keeps its change flag until the first VCL NAL unit
+                    bool unchanged = isSPS ? m_Headers.m_SeqParams.IsCurrentUnchanged() : m_Headers.m_PicParams.IsCurrentUnchanged();
+                    if (!unchanged && hdr->GetPointer() != nullptr && hdr->GetID() == id)
                     {
                         bool changed =
                             size + prefix_size != hdr->GetSize() ||
@@ -161,16 +161,28 @@ bool TaskBrokerSingleThreadDXVA::GetNextTaskInternal(H265Task *)
     VAStatus surfErr = VA_STATUS_SUCCESS;
     int32_t index;
 
+    // the last frame may be packed but not executed yet, its error is returned when the frame completes
+    H265DecoderFrame *pFailedFrame = 0;
+    UMC::Status submitSts = m_pTaskSupplier->SubmitPendingFrame(&pFailedFrame);
+
     for (H265DecoderFrameInfo * au = m_FirstAU; au; au = au->GetNextAU())
     {
         index = au->m_pFrame->GetFrameMID();
 
-        m_mGuard.Unlock();
+        if (au->m_pFrame == pFailedFrame)
+        {
+            // the frame wasn't executed, there is nothing to wait for
+            sts = submitSts;
+        }
+        else
         {
-            MFX_AUTO_LTRACE(MFX_TRACE_LEVEL_SCHED, "Dec vaSyncSurface");
-            sts = dxva_sd->GetPacker()->SyncTask(index, &surfErr);
+            m_mGuard.Unlock();
+            {
+                MFX_AUTO_LTRACE(MFX_TRACE_LEVEL_SCHED, "Dec vaSyncSurface");
+                sts = dxva_sd->GetPacker()->SyncTask(index, &surfErr);
+            }
+            m_mGuard.Lock();
         }
-        m_mGuard.Lock();
 
         //we should complete frame even we got an error
         //this allows to return the error from [RunDecoding]
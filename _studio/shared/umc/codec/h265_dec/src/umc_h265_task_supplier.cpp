@@ -1078,19 +1078,19 @@ UMC::Status TaskSupplier_H265::DecodeSEI(UMC::MediaDataEx *nalUnit)
 }
 
 // Decode video parameters set NAL unit
-UMC::Status TaskSupplier_H265::xDecodeVPS(H265HeadersBitstream *bs)
+UMC::Status TaskSupplier_H265::xDecodeVPS(H265HeadersBitstream *bs, const HeaderKey &key)
 {
     H265VideoParamSet vps;
 
     UMC::Status s = bs->GetVideoParamSet(&vps);
     if(s == UMC::UMC_OK)
-        m_Headers.m_VideoParams.AddHeader(&vps);
+        m_Headers.m_VideoParams.AddHeader(&vps, &key);
 
     return s;
 }
 
 // Decode sequence parameters set NAL unit
-UMC::Status TaskSupplier_H265::xDecodeSPS(H265HeadersBitstream *bs)
+UMC::Status TaskSupplier_H265::xDecodeSPS(H265HeadersBitstream *bs, const HeaderKey &key)
 {
     H265SeqParamSet sps;
     sps.Reset();
@@ -1150,7 +1150,7 @@ UMC::Status TaskSupplier_H265::xDecodeSPS(H265HeadersBitstream *bs)
         newResolution = true;
     }
 
-    m_Headers.m_SeqParams.AddHeader(&sps);
+    m_Headers.m_SeqParams.AddHeader(&sps, &key);
 
     m_pNALSplitter->SetSuggestedSize(CalculateSuggestedSize(&sps));
 
@@ -1161,7 +1161,7 @@ UMC::Status TaskSupplier_H265::xDecodeSPS(H265HeadersBitstream *bs)
 }
 
 // Decode picture parameters set NAL unit
-UMC::Status TaskSupplier_H265::xDecodePPS(H265HeadersBitstream * bs)
+UMC::Status TaskSupplier_H265::xDecodePPS(H265HeadersBitstream * bs, const HeaderKey &key)
 {
     H265PicParamSet pps;
     pps.Reset();
@@ -1401,11 +1401,49 @@ UMC::Status TaskSupplier_H265::xDecodePPS(H265HeadersBitstream * bs)
         pps.tilesInfo[i].width = pps.column_width[tileX];
     }
 
-    m_Headers.m_PicParams.AddHeader(&pps);
+    m_Headers.m_PicParams.AddHeader(&pps, &key);
 
     return s;
 }
 
+// Take the header parsed from the same parameter set payload before
+bool TaskSupplier_H265::xReuseHeader(NalUnitType nal_unit_type, const HeaderKey &key, UMC::Status &sts)
+{
+    sts = UMC::UMC_OK;
+
+    switch (nal_unit_type)
+    {
+    case NAL_UT_VPS:
+        return m_Headers.m_VideoParams.FindHeader(key) != 0;
+
+    case NAL_UT_SPS:
+        {
+            const H265SeqParamSet * old_sps = m_Headers.m_SeqParams.GetCurrentHeader();
+            const H265SeqParamSet * sps = m_Headers.m_SeqParams.FindHeader(key);
+            if (!sps)
+                return false;
+
+            HighestTid = sps->sps_max_sub_layers - 1;
+
+            // switching back to another stored SPS may still change resolution
+            if (sps != old_sps && IsNeedSPSInvalidate(old_sps, sps))
+            {
+                m_RecreateSurfaceFlag = IsNeedRecreateSurface(old_sps, sps);
+                sts = UMC::UMC_NTF_NEW_RESOLUTION;
+            }
+
+            m_pNALSplitter->SetSuggestedSize(CalculateSuggestedSize(sps));
+            return true;
+        }
+
+    case NAL_UT_PPS:
+        return m_Headers.m_PicParams.FindHeader(key) != 0;
+
+    default:
+        return false;
+    }
+}
+
 // Decode a bitstream header NAL unit
 UMC::Status TaskSupplier_H265::DecodeHeaders(UMC::MediaDataEx *nalUnit)
 {
@@ -1414,6 +1452,20 @@ UMC::Status TaskSupplier_H265::DecodeHeaders(UMC::MediaDataEx *nalUnit)
 
     H265HeadersBitstream bitStream;
 
+    // SPS parsing depends on the highest temporal sub-layer, PPS parsing on the referred SPS
+    NalUnitType nal_type = (NalUnitType)nalUnit->GetExData()->values[0];
+    uint32_t context = 0;
+    if (nal_type == NAL_UT_SPS)
+        context = HighestTid;
+    else if (nal_type == NAL_UT_PPS)
+        context = m_Headers.m_SeqParams.GetGeneration();
+
+    HeaderKey key((const uint8_t*)nalUnit->GetDataPointer(), nalUnit->GetDataSize(), context);
+
+    // broadcast streams resend the same parameter sets with every IRAP picture
+    if (xReuseHeader(nal_type, key, umcRes))
+        return umcRes;
+
     try
     {
         MemoryPiece mem;
@@ -1438,13 +1490,13 @@ UMC::Status TaskSupplier_H265::DecodeHeaders(UMC::MediaDataEx *nalUnit)
         switch (nal_unit_type)
         {
         case NAL_UT_VPS:
-            umcRes = xDecodeVPS(&bitStream);
+            umcRes = xDecodeVPS(&bitStream, key);
             break;
         case NAL_UT_SPS:
-            umcRes = xDecodeSPS(&bitStream);
+            umcRes = xDecodeSPS(&bitStream, key);
             break;
         case NAL_UT_PPS:
-            umcRes = xDecodePPS(&bitStream);
+            umcRes = xDecodePPS(&bitStream, key);
             break;
         default:
             break;
@@ -43,9 +43,15 @@ namespace UMC_HEVC_DECODER
 
 VATaskSupplier::VATaskSupplier()
     : m_bufferedFrameNumber(0)
+    , m_pSourceBegin(0)
+    , m_pSourceEnd(0)
+    , m_parseAhead(false)
+    , m_pPendingFrame(0)
+    , m_pendingStatus(UMC::UMC_OK)
     , m_drcFrameWidth(0)
     , m_drcFrameHeight(0)
 {
+    m_copyStatistics = {};
 }
 
 UMC::Status VATaskSupplier::Init(UMC::VideoDecoderParams *pInit)
@@ -108,12 +114,73 @@ H265DecoderFrame * VATaskSupplier::GetFrameToDisplayInternal(bool force)
 
 void VATaskSupplier::Reset()
 {
+    SubmitPendingFrame();
+    m_pendingStatus = UMC::UMC_OK;
+
     if (m_pTaskBroker)
         m_pTaskBroker->Reset();
 
     MFXTaskSupplier_H265::Reset();
 }
 
+void VATaskSupplier::Close()
+{
+    SubmitPendingFrame();
+    m_pendingStatus = UMC::UMC_OK;
+
+    MFXTaskSupplier_H265::Close();
+}
+
+void VATaskSupplier::AfterErrorRestore()
+{
+    SubmitPendingFrame();
+    m_pendingStatus = UMC::UMC_OK;
+
+    MFXTaskSupplier_H265::AfterErrorRestore();
+}
+
+UMC::Status VATaskSupplier::SubmitPendingFrame(H265DecoderFrame **ppFailedFrame)
+{
+    UMC::AutomaticUMCMutex guard(m_pendingGuard);
+
+    if (!m_pPendingFrame)
+        return UMC::UMC_OK;
+
+    H265DecoderFrame *pFrame = m_pPendingFrame;
+    m_pPendingFrame = 0;
+
+    try
+    {
+        EndDecodingFrame();
+    }
+    catch (h265_exception const& e)
+    {
+        pFrame->SetError(e.GetStatus());
+
+        if (ppFailedFrame)
+            *ppFailedFrame = pFrame;
+        // reported to the application by the next AddSource call
+        else if (m_pendingStatus == UMC::UMC_OK)
+            m_pendingStatus = e.GetStatus();
+
+        return e.GetStatus();
+    }
+
+    return UMC::UMC_OK;
+}
+
+void VATaskSupplier::CheckPendingStatus()
+{
+    UMC::Status sts = UMC::UMC_OK;
+    {
+        UMC::AutomaticUMCMutex guard(m_pendingGuard);
+        std::swap(sts, m_pendingStatus);
+    }
+
+    if (sts != UMC::UMC_OK)
+        throw h265_exception(sts);
+}
+
 inline bool isFreeFrame(H265DecoderFrame * pTmp)
 {
     return (!pTmp->m_isShortTermRef &&
@@ -137,10 +204,56 @@ void VATaskSupplier::CompleteFrame(H265DecoderFrame * pFrame)
     if (H265DecoderFrameInfo::STATUS_FILLED != pFrame->GetAU()->GetStatus())
         return;
 
+    uint64_t copiedBytes = 0;
+    for (uint32_t i = 0; i < pFrame->GetAU()->GetSliceCount(); i++)
+    {
+        const MemoryPiece &source = pFrame->GetAU()->GetSlice(i)->m_source;
+        if (source.IsAllocated())
+            copiedBytes += source.GetDataSize();
+    }
+
+    m_copyStatistics.lastFrameBytes = copiedBytes;
+    m_copyStatistics.totalBytes += copiedBytes;
+    MFX_LTRACE_I(MFX_TRACE_LEVEL_INTERNAL, copiedBytes);
+
+    // the same VA context can't start a new picture until the previous one is ended
+    SubmitPendingFrame();
+    CheckPendingStatus();
+
     StartDecodingFrame(pFrame);
+
+    if (m_parseAhead)
+    {
+        // headers and slice data are packed to VA buffers already,
+        // the frame is ended by the task broker or before the next frame is started
+        UMC::AutomaticUMCMutex guard(m_pendingGuard);
+        m_pPendingFrame = pFrame;
+        return;
+    }
+
     EndDecodingFrame();
 }
 
+UMC::Status VATaskSupplier::AddSource(UMC::MediaData *pSource)
+{
+    if (m_parseAhead)
+        CheckPendingStatus();
+
+    if (pSource)
+    {
+        m_pSourceBegin = (const uint8_t *)pSource->GetBufferPointer();
+        m_pSourceEnd = m_pSourceBegin + pSource->GetBufferSize();
+    }
+
+    UMC::Status umcRes = MFXTaskSupplier_H265::AddSource(pSource);
+
+    DetachPendingSlices();
+
+    m_pSourceBegin = m_pSourceEnd = 0;
+
+    return umcRes;
+}
+
 void VATaskSupplier::InitFrameCounter(H265DecoderFrame * pFrame, const H265Slice *pSlice)
 {
     TaskSupplier_H265::InitFrameCounter(pFrame, pSlice);
@@ -198,6 +311,53 @@ UMC::Status VATaskSupplier::AllocateFrameData(H265DecoderFrame * pFrame, mfxSize
     return UMC::UMC_OK;
 }
 
+// Places slice data to own buffer of the slice
+static void CopySliceSource(H265Slice *slice, const uint8_t *data, size_t size, double pts)
+{
+    slice->m_source.Allocate(size + DEFAULT_NU_TAIL_SIZE);
+    MFX_INTERNAL_CPY(slice->m_source.GetPointer(), data, (uint32_t)size);
+    memset(slice->m_source.GetPointer() + size, DEFAULT_NU_TAIL_VALUE, DEFAULT_NU_TAIL_SIZE);
+    slice->m_source.SetDataSize(size);
+    slice->m_source.SetTime(pts);
+}
+
+// Moves slice bitstream to m_source keeping its position
+static void RebaseSliceBitStream(H265Slice *slice)
+{
+    uint32_t* pbs;
+    uint32_t bitOffset;
+
+    slice->GetBitStream()->GetState(&pbs, &bitOffset);
+
+    size_t bytes = slice->GetBitStream()->BytesDecodedRoundOff();
+
+    slice->GetBitStream()->Reset(slice->m_source.GetPointer(), bitOffset,
+        (uint32_t)slice->m_source.GetDataSize());
+    slice->GetBitStream()->SetState((uint32_t*)(slice->m_source.GetPointer() + bytes), bitOffset);
+}
+
+void VATaskSupplier::DetachPendingSlices()
+{
+    auto detach = [](H265Slice *slice)
+    {
+        if (slice->m_source.IsAllocated() || !slice->m_source.GetDataSize())
+            return;
+
+        CopySliceSource(slice, slice->m_source.GetPointer(), slice->m_source.GetDataSize(), slice->m_source.GetTime());
+        RebaseSliceBitStream(slice);
+    };
+
+    if (m_pLastSlice)
+        detach(m_pLastSlice);
+
+    H265DecoderFrame *pFrame = GetView()->pCurFrame;
+    if (pFrame && pFrame->GetAU()->GetStatus() == H265DecoderFrameInfo::STATUS_NOT_FILLED)
+    {
+        for (uint32_t i = 0; i < pFrame->GetAU()->GetSliceCount(); i++)
+            detach(pFrame->GetAU()->GetSlice(i));
+    }
+}
+
 H265Slice * VATaskSupplier::DecodeSliceHeader(UMC::MediaDataEx *nalUnit)
 {
     size_t dataSize = nalUnit->GetDataSize();
@@ -212,30 +372,18 @@ H265Slice * VATaskSupplier::DecodeSliceHeader(UMC::MediaDataEx *nalUnit)
     if (!slice)
         return 0;
 
-    if (nalUnit->GetFlags() & UMC::MediaData::FLAG_VIDEO_DATA_NOT_FULL_FRAME)
+    // NAL units assembled from several chunks are kept by splitter only until the next call
+    const uint8_t *data = (const uint8_t *)nalUnit->GetDataPointer();
+    if (data >= m_pSourceBegin && data + nalUnit->GetDataSize() <= m_pSourceEnd)
     {
-        slice->m_source.Allocate(nalUnit->GetDataSize() + DEFAULT_NU_TAIL_SIZE);
-        MFX_INTERNAL_CPY(slice->m_source.GetPointer(), nalUnit->GetDataPointer(), (uint32_t)nalUnit->GetDataSize());
-        memset(slice->m_source.GetPointer() + nalUnit->GetDataSize(), DEFAULT_NU_TAIL_VALUE, DEFAULT_NU_TAIL_SIZE);
-        slice->m_source.SetDataSize(nalUnit->GetDataSize());
-        slice->m_source.SetTime(nalUnit->GetTime());
+        slice->m_source.SetData(nalUnit);
     }
     else
     {
-        slice->m_source.SetData(nalUnit);
+        CopySliceSource(slice, data, nalUnit->GetDataSize(), nalUnit->GetTime());
     }
 
-    uint32_t* pbs;
-    uint32_t bitOffset;
-
-    slice->GetBitStream()->GetState(&pbs, &bitOffset);
-
-    size_t bytes = slice->GetBitStream()->BytesDecodedRoundOff();
-
-    slice->GetBitStream()->Reset(slice->m_source.GetPointer(), bitOffset,
-        (uint32_t)slice->m_source.GetDataSize());
-    slice->GetBitStream()->SetState((uint32_t*)(slice->m_source.GetPointer() + bytes), bitOffset);
-
+    RebaseSliceBitStream(slice);
 
     return slice;
 }
@@ -28,6 +28,7 @@
 #endif
 #if !defined(MSDK_USE_EXTERNAL_IPP)
 #include "ippcore.h"
+#include "ippcc.h"
 #include "ippi.h"
 #include "ippj.h"
 #include "ipps.h"
@@ -31,6 +31,8 @@ class CJPEGDecoderHuffmanTable
 private:
   uint8_t                  m_bits[16];
   uint8_t                  m_vals[256];
+  // IppiDecodeHuffmanSpec built from m_bits/m_vals
+  CMemoryBuffer          m_table;
   bool                   m_bEmpty;
   bool                   m_bValid;
 
@@ -57,6 +59,8 @@ public:
 
   const uint8_t*   GetBits() const        { return m_bits; }
   const uint8_t*   GetValues() const      { return m_vals; }
+
+  operator IppiDecodeHuffmanSpec*(void) { return (IppiDecodeHuffmanSpec*)m_table.m_buffer; }
 };
 
 #endif // MFX_ENABLE_MJPEG_VIDEO_DECODE
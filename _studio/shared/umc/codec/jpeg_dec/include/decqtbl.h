@@ -30,6 +30,7 @@ class CJPEGDecoderQuantTable
 {
 private:
   uint8_t   m_rbf[DCTSIZE2*sizeof(uint16_t)+(CPU_CACHE_LINE-1)];
+  uint8_t   m_qbf[DCTSIZE2*sizeof(uint16_t)+(CPU_CACHE_LINE-1)];
 
 public:
   int     m_id;
@@ -37,6 +38,8 @@ public:
   int     m_initialized;
   uint8_t*  m_raw8u;
   uint16_t* m_raw16u;
+  // de-quantization table in natural order for IPP inverse DCT
+  uint16_t* m_qnt16u;
 
   CJPEGDecoderQuantTable(void);
   virtual ~CJPEGDecoderQuantTable(void);
@@ -44,6 +47,8 @@ public:
   JERRCODE Init(int id,uint8_t  raw[DCTSIZE2]);
 
   JERRCODE Init(int id,uint16_t raw[DCTSIZE2]);
+
+  operator uint16_t*()                 { return m_qnt16u; }
 };
 
 
@@ -142,8 +142,10 @@ public:
   int      m_ac_scans_completed;
   int      m_init_done;
 
-  int16_t*  m_block_buffer;
+  int16_t*  m_block_buffer = 0;
   int       m_block_buffer_size;
+  // IppiDecodeHuffmanState of the current VLC unit
+  CMemoryBuffer m_state;
   int      m_num_threads;
   int      m_sof_find;
 
@@ -179,13 +181,9 @@ public:
   JERRCODE ParseRST(void);
   JERRCODE ParseCOM(void);
 
-  JERRCODE DecodeScanBaseline(void);     // interleaved / non-interleaved scans
+  JERRCODE DecodeScanBaseline(void);     // interleaved scans
   JERRCODE DecodeScanBaselineIN(void);   // interleaved scan
   JERRCODE DecodeScanBaselineIN_P(void); // interleaved scan for plane image
-  JERRCODE DecodeScanBaselineNI(void);   // non-interleaved scan
-  JERRCODE DecodeScanLosslessIN(void);
-  JERRCODE DecodeScanLosslessNI(void);
-  JERRCODE DecodeScanProgressive(void);
 
   JERRCODE ProcessRestart(void);
 
@@ -198,9 +196,6 @@ public:
   // inverse DCT, de-quantization, level-shift for mcu row
   JERRCODE ReconstructMCURowBL8x8_NxN(int16_t* pMCUBuf, uint32_t colMCU, uint32_t maxMCU);
   JERRCODE ReconstructMCURowBL8x8(int16_t* pMCUBuf, uint32_t colMCU, uint32_t maxMCU);
-  JERRCODE ReconstructMCURowBL8x8To4x4(int16_t* pMCUBuf, uint32_t colMCU, uint32_t maxMCU);
-  JERRCODE ReconstructMCURowBL8x8To2x2(int16_t* pMCUBuf, uint32_t colMCU, uint32_t maxMCU);
-  JERRCODE ReconstructMCURowBL8x8To1x1(int16_t* pMCUBuf, uint32_t colMCU, uint32_t maxMCU);
   JERRCODE ReconstructMCURowEX(int16_t* pMCUBuf, uint32_t colMCU, uint32_t maxMCU);
 
   JERRCODE ProcessBuffer(int nMCURow, int thread_id = 0);
@@ -27,6 +27,7 @@
 
 #include <vector>
 #include <memory>
+#include <atomic>
 
 class CJpegTaskBuffer
 {
@@ -141,6 +142,10 @@ public:
     // Decoder's array
     std::unique_ptr<UMC::MJPEGVideoDecoderMFX> m_pMJPEGVideoDecoder;
 
+    // Number of pieces decoded. The thread decoding the last piece
+    // completes the frame.
+    std::atomic<mfxU32> m_numDecodedPieces;
+
 protected:
     // Close the object, release all resources
     void Close(void);
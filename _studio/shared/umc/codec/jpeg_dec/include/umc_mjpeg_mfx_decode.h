@@ -102,6 +102,9 @@ public:
     // Do post processing
     virtual Status PostProcessing(double ptr);
 
+    // Decode the given piece of the task's pictures
+    Status DecodePicture(const CJpegTask &task, const mfxU32 threadNumber, const mfxU32 callNumber);
+
     // Get the number of decoders allocated
     inline
     mfxU32 NumDecodersAllocated(void) const;
@@ -119,6 +122,12 @@ protected:
 
     Status _DecodeHeader(int32_t* nUsedBytes, const uint32_t threadNum);
 
+    // Decode the VLC unit of the field into the internal frame
+    Status DecodePiece(const mfxU32 fieldNum,
+                       const mfxU32 restartNum,
+                       const mfxU32 restartsToDecode,
+                       const mfxU32 threadNum);
+
     int32_t                  m_frameNo;
 
     VideoData               m_internalFrame;
@@ -48,6 +48,18 @@ CJPEGDecoderHuffmanTable::~CJPEGDecoderHuffmanTable(void)
 
 JERRCODE CJPEGDecoderHuffmanTable::Create(void)
 {
+  int       size;
+  IppStatus status;
+
+  status = mfxiDecodeHuffmanSpecGetBufSize_JPEG_8u(&size);
+  if(ippStsNoErr != status)
+  {
+    LOG1("IPP Error: mfxiDecodeHuffmanSpecGetBufSize_JPEG_8u() failed - ",status);
+    return JPEG_ERR_INTERNAL;
+  }
+
+  m_table.Allocate(size);
+
   m_bEmpty = 0;
   m_bValid = 0;
 
@@ -63,6 +75,8 @@ JERRCODE CJPEGDecoderHuffmanTable::Destroy(void)
   memset(m_bits, 0, sizeof(m_bits));
   memset(m_vals, 0, sizeof(m_vals));
 
+  m_table.Delete();
+
   m_bValid = 0;
   m_bEmpty = 1;
 
@@ -78,6 +92,17 @@ JERRCODE CJPEGDecoderHuffmanTable::Init(int id,int hclass,uint8_t* bits,uint8_t*
   MFX_INTERNAL_CPY(m_bits,bits,16);
   MFX_INTERNAL_CPY(m_vals,vals,256);
 
+  // fast-to-use table for software decoding, created by Create()
+  if(m_table.m_buffer)
+  {
+    IppStatus status = mfxiDecodeHuffmanSpecInit_JPEG_8u(m_bits,m_vals,(IppiDecodeHuffmanSpec*)m_table.m_buffer);
+    if(ippStsNoErr != status)
+    {
+      LOG1("IPP Error: mfxiDecodeHuffmanSpecInit_JPEG_8u() failed - ",status);
+      return JPEG_ERR_DHT_DATA;
+    }
+  }
+
   m_bValid = 1;
   m_bEmpty = 0;
 
@@ -30,6 +30,7 @@
 #endif
 #endif
 
+#include "ippi.h"
 #include "decqtbl.h"
 
 CJPEGDecoderQuantTable::CJPEGDecoderQuantTable(void)
@@ -41,7 +42,9 @@ CJPEGDecoderQuantTable::CJPEGDecoderQuantTable(void)
   // align for max performance
   m_raw8u  = UMC::align_pointer<uint8_t *>(m_rbf, CPU_CACHE_LINE);
   m_raw16u = UMC::align_pointer<uint16_t *>(m_rbf,CPU_CACHE_LINE);
+  m_qnt16u = UMC::align_pointer<uint16_t *>(m_qbf,CPU_CACHE_LINE);
   memset(m_rbf, 0, sizeof(m_rbf));
+  memset(m_qbf, 0, sizeof(m_qbf));
 
   return;
 } // ctor
@@ -54,6 +57,7 @@ CJPEGDecoderQuantTable::~CJPEGDecoderQuantTable(void)
   m_initialized = 0;
 
   memset(m_rbf, 0, sizeof(m_rbf));
+  memset(m_qbf, 0, sizeof(m_qbf));
 
   return;
 } // dtor
@@ -65,6 +69,14 @@ JERRCODE CJPEGDecoderQuantTable::Init(int id,uint8_t raw[64])
   m_precision = 0; // 8-bit precision
 
   MFX_INTERNAL_CPY(m_raw8u,raw,DCTSIZE2);
+
+  IppStatus status = mfxiQuantInvTableInit_JPEG_8u16u(m_raw8u,m_qnt16u);
+  if(ippStsNoErr != status)
+  {
+    LOG1("IPP Error: mfxiQuantInvTableInit_JPEG_8u16u() failed - ",status);
+    return JPEG_ERR_INTERNAL;
+  }
+
   m_initialized = 1;
 
   return JPEG_OK;
@@ -77,6 +89,13 @@ JERRCODE CJPEGDecoderQuantTable::Init(int id,uint16_t raw[64])
 
   MFX_INTERNAL_CPY((int16_t*)m_raw16u, (int16_t*)raw, DCTSIZE2*sizeof(int16_t));
 
+  IppStatus status = mfxiZigzagInv8x8_16s_C1((int16_t*)m_raw16u,(int16_t*)m_qnt16u);
+  if(ippStsNoErr != status)
+  {
+    LOG1("IPP Error: mfxiZigzagInv8x8_16s_C1() failed - ",status);
+    return JPEG_ERR_INTERNAL;
+  }
+
   m_initialized = 1;
 
   return JPEG_OK;
@@ -160,6 +160,9 @@ void CJPEGDecoder::Reset(void)
   m_init_done              = 0;
   m_marker                 = JM_NONE;
 
+  if(0 != m_block_buffer)
+    mfxFree(m_block_buffer);
+
   m_block_buffer           = 0;
   m_block_buffer_size      = 0;
   m_num_threads            = 0;
@@ -184,6 +187,102 @@ void CJPEGDecoder::Reset(void)
   return;
 } // CJPEGDecoder::Reset(void)
 
+
+JERRCODE CJPEGDecoder::Init(void)
+{
+  int       i;
+  int       size;
+  JERRCODE  jerr;
+  IppStatus status;
+  CJPEGColorComponent* curr_comp;
+
+  if(m_init_done)
+    return JPEG_OK;
+
+  // only 8-bit full size reconstruction of the known samplings is supported
+  if(8 != m_jpeg_precision || JS_OTHER == m_jpeg_sampling || JD_1_1 != m_jpeg_dct_scale)
+    return JPEG_NOT_IMPLEMENTED;
+
+  // every decoder object processes one VLC unit at once,
+  // VLC units of a picture are spread over several decoder objects
+  m_num_threads = 1;
+  m_dd_factor   = 1;
+
+  for(i = 0; i < m_jpeg_ncomp; i++)
+  {
+    curr_comp = &m_ccomp[i];
+
+    curr_comp->m_cc_height = m_mcuHeight;
+    curr_comp->m_cc_step   = m_numxMCU * m_mcuWidth;
+
+    curr_comp->m_ss_height = curr_comp->m_cc_height / curr_comp->m_v_factor;
+    curr_comp->m_ss_step   = curr_comp->m_cc_step   / curr_comp->m_h_factor;
+
+    jerr = curr_comp->CreateBufferCC(m_num_threads);
+    if(JPEG_OK != jerr)
+      return jerr;
+
+    jerr = curr_comp->CreateBufferSS(m_num_threads);
+    if(JPEG_OK != jerr)
+      return jerr;
+
+    curr_comp->m_need_upsampling = 0;
+  }
+
+  // coefficients of one MCU row
+  m_block_buffer_size = m_numxMCU * m_nblock * DCTSIZE2 * sizeof(int16_t);
+
+  if(0 != m_block_buffer)
+    mfxFree(m_block_buffer);
+
+  m_block_buffer = (int16_t*)mfxMalloc(m_block_buffer_size);
+  if(0 == m_block_buffer)
+  {
+    m_block_buffer_size = 0;
+    return JPEG_ERR_ALLOC;
+  }
+
+  status = mfxiDecodeHuffmanStateGetBufSize_JPEG_8u(&size);
+  if(ippStsNoErr != status)
+  {
+    LOG1("IPP Error: mfxiDecodeHuffmanStateGetBufSize_JPEG_8u() failed - ",status);
+    return JPEG_ERR_INTERNAL;
+  }
+
+  jerr = m_state.Allocate(size);
+  if(JPEG_OK != jerr)
+    return jerr;
+
+  m_init_done = 1;
+
+  return JPEG_OK;
+} // CJPEGDecoder::Init()
+
+
+JERRCODE CJPEGDecoder::Clean(void)
+{
+  int i;
+
+  if(0 != m_block_buffer)
+  {
+    mfxFree(m_block_buffer);
+    m_block_buffer = 0;
+  }
+  m_block_buffer_size = 0;
+
+  for(i = 0; i < MAX_COMPS_PER_SCAN; i++)
+  {
+    m_ccomp[i].DeleteBufferCC();
+    m_ccomp[i].DeleteBufferSS();
+  }
+
+  m_state.Delete();
+
+  m_init_done = 0;
+
+  return CJPEGDecoderBase::Clean();
+} // CJPEGDecoder::Clean()
+
 JERRCODE CJPEGDecoder::SetDestination(
   uint8_t*   pDst,
   int      dstStep,
@@ -748,173 +847,262 @@ JERRCODE CJPEGDecoder::ParseRST(void)
 
 } // CJPEGDecoder::ParseRST()
 
-JERRCODE CJPEGDecoder::ParseData()
+JERRCODE CJPEGDecoder::ProcessRestart(void)
 {
-    int32_t i;
-    JERRCODE jerr = Init();
-    if(JPEG_OK != jerr)
+  int       n;
+  JERRCODE  jerr;
+  IppStatus status;
+
+  status = mfxiDecodeHuffmanStateInit_JPEG_8u((IppiDecodeHuffmanState*)m_state.m_buffer);
+  if(ippStsNoErr != status)
+  {
+    LOG1("IPP Error: mfxiDecodeHuffmanStateInit_JPEG_8u() failed - ",status);
+    return JPEG_ERR_INTERNAL;
+  }
+
+  // reset DC predictors
+  for(n = 0; n < m_jpeg_ncomp; n++)
+  {
+    m_ccomp[n].m_lastDC = 0;
+  }
+
+  jerr = ParseRST();
+  if(JPEG_OK != jerr)
+  {
+    LOG0("Error: ParseRST() failed");
+    return jerr;
+  }
+
+  m_rst_go = 1;
+  m_restarts_to_go = m_curr_scan->jpeg_restart_interval;
+
+  return JPEG_OK;
+} // CJPEGDecoder::ProcessRestart()
+
+
+JERRCODE CJPEGDecoder::DecodeHuffmanMCURowBL(int16_t* pMCUBuf, uint32_t colMCU, uint32_t maxMCU)
+{
+  int       n, k, l;
+  uint32_t  j;
+  int       currPos;
+  JERRCODE  jerr;
+  IppStatus status;
+
+  for(j = colMCU; j < maxMCU; j++)
+  {
+    if(m_curr_scan->jpeg_restart_interval && 0 == m_restarts_to_go)
     {
-      return jerr;
+      jerr = ProcessRestart();
+      if(JPEG_OK != jerr)
+        return jerr;
     }
 
-    switch(m_jpeg_mode)
+    for(n = m_curr_scan->first_comp; n < m_curr_scan->first_comp + m_curr_scan->ncomps; n++)
     {
-    case JPEG_BASELINE:
-    case JPEG_EXTENDED:
-      {
-        jerr = DecodeScanBaseline();
-        if(JPEG_OK != jerr)
-          return jerr;
+      int16_t*               lastDC = &m_ccomp[n].m_lastDC;
+      IppiDecodeHuffmanSpec* dctbl  = m_dctbl[m_ccomp[n].m_dc_selector];
+      IppiDecodeHuffmanSpec* actbl  = m_actbl[m_ccomp[n].m_ac_selector];
 
-      }
-      break;
+      if(0 == dctbl || 0 == actbl)
+        return JPEG_ERR_DHT_DATA;
 
-    case JPEG_PROGRESSIVE:
+      for(k = 0; k < m_ccomp[n].m_scan_vsampling; k++)
       {
-        jerr = DecodeScanProgressive();
-
-        m_ac_scans_completed = 0;
-        for(i = 0; i < m_jpeg_ncomp; i++)
+        for(l = 0; l < m_ccomp[n].m_scan_hsampling; l++)
         {
-          m_ac_scans_completed += m_ccomp[i].m_ac_scan_completed;
-        }
+          // the tail of VLC unit can stay in the bit accumulator only
+          jerr = m_BitStreamIn.FillBuffer(SAFE_NBYTES);
+          if(JPEG_OK != jerr && JPEG_ERR_BUFF != jerr)
+            return jerr;
 
-        if(JPEG_OK != jerr ||
-          (m_dc_scan_completed != 0 && m_ac_scans_completed == m_jpeg_ncomp))
-        {
-          int16_t* pMCUBuf;
-          for(i = 0; i < (int) m_numyMCU; i++)
+          currPos = m_BitStreamIn.GetCurrPos();
+
+          status = mfxiDecodeHuffman8x8_JPEG_1u16s_C1(
+                     m_BitStreamIn.GetDataPtr(),m_BitStreamIn.GetDataLen(),&currPos,
+                     pMCUBuf,lastDC,(int*)&m_marker,dctbl,actbl,
+                     (IppiDecodeHuffmanState*)m_state.m_buffer);
+
+          m_BitStreamIn.SetCurrPos(currPos);
+
+          if(ippStsNoErr > status)
           {
-            pMCUBuf = m_block_buffer + (i* m_numxMCU * DCTSIZE2* m_nblock);
+            LOG1("IPP Error: mfxiDecodeHuffman8x8_JPEG_1u16s_C1() failed - ",status);
+            m_marker = JM_NONE;
+            return JPEG_ERR_INTERNAL;
+          }
 
-#ifdef __TIMING__
-            c0 = mfxGetCpuClocks();
-#endif
-            switch (m_jpeg_dct_scale)
-            {
-              case JD_1_1:
-              {
-                  jerr = ReconstructMCURowBL8x8(pMCUBuf, 0, m_numxMCU);
-              }
-              break;
+          pMCUBuf += DCTSIZE2;
+        } // for m_scan_hsampling
+      } // for m_scan_vsampling
+    } // for scan components
 
-              case JD_1_2:
-              {
-                jerr = ReconstructMCURowBL8x8To4x4(pMCUBuf, 0, m_numxMCU);
-              }
-              break;
+    if(m_curr_scan->jpeg_restart_interval)
+    {
+      m_restarts_to_go--;
+    }
+  } // for MCU
 
-              case JD_1_4:
-              {
-                jerr = ReconstructMCURowBL8x8To2x2(pMCUBuf, 0, m_numxMCU);
-              }
-              break;
+  return JPEG_OK;
+} // CJPEGDecoder::DecodeHuffmanMCURowBL()
 
-              case JD_1_8:
-              {
-                jerr = ReconstructMCURowBL8x8To1x1(pMCUBuf, 0, m_numxMCU);
-              }
-              break;
 
-              default:
-                break;
-            }
-            if(JPEG_OK != jerr)
-              return jerr;
-#ifdef __TIMING__
-            c1 = mfxGetCpuClocks();
-            m_clk_dct += c1 - c0;
-#endif
-            if(JD_PIXEL == m_dst.order) // pixel by pixel order
-            {
-#ifdef __TIMING__
-              c0 = mfxGetCpuClocks();
-#endif
-              jerr = UpSampling(i, 0, m_numxMCU);
-              if(JPEG_OK != jerr)
-                return jerr;
-#ifdef __TIMING__
-              c1 = mfxGetCpuClocks();
-              m_clk_ss += c1 - c0;
-#endif
+JERRCODE CJPEGDecoder::ReconstructMCURowBL8x8(int16_t* pMCUBuf, uint32_t colMCU, uint32_t maxMCU)
+{
+  int       c, k, l;
+  uint32_t  j;
+  int       dstStep;
+  uint8_t*  pDst;
+  uint16_t* qtbl;
+  IppStatus status;
+  CJPEGColorComponent* curr_comp;
 
-#ifdef __TIMING__
-              c0 = mfxGetCpuClocks();
-#endif
-             jerr = ColorConvert(i, 0, m_numxMCU);
-              if(JPEG_OK != jerr)
-                return jerr;
-#ifdef __TIMING__
-              c1 = mfxGetCpuClocks();
-              m_clk_cc += c1 - c0;
-#endif
-            }
-            else          // plane order
-            {
-              if(m_jpeg_precision == 8)
-              {
-                jerr = ProcessBuffer(i);
-                if(JPEG_OK != jerr)
-                  return jerr;
-              }
-              else
-                return JPEG_NOT_IMPLEMENTED; //not support 16-bit PLANE image
-            }
-          }
-        }
-      }
-      break;
+  for(j = colMCU; j < maxMCU; j++)
+  {
+    for(c = m_curr_scan->first_comp; c < m_curr_scan->first_comp + m_curr_scan->ncomps; c++)
+    {
+      curr_comp = &m_ccomp[c];
+      qtbl      = m_qntbl[curr_comp->m_q_selector];
 
-    case JPEG_LOSSLESS:
-      if(m_curr_scan->ncomps == m_jpeg_ncomp)
+      // full size components go to color conversion buffer directly
+      if(1 == curr_comp->m_h_factor && 1 == curr_comp->m_v_factor)
       {
-        jerr = DecodeScanLosslessIN();
-        if(JPEG_OK != jerr)
-          return jerr;
+        dstStep = curr_comp->m_cc_step;
+        pDst    = curr_comp->GetCCBufferPtr<uint8_t> (0) + 8 * j * curr_comp->m_scan_hsampling;
       }
       else
       {
-        jerr = DecodeScanLosslessNI();
-        if(JPEG_OK != jerr)
-          return jerr;
+        dstStep = curr_comp->m_ss_step;
+        pDst    = curr_comp->GetSSBufferPtr<uint8_t> (0) + 8 * j * curr_comp->m_scan_hsampling;
 
-        if(m_ac_scans_completed == m_jpeg_ncomp)
-        {
-          int16_t* pMCUBuf = m_block_buffer;
+        curr_comp->m_need_upsampling = 1;
+      }
 
-          for(i = 0; i < (int) m_numyMCU; i++)
+      for(k = 0; k < curr_comp->m_scan_vsampling; k++)
+      {
+        for(l = 0; l < curr_comp->m_scan_hsampling; l++)
+        {
+          status = mfxiDCTQuantInv8x8LS_JPEG_16s8u_C1R(pMCUBuf, pDst + k * 8 * dstStep + l * 8, dstStep, qtbl);
+          if(ippStsNoErr > status)
           {
-            if(m_curr_scan->jpeg_restart_interval && i*m_numxMCU % m_curr_scan->jpeg_restart_interval == 0)
-              m_rst_go = 1;
+            LOG1("IPP Error: mfxiDCTQuantInv8x8LS_JPEG_16s8u_C1R() failed - ",status);
+            return JPEG_ERR_INTERNAL;
+          }
 
-#ifdef __TIMING__
-            c0 = mfxGetCpuClocks();
-#endif
-            jerr = ReconstructMCURowLS(pMCUBuf, i);
-            if(JPEG_OK != jerr)
-              return jerr;
-#ifdef __TIMING__
-            c1 = mfxGetCpuClocks();
-            m_clk_diff += c1 - c0;
-#endif
+          pMCUBuf += DCTSIZE2;
+        } // for m_scan_hsampling
+      } // for m_scan_vsampling
+    } // for scan components
+  } // for MCU
 
-#ifdef __TIMING__
-            c0 = mfxGetCpuClocks();
-#endif
-            jerr = ColorConvert(i, 0, m_numxMCU);
-            if(JPEG_OK != jerr)
-              return jerr;
-#ifdef __TIMING__
-            c1 = mfxGetCpuClocks();
-            m_clk_cc += c1 - c0;
-#endif
+  return JPEG_OK;
+} // CJPEGDecoder::ReconstructMCURowBL8x8()
+
+
+JERRCODE CJPEGDecoder::DecodeScanBaseline(void)
+{
+  IppStatus status;
+
+  status = mfxiDecodeHuffmanStateInit_JPEG_8u((IppiDecodeHuffmanState*)m_state.m_buffer);
+  if(ippStsNoErr != status)
+  {
+    LOG1("IPP Error: mfxiDecodeHuffmanStateInit_JPEG_8u() failed - ",status);
+    return JPEG_ERR_INTERNAL;
+  }
+
+  m_marker = JM_NONE;
+
+  // the software decoder handles interleaved scans only
+  if(m_jpeg_ncomp != m_curr_scan->ncomps)
+    return JPEG_NOT_IMPLEMENTED;
+
+  return DecodeScanBaselineIN();
+} // CJPEGDecoder::DecodeScanBaseline()
+
+
+JERRCODE CJPEGDecoder::DecodeScanBaselineIN(void)
+{
+  int16_t*  pMCUBuf;
+  uint32_t  rowMCU, colMCU, maxMCU;
+  JERRCODE  jerr;
+  IppStatus status;
+
+  rowMCU = m_mcu_decoded / m_curr_scan->numxMCU;
+  colMCU = m_mcu_decoded % m_curr_scan->numxMCU;
+
+  // decode the VLC unit MCU row by MCU row,
+  // the unit may start and stop in the middle of a row
+  for(; rowMCU < m_curr_scan->numyMCU && m_mcu_to_decode; rowMCU++)
+  {
+    maxMCU  = std::min(m_curr_scan->numxMCU, colMCU + m_mcu_to_decode);
+    pMCUBuf = m_block_buffer + colMCU * m_nblock * DCTSIZE2;
+
+    status = mfxsZero_16s(pMCUBuf, (maxMCU - colMCU) * m_nblock * DCTSIZE2);
+    if(ippStsNoErr != status)
+    {
+      LOG1("IPP Error: mfxsZero_16s() failed - ",status);
+      return JPEG_ERR_INTERNAL;
+    }
+
+    jerr = DecodeHuffmanMCURowBL(pMCUBuf, colMCU, maxMCU);
+    if(JPEG_OK != jerr)
+      return jerr;
+
+    jerr = ReconstructMCURowBL8x8(pMCUBuf, colMCU, maxMCU);
+    if(JPEG_OK != jerr)
+      return jerr;
+
+    if(JD_PIXEL == m_dst.order || JC_NV12 == m_dst.color)
+    {
+      jerr = UpSampling(rowMCU, colMCU, maxMCU);
+      if(JPEG_OK != jerr)
+        return jerr;
+
+      jerr = ColorConvert(rowMCU, colMCU, maxMCU);
+      if(JPEG_OK != jerr)
+        return jerr;
+    }
+    else
+    {
+      jerr = ProcessBuffer(rowMCU);
+      if(JPEG_OK != jerr)
+        return jerr;
+    }
+
+    m_mcu_decoded   += maxMCU - colMCU;
+    m_mcu_to_decode -= maxMCU - colMCU;
+    colMCU = 0;
+  } // for numyMCU
+
+  return JPEG_OK;
+} // CJPEGDecoder::DecodeScanBaselineIN()
+
+
+JERRCODE CJPEGDecoder::ParseData()
+{
+    JERRCODE jerr = Init();
+    if(JPEG_OK != jerr)
+    {
+      return jerr;
+    }
+
+    switch(m_jpeg_mode)
+    {
+    case JPEG_BASELINE:
+    case JPEG_EXTENDED:
+      {
+        jerr = DecodeScanBaseline();
+        if(JPEG_OK != jerr)
+          return jerr;
 
-            m_rst_go = 0;
-          } // for m_numyMCU
-        }
       }
       break;
 
+    // progressive and lossless streams are rejected before decoding
+    case JPEG_PROGRESSIVE:
+    case JPEG_LOSSLESS:
+      jerr = JPEG_NOT_IMPLEMENTED;
+      break;
+
     default:
         jerr = JPEG_ERR_INTERNAL;
         break;
@@ -1264,6 +1452,14 @@ JERRCODE CJPEGDecoder::ColorConvert(uint32_t rowMCU, uint32_t colMCU, uint32_t m
       roi.width -= m_curr_scan->xPadding;
   }
 
+  // an NV12 chroma sample covers 2x2 luma ones, so an odd last column or row
+  // is converted in pairs too. Color converted buffers hold whole MCUs.
+  if(JC_NV12 == m_dst.color)
+  {
+      roi.width  = (roi.width + 1) & ~1;
+      roi.height = (roi.height + 1) & ~1;
+  }
+
   if(roi.height == 0)
     return JPEG_OK;
 
@@ -1323,6 +1519,19 @@ JERRCODE CJPEGDecoder::ColorConvert(uint32_t rowMCU, uint32_t colMCU, uint32_t m
           rowMCU * m_curr_scan->mcuHeight * m_curr_scan->min_v_factor * dstStep[1] / (2 * m_dd_factor) + 
           colMCU * m_curr_scan->mcuWidth * m_curr_scan->min_h_factor;
 
+      if(3 == m_curr_scan->ncomps)
+      {
+          status = mfxiYCbCr420_8u_P3P2R((const Ipp8u**)pSrc8u, srcStep, pDst8u[0], dstStep[0], pDst8u[1], dstStep[1], roi);
+
+          if(ippStsNoErr != status)
+          {
+              LOG1("IPP Error: mfxiYCbCr420_8u_P3P2R() failed - ",status);
+              return JPEG_ERR_INTERNAL;
+          }
+
+          return JPEG_OK;
+      }
+
       for(int n = m_curr_scan->first_comp; n < m_curr_scan->first_comp + m_curr_scan->ncomps; n++)
       {
           if(n == 0)
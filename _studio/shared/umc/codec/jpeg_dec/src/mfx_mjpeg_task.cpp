@@ -85,6 +85,7 @@ CJpegTask::CJpegTask(void)
 {
     m_numPic = 0;
     m_numPieces = 0;
+    m_numDecodedPieces = 0;
     surface_work = NULL;
     surface_out = NULL;
     dst = NULL;
@@ -179,6 +180,7 @@ void CJpegTask::Reset(void)
 
     m_numPic = 0;
     m_numPieces = 0;
+    m_numDecodedPieces = 0;
 
 } // void CJpegTask::Reset(void)
 
@@ -909,6 +909,162 @@ Status MJPEGVideoDecoderMFX::_DecodeHeader(int32_t* cnt, const uint32_t threadNu
     return UMC_OK;
 }
 
+Status MJPEGVideoDecoderMFX::DecodePicture(const CJpegTask &task,
+                                           const mfxU32 threadNumber,
+                                           const mfxU32 callNumber)
+{
+    mfxU32   picNum, pieceNum;
+    mfxU32   restartNum, restartsToDecode;
+    JERRCODE jerr;
+
+    if (!m_IsInit)
+        return UMC_ERR_NOT_INITIALIZED;
+
+    if (threadNumber >= NumDecodersAllocated())
+        return UMC_ERR_INVALID_PARAMS;
+
+    // find the picture and the piece to decode
+    picNum = 0;
+    pieceNum = callNumber;
+    while ((picNum < task.NumPicCollected()) &&
+           (pieceNum >= task.GetPictureBuffer(picNum).numPieces))
+    {
+        pieceNum -= task.GetPictureBuffer(picNum).numPieces;
+        picNum += 1;
+    }
+
+    if (picNum >= task.NumPicCollected())
+        return UMC_ERR_FAILED;
+
+    const CJpegTaskBuffer &picBuffer = task.GetPictureBuffer(picNum);
+    CJPEGDecoder *dec = m_dec[threadNumber].get();
+
+    // VLC units of a single scan only can be decoded independently
+    if (1 != picBuffer.numScans)
+        return UMC_ERR_NOT_IMPLEMENTED;
+
+    // every decoder object reads the picture header once
+    if (&picBuffer != m_pLastPicBuffer[threadNumber])
+    {
+        mfxSize  size = {};
+        int32_t  nchannels, precision;
+        JCOLOR   color;
+        JSS      sampling;
+
+        jerr = dec->SetSource(picBuffer.pBuf, picBuffer.pieceOffset[0] + picBuffer.pieceSize[0]);
+        if (JPEG_OK != jerr)
+            return UMC_ERR_FAILED;
+
+        jerr = dec->ReadHeader(&size.width, &size.height, &nchannels, &color, &sampling, &precision);
+        if (JPEG_ERR_BUFF == jerr)
+            return UMC_ERR_NOT_ENOUGH_DATA;
+        if (JPEG_OK != jerr)
+            return UMC_ERR_FAILED;
+
+        // the frame is allocated for the first picture parameters
+        if ((m_frameSampling != (int)sampling) ||
+            (m_frameDims.width != size.width) ||
+            (m_frameDims.height != (m_interleaved ? (size.height << 1) : size.height)))
+        {
+            return UMC_ERR_INVALID_STREAM;
+        }
+
+        m_pLastPicBuffer[threadNumber] = &picBuffer;
+    }
+
+    // get the number of restart intervals in the piece
+    restartNum = (mfxU32)picBuffer.pieceRSTOffset[pieceNum];
+    restartsToDecode = 0;
+    if (dec->m_scans[0].jpeg_restart_interval)
+    {
+        mfxU32 numRestarts = (dec->m_numxMCU * dec->m_numyMCU + dec->m_scans[0].jpeg_restart_interval - 1) /
+                             dec->m_scans[0].jpeg_restart_interval;
+
+        restartsToDecode = (pieceNum + 1 < picBuffer.numPieces) ?
+                           (mfxU32)(picBuffer.pieceRSTOffset[pieceNum + 1] - restartNum) :
+                           (numRestarts - restartNum);
+    }
+
+    jerr = dec->SetSource(picBuffer.pBuf + picBuffer.pieceOffset[pieceNum], picBuffer.pieceSize[pieceNum]);
+    if (JPEG_OK != jerr)
+        return UMC_ERR_FAILED;
+
+    return DecodePiece(picBuffer.fieldPos, restartNum, restartsToDecode, threadNumber);
+
+} // Status MJPEGVideoDecoderMFX::DecodePicture(const CJpegTask &task,
+
+Status MJPEGVideoDecoderMFX::DecodePiece(const mfxU32 fieldNum,
+                                         const mfxU32 restartNum,
+                                         const mfxU32 restartsToDecode,
+                                         const mfxU32 threadNum)
+{
+    CJPEGDecoder *dec = m_dec[threadNum].get();
+    uint8_t  *pDst[4] = {};
+    int32_t  dstStep[4] = {};
+    mfxSize  dstSize;
+    JERRCODE jerr;
+
+    dstSize.width  = m_frameDims.width;
+    dstSize.height = m_interleaved ? (m_frameDims.height >> 1) : m_frameDims.height;
+
+    switch (m_internalFrame.GetColorFormat())
+    {
+    case NV12:
+        for (mfxU32 i = 0; i < 2; i += 1)
+        {
+            pDst[i]    = (uint8_t*)m_internalFrame.GetPlanePointer(i);
+            dstStep[i] = (int32_t)m_internalFrame.GetPlanePitch(i);
+
+            // fields are stored line by line
+            if (m_interleaved)
+            {
+                pDst[i]    += fieldNum * dstStep[i];
+                dstStep[i] *= 2;
+            }
+        }
+
+        jerr = dec->SetDestination(pDst, dstStep, dstSize, 2, JC_NV12, JS_420);
+        break;
+
+    case RGB32:
+        pDst[0]    = (uint8_t*)m_internalFrame.GetPlanePointer(0);
+        dstStep[0] = (int32_t)m_internalFrame.GetPlanePitch(0);
+
+        if (m_interleaved)
+        {
+            pDst[0]    += fieldNum * dstStep[0];
+            dstStep[0] *= 2;
+        }
+
+        jerr = dec->SetDestination(pDst[0], dstStep[0], dstSize, 4, JC_BGRA);
+        break;
+
+    default:
+        return UMC_ERR_UNSUPPORTED;
+    }
+
+    if (JPEG_OK != jerr)
+        return UMC_ERR_FAILED;
+
+    jerr = dec->ReadData(restartNum, restartsToDecode);
+
+    switch (jerr)
+    {
+    case JPEG_OK:
+        return UMC_OK;
+
+    case JPEG_ERR_BUFF:
+        return UMC_ERR_NOT_ENOUGH_DATA;
+
+    case JPEG_NOT_IMPLEMENTED:
+        return UMC_ERR_NOT_IMPLEMENTED;
+
+    default:
+        return UMC_ERR_FAILED;
+    }
+
+} // Status MJPEGVideoDecoderMFX::DecodePiece(const mfxU32 fieldNum,
+
 void MJPEGVideoDecoderMFX::SetFrameAllocator(FrameAllocator * frameAllocator)
 {
     assert(frameAllocator);
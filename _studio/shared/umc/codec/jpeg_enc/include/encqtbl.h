@@ -0,0 +1,56 @@
+// Copyright (c) 2025 Intel Corporation
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#ifndef __ENCQTBL_H__
+#define __ENCQTBL_H__
+
+#include "umc_defs.h"
+#if defined (MFX_ENABLE_MJPEG_VIDEO_ENCODE)
+#include "ippj.h"
+#include "jpegbase.h"
+
+class CJPEGEncoderQuantTable
+{
+private:
+  uint8_t   m_rbf[DCTSIZE2*sizeof(uint8_t)+(CPU_CACHE_LINE-1)];
+  uint8_t   m_qbf[DCTSIZE2*sizeof(uint16_t)+(CPU_CACHE_LINE-1)];
+
+public:
+  int     m_id;
+  int     m_precision;
+  int     m_initialized;
+  // raw table in zigzag order, as written into DQT
+  uint8_t*  m_raw8u;
+  // quantization table in natural order for IPP forward DCT
+  uint16_t* m_qnt16u;
+
+  CJPEGEncoderQuantTable(void);
+  virtual ~CJPEGEncoderQuantTable(void);
+
+  // quality 1..100 scales raw table the way IJG does, 0 takes it as is
+  JERRCODE Init(int id,const uint8_t raw[DCTSIZE2],int quality);
+
+  operator uint16_t*()                 { return m_qnt16u; }
+};
+
+
+#endif // MFX_ENABLE_MJPEG_VIDEO_ENCODE
+#endif // __ENCQTBL_H__
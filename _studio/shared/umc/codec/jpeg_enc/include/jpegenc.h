@@ -0,0 +1,151 @@
+// Copyright (c) 2025 Intel Corporation
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#ifndef __JPEGENC_H__
+#define __JPEGENC_H__
+
+#include "umc_defs.h"
+#if defined (MFX_ENABLE_MJPEG_VIDEO_ENCODE)
+
+#include <vector>
+#include <memory>
+
+#include "jpegbase.h"
+#include "encqtbl.h"
+#include "enchtbl.h"
+
+// Baseline sequential JPEG encoder.
+//
+// The scan is cut into pieces of whole restart intervals, pieces are
+// independent and may be encoded by different threads at the same time,
+// their entropy coded data concatenated in piece order make the scan.
+class CJPEGEncoder
+{
+public:
+
+  CJPEGEncoder(void);
+  virtual ~CJPEGEncoder(void);
+
+  // pSrc[0] is Y, packed YUY2, RGBA/BGRA or gray plane, pSrc[1] is NV12 UV plane,
+  // must follow SetParams()
+  JERRCODE SetSource(
+    const uint8_t* pSrc[2],
+    const int      srcStep[2],
+    mfxSize        srcSize,
+    JCOLOR         srcColor,
+    JSS            srcSampling);
+
+  // JC_YCBCR (JS_420 or JS_422H), JC_GRAY or JC_RGB (JS_444)
+  JERRCODE SetParams(
+    JCOLOR   jpegColor,
+    JSS      jpegSampling,
+    int      restartInterval);
+
+  JERRCODE InitQuantTable(int id, const uint8_t raw[DCTSIZE2], int quality);
+  JERRCODE InitHuffmanTable(int id, HTBL_CLASS hclass, const uint8_t* bits, const uint8_t* vals);
+  JERRCODE SetComponentTables(int comp, int qntId, int huffId);
+
+  // SOI, APP0 or APP14, application data, DQT, SOF0, DHT, DRI, SOS
+  JERRCODE WriteHeader(std::vector<uint8_t>& dst, const uint8_t* pAppData = 0, int appDataLen = 0);
+  JERRCODE WriteTrailer(std::vector<uint8_t>& dst);
+
+  int      GetNumMCU(void) const    { return m_numxMCU * m_numyMCU; }
+  int      GetNumMCURows(void) const { return m_numyMCU; }
+  int      GetNumPieces(void) const { return m_numPieces; }
+
+  // splits the scan into at most maxPieces pieces
+  JERRCODE SetNumPieces(int maxPieces);
+
+  // thread safe for different pieces
+  JERRCODE EncodePiece(int piece);
+
+  const uint8_t* GetPieceData(int piece, int* len) const;
+
+protected:
+  struct CJPEGEncoderComponent
+  {
+    int            m_id;
+    int            m_hsampling;
+    int            m_vsampling;
+    int            m_q_selector;
+    int            m_h_selector;
+
+    // source samples of the component
+    const uint8_t* m_src;
+    int            m_srcPixStep;
+    int            m_srcStep;
+    int            m_srcWidth;
+    int            m_srcHeight;
+  };
+
+  // per piece state
+  struct CJPEGEncoderPiece
+  {
+    CJPEGEncoderPiece(void);
+
+    JERRCODE Init(const CJPEGEncoder& enc);
+
+    std::vector<uint8_t> m_data;
+    int                  m_len;
+
+    CMemoryBuffer        m_state;
+    // one MCU row of every component
+    CMemoryBuffer        m_rows;
+    uint8_t*             m_row[MAX_COMPS_PER_SCAN];
+    int                  m_rowStep[MAX_COMPS_PER_SCAN];
+    int16_t              m_lastDC[MAX_COMPS_PER_SCAN];
+
+    int16_t              m_blockbf[DCTSIZE2 + CPU_CACHE_LINE/sizeof(int16_t)];
+    int16_t*             m_block;
+  };
+
+  JERRCODE ConvertMCURow(CJPEGEncoderPiece& piece, int mcuRow, int firstMCU, int lastMCU) const;
+  JERRCODE EncodeMCU(CJPEGEncoderPiece& piece, int mcuCol) const;
+
+  mfxSize  m_srcSize;
+  JCOLOR   m_srcColor;
+
+  JCOLOR   m_jpeg_color;
+  JSS      m_jpeg_sampling;
+  int      m_jpeg_ncomp;
+  int      m_jpeg_restart_interval;
+
+  int      m_max_hsampling;
+  int      m_max_vsampling;
+  int      m_mcuWidth;
+  int      m_mcuHeight;
+  int      m_numxMCU;
+  int      m_numyMCU;
+  int      m_nblock;
+
+  int      m_numPieces;
+  int      m_mcuPerPiece;
+
+  CJPEGEncoderComponent    m_ccomp[MAX_COMPS_PER_SCAN];
+  CJPEGEncoderQuantTable   m_qntbl[MAX_QUANT_TABLES];
+  CJPEGEncoderHuffmanTable m_dctbl[MAX_HUFF_TABLES];
+  CJPEGEncoderHuffmanTable m_actbl[MAX_HUFF_TABLES];
+
+  std::vector<std::unique_ptr<CJPEGEncoderPiece>> m_pieces;
+};
+
+#endif // MFX_ENABLE_MJPEG_VIDEO_ENCODE
+#endif // __JPEGENC_H__
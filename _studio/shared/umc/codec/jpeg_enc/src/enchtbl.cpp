@@ -0,0 +1,122 @@
+// Copyright (c) 2025 Intel Corporation
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#include "umc_defs.h"
+#if defined (MFX_ENABLE_MJPEG_VIDEO_ENCODE)
+
+#include "jpegbase.h"
+#include "enchtbl.h"
+
+CJPEGEncoderHuffmanTable::CJPEGEncoderHuffmanTable(void)
+{
+  m_id     = 0;
+  m_hclass = 0;
+  m_bValid = 0;
+
+  memset(m_bits, 0, sizeof(m_bits));
+  memset(m_vals, 0, sizeof(m_vals));
+
+  return;
+} // ctor
+
+
+CJPEGEncoderHuffmanTable::~CJPEGEncoderHuffmanTable(void)
+{
+  Destroy();
+  return;
+} // dtor
+
+
+JERRCODE CJPEGEncoderHuffmanTable::Create(void)
+{
+  int       size;
+  IppStatus status;
+
+  status = mfxiEncodeHuffmanSpecGetBufSize_JPEG_8u(&size);
+  if(ippStsNoErr != status)
+  {
+    LOG1("IPP Error: mfxiEncodeHuffmanSpecGetBufSize_JPEG_8u() failed - ",status);
+    return JPEG_ERR_INTERNAL;
+  }
+
+  m_table.Allocate(size);
+
+  m_bValid = 0;
+
+  return JPEG_OK;
+} // CJPEGEncoderHuffmanTable::Create()
+
+
+JERRCODE CJPEGEncoderHuffmanTable::Destroy(void)
+{
+  m_id     = 0;
+  m_hclass = 0;
+
+  memset(m_bits, 0, sizeof(m_bits));
+  memset(m_vals, 0, sizeof(m_vals));
+
+  m_table.Delete();
+
+  m_bValid = 0;
+
+  return JPEG_OK;
+} // CJPEGEncoderHuffmanTable::Destroy()
+
+
+JERRCODE CJPEGEncoderHuffmanTable::Init(int id,int hclass,const uint8_t* bits,const uint8_t* vals)
+{
+  int       i;
+  int       nvals = 0;
+  IppStatus status;
+
+  m_id     = id     & 0x0f;
+  m_hclass = hclass & 0x0f;
+
+  for(i = 0; i < 16; i++)
+    nvals += bits[i];
+
+  if(nvals > 256)
+    return JPEG_ERR_DHT_DATA;
+
+  MFX_INTERNAL_CPY(m_bits,bits,16);
+  memset(m_vals, 0, sizeof(m_vals));
+  MFX_INTERNAL_CPY(m_vals,vals,nvals);
+
+  if(!m_table.m_buffer)
+  {
+    JERRCODE jerr = Create();
+    if(JPEG_OK != jerr)
+      return jerr;
+  }
+
+  status = mfxiEncodeHuffmanSpecInit_JPEG_8u(m_bits,m_vals,(IppiEncodeHuffmanSpec*)m_table.m_buffer);
+  if(ippStsNoErr != status)
+  {
+    LOG1("IPP Error: mfxiEncodeHuffmanSpecInit_JPEG_8u() failed - ",status);
+    return JPEG_ERR_DHT_DATA;
+  }
+
+  m_bValid = 1;
+
+  return JPEG_OK;
+} // CJPEGEncoderHuffmanTable::Init()
+
+#endif // MFX_ENABLE_MJPEG_VIDEO_ENCODE
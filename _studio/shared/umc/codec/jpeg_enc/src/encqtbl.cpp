@@ -0,0 +1,97 @@
+// Copyright (c) 2025 Intel Corporation
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#include "umc_defs.h"
+#include "umc_structures.h"
+
+#if defined (MFX_ENABLE_MJPEG_VIDEO_ENCODE)
+#if defined(__GNUC__)
+#if defined(__INTEL_COMPILER)
+#pragma warning (disable:1478)
+#else
+#pragma GCC diagnostic ignored "-Wdeprecated-declarations"
+#endif
+#endif
+
+#include "ippi.h"
+#include "encqtbl.h"
+
+CJPEGEncoderQuantTable::CJPEGEncoderQuantTable(void)
+{
+  m_id          = 0;
+  m_precision   = 0;
+  m_initialized = 0;
+
+  // align for max performance
+  m_raw8u  = UMC::align_pointer<uint8_t *>(m_rbf, CPU_CACHE_LINE);
+  m_qnt16u = UMC::align_pointer<uint16_t *>(m_qbf,CPU_CACHE_LINE);
+  memset(m_rbf, 0, sizeof(m_rbf));
+  memset(m_qbf, 0, sizeof(m_qbf));
+
+  return;
+} // ctor
+
+
+CJPEGEncoderQuantTable::~CJPEGEncoderQuantTable(void)
+{
+  m_id          = 0;
+  m_precision   = 0;
+  m_initialized = 0;
+
+  memset(m_rbf, 0, sizeof(m_rbf));
+  memset(m_qbf, 0, sizeof(m_qbf));
+
+  return;
+} // dtor
+
+
+JERRCODE CJPEGEncoderQuantTable::Init(int id,const uint8_t raw[64],int quality)
+{
+  IppStatus status;
+
+  m_id        = id & 0x0f;
+  m_precision = 0; // 8-bit precision
+
+  MFX_INTERNAL_CPY(m_raw8u,raw,DCTSIZE2);
+
+  if(quality)
+  {
+    status = mfxiQuantFwdRawTableInit_JPEG_8u(m_raw8u,quality);
+    if(ippStsNoErr != status)
+    {
+      LOG1("IPP Error: mfxiQuantFwdRawTableInit_JPEG_8u() failed - ",status);
+      return JPEG_ERR_INTERNAL;
+    }
+  }
+
+  status = mfxiQuantFwdTableInit_JPEG_8u16u(m_raw8u,m_qnt16u);
+  if(ippStsNoErr != status)
+  {
+    LOG1("IPP Error: mfxiQuantFwdTableInit_JPEG_8u16u() failed - ",status);
+    return JPEG_ERR_INTERNAL;
+  }
+
+  m_initialized = 1;
+
+  return JPEG_OK;
+} // CJPEGEncoderQuantTable::Init()
+
+#endif // MFX_ENABLE_MJPEG_VIDEO_ENCODE
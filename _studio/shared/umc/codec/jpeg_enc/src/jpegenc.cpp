@@ -0,0 +1,693 @@
+// Copyright (c) 2025 Intel Corporation
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#include "umc_defs.h"
+#if defined (MFX_ENABLE_MJPEG_VIDEO_ENCODE)
+#if defined(__GNUC__)
+#if defined(__INTEL_COMPILER)
+#pragma warning (disable:1478)
+#else
+#pragma GCC diagnostic ignored "-Wdeprecated-declarations"
+#endif
+#endif
+
+#include <string.h>
+#include <algorithm>
+
+#include "umc_structures.h"
+#include "jpegbase.h"
+#include "jpegenc.h"
+
+#if defined(MSDK_USE_EXTERNAL_IPP)
+#include "ipp2mfx.h"
+#endif
+
+// worst case of one Huffman coded block with 0xFF stuffing
+const int MAX_BYTES_PER_BLOCK = DCTSIZE2 * 8;
+
+const int ENC_PIECE_BUFLEN = 64 * 1024;
+
+
+static void WriteMarker(std::vector<uint8_t>& dst, JMARKER marker)
+{
+  dst.push_back(0xff);
+  dst.push_back((uint8_t)marker);
+} // WriteMarker()
+
+
+static void WriteWord(std::vector<uint8_t>& dst, int word)
+{
+  dst.push_back((uint8_t)(word >> 8));
+  dst.push_back((uint8_t)(word & 0xff));
+} // WriteWord()
+
+
+CJPEGEncoder::CJPEGEncoderPiece::CJPEGEncoderPiece(void)
+{
+  m_len   = 0;
+  m_block = UMC::align_pointer<int16_t*>(m_blockbf, CPU_CACHE_LINE);
+
+  memset(m_row, 0, sizeof(m_row));
+  memset(m_rowStep, 0, sizeof(m_rowStep));
+  memset(m_lastDC, 0, sizeof(m_lastDC));
+
+  return;
+} // ctor
+
+
+JERRCODE CJPEGEncoder::CJPEGEncoderPiece::Init(const CJPEGEncoder& enc)
+{
+  int       i;
+  int       size = 0;
+  IppStatus status;
+
+  if(!m_state.m_buffer)
+  {
+    status = mfxiEncodeHuffmanStateGetBufSize_JPEG_8u(&size);
+    if(ippStsNoErr != status)
+    {
+      LOG1("IPP Error: mfxiEncodeHuffmanStateGetBufSize_JPEG_8u() failed - ",status);
+      return JPEG_ERR_INTERNAL;
+    }
+
+    m_state.Allocate(size);
+  }
+
+  size = 0;
+  for(i = 0; i < enc.m_jpeg_ncomp; i++)
+  {
+    const CJPEGEncoderComponent& comp = enc.m_ccomp[i];
+
+    m_rowStep[i] = enc.m_numxMCU * comp.m_hsampling * DCTSIZE;
+    size += m_rowStep[i] * comp.m_vsampling * DCTSIZE + CPU_CACHE_LINE;
+  }
+
+  if(m_rows.m_buffer_size < size)
+    m_rows.Allocate(size);
+
+  uint8_t* ptr = m_rows.m_buffer;
+  for(i = 0; i < enc.m_jpeg_ncomp; i++)
+  {
+    m_row[i] = UMC::align_pointer<uint8_t*>(ptr, CPU_CACHE_LINE);
+    ptr = m_row[i] + m_rowStep[i] * enc.m_ccomp[i].m_vsampling * DCTSIZE;
+  }
+
+  if(m_data.empty())
+    m_data.resize(ENC_PIECE_BUFLEN);
+
+  m_len = 0;
+
+  return JPEG_OK;
+} // CJPEGEncoder::CJPEGEncoderPiece::Init()
+
+
+CJPEGEncoder::CJPEGEncoder(void)
+{
+  m_srcSize.width  = 0;
+  m_srcSize.height = 0;
+  m_srcColor       = JC_UNKNOWN;
+
+  m_jpeg_color            = JC_UNKNOWN;
+  m_jpeg_sampling         = JS_444;
+  m_jpeg_ncomp            = 0;
+  m_jpeg_restart_interval = 0;
+
+  m_max_hsampling = 1;
+  m_max_vsampling = 1;
+  m_mcuWidth      = DCTSIZE;
+  m_mcuHeight     = DCTSIZE;
+  m_numxMCU       = 0;
+  m_numyMCU       = 0;
+  m_nblock        = 0;
+
+  m_numPieces   = 0;
+  m_mcuPerPiece = 0;
+
+  memset(m_ccomp, 0, sizeof(m_ccomp));
+
+  return;
+} // ctor
+
+
+CJPEGEncoder::~CJPEGEncoder(void)
+{
+  return;
+} // dtor
+
+
+JERRCODE CJPEGEncoder::SetSource(
+  const uint8_t* pSrc[2],
+  const int      srcStep[2],
+  mfxSize        srcSize,
+  JCOLOR         srcColor,
+  JSS            srcSampling)
+{
+  int i;
+
+  if(0 == pSrc[0] || srcSize.width <= 0 || srcSize.height <= 0)
+    return JPEG_ERR_PARAMS;
+
+  if(srcSize.width > 0xffff || srcSize.height > 0xffff)
+    return JPEG_ERR_PARAMS;
+
+  // component samples in JPEG order
+  const uint8_t* ptr[MAX_COMPS_PER_SCAN] = { pSrc[0], pSrc[0], pSrc[0], 0 };
+  int pixStep[MAX_COMPS_PER_SCAN] = { 1, 1, 1, 0 };
+  int ncomp;
+
+  switch(srcColor)
+  {
+  case JC_GRAY:
+    ncomp = 1;
+    break;
+
+  case JC_NV12:
+    if(0 == pSrc[1])
+      return JPEG_ERR_PARAMS;
+    ncomp = (JC_GRAY == m_jpeg_color) ? 1 : 3;
+    ptr[1] = pSrc[1];     pixStep[1] = 2;
+    ptr[2] = pSrc[1] + 1; pixStep[2] = 2;
+    break;
+
+  case JC_YCBCR:
+    // packed YUY2
+    if(JS_422H != srcSampling)
+      return JPEG_NOT_IMPLEMENTED;
+    ncomp = 3;
+    ptr[1] = pSrc[0] + 1; pixStep[1] = 4;
+    ptr[2] = pSrc[0] + 3; pixStep[2] = 4;
+    pixStep[0] = 2;
+    break;
+
+  case JC_BGRA:
+    ncomp = 3;
+    ptr[0] = pSrc[0] + 2; pixStep[0] = 4;
+    ptr[1] = pSrc[0] + 1; pixStep[1] = 4;
+    ptr[2] = pSrc[0] + 0; pixStep[2] = 4;
+    break;
+
+  case JC_RGBA:
+    ncomp = 3;
+    ptr[0] = pSrc[0] + 0; pixStep[0] = 4;
+    ptr[1] = pSrc[0] + 1; pixStep[1] = 4;
+    ptr[2] = pSrc[0] + 2; pixStep[2] = 4;
+    break;
+
+  default:
+    return JPEG_NOT_IMPLEMENTED;
+  }
+
+  if(ncomp != m_jpeg_ncomp)
+    return JPEG_ERR_PARAMS;
+
+  for(i = 0; i < ncomp; i++)
+  {
+    CJPEGEncoderComponent& comp = m_ccomp[i];
+
+    comp.m_src        = ptr[i];
+    comp.m_srcPixStep = pixStep[i];
+    comp.m_srcStep    = (JC_NV12 == srcColor && i) ? srcStep[1] : srcStep[0];
+    comp.m_srcWidth   = (srcSize.width  * comp.m_hsampling + m_max_hsampling - 1) / m_max_hsampling;
+    comp.m_srcHeight  = (srcSize.height * comp.m_vsampling + m_max_vsampling - 1) / m_max_vsampling;
+  }
+
+  m_srcSize  = srcSize;
+  m_srcColor = srcColor;
+
+  m_numxMCU = (m_srcSize.width  + m_mcuWidth  - 1) / m_mcuWidth;
+  m_numyMCU = (m_srcSize.height + m_mcuHeight - 1) / m_mcuHeight;
+
+  return JPEG_OK;
+} // CJPEGEncoder::SetSource()
+
+
+JERRCODE CJPEGEncoder::SetParams(
+  JCOLOR   jpegColor,
+  JSS      jpegSampling,
+  int      restartInterval)
+{
+  int i;
+
+  if(restartInterval < 0 || restartInterval > 0xffff)
+    return JPEG_ERR_PARAMS;
+
+  switch(jpegColor)
+  {
+  case JC_GRAY:
+    m_jpeg_ncomp    = 1;
+    m_jpeg_sampling = JS_444;
+    m_ccomp[0].m_hsampling = 1;
+    m_ccomp[0].m_vsampling = 1;
+    break;
+
+  case JC_RGB:
+    if(JS_444 != jpegSampling)
+      return JPEG_NOT_IMPLEMENTED;
+    m_jpeg_ncomp    = 3;
+    m_jpeg_sampling = JS_444;
+    for(i = 0; i < 3; i++)
+    {
+      m_ccomp[i].m_hsampling = 1;
+      m_ccomp[i].m_vsampling = 1;
+    }
+    break;
+
+  case JC_YCBCR:
+    if(JS_420 != jpegSampling && JS_422H != jpegSampling)
+      return JPEG_NOT_IMPLEMENTED;
+    m_jpeg_ncomp    = 3;
+    m_jpeg_sampling = jpegSampling;
+    m_ccomp[0].m_hsampling = 2;
+    m_ccomp[0].m_vsampling = (JS_420 == jpegSampling) ? 2 : 1;
+    for(i = 1; i < 3; i++)
+    {
+      m_ccomp[i].m_hsampling = 1;
+      m_ccomp[i].m_vsampling = 1;
+    }
+    break;
+
+  default:
+    return JPEG_NOT_IMPLEMENTED;
+  }
+
+  m_jpeg_color            = jpegColor;
+  m_jpeg_restart_interval = restartInterval;
+
+  m_max_hsampling = 1;
+  m_max_vsampling = 1;
+  m_nblock        = 0;
+
+  for(i = 0; i < m_jpeg_ncomp; i++)
+  {
+    m_ccomp[i].m_id = i + 1;
+    m_max_hsampling = std::max(m_max_hsampling, m_ccomp[i].m_hsampling);
+    m_max_vsampling = std::max(m_max_vsampling, m_ccomp[i].m_vsampling);
+    m_nblock       += m_ccomp[i].m_hsampling * m_ccomp[i].m_vsampling;
+  }
+
+  m_mcuWidth  = m_max_hsampling * DCTSIZE;
+  m_mcuHeight = m_max_vsampling * DCTSIZE;
+
+  return JPEG_OK;
+} // CJPEGEncoder::SetParams()
+
+
+JERRCODE CJPEGEncoder::InitQuantTable(int id, const uint8_t raw[DCTSIZE2], int quality)
+{
+  if(id < 0 || id >= MAX_QUANT_TABLES)
+    return JPEG_ERR_PARAMS;
+
+  return m_qntbl[id].Init(id, raw, quality);
+} // CJPEGEncoder::InitQuantTable()
+
+
+JERRCODE CJPEGEncoder::InitHuffmanTable(int id, HTBL_CLASS hclass, const uint8_t* bits, const uint8_t* vals)
+{
+  if(id < 0 || id >= MAX_HUFF_TABLES)
+    return JPEG_ERR_PARAMS;
+
+  if(DC == hclass)
+    return m_dctbl[id].Init(id, hclass, bits, vals);
+
+  return m_actbl[id].Init(id, hclass, bits, vals);
+} // CJPEGEncoder::InitHuffmanTable()
+
+
+JERRCODE CJPEGEncoder::SetComponentTables(int comp, int qntId, int huffId)
+{
+  if(comp < 0 || comp >= MAX_COMPS_PER_SCAN)
+    return JPEG_ERR_PARAMS;
+
+  if(qntId < 0 || qntId >= MAX_QUANT_TABLES || huffId < 0 || huffId >= MAX_HUFF_TABLES)
+    return JPEG_ERR_PARAMS;
+
+  m_ccomp[comp].m_q_selector = qntId;
+  m_ccomp[comp].m_h_selector = huffId;
+
+  return JPEG_OK;
+} // CJPEGEncoder::SetComponentTables()
+
+
+JERRCODE CJPEGEncoder::WriteHeader(std::vector<uint8_t>& dst, const uint8_t* pAppData, int appDataLen)
+{
+  int  i, j;
+  bool qused[MAX_QUANT_TABLES] = {};
+  bool hused[MAX_HUFF_TABLES]  = {};
+
+  for(i = 0; i < m_jpeg_ncomp; i++)
+  {
+    if(!m_qntbl[m_ccomp[i].m_q_selector].m_initialized)
+      return JPEG_ERR_DQT_DATA;
+
+    if(!m_dctbl[m_ccomp[i].m_h_selector].IsValid() || !m_actbl[m_ccomp[i].m_h_selector].IsValid())
+      return JPEG_ERR_DHT_DATA;
+
+    qused[m_ccomp[i].m_q_selector] = true;
+    hused[m_ccomp[i].m_h_selector] = true;
+  }
+
+  WriteMarker(dst, JM_SOI);
+
+  if(JC_RGB == m_jpeg_color)
+  {
+    static const uint8_t adobe[] = { 'A', 'd', 'o', 'b', 'e', 0, 100, 0, 0, 0, 0, 0 /* transform */ };
+
+    WriteMarker(dst, JM_APP14);
+    WriteWord(dst, 2 + sizeof(adobe));
+    dst.insert(dst.end(), adobe, adobe + sizeof(adobe));
+  }
+  else
+  {
+    static const uint8_t jfif[] = { 'J', 'F', 'I', 'F', 0, 1, 2, JRU_NONE, 0, 1, 0, 1, 0, 0 };
+
+    WriteMarker(dst, JM_APP0);
+    WriteWord(dst, 2 + sizeof(jfif));
+    dst.insert(dst.end(), jfif, jfif + sizeof(jfif));
+  }
+
+  if(pAppData && appDataLen > 0)
+    dst.insert(dst.end(), pAppData, pAppData + appDataLen);
+
+  for(i = 0; i < MAX_QUANT_TABLES; i++)
+  {
+    if(!qused[i])
+      continue;
+
+    WriteMarker(dst, JM_DQT);
+    WriteWord(dst, 2 + 1 + DCTSIZE2);
+    dst.push_back((uint8_t)((m_qntbl[i].m_precision << 4) | i));
+    dst.insert(dst.end(), m_qntbl[i].m_raw8u, m_qntbl[i].m_raw8u + DCTSIZE2);
+  }
+
+  WriteMarker(dst, JM_SOF0);
+  WriteWord(dst, 8 + 3 * m_jpeg_ncomp);
+  dst.push_back(8);
+  WriteWord(dst, m_srcSize.height);
+  WriteWord(dst, m_srcSize.width);
+  dst.push_back((uint8_t)m_jpeg_ncomp);
+  for(i = 0; i < m_jpeg_ncomp; i++)
+  {
+    dst.push_back((uint8_t)m_ccomp[i].m_id);
+    dst.push_back((uint8_t)((m_ccomp[i].m_hsampling << 4) | m_ccomp[i].m_vsampling));
+    dst.push_back((uint8_t)m_ccomp[i].m_q_selector);
+  }
+
+  for(i = 0; i < MAX_HUFF_TABLES; i++)
+  {
+    if(!hused[i])
+      continue;
+
+    for(j = 0; j < 2; j++)
+    {
+      const CJPEGEncoderHuffmanTable& tbl = j ? m_actbl[i] : m_dctbl[i];
+      int nvals = 0;
+
+      for(int k = 0; k < 16; k++)
+        nvals += tbl.GetBits()[k];
+
+      WriteMarker(dst, JM_DHT);
+      WriteWord(dst, 2 + 1 + 16 + nvals);
+      dst.push_back((uint8_t)((j << 4) | i));
+      dst.insert(dst.end(), tbl.GetBits(), tbl.GetBits() + 16);
+      dst.insert(dst.end(), tbl.GetValues(), tbl.GetValues() + nvals);
+    }
+  }
+
+  if(m_jpeg_restart_interval)
+  {
+    WriteMarker(dst, JM_DRI);
+    WriteWord(dst, 4);
+    WriteWord(dst, m_jpeg_restart_interval);
+  }
+
+  WriteMarker(dst, JM_SOS);
+  WriteWord(dst, 6 + 2 * m_jpeg_ncomp);
+  dst.push_back((uint8_t)m_jpeg_ncomp);
+  for(i = 0; i < m_jpeg_ncomp; i++)
+  {
+    dst.push_back((uint8_t)m_ccomp[i].m_id);
+    dst.push_back((uint8_t)((m_ccomp[i].m_h_selector << 4) | m_ccomp[i].m_h_selector));
+  }
+  dst.push_back(0);           // Ss
+  dst.push_back(DCTSIZE2 - 1); // Se
+  dst.push_back(0);           // Ah, Al
+
+  return JPEG_OK;
+} // CJPEGEncoder::WriteHeader()
+
+
+JERRCODE CJPEGEncoder::WriteTrailer(std::vector<uint8_t>& dst)
+{
+  WriteMarker(dst, JM_EOI);
+
+  return JPEG_OK;
+} // CJPEGEncoder::WriteTrailer()
+
+
+JERRCODE CJPEGEncoder::SetNumPieces(int maxPieces)
+{
+  int i;
+  int numMCU = GetNumMCU();
+
+  if(0 == numMCU)
+    return JPEG_ERR_PARAMS;
+
+  // pieces have to start at restart interval boundary
+  int interval     = m_jpeg_restart_interval ? m_jpeg_restart_interval : numMCU;
+  int numIntervals = (numMCU + interval - 1) / interval;
+
+  m_numPieces = std::max(1, std::min(maxPieces, numIntervals));
+
+  m_mcuPerPiece = ((numIntervals + m_numPieces - 1) / m_numPieces) * interval;
+  m_numPieces   = (numMCU + m_mcuPerPiece - 1) / m_mcuPerPiece;
+
+  if((int)m_pieces.size() < m_numPieces)
+    m_pieces.resize(m_numPieces);
+
+  for(i = 0; i < m_numPieces; i++)
+  {
+    if(!m_pieces[i])
+      m_pieces[i].reset(new CJPEGEncoderPiece);
+
+    JERRCODE jerr = m_pieces[i]->Init(*this);
+    if(JPEG_OK != jerr)
+      return jerr;
+  }
+
+  return JPEG_OK;
+} // CJPEGEncoder::SetNumPieces()
+
+
+const uint8_t* CJPEGEncoder::GetPieceData(int piece, int* len) const
+{
+  if(piece < 0 || piece >= m_numPieces)
+  {
+    *len = 0;
+    return 0;
+  }
+
+  *len = m_pieces[piece]->m_len;
+
+  return m_pieces[piece]->m_data.data();
+} // CJPEGEncoder::GetPieceData()
+
+
+JERRCODE CJPEGEncoder::ConvertMCURow(CJPEGEncoderPiece& piece, int mcuRow, int firstMCU, int lastMCU) const
+{
+  int c, r, i;
+
+  for(c = 0; c < m_jpeg_ncomp; c++)
+  {
+    const CJPEGEncoderComponent& comp = m_ccomp[c];
+
+    int      ncols   = (lastMCU - firstMCU) * comp.m_hsampling * DCTSIZE;
+    int      nrows   = comp.m_vsampling * DCTSIZE;
+    int      sx      = firstMCU * comp.m_hsampling * DCTSIZE;
+    int      sy      = mcuRow * nrows;
+    int      valid   = std::min(ncols, comp.m_srcWidth - sx);
+    int      pixStep = comp.m_srcPixStep;
+    int      dstStep = piece.m_rowStep[c];
+    uint8_t* dst     = piece.m_row[c] + sx;
+
+    for(r = 0; r < nrows; r++, dst += dstStep)
+    {
+      // replicate the last line below the image
+      const uint8_t* src = comp.m_src + (size_t)std::min(sy + r, comp.m_srcHeight - 1) * comp.m_srcStep + (size_t)sx * pixStep;
+
+      if(1 == pixStep)
+      {
+        MFX_INTERNAL_CPY(dst, src, valid);
+      }
+      else if(2 == pixStep)
+      {
+        for(i = 0; i < valid; i++)
+          dst[i] = src[2 * i];
+      }
+      else
+      {
+        for(i = 0; i < valid; i++)
+          dst[i] = src[pixStep * i];
+      }
+
+      // and the last column on the right of it
+      if(valid < ncols)
+        memset(dst + valid, dst[valid - 1], ncols - valid);
+    }
+  }
+
+  return JPEG_OK;
+} // CJPEGEncoder::ConvertMCURow()
+
+
+JERRCODE CJPEGEncoder::EncodeMCU(CJPEGEncoderPiece& piece, int mcuCol) const
+{
+  int       c, h, v;
+  IppStatus status;
+
+  IppiEncodeHuffmanState* pState = (IppiEncodeHuffmanState*)piece.m_state.m_buffer;
+
+  for(c = 0; c < m_jpeg_ncomp; c++)
+  {
+    const CJPEGEncoderComponent& comp = m_ccomp[c];
+
+    CJPEGEncoderQuantTable&   qtbl  = const_cast<CJPEGEncoderQuantTable&>(m_qntbl[comp.m_q_selector]);
+    CJPEGEncoderHuffmanTable& dctbl = const_cast<CJPEGEncoderHuffmanTable&>(m_dctbl[comp.m_h_selector]);
+    CJPEGEncoderHuffmanTable& actbl = const_cast<CJPEGEncoderHuffmanTable&>(m_actbl[comp.m_h_selector]);
+
+    int      step = piece.m_rowStep[c];
+    uint8_t* src  = piece.m_row[c] + mcuCol * comp.m_hsampling * DCTSIZE;
+
+    for(v = 0; v < comp.m_vsampling; v++)
+    {
+      for(h = 0; h < comp.m_hsampling; h++)
+      {
+        status = mfxiDCTQuantFwd8x8LS_JPEG_8u16s_C1R(src + v * DCTSIZE * step + h * DCTSIZE, step, piece.m_block, qtbl);
+        if(ippStsNoErr != status)
+        {
+          LOG1("IPP Error: mfxiDCTQuantFwd8x8LS_JPEG_8u16s_C1R() failed - ",status);
+          return JPEG_ERR_INTERNAL;
+        }
+
+        status = mfxiEncodeHuffman8x8_JPEG_16s1u_C1(
+                   piece.m_block,
+                   piece.m_data.data(),
+                   (int)piece.m_data.size(),
+                   &piece.m_len,
+                   &piece.m_lastDC[c],
+                   dctbl,
+                   actbl,
+                   pState,
+                   0);
+        if(ippStsNoErr > status)
+        {
+          LOG1("IPP Error: mfxiEncodeHuffman8x8_JPEG_16s1u_C1() failed - ",status);
+          return JPEG_ERR_INTERNAL;
+        }
+      }
+    }
+  }
+
+  return JPEG_OK;
+} // CJPEGEncoder::EncodeMCU()
+
+
+JERRCODE CJPEGEncoder::EncodePiece(int piece)
+{
+  int       c;
+  int       mcu;
+  JERRCODE  jerr;
+  IppStatus status;
+
+  if(piece < 0 || piece >= m_numPieces)
+    return JPEG_ERR_PARAMS;
+
+  CJPEGEncoderPiece& ctx = *m_pieces[piece];
+  IppiEncodeHuffmanState* pState = (IppiEncodeHuffmanState*)ctx.m_state.m_buffer;
+
+  int numMCU   = GetNumMCU();
+  int firstMCU = piece * m_mcuPerPiece;
+  int lastMCU  = std::min(numMCU, firstMCU + m_mcuPerPiece);
+  int needed   = m_nblock * MAX_BYTES_PER_BLOCK + SAFE_NBYTES;
+
+  ctx.m_len = 0;
+
+  status = mfxiEncodeHuffmanStateInit_JPEG_8u(pState);
+  if(ippStsNoErr != status)
+  {
+    LOG1("IPP Error: mfxiEncodeHuffmanStateInit_JPEG_8u() failed - ",status);
+    return JPEG_ERR_INTERNAL;
+  }
+
+  for(mcu = firstMCU; mcu < lastMCU; )
+  {
+    int mcuRow = mcu / m_numxMCU;
+    int mcuCol = mcu % m_numxMCU;
+    int rowEnd = std::min(lastMCU - mcu + mcuCol, m_numxMCU);
+
+    jerr = ConvertMCURow(ctx, mcuRow, mcuCol, rowEnd);
+    if(JPEG_OK != jerr)
+      return jerr;
+
+    for( ; mcuCol < rowEnd; mcuCol++, mcu++)
+    {
+      if(m_jpeg_restart_interval ? (0 == mcu % m_jpeg_restart_interval) : (mcu == firstMCU))
+      {
+        for(c = 0; c < m_jpeg_ncomp; c++)
+          ctx.m_lastDC[c] = 0;
+      }
+
+      if((int)ctx.m_data.size() - ctx.m_len < needed)
+        ctx.m_data.resize(std::max(2 * ctx.m_data.size(), (size_t)(ctx.m_len + needed)));
+
+      jerr = EncodeMCU(ctx, mcuCol);
+      if(JPEG_OK != jerr)
+        return jerr;
+
+      // the last MCU of restart interval, except the last one in the scan
+      if(m_jpeg_restart_interval && 0 == (mcu + 1) % m_jpeg_restart_interval && mcu + 1 < numMCU)
+      {
+        status = mfxiEncodeHuffman8x8_JPEG_16s1u_C1(0, ctx.m_data.data(), (int)ctx.m_data.size(), &ctx.m_len, 0, 0, 0, pState, 1);
+        if(ippStsNoErr > status)
+        {
+          LOG1("IPP Error: mfxiEncodeHuffman8x8_JPEG_16s1u_C1() failed - ",status);
+          return JPEG_ERR_INTERNAL;
+        }
+
+        ctx.m_data[ctx.m_len++] = 0xff;
+        ctx.m_data[ctx.m_len++] = (uint8_t)(JM_RST0 + (((mcu + 1) / m_jpeg_restart_interval - 1) & 7));
+      }
+    }
+  }
+
+  if(lastMCU == numMCU)
+  {
+    status = mfxiEncodeHuffman8x8_JPEG_16s1u_C1(0, ctx.m_data.data(), (int)ctx.m_data.size(), &ctx.m_len, 0, 0, 0, pState, 1);
+    if(ippStsNoErr > status)
+    {
+      LOG1("IPP Error: mfxiEncodeHuffman8x8_JPEG_16s1u_C1() failed - ",status);
+      return JPEG_ERR_INTERNAL;
+    }
+  }
+
+  return JPEG_OK;
+} // CJPEGEncoder::EncodePiece()
+
+#endif // MFX_ENABLE_MJPEG_VIDEO_ENCODE
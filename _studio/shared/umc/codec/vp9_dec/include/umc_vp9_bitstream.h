@@ -22,6 +22,8 @@
 
 #include "umc_vp9_dec_defs.h"
 
+#include <cstring>
+
 #if defined(UMC_ENABLE_VP9_AV1_DECODE)
 
 #ifndef __UMC_VP9_BITSTREAM_H_
@@ -49,14 +51,14 @@ namespace UMC_VP9_DECODER
         size_t BytesDecoded() const
         {
             return
-                static_cast<size_t>(m_pbs - m_pbsBase) + (m_bitOffset / 8); 
+                BitsDecoded() / 8;
         }
 
         // Returns number of decoded bits since last reset
         size_t BitsDecoded() const
         {
             return
-                static_cast<size_t>(m_pbs - m_pbsBase) * 8 + m_bitOffset;
+                static_cast<size_t>(m_pbs - m_pbsBase) * 8 - m_cacheBits;
         }
 
         // Returns number of bytes left in bitstream array
@@ -71,29 +73,84 @@ namespace UMC_VP9_DECODER
 
         uint32_t GetBit()
         {
-            if (m_pbs >= m_pbsBase + m_maxBsSize)
-                throw vp9_exception(UMC::UMC_ERR_NOT_ENOUGH_DATA);
-
-            uint32_t const bit = (*m_pbs >> (7 - m_bitOffset)) & 1;
-            if (++m_bitOffset == 8)
+            if (!m_cacheBits)
             {
-                ++m_pbs;
-                m_bitOffset = 0;
+                Refill();
+                if (!m_cacheBits)
+                    throw vp9_exception(UMC::UMC_ERR_NOT_ENOUGH_DATA);
             }
-            
+
+            uint32_t const bit = static_cast<uint32_t>(m_cache >> 63);
+            m_cache <<= 1;
+            --m_cacheBits;
+
             return bit;
         }
 
-        uint32_t GetBits(uint32_t nbits);
+        uint32_t GetBits(uint32_t nbits)
+        {
+            if (nbits > 32)
+            {
+                // only the last 32 bits fit the result
+                SkipBits(nbits - 32);
+                nbits = 32;
+            }
+
+            if (!nbits)
+                return 0;
+
+            if (m_cacheBits < nbits)
+            {
+                Refill();
+                if (m_cacheBits < nbits)
+                    throw vp9_exception(UMC::UMC_ERR_NOT_ENOUGH_DATA);
+            }
+
+            uint32_t const bits = static_cast<uint32_t>(m_cache >> (64 - nbits));
+            m_cache <<= nbits;
+            m_cacheBits -= nbits;
+
+            return bits;
+        }
+
+        // Reads zero bits up to and including the first one bit, returns number of zeros
+        uint32_t GetLeadingZeros();
+
         uint32_t GetUe();
         int32_t GetSe();
 
     protected:
 
-        uint8_t* m_pbs;                                              // pointer to the current position of the buffer.
-        int32_t m_bitOffset;                                        // the bit position (0 to 31) in the dword pointed by m_pbs.
+        // Loads whole bytes into the cache until it holds at least 56 bits or data is over
+        void Refill()
+        {
+            if (m_pbsEnd - m_pbs >= 8)
+            {
+                uint64_t word;
+                std::memcpy(&word, m_pbs, sizeof(word));
+                // bits of a partially loaded byte are the same as the ones already in the cache,
+                // so it is safe to OR them again on the next refill
+                m_cache |= __builtin_bswap64(word) >> m_cacheBits;
+                m_pbs += (63 - m_cacheBits) >> 3;
+                m_cacheBits |= 56;
+            }
+            else
+            {
+                for (; m_cacheBits < 56 && m_pbs < m_pbsEnd; m_cacheBits += 8)
+                    m_cache |= uint64_t(*m_pbs++) << (56 - m_cacheBits);
+            }
+        }
+
+        void SkipBits(uint32_t nbits);
+        // Advances byte aligned position, caller is responsible for the bounds
+        void SkipBytes(size_t nbytes);
+
+        uint8_t* m_pbs;                                              // pointer to the next byte to be loaded into the cache.
         uint8_t* m_pbsBase;                                          // pointer to the first byte of the buffer.
+        uint8_t* m_pbsEnd;                                           // pointer past the last byte of the buffer.
         uint32_t m_maxBsSize;                                        // maximum buffer size in bytes. 
+        uint64_t m_cache;                                            // not yet consumed bits, MSB first.
+        uint32_t m_cacheBits;                                        // number of valid bits in m_cache (0 to 63).
     };
 
     inline
@@ -25,6 +25,8 @@
 #include "umc_vp9_bitstream.h"
 #include "umc_vp9_frame.h"
 
+#include <cassert>
+
 namespace UMC_VP9_DECODER
 {
 
@@ -49,9 +51,13 @@ void VP9Bitstream::Reset(uint8_t * const pb, int32_t offset, const uint32_t maxs
 {
     m_pbs       = pb;
     m_pbsBase   = pb;
-    m_bitOffset = offset;
+    m_pbsEnd    = pb + maxsize;
     m_maxBsSize = maxsize;
+    m_cache     = 0;
+    m_cacheBits = 0;
 
+    if (offset > 0)
+        SkipBits(offset);
 }
 
 // Return bitstream array base address and size
@@ -61,23 +67,76 @@ void VP9Bitstream::GetOrg(uint8_t **pbs, uint32_t *size)
     *size      = m_maxBsSize; 
 }
 
-uint32_t VP9Bitstream::GetBits(uint32_t nbits)
+void VP9Bitstream::SkipBits(uint32_t nbits)
 {
-    mfxU32 bits = 0;
-    for (; nbits > 0; --nbits)
+    if (nbits <= m_cacheBits)
+    {
+        // m_cacheBits < 64, so the shift is defined
+        m_cache <<= nbits;
+        m_cacheBits -= nbits;
+        return;
+    }
+
+    size_t const pos = BitsDecoded() + nbits;
+    if (pos > size_t(m_maxBsSize) * 8)
+        throw vp9_exception(UMC::UMC_ERR_NOT_ENOUGH_DATA);
+
+    m_pbs       = m_pbsBase + pos / 8;
+    m_cache     = 0;
+    m_cacheBits = 0;
+
+    uint32_t const bitOffset = pos % 8;
+    if (bitOffset)
     {
-        bits <<= 1;
-        bits |= GetBit();
+        Refill();
+        m_cache <<= bitOffset;
+        m_cacheBits -= bitOffset;
     }
+}
+
+void VP9Bitstream::SkipBytes(size_t nbytes)
+{
+    assert(!(m_cacheBits % 8));
 
-    return bits;
+    m_pbs       = m_pbsBase + BytesDecoded() + nbytes;
+    m_cache     = 0;
+    m_cacheBits = 0;
 }
 
-uint32_t VP9Bitstream::GetUe()
+uint32_t VP9Bitstream::GetLeadingZeros()
 {
     uint32_t zeroes = 0;
-    while (GetBit() == 0)
-        ++zeroes;
+    for (;;)
+    {
+        if (!m_cacheBits)
+        {
+            Refill();
+            if (!m_cacheBits)
+                throw vp9_exception(UMC::UMC_ERR_NOT_ENOUGH_DATA);
+        }
+
+        // bits behind m_cacheBits are either zero or real stream data not counted yet
+        uint32_t const count = m_cache ?
+            static_cast<uint32_t>(__builtin_clzll(m_cache)) : 64;
+        if (count < m_cacheBits)
+        {
+            zeroes += count;
+            // drop the zeros together with the terminating one bit
+            m_cache <<= count;
+            m_cache <<= 1;
+            m_cacheBits -= count + 1;
+            return zeroes;
+        }
+
+        zeroes += m_cacheBits;
+        m_cache = 0;
+        m_cacheBits = 0;
+    }
+}
+
+uint32_t VP9Bitstream::GetUe()
+{
+    uint32_t const zeroes = GetLeadingZeros();
 
     return zeroes == 0 ?
         0 : ((1 << zeroes) | GetBits(zeroes)) - 1; 
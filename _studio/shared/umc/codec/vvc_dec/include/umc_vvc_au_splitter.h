@@ -104,120 +104,5 @@ namespace UMC_VVC_DECODER
         StartCodeSearcher     m_iCodeSearcher;    // NAL unit start code searcher
     };
 
-    // Utility class for writing 32-bit little endian integers
-    class VVCDstDwordPointer
-    {
-    public:
-        VVCDstDwordPointer(void)
-        {
-            m_pDest = NULL;
-            m_iCur = 0;
-            m_nByteNum = 0;
-        }
-
-        VVCDstDwordPointer operator = (void *pDest)
-        {
-            m_pDest = (uint32_t *) pDest;
-            m_nByteNum = 0;
-            m_iCur = 0;
-
-            return *this;
-        }
-
-        VVCDstDwordPointer &operator ++ (void)
-        {
-            if (4 == ++m_nByteNum)
-            {
-                *m_pDest = m_iCur;
-                m_pDest += 1;
-                m_nByteNum = 0;
-                m_iCur = 0;
-            }
-            else
-            {
-                m_iCur <<= 8;
-            }
-
-            return *this;
-        }
-
-        uint8_t operator = (uint8_t nByte)
-        {
-            m_iCur = (m_iCur & ~0x0ff) | ((uint32_t) nByte);
-            return nByte;
-        }
-
-    protected:
-        uint32_t *m_pDest;                              // pointer to destination buffer
-        uint32_t m_nByteNum;                            // number of current byte in dword
-        uint32_t m_iCur;                                // current dword
-    };
-
-    // Utility class for reading big endian bitstream
-    class VVCSourcePointer
-    {
-    public:
-        VVCSourcePointer(void)
-        {
-            m_nZeros = 0;
-            m_pSource = NULL;
-            m_nRemovedBytes = 0;
-        }
-
-        VVCSourcePointer &operator = (void *pSource)
-        {
-            m_pSource = (uint8_t *) pSource;
-            m_nZeros = 0;
-            m_nRemovedBytes = 0;
-
-            return *this;
-        }
-
-        VVCSourcePointer &operator ++ (void)
-        {
-            uint8_t bCurByte = m_pSource[0];
-
-            if (0 == bCurByte)
-            {
-                m_nZeros += 1;
-            }
-            else
-            {
-                if ((3 == bCurByte) && (2 <= m_nZeros))
-                {
-                    m_nRemovedBytes += 1;
-                }
-                m_nZeros = 0;
-            }
-
-            m_pSource += 1;
-
-            return *this;
-        }
-
-        bool IsPrevent(void)
-        {
-            if ((3 == m_pSource[0]) && (2 <= m_nZeros))
-                return true;
-            else
-                return false;
-        }
-
-        operator uint8_t (void)
-        {
-            return m_pSource[0];
-        }
-
-        uint32_t GetRemovedBytes(void)
-        {
-            return m_nRemovedBytes;
-        }
-
-    protected:
-        uint8_t *m_pSource;                       // pointer to destination buffer
-        uint32_t m_nZeros;                        // number of preceding zeros
-        uint32_t m_nRemovedBytes;                 // number of removed bytes
-    };
-
 } // namespace UMC_VVC_DECODER
 #endif // MFX_ENABLE_VVC_VIDEO_DECODE
@@ -306,12 +306,14 @@ namespace UMC_VVC_DECODER
         // Decode SEI NAL unit
         UMC::Status DecodeSEI(UMC::MediaDataEx *nalUnit);
 
+        // Take the header parsed from the same parameter set payload before
+        bool xReuseHeader(NalUnitType nal_unit_type, const HeaderKey &key, UMC::Status &sts);
         // Decode video parameters set NAL unit
-        UMC::Status xDecodeVPS(VVCHeadersBitstream *);
+        UMC::Status xDecodeVPS(VVCHeadersBitstream *, const HeaderKey &key);
         // Decode sequence parameters set NAL unit
-        UMC::Status xDecodeSPS(VVCHeadersBitstream *);
+        UMC::Status xDecodeSPS(VVCHeadersBitstream *, const HeaderKey &key);
         // Decode picture parameters set NAL unit
-        UMC::Status xDecodePPS(VVCHeadersBitstream *);
+        UMC::Status xDecodePPS(VVCHeadersBitstream *, const HeaderKey &key);
         // Decode picture header NAL unit
         UMC::Status xDecodePH(VVCHeadersBitstream *);
         // Decode adaption parameters set NAL unit
@@ -30,6 +30,29 @@
 
 namespace UMC_VVC_DECODER
 {
+    // Payload of parameter set NAL unit and decoder state its parsing depends on
+    struct HeaderKey
+    {
+        HeaderKey(const uint8_t *data, size_t size, uint32_t context)
+            : m_data(data)
+            , m_size(size)
+            , m_context(context)
+            , m_hash(0xcbf29ce484222325ull)
+        {
+            // FNV-1a
+            for (size_t i = 0; i < size; i++)
+            {
+                m_hash ^= data[i];
+                m_hash *= 0x100000001b3ull;
+            }
+        }
+
+        const uint8_t *m_data;
+        size_t         m_size;
+        uint32_t       m_context;
+        uint64_t       m_hash;
+    };
+
     // Header set container
     template <typename T>
     class HeaderSet
@@ -40,6 +63,8 @@ namespace UMC_VVC_DECODER
             : m_header()
             , m_objHeap(pObjHeap)
             , m_currentID(-1)
+            , m_generation(0)
+            , m_isCurrentUnchanged(false)
         {
         }
 
@@ -48,16 +73,29 @@ namespace UMC_VVC_DECODER
             Reset(false);
         }
 
-        T * AddHeader(T* hdr)
+        // Stores a copy of parsed header, the key allows to reuse it when the same payload is received again
+        T * AddHeader(T* hdr, const HeaderKey *key = nullptr)
         {
             uint32_t id = hdr->GetID();
 
             if (id >= m_header.size())
             {
                 m_header.resize(id + 1, nullptr);
+                m_keys.resize(id + 1);
             }
 
             m_currentID = id;
+            m_isCurrentUnchanged = false;
+            m_generation++;
+
+            StoredKey &stored = m_keys[id];
+            stored.payload.clear();
+            if (key)
+            {
+                stored.payload.assign(key->m_data, key->m_data + key->m_size);
+                stored.context = key->m_context;
+                stored.hash = key->m_hash;
+            }
 
             if (m_header[id])
             {
@@ -75,6 +113,29 @@ namespace UMC_VVC_DECODER
             return header;
         }
 
+        // Returns the header parsed from the same payload and makes it current,
+        // parameter sets resent on every IRAP skip parsing and keep their heap object
+        T * FindHeader(const HeaderKey &key)
+        {
+            for (uint32_t id = 0; id < m_header.size(); id++)
+            {
+                StoredKey const& stored = m_keys[id];
+
+                if (!m_header[id] || stored.hash != key.m_hash || stored.context != key.m_context ||
+                    stored.payload.size() != key.m_size || !key.m_size)
+                    continue;
+
+                if (memcmp(stored.payload.data(), key.m_data, key.m_size))
+                    continue;
+
+                m_currentID = id;
+                m_isCurrentUnchanged = true;
+                return m_header[id];
+            }
+
+            return nullptr;
+        }
+
         T * GetHeader(int32_t id)
         {
             if ((uint32_t)id >= m_header.size())
@@ -126,6 +187,8 @@ namespace UMC_VVC_DECODER
             assert(m_header[id] == hdr);
             m_header[id]->DecrementReference();
             m_header[id] = 0;
+            m_keys[id].payload.clear();
+            m_generation++;
         }
 
         void Reset(bool isPartialReset = false)
@@ -138,7 +201,9 @@ namespace UMC_VVC_DECODER
                 }
 
                 m_header.clear();
+                m_keys.clear();
                 m_currentID = -1;
+                m_isCurrentUnchanged = false;
             }
         }
 
@@ -169,11 +234,33 @@ namespace UMC_VVC_DECODER
             return GetHeader(m_currentID);
         }
 
+        // The current header was received again with the same content
+        bool IsCurrentUnchanged() const
+        {
+            return m_isCurrentUnchanged;
+        }
+
+        // Changes each time a header with new content is stored
+        uint32_t GetGeneration() const
+        {
+            return m_generation;
+        }
+
     private:
 
+        struct StoredKey
+        {
+            std::vector<uint8_t> payload;
+            uint64_t             hash;
+            uint32_t             context;
+        };
+
         std::vector<T*>           m_header;
+        std::vector<StoredKey>    m_keys;
         Heap_Objects              *m_objHeap;
         int32_t                   m_currentID;
+        uint32_t                  m_generation;
+        bool                      m_isCurrentUnchanged;
     };
 
     // VPS/SPS/PPS/PH etc. headers manager
@@ -25,6 +25,8 @@
 #define __UMC_VVC_HEAP_H
 
 #include <memory>
+#include <atomic>
+#include <unordered_set>
 #include "umc_mutex.h"
 #include "umc_vvc_dec_defs.h"
 #include "umc_media_data.h"
@@ -115,6 +117,7 @@ namespace UMC_VVC_DECODER
             , m_size(size)
             , m_isTyped(isTyped)
             , m_heap(heap)
+            , m_isFree(false)
         {
         }
 
@@ -127,6 +130,7 @@ namespace UMC_VVC_DECODER
         size_t m_size;
         bool   m_isTyped;
         Heap_Objects *m_heap;
+        std::atomic<bool> m_isFree;   // item is in the free list of its heap
 
         static Item *Allocate(Heap_Objects *heap, size_t size, bool isTyped = false)
         {
@@ -155,12 +159,30 @@ namespace UMC_VVC_DECODER
 
 
     // Collection of heap objects
+    //
+    // Free items are kept in per size class lists. Untyped buffers are rounded up to the class size and
+    // serve any request of their class, typed items keep constructed objects and are reused for the same size only.
+    // Items are returned to the lists without locking, pops of the same class are serialized by the class mutex,
+    // so a popped item can't be pushed back while another pop is in progress (no ABA).
+    // Free lists retain up to m_maxRetainedSize bytes, past it the largest free items are deleted.
+    // Allocated items are registered, so a repeated Free of the same pointer is ignored even if the item was deleted.
     class Heap_Objects
     {
     public:
 
-        Heap_Objects()
-            : m_firstFreeItem(0)
+        enum
+        {
+            MIN_CLASS_SIZE_LOG  = 6,                                // class 0 holds sizes up to 64 bytes
+            MAX_CLASS_SIZE_LOG  = 32,                               // larger buffers share the last list
+            LARGE_SIZE_CLASS    = 1 + 4 * (MAX_CLASS_SIZE_LOG - MIN_CLASS_SIZE_LOG),
+            NUM_SIZE_CLASSES    = LARGE_SIZE_CLASS + 1
+        };
+
+        static const size_t DEFAULT_MAX_RETAINED_SIZE = 64 * 1024 * 1024;
+
+        Heap_Objects(size_t maxRetainedSize = DEFAULT_MAX_RETAINED_SIZE)
+            : m_retainedSize(0)
+            , m_maxRetainedSize(maxRetainedSize)
         {
         }
 
@@ -169,46 +191,77 @@ namespace UMC_VVC_DECODER
             Release();
         }
 
-        Item *GetItemForAllocation(size_t size, bool typed = false)
+        // Returns size class index and the size of buffers of this class (4 classes per power of 2)
+        static uint32_t GetSizeClass(size_t size, size_t &classSize)
         {
-            UMC::AutomaticUMCMutex guard(m_guard);
-
-            if (!m_firstFreeItem)
+            if (size <= (size_t(1) << MIN_CLASS_SIZE_LOG))
             {
+                classSize = size_t(1) << MIN_CLASS_SIZE_LOG;
                 return 0;
             }
 
-            if (m_firstFreeItem->m_size == size && m_firstFreeItem->m_isTyped == typed)
+            uint32_t sizeLog = 63 - __builtin_clzll((unsigned long long)(size - 1));
+            if (sizeLog >= MAX_CLASS_SIZE_LOG)
             {
-                Item *ptr = m_firstFreeItem;
-                m_firstFreeItem = m_firstFreeItem->m_pNext;
-                assert(ptr->m_size == size);
-                return ptr;
+                classSize = size;
+                return LARGE_SIZE_CLASS;
             }
 
-            Item *temp = m_firstFreeItem;
+            size_t step = size_t(1) << (sizeLog - 2);
+            classSize = (size + step - 1) & ~(step - 1);
+            return 1 + 4 * (sizeLog - MIN_CLASS_SIZE_LOG) + uint32_t(classSize >> (sizeLog - 2)) - 5;
+        }
+
+        Item *GetItemForAllocation(size_t size, bool typed = false)
+        {
+            size_t classSize;
+            uint32_t sizeClass = GetSizeClass(size, classSize);
+            bool exactSize = typed || sizeClass == LARGE_SIZE_CLASS;
+
+            FreeList &list = typed ? m_typedItems[sizeClass] : m_items[sizeClass];
+            UMC::AutomaticUMCMutex guard(list.m_guard);
 
-            while (temp->m_pNext)
+            for (;;)
             {
-                if (temp->m_pNext->m_size == size && temp->m_pNext->m_isTyped == typed)
+                Item *head = list.m_head.load(std::memory_order_acquire);
+
+                // untyped items of a class are interchangeable, objects and large buffers are reused for the same size only
+                Item *prev = 0;
+                Item *item = head;
+                while (item && exactSize && item->m_size != size)
                 {
-                    Item *ptr = temp->m_pNext;
-                    temp->m_pNext = temp->m_pNext->m_pNext;
-                    return ptr;
+                    prev = item;
+                    item = item->m_pNext;
                 }
 
-                temp = temp->m_pNext;
-            }
+                if (!item)
+                    return 0;
 
-            return 0;
+                if (prev)
+                {
+                    // only the head is changed by concurrent Free
+                    prev->m_pNext = item->m_pNext;
+                }
+                else if (!list.m_head.compare_exchange_weak(head, item->m_pNext, std::memory_order_acq_rel))
+                {
+                    continue;
+                }
+
+                item->m_isFree.store(false, std::memory_order_relaxed);
+                m_retainedSize.fetch_sub(item->m_size, std::memory_order_relaxed);
+                assert(item->m_size >= size);
+                return item;
+            }
         }
 
         void *Allocate(size_t size, bool isTyped = false)
         {
-            Item *item = GetItemForAllocation(size);
+            Item *item = GetItemForAllocation(size, isTyped);
             if (!item)
             {
-                item = Item::Allocate(this, size, isTyped);
+                size_t classSize;
+                GetSizeClass(size, classSize);
+                item = AllocateItem(isTyped ? size : classSize, isTyped);
             }
 
             return item->m_ptr;
@@ -227,7 +280,7 @@ namespace UMC_VVC_DECODER
 
             if (!item)
             {
-                void *ptr = Allocate(sizeof(T), true);
+                void *ptr = AllocateItem(sizeof(T), true)->m_ptr;
                 return new(ptr) T();
             }
 
@@ -244,17 +297,19 @@ namespace UMC_VVC_DECODER
             if (!obj)
                 return;
 
-            UMC::AutomaticUMCMutex guard(m_guard);
             Item *item = (Item *) ((uint8_t*)obj - sizeof(Item));
 
-            Item *temp = m_firstFreeItem;
-
-            while (temp)
             {
-                if (temp == item) // already removed
+                // the item is not dereferenced before it is found among allocated ones
+                UMC::AutomaticUMCMutex guard(m_itemsGuard);
+                if (m_allocatedItems.find(item) == m_allocatedItems.end())
                     return;
 
-                temp = temp->m_pNext;
+                if (item->m_isFree.exchange(true, std::memory_order_acq_rel)) // already removed
+                    return;
+
+                if (forceFree)
+                    m_allocatedItems.erase(item);
             }
 
             if (forceFree)
@@ -262,35 +317,135 @@ namespace UMC_VVC_DECODER
                 Item::Free(item);
                 return;
             }
-            else
+
+            if (item->m_isTyped)
             {
-                if (item->m_isTyped)
-                {
-                    HeapObject * object = reinterpret_cast<HeapObject *>(item->m_ptr);
-                    object->Reset();
-                }
+                HeapObject *object = reinterpret_cast<HeapObject *>(item->m_ptr);
+                object->Reset();
             }
 
-            item->m_pNext = m_firstFreeItem;
-            m_firstFreeItem = item;
+            size_t classSize;
+            uint32_t sizeClass = GetSizeClass(item->m_size, classSize);
+
+            FreeList &list = item->m_isTyped ? m_typedItems[sizeClass] : m_items[sizeClass];
+
+            // counted before the push, so a pop of the item never subtracts its size first
+            bool overBudget = m_retainedSize.fetch_add(item->m_size, std::memory_order_relaxed) + item->m_size > m_maxRetainedSize;
+
+            Item *head = list.m_head.load(std::memory_order_relaxed);
+            do
+            {
+                item->m_pNext = head;
+            } while (!list.m_head.compare_exchange_weak(head, item, std::memory_order_release, std::memory_order_relaxed));
+
+            if (overBudget)
+                Trim(m_maxRetainedSize / 2);
         }
 
         void Release()
         {
-            UMC::AutomaticUMCMutex guard(m_guard);
+            for (uint32_t i = 0; i < NUM_SIZE_CLASSES; i++)
+            {
+                Release(m_items[i]);
+                Release(m_typedItems[i]);
+            }
+        }
 
-            while (m_firstFreeItem)
+        // Deletes free items starting from the largest class until free lists retain no more than targetSize bytes
+        void Trim(size_t targetSize)
+        {
+            for (uint32_t i = NUM_SIZE_CLASSES; i-- > 0 && m_retainedSize.load(std::memory_order_relaxed) > targetSize; )
             {
-                Item *pTemp = m_firstFreeItem->m_pNext;
-                Item::Free(m_firstFreeItem);
-                m_firstFreeItem = pTemp;
+                Trim(m_items[i], targetSize);
+                Trim(m_typedItems[i], targetSize);
             }
         }
 
     private:
 
-        Item *m_firstFreeItem;
-        UMC::Mutex m_guard;
+        struct FreeList
+        {
+            FreeList()
+                : m_head(0)
+            {
+            }
+
+            std::atomic<Item *> m_head;
+            UMC::Mutex m_guard;
+        };
+
+        Item *AllocateItem(size_t size, bool isTyped)
+        {
+            Item *item = Item::Allocate(this, size, isTyped);
+
+            UMC::AutomaticUMCMutex guard(m_itemsGuard);
+            m_allocatedItems.insert(item);
+            return item;
+        }
+
+        // Deletes items taken off a free list, a later Free of their pointers doesn't find them among allocated ones.
+        // Called without the class mutex held, as destructors of typed items may free into the heap.
+        void DeleteItems(Item *item)
+        {
+            while (item)
+            {
+                Item *pTemp = item->m_pNext;
+
+                m_retainedSize.fetch_sub(item->m_size, std::memory_order_relaxed);
+                {
+                    UMC::AutomaticUMCMutex guard(m_itemsGuard);
+                    m_allocatedItems.erase(item);
+                }
+
+                Item::Free(item);
+                item = pTemp;
+            }
+        }
+
+        void Release(FreeList &list)
+        {
+            Item *item;
+            {
+                UMC::AutomaticUMCMutex guard(list.m_guard);
+                item = list.m_head.exchange(0, std::memory_order_acquire);
+            }
+
+            DeleteItems(item);
+        }
+
+        void Trim(FreeList &list, size_t targetSize)
+        {
+            Item *removed = 0;
+            {
+                UMC::AutomaticUMCMutex guard(list.m_guard);
+
+                size_t retainedSize = m_retainedSize.load(std::memory_order_relaxed);
+                while (retainedSize > targetSize)
+                {
+                    Item *head = list.m_head.load(std::memory_order_acquire);
+                    if (!head)
+                        break;
+
+                    if (!list.m_head.compare_exchange_weak(head, head->m_pNext, std::memory_order_acq_rel))
+                        continue;
+
+                    retainedSize = retainedSize > head->m_size ? retainedSize - head->m_size : 0;
+                    head->m_pNext = removed;
+                    removed = head;
+                }
+            }
+
+            DeleteItems(removed);
+        }
+
+        FreeList m_items[NUM_SIZE_CLASSES];
+        FreeList m_typedItems[NUM_SIZE_CLASSES];
+
+        std::atomic<size_t> m_retainedSize;                         // bytes kept by free lists
+        size_t              m_maxRetainedSize;
+
+        std::unordered_set<Item *> m_allocatedItems;                // items which are not deleted yet
+        UMC::Mutex                 m_itemsGuard;
     };
 
 } // namespace UMC_VVC_DECODER
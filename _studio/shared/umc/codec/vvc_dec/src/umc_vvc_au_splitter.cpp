@@ -23,6 +23,7 @@
 
 #include "umc_media_data.h"
 #include "umc_vvc_au_splitter.h"
+#include "umc_start_code_scanner.h"
 
 namespace UMC_VVC_DECODER
 {
@@ -133,78 +134,25 @@ namespace UMC_VVC_DECODER
 
     int32_t StartCodeSearcher::FindStartCode(uint8_t *(&pBuf), size_t &size, int32_t &startCodeSize)
     {
-        uint32_t numZeroBytes = 0;
-
-        int32_t i = 0;
-        for (; i < (int32_t)size - 2; )
+        uint32_t numZeroBytes = UMC::MoveToNextStartCode(pBuf, size);
+        if (numZeroBytes)
         {
-            if (pBuf[1])
-            {
-                pBuf += 2;
-                i += 2;
-                continue;
-            }
-
-            numZeroBytes = 0;
-            if (!pBuf[0])
-                numZeroBytes++;
-
-            uint32_t j;
-            for (j = 1; j < (uint32_t)size - i; j++)
-            {
-                if (pBuf[j])
-                    break;
-            }
-
-            numZeroBytes = numZeroBytes ? j: j - 1;
-
-            pBuf += j;
-            i += j;
-
-            if (i >= (int32_t)size)
-            {
-                break;
-            }
-
-            if (numZeroBytes >= 2 && pBuf[0] == 1)
+            startCodeSize = numZeroBytes + 1;
+            if (size >= 1)
             {
-                startCodeSize = std::min(numZeroBytes + 1, 4u);
-                size -= i + 1;
-                pBuf++;    // remove 0x01 symbol
-                if (size >= 1)
-                {
-                    return (pBuf[1] >> NAL_UNITTYPE_SHIFT); // get nal_unit_type
-                }
-                else
-                {
-                    pBuf -= startCodeSize;
-                    size += startCodeSize;
-                    startCodeSize = 0;
-                    return -1;
-                }
+                return (pBuf[1] >> NAL_UNITTYPE_SHIFT); // get nal_unit_type
             }
-
-            numZeroBytes = 0;
-        }
-
-        if (!numZeroBytes)
-        {
-            for (uint32_t k = 0; k < size - i; k++, pBuf++)
+            else
             {
-                if (pBuf[0])
-                {
-                    numZeroBytes = 0;
-                    continue;
-                }
-
-                numZeroBytes++;
+                pBuf -= startCodeSize;
+                size += startCodeSize;
+                startCodeSize = 0;
+                return -1;
             }
         }
 
-        numZeroBytes = std::min(numZeroBytes, 3u);
-        pBuf -= numZeroBytes;
-        size = numZeroBytes;
-        startCodeSize = numZeroBytes;
+        // pBuf points to the trailing zeros
+        startCodeSize = (int32_t)size;
         return -1;
     }
 
@@ -331,67 +279,7 @@ namespace UMC_VVC_DECODER
     // Change memory region to little endian for reading with 32-bit DWORDs and remove start code emulation prevention bytes
     inline void SwapMemoryAndRemovePreventionBytes(void *pDestination, size_t &nDstSize, void *pSource, size_t nSrcSize, std::vector<uint32_t> *pRemovedOffsets)
     {
-        VVCDstDwordPointer pDst;
-        VVCSourcePointer pSrc;
-        size_t i;
-
-        // VVCDstDwordPointer object is swapping written bytes
-        // VVCSourcePointer removes emu-prevention start-code bytes
-
-        // reset pointer(s)
-        pSrc = pSource;
-        pDst = pDestination;
-
-        // first two bytes
-        i = 0;
-        while (i < std::min(size_t(2), nSrcSize))
-        {
-            pDst = (uint8_t) pSrc;
-            ++pDst;
-            ++pSrc;
-            ++i;
-        }
-
-        // do swapping
-        if (NULL != pRemovedOffsets)
-        {
-            while (i < (uint32_t) nSrcSize)
-            {
-                if (false == pSrc.IsPrevent())
-                {
-                    pDst = (uint8_t) pSrc;
-                    ++pDst;
-                }
-                else
-                    pRemovedOffsets->push_back(uint32_t(i));
-
-                ++pSrc;
-                ++i;
-            }
-        }
-        else
-        {
-            while (i < (uint32_t) nSrcSize)
-            {
-                if (false == pSrc.IsPrevent())
-                {
-                    pDst = (uint8_t) pSrc;
-                    ++pDst;
-                }
-
-                ++pSrc;
-                ++i;
-            }
-        }
-
-        // write padding bytes
-        nDstSize = nSrcSize - pSrc.GetRemovedBytes();
-        while (nDstSize & 3)
-        {
-            pDst = (uint8_t) (0);
-            ++nDstSize;
-            ++pDst;
-        }
+        nDstSize = UMC::RemovePreventingBytesAndSwap((uint8_t *) pDestination, (uint8_t *) pSource, nSrcSize, 0, pRemovedOffsets);
     }
 
     // Memory big-to-little endian converter
@@ -837,7 +837,6 @@ namespace UMC_VVC_DECODER
         if (m_lastSlice)
         {
             m_lastSlice->Release();
-            m_ObjHeap.FreeObject(&m_lastSlice);
             m_lastSlice = 0;
         }
 
@@ -1240,6 +1239,18 @@ namespace UMC_VVC_DECODER
 
         VVCHeadersBitstream bitStream;
 
+        // VPS target output layer set comes from OPI or external setting
+        NalUnitType nal_type = (NalUnitType)nalUnit->GetExData()->values[0];
+        uint32_t context = 0;
+        if (nal_type == NAL_UNIT_VPS)
+            context = (m_currHeaders.m_opiParams.GetGeneration() << 2) | (GetTOlsIdxExternalFlag() << 1) | GetTOlsIdxOpiFlag();
+
+        HeaderKey key((const uint8_t*)nalUnit->GetDataPointer(), nalUnit->GetDataSize(), context);
+
+        // broadcast streams resend the same parameter sets with every IRAP picture
+        if (xReuseHeader(nal_type, key, sts))
+            return sts;
+
         try
         {
             MemoryPiece mem;
@@ -1261,13 +1272,13 @@ namespace UMC_VVC_DECODER
             switch (nal_unit_type)
             {
             case NAL_UNIT_VPS:
-                sts = xDecodeVPS(&bitStream);
+                sts = xDecodeVPS(&bitStream, key);
                 break;
             case NAL_UNIT_SPS:
-                sts = xDecodeSPS(&bitStream);
+                sts = xDecodeSPS(&bitStream, key);
                 break;
             case NAL_UNIT_PPS:
-                sts = xDecodePPS(&bitStream);
+                sts = xDecodePPS(&bitStream, key);
                 break;
             case NAL_UNIT_PREFIX_APS:
             case NAL_UNIT_SUFFIX_APS:
@@ -1319,7 +1330,42 @@ namespace UMC_VVC_DECODER
         return sts;
     }
 
-    UMC::Status VVCDecoder::xDecodeVPS(VVCHeadersBitstream *bs)
+    // Take the header parsed from the same parameter set payload before
+    bool VVCDecoder::xReuseHeader(NalUnitType nal_unit_type, const HeaderKey &key, UMC::Status &sts)
+    {
+        switch (nal_unit_type)
+        {
+        case NAL_UNIT_VPS:
+            return m_currHeaders.m_videoParams.FindHeader(key) != nullptr;
+
+        case NAL_UNIT_SPS:
+            {
+                const VVCSeqParamSet* old_sps = m_currHeaders.m_seqParams.GetCurrentHeader();
+                const VVCSeqParamSet* sps = m_currHeaders.m_seqParams.FindHeader(key);
+                if (!sps)
+                {
+                    return false;
+                }
+
+                // switching back to another stored SPS may still change resolution
+                if (sps != old_sps && IsNeedSPSInvalidate(old_sps, sps))
+                {
+                    sts = UMC::UMC_NTF_NEW_RESOLUTION;
+                }
+
+                m_splitter->SetSuggestedSize(CalculateSuggestedSize(sps));
+                return true;
+            }
+
+        case NAL_UNIT_PPS:
+            return m_currHeaders.m_picParams.FindHeader(key) != nullptr;
+
+        default:
+            return false;
+        }
+    }
+
+    UMC::Status VVCDecoder::xDecodeVPS(VVCHeadersBitstream *bs, const HeaderKey &key)
     {
         VVCVideoParamSet vps = {};
 
@@ -1337,12 +1383,12 @@ namespace UMC_VVC_DECODER
             vps.vps_target_ols_idx = opi->opi_ols_idx;
         }
 
-        m_currHeaders.m_videoParams.AddHeader(&vps);
+        m_currHeaders.m_videoParams.AddHeader(&vps, &key);
 
         return UMC::UMC_OK;
     }
 
-    UMC::Status VVCDecoder::xDecodeSPS(VVCHeadersBitstream *bs)
+    UMC::Status VVCDecoder::xDecodeSPS(VVCHeadersBitstream *bs, const HeaderKey &key)
     {
         VVCSeqParamSet sps = {};
         sps.m_changed = false;
@@ -1360,7 +1406,10 @@ namespace UMC_VVC_DECODER
             newResolution = true;
         }
 
-        m_currHeaders.m_seqParams.AddHeader(&sps);
+        // the same payload would be taken from the set, so a stored SPS with this id had other content
+        sps.m_changed = m_currHeaders.m_seqParams.GetHeader(sps.GetID()) != nullptr;
+
+        m_currHeaders.m_seqParams.AddHeader(&sps, &key);
 
         m_splitter->SetSuggestedSize(CalculateSuggestedSize(&sps));
 
@@ -1372,7 +1421,7 @@ namespace UMC_VVC_DECODER
         return UMC::UMC_OK;
     }
 
-    UMC::Status VVCDecoder::xDecodePPS(VVCHeadersBitstream *bs)
+    UMC::Status VVCDecoder::xDecodePPS(VVCHeadersBitstream *bs, const HeaderKey &key)
     {
         VVCPicParamSet pps = {};
         pps.pps_num_slices_in_pic = 1;
@@ -1386,6 +1435,9 @@ namespace UMC_VVC_DECODER
 
         if (m_currHeaders.m_picParams.GetHeader(pps.GetID()))
         {
+            // the same payload would be taken from the set, so the stored PPS had other content
+            pps.m_changed = true;
+
             VVCPicParamSet* pPicParamSet = m_currHeaders.m_picParams.GetHeader(pps.GetID());
             for (uint32_t i = 0; i < pPicParamSet->pps_rect_slices.size(); i++)
             {
@@ -1403,7 +1455,7 @@ namespace UMC_VVC_DECODER
             }
             pPicParamSet->pps_sub_pics.clear();
         }
-        m_currHeaders.m_picParams.AddHeader(&pps);
+        m_currHeaders.m_picParams.AddHeader(&pps, &key);
 
         return UMC::UMC_OK;
     }
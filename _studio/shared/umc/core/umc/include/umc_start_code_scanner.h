@@ -0,0 +1,70 @@
+// Copyright (c) 2025 Intel Corporation
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#ifndef __UMC_START_CODE_SCANNER_H__
+#define __UMC_START_CODE_SCANNER_H__
+
+#include <cstdint>
+#include <cstddef>
+#include <vector>
+
+namespace UMC
+{
+
+// Returns pointer to the first byte of the first 00 00 01 prefix located entirely
+// in [begin, end) or end if there is no such prefix.
+// Zero bytes are located with SSE2/AVX2 compare masks, the last few bytes are handled by scalar code.
+const uint8_t* FindStartCodePrefix(const uint8_t* begin, const uint8_t* end);
+
+inline uint8_t* FindStartCodePrefix(uint8_t* begin, uint8_t* end)
+{
+    return const_cast<uint8_t*>(FindStartCodePrefix(static_cast<const uint8_t*>(begin), static_cast<const uint8_t*>(end)));
+}
+
+// Returns pointer to the first byte of the first 00 00 03 sequence located entirely
+// in [begin, end) or end if there is none, 0x03 is an emulation prevention byte.
+const uint8_t* FindEmulationPreventionPrefix(const uint8_t* begin, const uint8_t* end);
+
+// Common part of the Annex-B NAL unit splitters.
+// Moves pb right after the 0x01 byte of the first start code in [pb, pb + size) and returns
+// the number of zero bytes which precede 0x01 (2 or 3, longer zero runs are reported as 3). If there is no start code, pb and size
+// are moved to the trailing zero bytes (at most 3) which may begin a start code continued in the
+// next chunk of data and 0 is returned.
+uint32_t MoveToNextStartCode(uint8_t* (&pb), size_t& size);
+
+// Copies NAL unit payload to pDestination removing emulation prevention bytes and
+// swapping every output dword to the little endian layout expected by UMC bitstream readers.
+// Output is padded with tailValue up to dword boundary, its size is returned.
+// Source offsets of removed bytes are appended to pRemovedOffsets when it is not null.
+// Runs without emulation prevention bytes are copied and swapped in bulk, so a NAL unit
+// without them is handled by a single swapping copy.
+size_t RemovePreventingBytesAndSwap(uint8_t *pDestination, const uint8_t *pSource, size_t nSrcSize, uint8_t tailValue, std::vector<uint32_t> *pRemovedOffsets);
+
+// ISA specific kernels
+// Searches [begin, end) for 00 00 code sequence
+const uint8_t* FindZeroZeroPrefix_SSE2(const uint8_t* begin, const uint8_t* end, uint8_t code);
+const uint8_t* FindZeroZeroPrefix_AVX2(const uint8_t* begin, const uint8_t* end, uint8_t code);
+// Reverses byte order of each dword, size is multiple of 4, pDst may be equal to pSrc
+void SwapDwords_SSE2(uint8_t *pDst, const uint8_t *pSrc, size_t size);
+void SwapDwords_AVX2(uint8_t *pDst, const uint8_t *pSrc, size_t size);
+
+} // namespace UMC
+
+#endif // __UMC_START_CODE_SCANNER_H__
@@ -0,0 +1,204 @@
+// Copyright (c) 2025 Intel Corporation
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "umc_start_code_scanner.h"
+
+#include <cstring>
+#include <emmintrin.h>
+
+namespace UMC
+{
+
+typedef const uint8_t* (*t_findZeroZeroPrefix)(const uint8_t*, const uint8_t*, uint8_t);
+typedef void (*t_swapDwords)(uint8_t*, const uint8_t*, size_t);
+
+static const uint8_t* FindZeroZeroPrefix_C(const uint8_t* begin, const uint8_t* end, uint8_t code)
+{
+    for (const uint8_t* p = begin; end - p >= 3; ++p)
+    {
+        if (p[2] && p[2] != code)
+        {
+            // neither p[0..2] nor p[1..3] nor p[2..4] can match
+            p += 2;
+            continue;
+        }
+
+        if (!p[0] && !p[1] && p[2] == code)
+            return p;
+    }
+
+    return end;
+}
+
+const uint8_t* FindZeroZeroPrefix_SSE2(const uint8_t* begin, const uint8_t* end, uint8_t code)
+{
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i last = _mm_set1_epi8((char)code);
+
+    const uint8_t* p = begin;
+
+    // 16 candidate positions per iteration, p[0..17] is read
+    for (; end - p >= 18; p += 16)
+    {
+        __m128i b0 = _mm_loadu_si128((const __m128i*)(p));
+        __m128i b1 = _mm_loadu_si128((const __m128i*)(p + 1));
+        __m128i b2 = _mm_loadu_si128((const __m128i*)(p + 2));
+
+        __m128i m = _mm_and_si128(_mm_cmpeq_epi8(b0, zero), _mm_cmpeq_epi8(b1, zero));
+        m = _mm_and_si128(m, _mm_cmpeq_epi8(b2, last));
+
+        int mask = _mm_movemask_epi8(m);
+        if (mask)
+            return p + __builtin_ctz(mask);
+    }
+
+    return FindZeroZeroPrefix_C(p, end, code);
+}
+
+void SwapDwords_SSE2(uint8_t *pDst, const uint8_t *pSrc, size_t size)
+{
+    size_t i = 0;
+
+    for (; i + 16 <= size; i += 16)
+    {
+        __m128i v = _mm_loadu_si128((const __m128i*)(pSrc + i));
+        // swap bytes in words, then words in dwords
+        v = _mm_or_si128(_mm_slli_epi16(v, 8), _mm_srli_epi16(v, 8));
+        v = _mm_shufflelo_epi16(v, _MM_SHUFFLE(2, 3, 0, 1));
+        v = _mm_shufflehi_epi16(v, _MM_SHUFFLE(2, 3, 0, 1));
+        _mm_storeu_si128((__m128i*)(pDst + i), v);
+    }
+
+    for (; i < size; i += 4)
+    {
+        uint32_t dword;
+        memcpy(&dword, pSrc + i, sizeof(dword));
+        dword = __builtin_bswap32(dword);
+        memcpy(pDst + i, &dword, sizeof(dword));
+    }
+}
+
+static const uint8_t* FindZeroZeroPrefix(const uint8_t* begin, const uint8_t* end, uint8_t code)
+{
+    static const t_findZeroZeroPrefix findZeroZeroPrefix_impl =
+        __builtin_cpu_supports("avx2") ? FindZeroZeroPrefix_AVX2 : FindZeroZeroPrefix_SSE2;
+
+    return findZeroZeroPrefix_impl(begin, end, code);
+}
+
+static void SwapDwords(uint8_t *pDst, const uint8_t *pSrc, size_t size)
+{
+    static const t_swapDwords swapDwords_impl =
+        __builtin_cpu_supports("avx2") ? SwapDwords_AVX2 : SwapDwords_SSE2;
+
+    swapDwords_impl(pDst, pSrc, size);
+}
+
+const uint8_t* FindStartCodePrefix(const uint8_t* begin, const uint8_t* end)
+{
+    return FindZeroZeroPrefix(begin, end, 1);
+}
+
+const uint8_t* FindEmulationPreventionPrefix(const uint8_t* begin, const uint8_t* end)
+{
+    return FindZeroZeroPrefix(begin, end, 3);
+}
+
+uint32_t MoveToNextStartCode(uint8_t* (&pb), size_t& size)
+{
+    uint8_t* begin = pb;
+    uint8_t* end   = pb + size;
+
+    uint8_t* prefix = FindStartCodePrefix(begin, end);
+    if (prefix != end)
+    {
+        // the prefix might be preceded by zero_byte
+        uint32_t zeroCount = 2;
+        if (prefix != begin && !prefix[-1])
+            zeroCount++;
+
+        pb   = prefix + 3; // skip 0x01 symbol
+        size = end - pb;
+        return zeroCount;
+    }
+
+    // keep trailing zeros, they can be a part of start code split between chunks
+    uint32_t zeroCount = 0;
+    while (zeroCount < 3 && zeroCount < size && !end[-1 - (ptrdiff_t)zeroCount])
+        zeroCount++;
+
+    pb   = end - zeroCount;
+    size = zeroCount;
+    return 0;
+}
+
+size_t RemovePreventingBytesAndSwap(uint8_t *pDestination, const uint8_t *pSource, size_t nSrcSize, uint8_t tailValue, std::vector<uint32_t> *pRemovedOffsets)
+{
+    const uint8_t *end = pSource + nSrcSize;
+    const uint8_t *prefix = FindEmulationPreventionPrefix(pSource, end);
+
+    size_t nDstSize;
+    size_t nSwapped;
+
+    if (prefix == end)
+    {
+        // nothing to remove, swap whole dwords directly from the source
+        nSwapped = nSrcSize & ~size_t(3);
+        SwapDwords(pDestination, pSource, nSwapped);
+
+        memcpy(pDestination + nSwapped, pSource + nSwapped, nSrcSize - nSwapped);
+        nDstSize = nSrcSize;
+    }
+    else
+    {
+        uint8_t *pDst = pDestination;
+        const uint8_t *run = pSource;
+
+        while (prefix != end)
+        {
+            const uint8_t *pPrevent = prefix + 2;
+
+            memcpy(pDst, run, pPrevent - run);
+            pDst += pPrevent - run;
+
+            if (pRemovedOffsets)
+                pRemovedOffsets->push_back(uint32_t(pPrevent - pSource));
+
+            run = pPrevent + 1;
+            prefix = FindEmulationPreventionPrefix(run, end);
+        }
+
+        memcpy(pDst, run, end - run);
+        pDst += end - run;
+
+        nDstSize = pDst - pDestination;
+        nSwapped = 0;
+    }
+
+    // write padding bytes
+    while (nDstSize & 3)
+        pDestination[nDstSize++] = tailValue;
+
+    SwapDwords(pDestination + nSwapped, pDestination + nSwapped, nDstSize - nSwapped);
+
+    return nDstSize;
+}
+
+} // namespace UMC
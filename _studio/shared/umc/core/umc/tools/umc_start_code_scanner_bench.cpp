@@ -0,0 +1,244 @@
+// Copyright (c) 2025 Intel Corporation
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+
+// Throughput of the Annex-B start code scanner.
+// Synthetic streams and the given Annex-B files are split into NAL units with
+// the byte by byte search the NAL splitters used before, with each SIMD
+// kernel the CPU supports and with MoveToNextStartCode as the splitters call it.
+// Every method has to find the same number of start codes.
+//
+// Usage:
+//   umc_start_code_scanner_bench [iterations [stream.265 ...]]
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+#include "umc_start_code_scanner.h"
+
+struct Stream
+{
+    std::string          name;
+    std::vector<uint8_t> data;
+};
+
+// NAL units of random payload with emulation prevention, zeroPercent controls
+// how often the payload has zero bytes, zero runs make the byte by byte search branchy
+static Stream MakeStream(const char* name, size_t size, size_t nalSize, int zeroPercent)
+{
+    Stream stream;
+    stream.name = name;
+    stream.data.reserve(size + nalSize + 16);
+
+    unsigned int seed = 12345;
+    while (stream.data.size() < size)
+    {
+        const uint8_t startCode[] = { 0, 0, 0, 1 };
+        stream.data.insert(stream.data.end(), startCode, startCode + sizeof(startCode));
+
+        int zeros = 0;
+        for (size_t i = 0; i < nalSize; i++)
+        {
+            seed = seed * 1103515245 + 12345;
+
+            uint8_t byte = ((int)((seed >> 16) % 100) < zeroPercent) ? 0 : (uint8_t)(seed >> 8);
+
+            if (zeros >= 2 && byte <= 3)
+            {
+                stream.data.push_back(3);
+                zeros = 0;
+            }
+
+            stream.data.push_back(byte);
+            zeros = byte ? 0 : zeros + 1;
+        }
+
+        // NAL unit can't end with zero byte
+        if (!stream.data.back())
+            stream.data.back() = 0x80;
+    }
+
+    return stream;
+}
+
+static bool ReadStream(const char* fileName, Stream& stream)
+{
+    FILE* file = fopen(fileName, "rb");
+    if (!file)
+        return false;
+
+    stream.name = fileName;
+    stream.data.clear();
+
+    uint8_t buffer[65536];
+    size_t  read;
+    while ((read = fread(buffer, 1, sizeof(buffer), file)) > 0)
+        stream.data.insert(stream.data.end(), buffer, buffer + read);
+
+    fclose(file);
+
+    return !stream.data.empty();
+}
+
+// byte by byte search of the former FindStartCode
+static size_t CountBytewise(const uint8_t* pb, size_t size)
+{
+    size_t count = 0;
+
+    while (size >= 3)
+    {
+        if (!pb[0] && !pb[1] && pb[2] == 1)
+        {
+            count++;
+            pb += 3;
+            size -= 3;
+            continue;
+        }
+
+        pb++;
+        size--;
+    }
+
+    return count;
+}
+
+template <const uint8_t* (*Find)(const uint8_t*, const uint8_t*, uint8_t)>
+static size_t CountKernel(const uint8_t* pb, size_t size)
+{
+    const uint8_t* end   = pb + size;
+    size_t         count = 0;
+
+    for (const uint8_t* p = Find(pb, end, 1); p != end; p = Find(p + 3, end, 1))
+        count++;
+
+    return count;
+}
+
+static size_t CountSplitter(const uint8_t* pb, size_t size)
+{
+    uint8_t* p     = const_cast<uint8_t*>(pb);
+    size_t   count = 0;
+
+    while (UMC::MoveToNextStartCode(p, size))
+        count++;
+
+    return count;
+}
+
+struct BenchMethod
+{
+    const char* name;
+    bool        (*isSupported)();
+    size_t      (*count)(const uint8_t*, size_t);
+};
+
+static bool IsSupported_Any()  { return true; }
+static bool IsSupported_AVX2() { return __builtin_cpu_supports("avx2"); }
+
+static const BenchMethod methods[] =
+{
+    { "bytewise", IsSupported_Any,  CountBytewise },
+    { "SSE2",     IsSupported_Any,  CountKernel<UMC::FindZeroZeroPrefix_SSE2> },
+    { "AVX2",     IsSupported_AVX2, CountKernel<UMC::FindZeroZeroPrefix_AVX2> },
+    { "splitter", IsSupported_Any,  CountSplitter },
+};
+
+int main(int argc, char* argv[])
+{
+    int iterations = 10;
+
+    if (argc >= 2)
+        iterations = atoi(argv[1]);
+
+    if (iterations <= 0)
+    {
+        printf("usage: %s [iterations [stream.265 ...]]\n", argv[0]);
+        return 1;
+    }
+
+    std::vector<Stream> streams;
+    streams.push_back(MakeStream("intra 4K, 256 KB NALs", 64 << 20, 256 << 10, 1));
+    streams.push_back(MakeStream("low delay, 1 KB NALs",  64 << 20, 1 << 10,   1));
+    streams.push_back(MakeStream("zero heavy, 16 KB NALs", 64 << 20, 16 << 10, 30));
+
+    for (int i = 2; i < argc; i++)
+    {
+        Stream stream;
+        if (!ReadStream(argv[i], stream))
+        {
+            printf("can't read %s\n", argv[i]);
+            return 1;
+        }
+        streams.push_back(std::move(stream));
+    }
+
+    printf("%d iterations, best time of each run, MB/s\n", iterations);
+    printf("%-24s %9s", "stream", "NALs");
+    for (const BenchMethod& method : methods)
+        printf(" %9s", method.name);
+    printf("\n");
+
+    int failures = 0;
+
+    for (const Stream& stream : streams)
+    {
+        size_t nalCount = CountBytewise(stream.data.data(), stream.data.size());
+
+        printf("%-24.24s %9zu", stream.name.c_str(), nalCount);
+
+        for (const BenchMethod& method : methods)
+        {
+            if (!method.isSupported())
+            {
+                printf(" %9s", "n/a");
+                continue;
+            }
+
+            double best  = 0;
+            size_t count = 0;
+            for (int i = 0; i < iterations; i++)
+            {
+                auto start = std::chrono::steady_clock::now();
+                count = method.count(stream.data.data(), stream.data.size());
+                double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+                if (!i || seconds < best)
+                    best = seconds;
+            }
+
+            if (count != nalCount)
+            {
+                printf(" %9s", "MISMATCH");
+                failures++;
+                continue;
+            }
+
+            printf(" %9.0f", stream.data.size() / best * 1e-6);
+        }
+
+        printf("\n");
+    }
+
+    return failures ? 1 : 0;
+}
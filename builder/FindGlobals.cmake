@@ -352,3 +352,19 @@ else()
       $<$<PLATFORM_ID:Linux>:   -mavx2>
     )
 endif()
+
+add_library(mfx_require_avx512_properties INTERFACE)
+
+if (CMAKE_C_COMPILER_ID MATCHES Intel)
+  target_compile_options(mfx_require_avx512_properties
+    INTERFACE
+      $<$<PLATFORM_ID:Windows>: /QxCORE-AVX512>
+      $<$<PLATFORM_ID:Linux>:   -xCORE-AVX512>
+    )
+else()
+  target_compile_options(mfx_require_avx512_properties
+    INTERFACE
+      $<$<PLATFORM_ID:Windows>: /arch:AVX512>
+      $<$<PLATFORM_ID:Linux>:   -mavx512f -mavx512bw>
+    )
+endif()
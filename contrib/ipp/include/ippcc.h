@@ -132,6 +132,28 @@ IPPAPI(IppStatus, mfxiYCbCr422ToYCbCr420_8u_C2P3R,( const Ipp8u* pSrc, int srcSt
 IPPAPI(IppStatus, mfxiYCbCr420_8u_P2P3R,(const Ipp8u* pSrcY,int srcYStep,const Ipp8u* pSrcCbCr, int srcCbCrStep,
 Ipp8u* pDst[3], int dstStep[3], IppiSize roiSize ))
 
+/* ///////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+//  Name:       mfxiYCbCr420_8u_P3P2R
+//  Purpose:    Converts a I420(IYUV) image to the NV12 image.
+//  Return:
+//    ippStsNoErr              Ok
+//    ippStsNullPtrErr         One or more pointers are NULL
+//    ippStsSizeErr            if roiSize.width < 1 || roiSize.height < 1
+//
+//  Arguments:
+//    pSrc                     array of pointers to the components of the source image
+//    srcStep                  array of steps values for every component
+//    pDstY                    pointer to the destination Y plane
+//    dstYStep                 step  for the destination Y plane
+//    pDstCbCr                 pointer to the destination CbCr plane
+//    dstCbCrStep              step  for the destination CbCr plane
+//     roiSize                 region of interest to be processed, in pixels
+//  Notes:
+//    roiSize is the size of Y plane, chroma planes are roiSize/2 rounded down.
+*/
+IPPAPI(IppStatus, mfxiYCbCr420_8u_P3P2R,(const Ipp8u* pSrc[3], int srcStep[3], Ipp8u* pDstY, int dstYStep,
+Ipp8u* pDstCbCr, int dstCbCrStep, IppiSize roiSize ))
+
 /* ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 //  Name:       mfxiCbYCr422ToYCbCr422_8u_C2P3R
 //  Purpose:    Converts a UYVY image to the P422 image
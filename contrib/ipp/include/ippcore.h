@@ -82,6 +82,22 @@ IPPAPI( void, mfxFree, (void* ptr) )
 
 IPPAPI( IppStatus, MfxIppInit, (void) )
 
+/* /////////////////////////////////////////////////////////////////////////////
+//  Name:       mfxSetCpuFeatures
+//  Purpose:    restricts optimized code paths to the given CPU features
+//  Parameter:
+//    cpuFeatures  mask of ippCPUID_* values, 0 enables all features of the CPU
+//  Returns:
+//    ippStsNoErr                  Ok
+//    ippStsFeatureNotSupported    CPU doesn't support some of requested features,
+//                                 they are ignored
+//
+//  Name:       mfxGetEnabledCpuFeatures
+//  Purpose:    returns the mask of CPU features used for dispatching
+*/
+IPPAPI( IppStatus, mfxSetCpuFeatures, ( Ipp64u cpuFeatures ) )
+IPPAPI( Ipp64u, mfxGetEnabledCpuFeatures, ( void ) )
+
 /* ////////////////////////////////////////////////////////////////////////////
 //  Name:       mfxGetMaxCacheSizeB
 //
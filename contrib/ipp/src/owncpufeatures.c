@@ -30,7 +30,23 @@
 
 #include "dispatcher.h"
 
-static Ipp64u ownFeaturesMask = PX_FM;
+/* 0 until the first request, then CPU features allowed for dispatching */
+static Ipp64u ownFeaturesMask = 0;
+
+static Ipp64u ownGetCpuFeatures( void )
+{
+  Ipp64u features = PX_FM;
+
+  if( __builtin_cpu_supports("sse3") )   features |= ippCPUID_SSE3;
+  if( __builtin_cpu_supports("ssse3") )  features |= ippCPUID_SSSE3;
+  if( __builtin_cpu_supports("sse4.1") ) features |= ippCPUID_SSE41;
+  if( __builtin_cpu_supports("sse4.2") ) features |= ippCPUID_SSE42;
+  /* the check includes OS support of the YMM state */
+  if( __builtin_cpu_supports("avx") )    features |= ippCPUID_AVX | ippAVX_ENABLEDBYOS;
+  if( __builtin_cpu_supports("avx2") )   features |= ippCPUID_AVX2;
+
+  return features;
+}
 
 
 /*=======================================================================*/
@@ -66,9 +82,54 @@ static Ipp64u ownFeaturesMask = PX_FM;
 /*=======================================================================*/
 int __CDECL mfxownGetFeature( Ipp64u MaskOfFeature )
 {
+  if( 0 == ownFeaturesMask ) {
+    ownFeaturesMask = ownGetCpuFeatures();
+  }
+
   if( (ownFeaturesMask & MaskOfFeature) == MaskOfFeature ) {
     return 1;
   } else {
     return 0;
   };
 }
+
+
+/* ///////////////////////////////////////////////////////////////////////////
+//  Name:
+//    mfxSetCpuFeatures
+//
+//  Purpose:
+//    restrict the code paths selected by the library to the given features,
+//    features not supported by the CPU are ignored
+//
+//  Parameters:
+//    cpuFeatures  mask of ippCPUID_* values, 0 enables all CPU features
+//
+//  Returns:
+//    ippStsNoErr                if all requested features are supported
+//    ippStsFeatureNotSupported  if CPU doesn't support some of them
+*/
+
+IPPFUN( IppStatus, mfxSetCpuFeatures, ( Ipp64u cpuFeatures ) )
+{
+  Ipp64u features = ownGetCpuFeatures();
+
+  if( 0 == cpuFeatures ) {
+    ownFeaturesMask = features;
+    return ippStsNoErr;
+  }
+
+  ownFeaturesMask = (cpuFeatures & features) | PX_FM;
+
+  return ((cpuFeatures & features) == cpuFeatures) ? ippStsNoErr : ippStsFeatureNotSupported;
+} /* mfxSetCpuFeatures() */
+
+
+IPPFUN( Ipp64u, mfxGetEnabledCpuFeatures, ( void ) )
+{
+  if( 0 == ownFeaturesMask ) {
+    ownFeaturesMask = ownGetCpuFeatures();
+  }
+
+  return ownFeaturesMask;
+} /* mfxGetEnabledCpuFeatures() */
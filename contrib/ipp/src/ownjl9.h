@@ -0,0 +1,80 @@
+// Copyright (c) 2025 Intel Corporation
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+/*
+//
+//  Purpose:
+//    AVX2 (L9) code paths of JPEG decoder functions.
+//    They are built into ipp_avx2 object library and called by library
+//    functions when mfxownGetFeature(ippCPUID_AVX2) is true.
+//    Results are bit exact with the SSE4 code paths.
+//
+*/
+
+#ifndef __OWNJL9_H__
+#define __OWNJL9_H__
+
+#ifndef __OWNJ_H__
+#include "ownj.h"
+#endif
+#ifndef __CPUDEF_H__
+#include "cpudef.h"
+#endif
+
+#define OWN_HAS_L9() mfxownGetFeature( ippCPUID_AVX2 )
+
+
+OWNAPI(void, mfxownpj_DCTQuantInv8x8LS_JPEG_16s8u_C1R_L9, (
+  const Ipp16s* pSrc,
+        Ipp8u*  pDst,
+        int     dstStep,
+  const Ipp16u* pQuantInvTable));
+
+OWNAPI(void, mfxownpj_SampleUpRowH2V1_Triangle_JPEG_8u_C1_L9, (
+  const Ipp8u* pSrc,
+        int    srcWidth,
+        Ipp8u* pDst));
+
+OWNAPI(void, mfxownpj_SampleUpRowH2V2_Triangle_JPEG_8u_C1_L9, (
+  const Ipp8u* pSrc1,
+  const Ipp8u* pSrc2,
+        int    srcWidth,
+        Ipp8u* pDst));
+
+OWNAPI(void, mfxownYCbCrToBGR_JPEG_8u_P3C4R_L9, (
+  const Ipp8u*   pYCC[3],
+        int      yccStep,
+        Ipp8u*   pBGR,
+        int      bgrStep,
+        IppiSize roiSize,
+        Ipp8u    aval));
+
+OWNAPI(void, mfxownYCbCr420_8u_P3P2R_L9, (
+  const Ipp8u*   pSrc[3],
+        int      srcStep[3],
+        Ipp8u*   pDstY,
+        int      dstYStep,
+        Ipp8u*   pDstCbCr,
+        int      dstCbCrStep,
+        IppiSize roiSize));
+
+#endif /* __OWNJL9_H__ */
+
+/* ///////////////////////// End of file "ownjl9.h" ///////////////////////// */
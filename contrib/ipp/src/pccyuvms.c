@@ -20,6 +20,7 @@
 
 #include "precomp.h"
 #include "owncc.h"
+#include "ownjl9.h"
 
 #if !( (_IPP > _IPP_A6) || (_IPP32E>=_IPP32E_M7)/*|| (_IPPLRB >= _IPPLRB_B1)*/)
 
@@ -818,3 +819,78 @@ IPPFUN(IppStatus, mfxiYCbCr420_8u_P2P3R,(
 
   return ippStsNoErr;
 } /* mfxiYCbCr420_8u_P2P3R() */
+
+
+/* ///////////////////////////////////////////////////////////////////////////
+//  Name:       mfxiYCbCr420_8u_P3P2R
+//  Purpose:    Converts a I420(IYUV) image to the NV12 image.
+//  Return:
+//    ippStsNoErr              Ok
+//    ippStsNullPtrErr         One or more pointers are NULL
+//    ippStsSizeErr            if roiSize.width < 1 || roiSize.height < 1
+//
+//  Arguments:
+//    pSrc         array of pointers to the components of the source image
+//    srcStep      array of steps values for every component
+//    pDstY        pointer to the destination Y plane
+//    dstYStep     step  for the destination Y plane
+//    pDstCbCr     pointer to the destination CbCr plane
+//    dstCbCrStep  step  for the destination CbCr plane
+//    roiSize      region of interest to be processed, in pixels
+//  Notes:
+//    roiSize is the size of Y plane, chroma planes are roiSize/2
+//    rounded down.
+*/
+
+IPPFUN(IppStatus, mfxiYCbCr420_8u_P3P2R,(
+  const Ipp8u*   pSrc[3],
+        int      srcStep[3],
+        Ipp8u*   pDstY,
+        int      dstYStep,
+        Ipp8u*   pDstCbCr,
+        int      dstCbCrStep,
+        IppiSize roiSize))
+{
+  int w;
+  int h;
+
+  IPP_BAD_PTR2_RET( pSrc, srcStep );
+  IPP_BAD_PTR3_RET( pSrc[0], pSrc[1], pSrc[2] );
+  IPP_BAD_PTR2_RET( pDstY, pDstCbCr );
+  IPP_BADARG_RET((roiSize.width  < 1), ippStsSizeErr);
+  IPP_BADARG_RET((roiSize.height < 1), ippStsSizeErr);
+
+  if( OWN_HAS_L9() )
+  {
+    mfxownYCbCr420_8u_P3P2R_L9( pSrc, srcStep, pDstY, dstYStep, pDstCbCr, dstCbCrStep, roiSize );
+    return ippStsNoErr;
+  }
+
+  /* Y plane */
+  for( h = 0; h < roiSize.height; h ++ )
+  {
+    const Ipp8u* src = pSrc[0] + h * srcStep[0];
+    Ipp8u*       dst = pDstY   + h * dstYStep;
+
+    for( w = 0; w < roiSize.width; w ++ )
+    {
+      dst[w] = src[w];
+    }
+  }
+
+  /* CbCr plane */
+  for( h = 0; h < roiSize.height / 2; h ++ )
+  {
+    const Ipp8u* srcu = pSrc[1]  + h * srcStep[1];
+    const Ipp8u* srcv = pSrc[2]  + h * srcStep[2];
+    Ipp8u*       dst  = pDstCbCr + h * dstCbCrStep;
+
+    for( w = 0; w < roiSize.width / 2; w ++ )
+    {
+      dst[2 * w]     = srcu[w];
+      dst[2 * w + 1] = srcv[w];
+    }
+  }
+
+  return ippStsNoErr;
+} /* mfxiYCbCr420_8u_P3P2R() */
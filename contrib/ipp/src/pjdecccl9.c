@@ -0,0 +1,222 @@
+// Copyright (c) 2025 Intel Corporation
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+/*
+//
+//  Purpose:
+//    Color conversion functions of JPEG decoder, AVX2 code path
+//
+//  Contents:
+//    mfxownYCbCrToBGR_JPEG_8u_P3C4R_L9
+//    mfxownYCbCr420_8u_P3P2R_L9
+//
+//  Notes:
+//    YCbCr to BGR uses the same 16-bit fixed point arithmetic
+//    as mfxownYCbCrToBGR_JPEG_8u_P3C4R (pjencccpsy8.c)
+//
+*/
+
+#include <immintrin.h>
+
+#include "precomp.h"
+#include "ownjl9.h"
+
+#define kRCr  0x00002cdd
+#define kGCr  0x000016da
+#define kGCb  0x00000b03
+#define kBCb  0x000038b4
+#define kR    0x00000b37
+#define kG    0x00000877
+#define kB    0x00000e2d
+
+
+/* converts 16 pixels, pY/pCb/pCr are 16 bytes, pBGR is 64 bytes */
+__INLINE void ownYCbCrToBGR_16px(
+  const Ipp8u* pY,
+  const Ipp8u* pCb,
+  const Ipp8u* pCr,
+        Ipp8u* pBGR,
+        __m256i  aval)
+{
+  const __m256i iRCr = _mm256_set1_epi16( kRCr );
+  const __m256i iGCr = _mm256_set1_epi16( kGCr );
+  const __m256i iGCb = _mm256_set1_epi16( kGCb );
+  const __m256i iBCb = _mm256_set1_epi16( kBCb );
+  const __m256i iR   = _mm256_set1_epi16( kR );
+  const __m256i iG   = _mm256_set1_epi16( kG );
+  const __m256i iB   = _mm256_set1_epi16( kB );
+  const __m256i kOKR = _mm256_set1_epi16( 8 );
+  /* b0..b7 g0..g7 -> b0 g0 b1 g1 ..., the same for r and a */
+  const __m256i sHf  = _mm256_setr_epi8(
+    0, 8, 1, 9, 2, 10, 3, 11, 4, 12, 5, 13, 6, 14, 7, 15,
+    0, 8, 1, 9, 2, 10, 3, 11, 4, 12, 5, 13, 6, 14, 7, 15 );
+
+  __m256i eY, eU, eV, eR, eG, eB, eBG, eRA, t0, t1;
+
+  eY = _mm256_slli_epi16( _mm256_cvtepu8_epi16( _mm_loadu_si128( (const __m128i*)pY  ) ), 4 );
+  eU = _mm256_slli_epi16( _mm256_cvtepu8_epi16( _mm_loadu_si128( (const __m128i*)pCb ) ), 7 );
+  eV = _mm256_slli_epi16( _mm256_cvtepu8_epi16( _mm_loadu_si128( (const __m128i*)pCr ) ), 7 );
+
+  eR = _mm256_mulhi_epi16( eV, iRCr );
+  eR = _mm256_adds_epi16 ( eR, eY   );
+  eR = _mm256_subs_epi16 ( eR, iR   );
+  eR = _mm256_adds_epi16 ( eR, kOKR );
+  eR = _mm256_srai_epi16 ( eR, 4    );
+
+  eB = _mm256_mulhi_epi16( eU, iBCb );
+  eB = _mm256_adds_epi16 ( eB, eY   );
+  eB = _mm256_subs_epi16 ( eB, iB   );
+  eB = _mm256_adds_epi16 ( eB, kOKR );
+  eB = _mm256_srai_epi16 ( eB, 4    );
+
+  eG = _mm256_mulhi_epi16( eU, iGCb );
+  eG = _mm256_adds_epi16 ( eG, _mm256_mulhi_epi16( eV, iGCr ) );
+  eY = _mm256_adds_epi16 ( eY, iG   );
+  eG = _mm256_subs_epi16 ( eY, eG   );
+  eG = _mm256_adds_epi16 ( eG, kOKR );
+  eG = _mm256_srai_epi16 ( eG, 4    );
+
+  /* per lane: |g7..g0|b7..b0| and |a..a|r7..r0|, lane 1 holds pixels 8..15 */
+  eBG = _mm256_shuffle_epi8( _mm256_packus_epi16( eB, eG ), sHf );
+  eRA = _mm256_shuffle_epi8( _mm256_packus_epi16( eR, aval ), sHf );
+
+  t0 = _mm256_unpacklo_epi16( eBG, eRA ); /* pixels 0..3 | 8..11  */
+  t1 = _mm256_unpackhi_epi16( eBG, eRA ); /* pixels 4..7 | 12..15 */
+
+  _mm256_storeu_si256( (__m256i*)pBGR,        _mm256_permute2x128_si256( t0, t1, 0x20 ) );
+  _mm256_storeu_si256( (__m256i*)(pBGR + 32), _mm256_permute2x128_si256( t0, t1, 0x31 ) );
+
+  return;
+} /* ownYCbCrToBGR_16px() */
+
+
+OWNFUN(void, mfxownYCbCrToBGR_JPEG_8u_P3C4R_L9, (
+  const Ipp8u*   pYCC[3],
+        int      yccStep,
+        Ipp8u*   pBGR,
+        int      bgrStep,
+        IppiSize roiSize,
+        Ipp8u    aval))
+{
+  int h, w;
+  int width16 = roiSize.width & ~15;
+  int last    = roiSize.width & 15;
+  /* alpha in 16-bit lanes, so that packus puts it next to red */
+  const __m256i eAval = _mm256_set1_epi16( aval );
+
+  for(h = 0; h < roiSize.height; h++)
+  {
+    const Ipp8u* srcy = pYCC[0] + h * yccStep;
+    const Ipp8u* srcu = pYCC[1] + h * yccStep;
+    const Ipp8u* srcv = pYCC[2] + h * yccStep;
+    Ipp8u*       dst  = pBGR    + h * bgrStep;
+
+    for(w = 0; w < width16; w += 16)
+    {
+      ownYCbCrToBGR_16px( srcy + w, srcu + w, srcv + w, dst + w * 4, eAval );
+    }
+
+    if( last )
+    {
+      Ipp8u y[16], u[16], v[16];
+      Ipp8u bgr[64];
+
+      for(w = 0; w < last; w++)
+      {
+        y[w] = srcy[width16 + w];
+        u[w] = srcu[width16 + w];
+        v[w] = srcv[width16 + w];
+      }
+      for( ; w < 16; w++)
+      {
+        y[w] = u[w] = v[w] = 0;
+      }
+
+      ownYCbCrToBGR_16px( y, u, v, bgr, eAval );
+
+      for(w = 0; w < last * 4; w++)
+      {
+        dst[width16 * 4 + w] = bgr[w];
+      }
+    }
+  }
+
+  return;
+} /* mfxownYCbCrToBGR_JPEG_8u_P3C4R_L9() */
+
+
+OWNFUN(void, mfxownYCbCr420_8u_P3P2R_L9, (
+  const Ipp8u*   pSrc[3],
+        int      srcStep[3],
+        Ipp8u*   pDstY,
+        int      dstYStep,
+        Ipp8u*   pDstCbCr,
+        int      dstCbCrStep,
+        IppiSize roiSize))
+{
+  int h, w;
+  int width  = roiSize.width;
+  int height = roiSize.height;
+
+  /* Y plane */
+  for(h = 0; h < height; h++)
+  {
+    const Ipp8u* src = pSrc[0] + h * srcStep[0];
+    Ipp8u*       dst = pDstY   + h * dstYStep;
+
+    for(w = 0; w + 32 <= width; w += 32)
+    {
+      _mm256_storeu_si256( (__m256i*)(dst + w), _mm256_loadu_si256( (const __m256i*)(src + w) ) );
+    }
+    for( ; w < width; w++)
+    {
+      dst[w] = src[w];
+    }
+  }
+
+  width  >>= 1;
+  height >>= 1;
+
+  /* interleaved CbCr plane */
+  for(h = 0; h < height; h++)
+  {
+    const Ipp8u* srcu = pSrc[1]  + h * srcStep[1];
+    const Ipp8u* srcv = pSrc[2]  + h * srcStep[2];
+    Ipp8u*       dst  = pDstCbCr + h * dstCbCrStep;
+
+    for(w = 0; w + 32 <= width; w += 32)
+    {
+      __m256i u  = _mm256_loadu_si256( (const __m256i*)(srcu + w) );
+      __m256i v  = _mm256_loadu_si256( (const __m256i*)(srcv + w) );
+      __m256i lo = _mm256_unpacklo_epi8( u, v ); /* 0..7  | 16..23 */
+      __m256i hi = _mm256_unpackhi_epi8( u, v ); /* 8..15 | 24..31 */
+
+      _mm256_storeu_si256( (__m256i*)(dst + 2 * w),      _mm256_permute2x128_si256( lo, hi, 0x20 ) );
+      _mm256_storeu_si256( (__m256i*)(dst + 2 * w + 32), _mm256_permute2x128_si256( lo, hi, 0x31 ) );
+    }
+    for( ; w < width; w++)
+    {
+      dst[2 * w]     = srcu[w];
+      dst[2 * w + 1] = srcv[w];
+    }
+  }
+
+  return;
+} /* mfxownYCbCr420_8u_P3P2R_L9() */
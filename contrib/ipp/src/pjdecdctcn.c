@@ -31,6 +31,7 @@
 
 #include "precomp.h"
 #include "ownj.h"
+#include "ownjl9.h"
 
 //#ifndef __PS_ANARITH_H__
 //#include "ps_anarith.h"
@@ -199,7 +200,9 @@ IPPFUN(IppStatus, mfxiDCTQuantInv8x8LS_JPEG_16s8u_C1R, (
    IPP_BAD_STEP_RET(dstStep)
    IPP_BAD_PTR1_RET(pQuantInvTable)
 
-   if ( !((IPP_INT_PTR(pSrc)|IPP_INT_PTR(pQuantInvTable)) & 15) ) {
+   if ( OWN_HAS_L9() ) {
+      mfxownpj_DCTQuantInv8x8LS_JPEG_16s8u_C1R_L9 ( pSrc, pDst, dstStep, pQuantInvTable );
+   } else if ( !((IPP_INT_PTR(pSrc)|IPP_INT_PTR(pQuantInvTable)) & 15) ) {
       dct_8x8_inv_16s_algnd ( pSrc, pDst, dstStep, (const Ipp16s*)pQuantInvTable);
    } else {
       dct_8x8_inv_16s ( pSrc, pDst, dstStep, (const Ipp16s*)pQuantInvTable);
@@ -0,0 +1,257 @@
+// Copyright (c) 2025 Intel Corporation
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+/*
+//
+//  Purpose:
+//    Inverse DCT transform, de-quantization and level shift, AVX2 code path
+//
+//  Contents:
+//    mfxownpj_DCTQuantInv8x8LS_JPEG_16s8u_C1R_L9
+//
+//  Notes:
+//    Same arithmetic as SSE4 code path in pjdecdctcn.c. Rows with equal
+//    coefficient tables (0 and 4, 1 and 7, 2 and 6, 3 and 5) are transformed
+//    in the halves of one YMM register. Zero rows are not checked: on real
+//    streams the branch is mispredicted too often to pay off.
+//
+*/
+
+#include <immintrin.h>
+
+#include "precomp.h"
+#include "ownjl9.h"
+
+#define XMMCONST           static const _Alignas(32)
+
+#define SH_2020            _MM_SHUFFLE(2,0,2,0)
+#define SH_3131            _MM_SHUFFLE(3,1,3,1)
+#define SH_1032            _MM_SHUFFLE(1,0,3,2)
+#define SH_0123            _MM_SHUFFLE(0,1,2,3)
+
+#define PADDSW(a, b)       _mm_adds_epi16( a, b )
+#define PSUBSW(a, b)       _mm_subs_epi16( a, b )
+#define PMULHW(a, b)       _mm_mulhi_epi16( a, b )
+#define PSRAW(a, c)        _mm_srai_epi16( a, c )
+#define LDK(p)             _mm_load_si128( (const __m128i*)(p) )
+
+#define STLH(p1, p2, v)    { _mm_storel_epi64( (__m128i*)(p1), v ); \
+                             _mm_storeh_pd( (double*)(p2), _mm_castsi128_pd( v ) ); }
+
+#define BITS_INV_ACC       5
+#define SHIFT_INV_ROW     16 - BITS_INV_ACC
+#define SHIFT_INV_COL      1 + BITS_INV_ACC
+#define RND_INV_ROW        (1 << (SHIFT_INV_ROW-1))
+
+#define c_inv_corr_0     -1024 * (6 - BITS_INV_ACC) + 65536 /* -0.5 + 32.0  */
+#define c_inv_corr_1      1877 * (6 - BITS_INV_ACC)         /*  0.9167      */
+#define c_inv_corr_2      1236 * (6 - BITS_INV_ACC)         /*  0.6035      */
+#define c_inv_corr_3       680 * (6 - BITS_INV_ACC)         /*  0.3322      */
+#define c_inv_corr_4         0 * (6 - BITS_INV_ACC)         /*  0.0         */
+#define c_inv_corr_5      -569 * (6 - BITS_INV_ACC)         /* -0.278       */
+#define c_inv_corr_6      -512 * (6 - BITS_INV_ACC)         /* -0.25        */
+#define c_inv_corr_7      -651 * (6 - BITS_INV_ACC)         /* -0.3176      */
+
+#define RND_INV_ROW_0      (RND_INV_ROW + c_inv_corr_0)
+#define RND_INV_ROW_1      (RND_INV_ROW + c_inv_corr_1)
+#define RND_INV_ROW_2      (RND_INV_ROW + c_inv_corr_2)
+#define RND_INV_ROW_3      (RND_INV_ROW + c_inv_corr_3)
+#define RND_INV_ROW_4      (RND_INV_ROW + c_inv_corr_4)
+#define RND_INV_ROW_5      (RND_INV_ROW + c_inv_corr_5)
+#define RND_INV_ROW_6      (RND_INV_ROW + c_inv_corr_6)
+#define RND_INV_ROW_7      (RND_INV_ROW + c_inv_corr_7)
+
+/* rounding constants of two rows placed to the low and high halves */
+#define ROUND_PAIR(a, b)   { RND_INV_ROW_##a, RND_INV_ROW_##a, RND_INV_ROW_##a, RND_INV_ROW_##a, \
+                             RND_INV_ROW_##b, RND_INV_ROW_##b, RND_INV_ROW_##b, RND_INV_ROW_##b }
+
+XMMCONST int round_i_04[8] = ROUND_PAIR(0, 4);
+XMMCONST int round_i_17[8] = ROUND_PAIR(1, 7);
+XMMCONST int round_i_26[8] = ROUND_PAIR(2, 6);
+XMMCONST int round_i_35[8] = ROUND_PAIR(3, 5);
+
+
+XMMCONST short int tg_1_16[8] =
+   { 13036,  13036,  13036,  13036,  13036,  13036,  13036,  13036 };
+XMMCONST short int tg_2_16[8] =
+   { 27146,  27146,  27146,  27146,  27146,  27146,  27146,  27146 };
+XMMCONST short int tg_3_16[8] =
+   {-21746, -21746, -21746, -21746, -21746, -21746, -21746, -21746 };
+XMMCONST short int cos_4_16[8] =
+   {-19195, -19195, -19195, -19195, -19195, -19195, -19195, -19195 };
+
+
+XMMCONST short int tab_i_04[32] =
+   { 16384,  21407,  16384,   8867, -16384,  21407,  16384,  -8867,
+     16384,  -8867,  16384, -21407,  16384,   8867, -16384, -21407,
+     22725,  19266,  19266,  -4520,   4520,  19266,  19266, -22725,
+     12873, -22725,   4520, -12873,  12873,   4520, -22725, -12873 };
+XMMCONST short int tab_i_17[32] =
+   { 22725,  29692,  22725,  12299, -22725,  29692,  22725, -12299,
+     22725, -12299,  22725, -29692,  22725,  12299, -22725, -29692,
+     31521,  26722,  26722,  -6270,   6270,  26722,  26722, -31521,
+     17855, -31521,   6270, -17855,  17855,   6270, -31521, -17855 };
+XMMCONST short int tab_i_26[32] =
+   { 21407,  27969,  21407,  11585, -21407,  27969,  21407, -11585,
+     21407, -11585,  21407, -27969,  21407,  11585, -21407, -27969,
+     29692,  25172,  25172,  -5906,   5906,  25172,  25172, -29692,
+     16819, -29692,   5906, -16819,  16819,   5906, -29692, -16819 };
+XMMCONST short int tab_i_35[32] =
+   { 19266,  25172,  19266,  10426, -19266,  25172,  19266, -10426,
+     19266, -10426,  19266, -25172,  19266,  10426, -19266, -25172,
+     26722,  22654,  22654,  -5315,   5315,  22654,  22654, -26722,
+     15137, -26722,   5315, -15137,  15137,   5315, -26722, -15137 };
+
+
+/* load rows a and b to the low and high halves */
+#define LD_PAIR(p, a, b) \
+   _mm256_inserti128_si256( _mm256_castsi128_si256( _mm_loadu_si128( (const __m128i*)((p) + (a)*8) ) ), \
+                            _mm_loadu_si128( (const __m128i*)((p) + (b)*8) ), 1 )
+
+#define BCAST(p)           _mm256_broadcastsi128_si256( _mm_load_si128( (const __m128i*)(p) ) )
+
+
+__INLINE __m256i dct_8x8_inv_row_pair(
+  const Ipp16s* pSrc,
+  const Ipp16s* pQuantInvTable,
+        int     a,
+        int     b,
+  const short*  tab,
+  const int*    round)
+{
+   __m256i x, xe, xo, t1e, t2e, t1o, t2o, a0, b0, s0, s1;
+
+   x   = LD_PAIR( pSrc, a, b );
+   x   = _mm256_mullo_epi16( x, LD_PAIR( pQuantInvTable, a, b ) );
+   xe  = _mm256_shufflelo_epi16( x, SH_2020 );
+   xo  = _mm256_shufflelo_epi16( x, SH_3131 );
+   xe  = _mm256_shufflehi_epi16( xe, SH_2020 );
+   xo  = _mm256_shufflehi_epi16( xo, SH_3131 );
+   t1e = _mm256_madd_epi16( xe, BCAST( tab + 0 ) );
+   t2e = _mm256_madd_epi16( xe, BCAST( tab + 8 ) );
+   t1o = _mm256_madd_epi16( xo, BCAST( tab + 16 ) );
+   t2o = _mm256_madd_epi16( xo, BCAST( tab + 24 ) );
+   t1e = _mm256_add_epi32( t1e, _mm256_load_si256( (const __m256i*)round ) );
+   t2e = _mm256_shuffle_epi32( t2e, SH_1032 );
+   t2o = _mm256_shuffle_epi32( t2o, SH_1032 );
+   a0  = _mm256_add_epi32( t1e, t2e );
+   b0  = _mm256_add_epi32( t1o, t2o );
+   s0  = _mm256_add_epi32( a0, b0 );
+   s1  = _mm256_sub_epi32( a0, b0 );
+   s0  = _mm256_srai_epi32( s0, SHIFT_INV_ROW );
+   s1  = _mm256_srai_epi32( s1, SHIFT_INV_ROW );
+   x   = _mm256_packs_epi32( s0, s1 );
+
+   return _mm256_shufflehi_epi16( x, SH_0123 );
+} /* dct_8x8_inv_row_pair() */
+
+
+OWNFUN(void, mfxownpj_DCTQuantInv8x8LS_JPEG_16s8u_C1R_L9, (
+  const Ipp16s* pSrc,
+        Ipp8u*  pDst,
+        int     dstStep,
+  const Ipp16u* pQuantInvTable))
+{
+   const Ipp16s* pQnt = (const Ipp16s*)pQuantInvTable;
+   __m256i x04, x17, x26, x35;
+   __m128i x0, x1, x2, x3, x4, x5, x6, x7,
+           y0, y1, y2, y3, y4, y5, y6, y7,
+           t0, t1, t2, t3, t4, t5, t6, t7,
+           tp03, tm03, tp12, tm12, tp65, tm65,
+           tp465, tm465, tp765, tm765, c128;
+
+/* ------------------------------------------------------------------------ */
+/* rows                                                                     */
+/* ------------------------------------------------------------------------ */
+
+   x04 = dct_8x8_inv_row_pair( pSrc, pQnt, 0, 4, tab_i_04, round_i_04 );
+   x17 = dct_8x8_inv_row_pair( pSrc, pQnt, 1, 7, tab_i_17, round_i_17 );
+   x26 = dct_8x8_inv_row_pair( pSrc, pQnt, 2, 6, tab_i_26, round_i_26 );
+   x35 = dct_8x8_inv_row_pair( pSrc, pQnt, 3, 5, tab_i_35, round_i_35 );
+
+   x0 = _mm256_castsi256_si128( x04 );
+   x4 = _mm256_extracti128_si256( x04, 1 );
+   x1 = _mm256_castsi256_si128( x17 );
+   x7 = _mm256_extracti128_si256( x17, 1 );
+   x2 = _mm256_castsi256_si128( x26 );
+   x6 = _mm256_extracti128_si256( x26, 1 );
+   x3 = _mm256_castsi256_si128( x35 );
+   x5 = _mm256_extracti128_si256( x35, 1 );
+
+/* ------------------------------------------------------------------------ */
+/* columns                                                                  */
+/* ------------------------------------------------------------------------ */
+
+   t3    = PADDSW( PMULHW( x3, LDK(tg_3_16) ), x3 );
+   t5    = PADDSW( PMULHW( x5, LDK(tg_3_16) ), x5 );
+   tm765 = PADDSW( t5, x3 );
+   tm465 = PSUBSW( x5, t3 );
+
+   t1    = PMULHW( x1, LDK(tg_1_16) );
+   t7    = PMULHW( x7, LDK(tg_1_16) );
+   tp765 = PADDSW( x1, t7 );
+   tp465 = PSUBSW( t1, x7 );
+
+   t7    = PADDSW( tp765, tm765 );
+   tp65  = PSUBSW( tp765, tm765 );
+   t4    = PADDSW( tp465, tm465 );
+   tm65  = PSUBSW( tp465, tm465 );
+
+   t2    = PMULHW( x2, LDK(tg_2_16) );
+   t6    = PMULHW( x6, LDK(tg_2_16) );
+   tm03  = PADDSW( x2, t6 );
+   tm12  = PSUBSW( t2, x6 );
+
+   t5    = PSUBSW( tp65, tm65 );
+   t6    = PADDSW( tp65, tm65 );
+   t5    = PADDSW( PMULHW( t5, LDK(cos_4_16) ), t5 );
+   t6    = PADDSW( PMULHW( t6, LDK(cos_4_16) ), t6 );
+
+   tp03  = PADDSW( x0, x4 );
+   tp12  = PSUBSW( x0, x4 );
+
+   t0    = PADDSW( tp03, tm03 );
+   t3    = PSUBSW( tp03, tm03 );
+   t1    = PADDSW( tp12, tm12 );
+   t2    = PSUBSW( tp12, tm12 );
+
+   y0    = PSRAW( PADDSW( t0, t7 ), SHIFT_INV_COL );
+   y7    = PSRAW( PSUBSW( t0, t7 ), SHIFT_INV_COL );
+   y1    = PSRAW( PADDSW( t1, t6 ), SHIFT_INV_COL );
+   y6    = PSRAW( PSUBSW( t1, t6 ), SHIFT_INV_COL );
+   y2    = PSRAW( PADDSW( t2, t5 ), SHIFT_INV_COL );
+   y5    = PSRAW( PSUBSW( t2, t5 ), SHIFT_INV_COL );
+   y3    = PSRAW( PADDSW( t3, t4 ), SHIFT_INV_COL );
+   y4    = PSRAW( PSUBSW( t3, t4 ), SHIFT_INV_COL );
+
+   c128 = _mm_set1_epi16( 128 );
+
+   y0 = _mm_packus_epi16( _mm_add_epi16( y0, c128 ), _mm_add_epi16( y1, c128 ) );
+   y2 = _mm_packus_epi16( _mm_add_epi16( y2, c128 ), _mm_add_epi16( y3, c128 ) );
+   y4 = _mm_packus_epi16( _mm_add_epi16( y4, c128 ), _mm_add_epi16( y5, c128 ) );
+   y6 = _mm_packus_epi16( _mm_add_epi16( y6, c128 ), _mm_add_epi16( y7, c128 ) );
+
+   STLH( pDst + 0*dstStep, pDst + 1*dstStep, y0 );
+   STLH( pDst + 2*dstStep, pDst + 3*dstStep, y2 );
+   STLH( pDst + 4*dstStep, pDst + 5*dstStep, y4 );
+   STLH( pDst + 6*dstStep, pDst + 7*dstStep, y6 );
+
+   return;
+} /* mfxownpj_DCTQuantInv8x8LS_JPEG_16s8u_C1R_L9() */
@@ -37,6 +37,9 @@
 #ifndef __PJDECSS_H__
 #include "pjdecss.h"
 #endif
+#ifndef __OWNJL9_H__
+#include "ownjl9.h"
+#endif
 
 
 
@@ -67,6 +70,12 @@ IPPFUN(IppStatus, mfxiSampleUpRowH2V1_Triangle_JPEG_8u_C1, (
   IPP_BAD_PTR2_RET(pSrc,pDst)
   IPP_BAD_SIZE_RET(srcWidth)
 
+  if( OWN_HAS_L9() )
+  {
+    mfxownpj_SampleUpRowH2V1_Triangle_JPEG_8u_C1_L9(pSrc, srcWidth, pDst);
+    return ippStsNoErr;
+  }
+
 #if IPPJ_DECSS_OPT || (_IPPXSC >= _IPPXSC_S2)
   ownpj_SampleUpRowH2V1_Triangle_JPEG_8u_C1(pSrc, srcWidth, pDst);
 #else
@@ -128,6 +137,12 @@ IPPFUN(IppStatus, mfxiSampleUpRowH2V2_Triangle_JPEG_8u_C1, (
   IPP_BAD_PTR3_RET(pSrc1,pSrc2,pDst)
   IPP_BAD_SIZE_RET(srcWidth)
 
+  if( OWN_HAS_L9() )
+  {
+    mfxownpj_SampleUpRowH2V2_Triangle_JPEG_8u_C1_L9(pSrc1, pSrc2, srcWidth, pDst);
+    return ippStsNoErr;
+  }
+
 #if IPPJ_DECSS_OPT// || (_IPPXSC >= _IPPXSC_S2)
   ownpj_SampleUpRowH2V2_Triangle_JPEG_8u_C1(pSrc1, pSrc2, srcWidth, pDst);
 #else
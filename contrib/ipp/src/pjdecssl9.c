@@ -0,0 +1,147 @@
+// Copyright (c) 2025 Intel Corporation
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+/*
+//
+//  Purpose:
+//    Upsampling functions, AVX2 code path
+//
+//  Contents:
+//    mfxownpj_SampleUpRowH2V1_Triangle_JPEG_8u_C1_L9
+//    mfxownpj_SampleUpRowH2V2_Triangle_JPEG_8u_C1_L9
+//
+//  Notes:
+//    16 source pixels are processed per iteration in 16-bit lanes,
+//    the first and the last columns are processed as in pjdecss0.c
+//
+*/
+
+#include <immintrin.h>
+
+#include "precomp.h"
+#include "ownjl9.h"
+
+#define LD16(p)  _mm256_cvtepu8_epi16( _mm_loadu_si128( (const __m128i*)(p) ) )
+
+/* even and odd output pixels in 16-bit lanes to 32 sequential bytes */
+#define ST32(p, even, odd) \
+  _mm256_storeu_si256( (__m256i*)(p), _mm256_or_si256( even, _mm256_slli_epi16( odd, 8 ) ) )
+
+
+OWNFUN(void, mfxownpj_SampleUpRowH2V1_Triangle_JPEG_8u_C1_L9, (
+  const Ipp8u* pSrc,
+        int    srcWidth,
+        Ipp8u* pDst))
+{
+  int i;
+  int invalue;
+  const __m256i one = _mm256_set1_epi16( 1 );
+  const __m256i two = _mm256_set1_epi16( 2 );
+
+  /* Special case for first column */
+  invalue = pSrc[0];
+  pDst[0] = (Ipp8u)invalue;
+  pDst[1] = (Ipp8u)((invalue * 3 + pSrc[1] + 2) >> 2);
+
+  /* General case: 3/4 * nearer pixel + 1/4 * further pixel */
+  for(i = 1; i + 16 < srcWidth; i += 16)
+  {
+    __m256i prev = LD16( pSrc + i - 1 );
+    __m256i curr = LD16( pSrc + i );
+    __m256i next = LD16( pSrc + i + 1 );
+    __m256i curr3 = _mm256_add_epi16( curr, _mm256_add_epi16( curr, curr ) );
+    __m256i even = _mm256_srli_epi16( _mm256_add_epi16( _mm256_add_epi16( curr3, prev ), one ), 2 );
+    __m256i odd  = _mm256_srli_epi16( _mm256_add_epi16( _mm256_add_epi16( curr3, next ), two ), 2 );
+
+    ST32( pDst + 2 * i, even, odd );
+  }
+
+  for( ; i < srcWidth - 1; i++)
+  {
+    invalue = pSrc[i] * 3;
+    pDst[2 * i]     = (Ipp8u)((invalue + pSrc[i - 1] + 1) >> 2);
+    pDst[2 * i + 1] = (Ipp8u)((invalue + pSrc[i + 1] + 2) >> 2);
+  }
+
+  /* Special case for last column */
+  invalue = pSrc[srcWidth - 1];
+  pDst[2 * srcWidth - 2] = (Ipp8u)((invalue * 3 + pSrc[srcWidth - 2] + 1) >> 2);
+  pDst[2 * srcWidth - 1] = (Ipp8u)invalue;
+
+  return;
+} /* mfxownpj_SampleUpRowH2V1_Triangle_JPEG_8u_C1_L9() */
+
+
+OWNFUN(void, mfxownpj_SampleUpRowH2V2_Triangle_JPEG_8u_C1_L9, (
+  const Ipp8u* pSrc1,
+  const Ipp8u* pSrc2,
+        int    srcWidth,
+        Ipp8u* pDst))
+{
+  int i;
+  int thiscolsum, lastcolsum, nextcolsum;
+  const __m256i seven = _mm256_set1_epi16( 7 );
+  const __m256i eight = _mm256_set1_epi16( 8 );
+
+#define COLSUM(i) (pSrc1[i] * 3 + pSrc2[i])
+#define COLSUM16(i) \
+  _mm256_add_epi16( _mm256_mullo_epi16( LD16( pSrc1 + (i) ), _mm256_set1_epi16( 3 ) ), LD16( pSrc2 + (i) ) )
+
+  /* Special case for first column */
+  thiscolsum = COLSUM(0);
+  nextcolsum = COLSUM(1);
+
+  pDst[0] = (Ipp8u)((thiscolsum * 4 + 8) >> 4);
+  pDst[1] = (Ipp8u)((thiscolsum * 3 + nextcolsum + 7) >> 4);
+
+  /* General case: 3/4 * nearer pixel + 1/4 * further pixel */
+  /* in each dimension, thus 9/16, 3/16, 3/16, 1/16 overall */
+  for(i = 1; i + 16 < srcWidth; i += 16)
+  {
+    __m256i last = COLSUM16( i - 1 );
+    __m256i curr = COLSUM16( i );
+    __m256i next = COLSUM16( i + 1 );
+    __m256i curr3 = _mm256_add_epi16( curr, _mm256_add_epi16( curr, curr ) );
+    __m256i even = _mm256_srli_epi16( _mm256_add_epi16( _mm256_add_epi16( curr3, last ), eight ), 4 );
+    __m256i odd  = _mm256_srli_epi16( _mm256_add_epi16( _mm256_add_epi16( curr3, next ), seven ), 4 );
+
+    ST32( pDst + 2 * i, even, odd );
+  }
+
+  for( ; i < srcWidth - 1; i++)
+  {
+    lastcolsum = COLSUM(i - 1);
+    thiscolsum = COLSUM(i);
+    nextcolsum = COLSUM(i + 1);
+    pDst[2 * i]     = (Ipp8u)((thiscolsum * 3 + lastcolsum + 8) >> 4);
+    pDst[2 * i + 1] = (Ipp8u)((thiscolsum * 3 + nextcolsum + 7) >> 4);
+  }
+
+  /* Special case for last column */
+  lastcolsum = COLSUM(srcWidth - 2);
+  thiscolsum = COLSUM(srcWidth - 1);
+  pDst[2 * srcWidth - 2] = (Ipp8u)((thiscolsum * 3 + lastcolsum + 8) >> 4);
+  pDst[2 * srcWidth - 1] = (Ipp8u)((thiscolsum * 4 + 7) >> 4);
+
+#undef COLSUM16
+#undef COLSUM
+
+  return;
+} /* mfxownpj_SampleUpRowH2V2_Triangle_JPEG_8u_C1_L9() */
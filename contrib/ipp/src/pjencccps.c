@@ -33,6 +33,9 @@
 #ifndef __OWNJ_H__
 #include "ownj.h"
 #endif
+#ifndef __OWNJL9_H__
+#include "ownjl9.h"
+#endif
 #define CLIP(x) ((x < 0) ? 0 : ((x > 255) ? 255 : x))
 
 #if ( _IPP >= _IPP_V8 )||( _IPP32E >= _IPP32E_U8 )
@@ -99,6 +102,13 @@ const Ipp8u* pYCC[3],int yccStep,Ipp8u* pBGR,int bgrStep,IppiSize roiSize, Ipp8u
   IPP_BAD_PTR3_RET( pYCC[0], pYCC[1], pYCC[2]);
   IPP_BADARG_RET((roiSize.width < 2 || roiSize.height < 1), ippStsSizeErr);
   IPP_BADARG_RET(( yccStep == 0 || bgrStep == 0 ), ippStsStepErr);
+
+  if( OWN_HAS_L9() )
+  {
+    mfxownYCbCrToBGR_JPEG_8u_P3C4R_L9( pYCC, yccStep, pBGR, bgrStep, roiSize, aval );
+    return ippStsNoErr;
+  }
+
 #if ( _IPP >= _IPP_V8 )||( _IPP32E >= _IPP32E_U8 )
   mfxownYCbCrToBGR_JPEG_8u_P3C4R( pYCC, yccStep, pBGR, bgrStep, roiSize, aval, 1 );
 #else
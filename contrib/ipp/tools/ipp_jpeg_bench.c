@@ -0,0 +1,329 @@
+// Copyright (c) 2025 Intel Corporation
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+/*
+//
+//  Purpose:
+//    Throughput of JPEG decoder kernels for every dispatched code path.
+//    Each kernel is run with CPU features limited to SSE4.2 and with all
+//    features of the CPU, outputs of the code paths are compared.
+//
+//  Usage:
+//    ipp_jpeg_bench [width height [iterations]]
+//
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <time.h>
+
+#include "ippcore.h"
+#include "ippcc.h"
+#include "ippj.h"
+
+#define SSE42_FEATURES \
+  ( ippCPUID_MMX | ippCPUID_SSE | ippCPUID_SSE2 | ippCPUID_SSE3 | \
+    ippCPUID_SSSE3 | ippCPUID_SSE41 | ippCPUID_SSE42 )
+
+#define NUM_PATHS    2
+#define BENCH_ROUNDS 7
+
+typedef struct _BenchCtx
+{
+  int     width;
+  int     height;
+  int     nBlocks;
+
+  Ipp16s* pCoefs;
+  Ipp16u  quantInv[64];
+  Ipp8u*  pPixels[NUM_PATHS];
+
+  Ipp8u*  pPlanes[3];
+  Ipp8u*  pOut[NUM_PATHS];
+  int     outSize;
+} BenchCtx;
+
+typedef IppStatus (*BenchKernel)(BenchCtx* ctx, int path);
+
+
+static double GetTime(void)
+{
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+
+static unsigned int Rand(void)
+{
+  static unsigned int seed = 12345;
+  seed = seed * 1103515245 + 12345;
+  return (seed >> 16) & 0x7fff;
+}
+
+
+/* luminance quantization table, ISO/IEC 10918-1 Annex K, in zigzag order */
+static const Ipp8u StdLumQuant[64] =
+{
+  16, 11, 12, 14, 12, 10, 16, 14, 13, 14, 18, 17, 16, 19, 24, 40,
+  26, 24, 22, 22, 24, 49, 35, 37, 29, 40, 58, 51, 61, 60, 57, 51,
+  56, 55, 64, 72, 92, 78, 64, 68, 87, 69, 55, 56, 80,109, 81, 87,
+  95, 98,103,104,103, 62, 77,113,121,112,100,120, 92,101,103, 99
+};
+
+
+/* smooth areas, edges and some noise, as in camera pictures */
+static void FillImage(Ipp8u* pImage, int width, int height)
+{
+  int x, y;
+
+  for(y = 0; y < height; y++)
+  {
+    for(x = 0; x < width; x++)
+    {
+      int value = 128 + (int)(60.0 * sin(x / 23.0) * cos(y / 17.0)) +
+                  ((((x / 64) + (y / 48)) & 1) ? 30 : -30) + (int)(Rand() % 9) - 4;
+
+      pImage[y * width + x] = (Ipp8u)(value < 0 ? 0 : value > 255 ? 255 : value);
+    }
+  }
+}
+
+
+static IppStatus IDCTKernel(BenchCtx* ctx, int path)
+{
+  int i;
+  int blocksPerRow = ctx->width / 8;
+
+  for(i = 0; i < ctx->nBlocks; i++)
+  {
+    Ipp8u* pDst = ctx->pPixels[path] + (i / blocksPerRow) * 8 * ctx->width + (i % blocksPerRow) * 8;
+    IppStatus status = mfxiDCTQuantInv8x8LS_JPEG_16s8u_C1R(
+      ctx->pCoefs + i * 64, pDst, ctx->width, ctx->quantInv);
+    if(ippStsNoErr != status)
+      return status;
+  }
+
+  return ippStsNoErr;
+}
+
+
+static IppStatus UpH2V1Kernel(BenchCtx* ctx, int path)
+{
+  int y;
+
+  for(y = 0; y < ctx->height; y++)
+  {
+    IppStatus status = mfxiSampleUpRowH2V1_Triangle_JPEG_8u_C1(
+      ctx->pPlanes[1] + y * ctx->width / 2, ctx->width / 2, ctx->pOut[path] + y * ctx->width);
+    if(ippStsNoErr != status)
+      return status;
+  }
+
+  return ippStsNoErr;
+}
+
+
+static IppStatus UpH2V2Kernel(BenchCtx* ctx, int path)
+{
+  int y;
+
+  for(y = 0; y < ctx->height; y++)
+  {
+    const Ipp8u* pSrc1 = ctx->pPlanes[1] + (y / 2) * ctx->width / 2;
+    const Ipp8u* pSrc2 = pSrc1 + ((y & 1) ? ctx->width / 2 : -ctx->width / 2);
+    IppStatus status;
+
+    if(y < 2 || y >= ctx->height - 2)
+      pSrc2 = pSrc1;
+
+    status = mfxiSampleUpRowH2V2_Triangle_JPEG_8u_C1(
+      pSrc1, pSrc2, ctx->width / 2, ctx->pOut[path] + y * ctx->width);
+    if(ippStsNoErr != status)
+      return status;
+  }
+
+  return ippStsNoErr;
+}
+
+
+static IppStatus ToBGRAKernel(BenchCtx* ctx, int path)
+{
+  IppiSize roi = { ctx->width, ctx->height };
+
+  return mfxiYCbCrToBGR_JPEG_8u_P3C4R(
+    (const Ipp8u**)ctx->pPlanes, ctx->width, ctx->pOut[path], ctx->width * 4, roi, 0xFF);
+}
+
+
+static IppStatus ToNV12Kernel(BenchCtx* ctx, int path)
+{
+  IppiSize roi = { ctx->width, ctx->height };
+  int srcStep[3] = { ctx->width, ctx->width, ctx->width };
+
+  return mfxiYCbCr420_8u_P3P2R(
+    (const Ipp8u**)ctx->pPlanes, srcStep,
+    ctx->pOut[path], ctx->width,
+    ctx->pOut[path] + ctx->width * ctx->height, ctx->width, roi);
+}
+
+
+static int Run(
+  BenchCtx*   ctx,
+  const char* name,
+  BenchKernel kernel,
+  const void* pOut0,
+  const void* pOut1,
+  int         outSize,
+  double      bytes,
+  int         iterations)
+{
+  static const Ipp64u features[NUM_PATHS] = { SSE42_FEATURES, 0 };
+  static const char*  names[NUM_PATHS]    = { "sse4.2", "native" };
+  double best[NUM_PATHS] = { 0, 0 };
+  int round, path, i;
+
+  for(path = 0; path < NUM_PATHS; path++)
+  {
+    mfxSetCpuFeatures(features[path]);
+
+    /* warm up, output for comparison */
+    if(ippStsNoErr != kernel(ctx, path))
+    {
+      printf("%-14s %s: failed\n", name, names[path]);
+      return -1;
+    }
+  }
+
+  /* paths are interleaved and the best time is taken to reduce noise */
+  for(round = 0; round < BENCH_ROUNDS; round++)
+  {
+    for(path = 0; path < NUM_PATHS; path++)
+    {
+      double start, time;
+
+      mfxSetCpuFeatures(features[path]);
+
+      start = GetTime();
+      for(i = 0; i < iterations; i++)
+        kernel(ctx, path);
+      time = GetTime() - start;
+
+      if(0 == round || time < best[path])
+        best[path] = time;
+    }
+  }
+
+  mfxSetCpuFeatures(0);
+
+  printf("%-14s %10.1f %10.1f %8.2fx  %s\n", name,
+    bytes * iterations / best[0] / 1e6, bytes * iterations / best[1] / 1e6, best[0] / best[1],
+    memcmp(pOut0, pOut1, outSize) ? "MISMATCH" : "bit exact");
+
+  return memcmp(pOut0, pOut1, outSize) ? -1 : 0;
+}
+
+
+int main(int argc, char* argv[])
+{
+  BenchCtx ctx;
+  Ipp8u    quantRaw[64];
+  Ipp16u   quantFwd[64];
+  int      iterations = 10;
+  int      errors = 0;
+  int      i;
+
+  memset(&ctx, 0, sizeof(ctx));
+
+  ctx.width  = 1920;
+  ctx.height = 1088;
+
+  if(argc >= 3)
+  {
+    ctx.width  = atoi(argv[1]) & ~15;
+    ctx.height = atoi(argv[2]) & ~15;
+  }
+  if(argc >= 4)
+    iterations = atoi(argv[3]);
+
+  if(ctx.width < 16 || ctx.height < 16 || iterations < 1)
+  {
+    printf("usage: %s [width height [iterations]]\n", argv[0]);
+    return 1;
+  }
+
+  ctx.nBlocks = (ctx.width / 8) * (ctx.height / 8);
+  ctx.outSize = ctx.width * ctx.height * 4;
+  ctx.pCoefs  = (Ipp16s*)malloc(ctx.nBlocks * 64 * sizeof(Ipp16s));
+  for(i = 0; i < NUM_PATHS; i++)
+  {
+    ctx.pPixels[i] = (Ipp8u*)malloc(ctx.width * ctx.height);
+    ctx.pOut[i]    = (Ipp8u*)malloc(ctx.outSize);
+    if(!ctx.pPixels[i] || !ctx.pOut[i])
+      return 1;
+  }
+  for(i = 0; i < 3; i++)
+  {
+    int j;
+    ctx.pPlanes[i] = (Ipp8u*)malloc(ctx.width * ctx.height);
+    if(!ctx.pPlanes[i])
+      return 1;
+    for(j = 0; j < ctx.width * ctx.height; j++)
+      ctx.pPlanes[i][j] = (Ipp8u)(Rand() & 0xff);
+  }
+  if(!ctx.pCoefs)
+    return 1;
+
+  /* coefficients of JPEG picture with quality 75 */
+  memcpy(quantRaw, StdLumQuant, sizeof(quantRaw));
+  mfxiQuantFwdRawTableInit_JPEG_8u(quantRaw, 75);
+  mfxiQuantFwdTableInit_JPEG_8u16u(quantRaw, quantFwd);
+  mfxiQuantInvTableInit_JPEG_8u16u(quantRaw, ctx.quantInv);
+
+  FillImage(ctx.pPixels[0], ctx.width, ctx.height);
+
+  for(i = 0; i < ctx.nBlocks; i++)
+  {
+    int blocksPerRow = ctx.width / 8;
+    mfxiDCTQuantFwd8x8LS_JPEG_8u16s_C1R(
+      ctx.pPixels[0] + (i / blocksPerRow) * 8 * ctx.width + (i % blocksPerRow) * 8, ctx.width,
+      ctx.pCoefs + i * 64, quantFwd);
+  }
+
+  printf("%dx%d, %d iterations, enabled CPU features 0x%llx\n", ctx.width, ctx.height, iterations,
+    (unsigned long long)mfxGetEnabledCpuFeatures());
+  printf("%-14s %10s %10s %9s\n", "kernel, MB/s", "sse4.2", "native", "speedup");
+
+  /* throughput is given in bytes of decoded 8-bit samples */
+  errors |= Run(&ctx, "idct", IDCTKernel, ctx.pPixels[0], ctx.pPixels[1],
+                ctx.width * ctx.height, ctx.nBlocks * 64.0, iterations);
+  errors |= Run(&ctx, "upsample_h2v1", UpH2V1Kernel, ctx.pOut[0], ctx.pOut[1],
+                ctx.width * ctx.height, (double)ctx.width * ctx.height, iterations);
+  errors |= Run(&ctx, "upsample_h2v2", UpH2V2Kernel, ctx.pOut[0], ctx.pOut[1],
+                ctx.width * ctx.height, (double)ctx.width * ctx.height, iterations);
+  errors |= Run(&ctx, "ycbcr_to_bgra", ToBGRAKernel, ctx.pOut[0], ctx.pOut[1],
+                ctx.outSize, (double)ctx.width * ctx.height * 3, iterations);
+  errors |= Run(&ctx, "i420_to_nv12", ToNV12Kernel, ctx.pOut[0], ctx.pOut[1],
+                ctx.width * ctx.height * 3 / 2, (double)ctx.width * ctx.height * 3 / 2, iterations);
+
+  return errors ? 1 : 0;
+}